@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Work at the root directory
+# Should have conanfile.py present there.
+cd "$(dirname "$0")"
+cd ../..
+
+source scripts/common.sh
+_setArgs "$@"
+
+# Call build function from common
+build
+
+executable="build/${BUILD_TYPE}/benchmark_predicate_evaluation"
+declaration="declaration.core"
+repeats=5
+
+# Benchmarks the events/s of the evaluation hot path for the experiment queries.
+function benchmark_experiment() {
+    base_dir=$1
+    csv=$2
+    compressed_csv=$3
+    benchmark_file="$base_dir/predicate_evaluation_benchmark.csv"
+
+    if ! test -f $base_dir/$csv; then
+        if test -f $base_dir/$compressed_csv; then
+            echo -e "$csv not found, uncompressing"
+            tar -xf $base_dir/$compressed_csv --directory $base_dir
+        else
+            echo -e "${RED}$base_dir/$csv not found, skipping${NORMAL_OUTPUT}"
+            return
+        fi
+    fi
+
+    queries=$(find "$base_dir/queries" -type f | sort -V)
+
+    echo "query,predicate_evaluator_events_per_second,virtual_predicates_events_per_second,evaluator_events_per_second" >$benchmark_file
+    for query in $queries; do
+        echo -e "Running ${query}"
+        query_file=$(basename "$query")
+        output=$($executable $query $base_dir/$declaration $base_dir/$csv $repeats)
+        predicates=$(echo "$output" | grep "^PredicateEvaluator:" | awk '{print $3}')
+        virtual_predicates=$(echo "$output" | grep "^Virtual predicates:" | awk '{print $4}')
+        evaluator=$(echo "$output" | grep "^Evaluator:" | awk '{print $3}')
+        echo "$query_file,$predicates,$virtual_predicates,$evaluator" >> "$benchmark_file"
+    done
+}
+
+benchmark_experiment "src/targets/experiments/stocks" "stock_data.csv" "stock_data.tar.xz"
+benchmark_experiment "src/targets/experiments/taxis" "taxi_data.csv" "taxi_data.tar.xz"
+benchmark_experiment "src/targets/experiments/smart_homes" "smart_homes_data.csv" "smart_homes_data.tar.xz"
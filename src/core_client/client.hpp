@@ -26,6 +26,9 @@
 #include "shared/datatypes/enumerator.hpp"
 #include "shared/datatypes/parsing/event_info_parsed.hpp"
 #include "shared/datatypes/parsing/stream_info_parsed.hpp"
+#include "shared/datatypes/query_stats.hpp"
+#include "shared/datatypes/result_batch.hpp"
+#include "shared/datatypes/result_emission_mode.hpp"
 #include "shared/datatypes/server_response.hpp"
 #include "shared/datatypes/server_response_type.hpp"
 #include "shared/networking/message_dealer/zmq_message_dealer.hpp"
@@ -39,6 +42,8 @@ class Client {
   using ClientReqSerializer = Internal::CerealSerializer<Types::ClientRequest>;
   using ServerResSerializer = Internal::CerealSerializer<Types::ServerResponse>;
   using EnumeratorSerializer = Internal::CerealSerializer<Types::Enumerator>;
+  using ResultBatchSerializer = Internal::CerealSerializer<Types::ResultBatch>;
+  using CountSerializer = Internal::CerealSerializer<uint64_t>;
   std::unordered_set<Types::PortNumber> known_query_evaluator_ports;  // TODO
   std::vector<std::thread> subscriber_threads;
   std::vector<std::unique_ptr<Internal::ZMQMessageSubscriber>> subscribers;
@@ -113,37 +118,54 @@ class Client {
     return port_number;
   }
 
+  // Runtime statistics of every query of the server, in the order they were added.
+  Types::ServerStats get_query_stats() {
+    Types::ClientRequest request("", Types::ClientRequestType::QueryStats);
+    Types::ServerResponse response = send_request(request);
+    assert(response.response_type == Types::ServerResponseType::QueryStats);
+    return Internal::CerealSerializer<Types::ServerStats>::deserialize(
+      response.serialized_response_data);
+  }
+
   template <class Handler>
-  SubscriptionId subscribe_to_complex_event(Types::PortNumber port) {
+  SubscriptionId subscribe_to_complex_event(
+    Types::PortNumber port,
+    Types::ResultEmissionMode mode = Types::ResultEmissionMode::EveryEvent) {
     static_assert(std::is_base_of_v<StaticMessageHandler<Handler>, Handler>);
 
-    auto subscription_id = create_subscribers_and_stop_conditions(port);
-    subscriber_threads.emplace_back([&]() {
+    auto subscription_id = create_subscribers_and_stop_conditions(port, mode);
+    subscriber_threads.emplace_back([this, subscription_id, mode]() {
+      Handler handler;
       while (*stop_conditions[subscription_id]) {
         std::string msg = subscribers[subscription_id]->receive();
-        auto enumerator = EnumeratorSerializer::deserialize(msg);
-        for (auto& complex_event : extract_complex_events(enumerator)) {
-          Handler::static_eval(complex_event);
-        }
+        handle_message(&handler, mode, msg);
       }
     });
     return subscription_id;
   }
 
+  /**
+   * Receives the results of the query at the port in another thread. With
+   * ResultEmissionMode::MatchesOnly the handler only gets the non-empty
+   * enumerators, and the progress of the query through handle_progress.
+   */
   template <typename Handler>
-  SubscriptionId subscribe_to_complex_event(Handler* handler, Types::PortNumber port) {
+  SubscriptionId subscribe_to_complex_event(
+    Handler* handler,
+    Types::PortNumber port,
+    Types::ResultEmissionMode mode = Types::ResultEmissionMode::EveryEvent) {
     static_assert(std::is_base_of_v<MessageHandler<Handler>, Handler>
                   || std::is_base_of_v<StaticMessageHandler<Handler>, Handler>);
 
-    auto subscription_id = create_subscribers_and_stop_conditions(port);
+    auto subscription_id = create_subscribers_and_stop_conditions(port, mode);
     auto subscriber = subscribers[subscription_id].get();
     auto& stop_condition = stop_conditions[subscription_id];
-    subscriber_threads.emplace_back([handler, subscriber, stop_condition]() {
+    subscriber_threads.emplace_back([handler, subscriber, stop_condition, mode]() {
       ZoneScopedN("Client::subscribe_to_complex_event::thread");  // NOLINT
       while (!*stop_condition && !handler->needs_to_stop()) {
         std::optional<std::string> message = subscriber->receive(100);
         if (message.has_value()) {
-          handler->eval(EnumeratorSerializer::deserialize(message.value()));
+          handle_message(handler, mode, message.value());
         }
       }
     });
@@ -184,6 +206,32 @@ class Client {
     return res;
   }
 
+  template <typename Handler>
+  static void
+  handle_message(Handler* handler, Types::ResultEmissionMode mode, std::string& message) {
+    if (!Types::is_result_emission_frame(mode, message)) {
+      return;
+    }
+    std::string payload = Types::result_emission_payload(mode, message);
+    if (mode == Types::ResultEmissionMode::EveryEvent) {
+      if (Types::is_result_count_payload(payload)) {
+        handler->eval(Types::Enumerator(CountSerializer::deserialize(
+          payload.substr(Types::RESULT_COUNT_TOPIC.size()))));
+        return;
+      }
+      handler->eval(EnumeratorSerializer::deserialize(payload));
+      return;
+    }
+    Types::ResultBatch batch = ResultBatchSerializer::deserialize(payload);
+    for (Types::Enumerator& enumerator : batch.enumerators) {
+      handler->eval(std::move(enumerator));
+    }
+    for (uint64_t count : batch.counts) {
+      handler->eval(Types::Enumerator(count));
+    }
+    handler->eval_progress(batch.amount_of_events_processed);
+  }
+
   std::vector<Types::ComplexEvent> extract_complex_events(Types::Enumerator& enumerator) {
     std::vector<Types::ComplexEvent> out;
     for (auto val : enumerator) {
@@ -192,9 +240,10 @@ class Client {
     return out;
   }
 
-  SubscriptionId create_subscribers_and_stop_conditions(Types::PortNumber port) {
+  SubscriptionId create_subscribers_and_stop_conditions(Types::PortNumber port,
+                                                        Types::ResultEmissionMode mode) {
     subscribers.push_back(std::make_unique<Internal::ZMQMessageSubscriber>(
-      address + ":" + std::to_string(port)));
+      address + ":" + std::to_string(port), Types::result_emission_topic(mode)));
     stop_conditions.push_back(std::make_unique<std::atomic<bool>>(false));
     SubscriptionId subscription_id = subscribers.size() - 1;
     assert(stop_conditions.size() == subscription_id + 1);
@@ -20,6 +20,13 @@ class MessageHandler {
     assert(false && "handle_complex_event is not implemented");
   }
 
+  void eval_progress(uint64_t amount_of_events_processed) {
+    static_cast<Derived*>(this)->handle_progress(amount_of_events_processed);
+  }
+
+  // Only called in ResultEmissionMode::MatchesOnly subscriptions.
+  void handle_progress(uint64_t amount_of_events_processed) {}
+
   bool needs_to_stop() {
     return static_cast<Derived*>(this)->needs_to_stop_implementation();
   }
@@ -40,12 +47,22 @@ class StaticMessageHandler {
     assert(false && "statically_handle_complex_event is not implemented");
   }
 
+  static void eval_progress(uint64_t amount_of_events_processed) {
+    Derived::handle_progress(amount_of_events_processed);
+  }
+
+  // Only called in ResultEmissionMode::MatchesOnly subscriptions.
+  static void handle_progress(uint64_t amount_of_events_processed) {}
+
   static bool needs_to_stop_implementation() { return false; }
 };
 
 class Printer : public StaticMessageHandler<Printer> {
  public:
   static void handle_complex_event(Types::Enumerator& enumerator) {
+    if (enumerator.count.has_value()) {
+      std::cout << "COUNT(*) = " << enumerator.count.value() << std::endl;
+    }
     for (auto& complex_event : enumerator)
       std::cout << complex_event.to_string() << std::endl;
   }
@@ -11,15 +11,23 @@ namespace CORE::Internal::CEQL {
 struct Select {
   enum class Strategy { ALL, ANY, LAST, MAX, NEXT, STRICT, DEFAULT = Strategy::ALL };
 
+  // What the query outputs for every event. With COUNT(*) it outputs the
+  // amount of complex events instead of them, see tECS::Enumerator::count.
+  enum class Output { COMPLEX_EVENTS, COUNT };
+
   std::unique_ptr<Formula> formula;
   Strategy strategy;
   bool is_star;
+  Output output = Output::COMPLEX_EVENTS;
 
   Select(Strategy&& strategy, bool is_star, std::unique_ptr<Formula>&& formula)
       : strategy(std::move(strategy)), is_star(is_star), formula(std::move(formula)) {}
 
   std::string to_string() const {
     std::string out = "Select " + strategy_to_string(strategy);
+    if (output == Output::COUNT) {
+      return out + " COUNT(*) ";
+    }
     if (is_star) {
       return out + " * ";
     }
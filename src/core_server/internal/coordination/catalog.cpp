@@ -139,6 +139,11 @@ const std::vector<Types::QueryInfo>& Catalog::get_all_query_infos() const noexce
 }
 
 uint64_t Catalog::add_type_to_schema(std::vector<Types::AttributeInfo>& event_attributes) {
+  return tuple_schemas.add_schema(to_tuple_schema(event_attributes));
+}
+
+std::vector<RingTupleQueue::SupportedTypes>
+Catalog::to_tuple_schema(const std::vector<Types::AttributeInfo>& event_attributes) {
   std::vector<RingTupleQueue::SupportedTypes> converted_types;
   for (auto type : event_attributes) {
     switch (type.value_type) {
@@ -158,10 +163,10 @@ uint64_t Catalog::add_type_to_schema(std::vector<Types::AttributeInfo>& event_at
         converted_types.push_back(RingTupleQueue::SupportedTypes::DATE);
         break;
       default:
-        assert(false && "A value_type is missing in add_type_to_schema");
+        assert(false && "A value_type is missing in to_tuple_schema");
     }
   }
-  return tuple_schemas.add_schema(std::move(converted_types));
+  return converted_types;
 }
 
 }  // namespace CORE::Internal
@@ -60,8 +60,15 @@ class Catalog {
 
   std::size_t number_of_streams() const { return streams_info.size(); }
 
+  // Changes whenever the catalog changes, it only grows with new streams.
+  uint64_t version() const { return streams_info.size(); }
+
   uint64_t add_type_to_schema(std::vector<Types::AttributeInfo>& event_attributes);
 
+  // Schema of the tuples of an event type with the attributes.
+  static std::vector<RingTupleQueue::SupportedTypes>
+  to_tuple_schema(const std::vector<Types::AttributeInfo>& event_attributes);
+
  private:
   [[nodiscard]] Types::EventInfo
   add_event_type(Types::EventInfoParsed&& parsed_event_info) noexcept;
@@ -36,6 +36,19 @@
 
 namespace CORE::Internal {
 
+/**
+ * Where an attribute is in the tuples of an event type, resolved when a
+ * query is compiled so that its tuples are read with no name lookups.
+ */
+struct AttributeOffset {
+  // False if the event type does not have the attribute.
+  bool present = false;
+  uint64_t index = 0;
+  // Position in the words of the tuple, see Tuple::at_offset.
+  uint64_t word_offset = 0;
+  Types::ValueTypes value_type = Types::ValueTypes::INT64;
+};
+
 class QueryCatalog {
  private:
   std::vector<Types::EventInfo> events_info;
@@ -248,6 +261,30 @@ class QueryCatalog {
     }
   }
 
+  /**
+   * @return The offsets of the attribute in every event type of the query,
+   *         indexed by UniqueEventTypeId.
+   */
+  std::vector<AttributeOffset> get_attribute_offsets(std::string attribute_name) const {
+    std::vector<AttributeOffset> out;
+    for (const Types::EventInfo& event_info : events_info) {
+      auto search = event_info.attribute_names_to_ids.find(attribute_name);
+      if (search == event_info.attribute_names_to_ids.end()) {
+        continue;
+      }
+      std::vector<uint64_t> word_offsets = RingTupleQueue::TupleSchemas::positions_of(
+        Catalog::to_tuple_schema(event_info.attributes_info));
+      if (event_info.id >= out.size()) {
+        out.resize(event_info.id + 1);
+      }
+      out[event_info.id] = {true,
+                            search->second,
+                            word_offsets[search->second],
+                            event_info.attributes_info[search->second].value_type};
+    }
+    return out;
+  }
+
   Types::Enumerator convert_enumerator(tECS::Enumerator&& enumerator) const {
     ZoneScopedN("Catalog::convert_enumerator");
     std::vector<Types::ComplexEvent> out;
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace CORE::Internal::Bitset {
+
+/**
+ * Arbitrary-width bitset that keeps the first SMALL_BITSET_INLINE_WORDS
+ * words inline and only spills to the heap for wider bitsets. Predicate
+ * evaluations, PredicateSets and DetCEA states are computed once per event,
+ * so as long as the number of physical predicates/CEA states fits inside
+ * the inline words no memory is allocated on the hot path.
+ *
+ * The heap words are kept trimmed (no trailing zero words), so two equal
+ * bitsets always share the same representation.
+ */
+class SmallBitset {
+ public:
+  static constexpr size_t SMALL_BITSET_INLINE_WORDS = 4;
+  static constexpr size_t BITS_PER_WORD = 64;
+  static constexpr size_t INLINE_BITS = SMALL_BITSET_INLINE_WORDS * BITS_PER_WORD;
+
+ private:
+  std::array<uint64_t, SMALL_BITSET_INLINE_WORDS> inline_words{};
+  std::vector<uint64_t> heap_words{};
+
+ public:
+  SmallBitset() = default;
+
+  // Implicit so that literals such as 0b101 can be used as bitsets.
+  SmallBitset(uint64_t value) { inline_words[0] = value; }
+
+  static SmallBitset with_bit(size_t pos) {
+    SmallBitset out;
+    out.set(pos);
+    return out;
+  }
+
+  size_t amount_of_words() const { return SMALL_BITSET_INLINE_WORDS + heap_words.size(); }
+
+  uint64_t word(size_t i) const {
+    if (i < SMALL_BITSET_INLINE_WORDS) return inline_words[i];
+    i -= SMALL_BITSET_INLINE_WORDS;
+    return i < heap_words.size() ? heap_words[i] : 0;
+  }
+
+  bool is_inline() const { return heap_words.empty(); }
+
+  void set(size_t pos) { word_ref(pos / BITS_PER_WORD) |= bit_of(pos); }
+
+  void reset(size_t pos) {
+    size_t i = pos / BITS_PER_WORD;
+    if (i >= amount_of_words()) return;
+    word_ref(i) &= ~bit_of(pos);
+    trim();
+  }
+
+  bool test(size_t pos) const {
+    return (word(pos / BITS_PER_WORD) & bit_of(pos)) != 0;
+  }
+
+  bool none() const {
+    if (!heap_words.empty()) return false;
+    for (uint64_t w : inline_words) {
+      if (w != 0) return false;
+    }
+    return true;
+  }
+
+  bool any() const { return !none(); }
+
+  size_t count() const {
+    size_t out = 0;
+    for (uint64_t w : inline_words) out += std::popcount(w);
+    for (uint64_t w : heap_words) out += std::popcount(w);
+    return out;
+  }
+
+  bool intersects(const SmallBitset& other) const {
+    for (size_t i = 0; i < SMALL_BITSET_INLINE_WORDS; i++) {
+      if ((inline_words[i] & other.inline_words[i]) != 0) return true;
+    }
+    size_t common = std::min(heap_words.size(), other.heap_words.size());
+    for (size_t i = 0; i < common; i++) {
+      if ((heap_words[i] & other.heap_words[i]) != 0) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Checks ((*this ^ expected) & mask) == 0 without building temporaries,
+   * that is, whether this bitset agrees with expected on every bit of mask.
+   */
+  bool agrees_with_on(const SmallBitset& expected, const SmallBitset& mask) const {
+    size_t words = mask.amount_of_words();
+    for (size_t i = 0; i < words; i++) {
+      if (((word(i) ^ expected.word(i)) & mask.word(i)) != 0) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Flips the first amount_of_bits bits.
+   */
+  SmallBitset complement(size_t amount_of_bits) const {
+    SmallBitset out = *this;
+    size_t full_words = amount_of_bits / BITS_PER_WORD;
+    for (size_t i = 0; i < full_words; i++) {
+      out.word_ref(i) = ~out.word(i);
+    }
+    size_t remaining_bits = amount_of_bits % BITS_PER_WORD;
+    if (remaining_bits != 0) {
+      out.word_ref(full_words) ^= (uint64_t(1) << remaining_bits) - 1;
+    }
+    out.trim();
+    return out;
+  }
+
+  SmallBitset& operator&=(const SmallBitset& other) {
+    for (size_t i = 0; i < SMALL_BITSET_INLINE_WORDS; i++) {
+      inline_words[i] &= other.inline_words[i];
+    }
+    heap_words.resize(std::min(heap_words.size(), other.heap_words.size()));
+    for (size_t i = 0; i < heap_words.size(); i++) {
+      heap_words[i] &= other.heap_words[i];
+    }
+    trim();
+    return *this;
+  }
+
+  SmallBitset& operator|=(const SmallBitset& other) {
+    for (size_t i = 0; i < SMALL_BITSET_INLINE_WORDS; i++) {
+      inline_words[i] |= other.inline_words[i];
+    }
+    if (heap_words.size() < other.heap_words.size()) {
+      heap_words.resize(other.heap_words.size(), 0);
+    }
+    for (size_t i = 0; i < other.heap_words.size(); i++) {
+      heap_words[i] |= other.heap_words[i];
+    }
+    return *this;
+  }
+
+  SmallBitset& operator^=(const SmallBitset& other) {
+    for (size_t i = 0; i < SMALL_BITSET_INLINE_WORDS; i++) {
+      inline_words[i] ^= other.inline_words[i];
+    }
+    if (heap_words.size() < other.heap_words.size()) {
+      heap_words.resize(other.heap_words.size(), 0);
+    }
+    for (size_t i = 0; i < other.heap_words.size(); i++) {
+      heap_words[i] ^= other.heap_words[i];
+    }
+    trim();
+    return *this;
+  }
+
+  friend SmallBitset operator&(SmallBitset lhs, const SmallBitset& rhs) {
+    lhs &= rhs;
+    return lhs;
+  }
+
+  friend SmallBitset operator|(SmallBitset lhs, const SmallBitset& rhs) {
+    lhs |= rhs;
+    return lhs;
+  }
+
+  friend SmallBitset operator^(SmallBitset lhs, const SmallBitset& rhs) {
+    lhs ^= rhs;
+    return lhs;
+  }
+
+  friend bool operator==(const SmallBitset& lhs, const SmallBitset& rhs) {
+    return lhs.inline_words == rhs.inline_words && lhs.heap_words == rhs.heap_words;
+  }
+
+  // Numeric order, the same one mpz_class had.
+  friend bool operator<(const SmallBitset& lhs, const SmallBitset& rhs) {
+    if (lhs.heap_words.size() != rhs.heap_words.size()) {
+      return lhs.heap_words.size() < rhs.heap_words.size();
+    }
+    for (size_t i = lhs.amount_of_words(); i-- > 0;) {
+      if (lhs.word(i) != rhs.word(i)) return lhs.word(i) < rhs.word(i);
+    }
+    return false;
+  }
+
+  friend bool operator>(const SmallBitset& lhs, const SmallBitset& rhs) {
+    return rhs < lhs;
+  }
+
+  /**
+   * Calls f(pos) for every set bit in increasing order.
+   */
+  template <typename F>
+  void for_each_set_bit(F&& f) const {
+    for (size_t i = 0; i < amount_of_words(); i++) {
+      uint64_t w = word(i);
+      while (w != 0) {
+        f(i * BITS_PER_WORD + std::countr_zero(w));
+        w &= w - 1;
+      }
+    }
+  }
+
+  size_t hash() const {
+    size_t seed = heap_words.size();
+    for (size_t i = 0; i < amount_of_words(); i++) {
+      // boost::hash_combine
+      seed ^= std::hash<uint64_t>{}(word(i)) + 0x9e3779b97f4a7c15ULL + (seed << 6)
+              + (seed >> 2);
+    }
+    return seed;
+  }
+
+  // Base 2 without leading zeros, as mpz_class::get_str(2).
+  std::string to_string() const {
+    std::string out = "";
+    for (size_t i = amount_of_words(); i-- > 0;) {
+      uint64_t w = word(i);
+      for (size_t bit = BITS_PER_WORD; bit-- > 0;) {
+        bool is_set = (w >> bit) & 1;
+        if (is_set || !out.empty()) out += is_set ? '1' : '0';
+      }
+    }
+    return out.empty() ? "0" : out;
+  }
+
+ private:
+  static uint64_t bit_of(size_t pos) { return uint64_t(1) << (pos % BITS_PER_WORD); }
+
+  uint64_t& word_ref(size_t i) {
+    if (i < SMALL_BITSET_INLINE_WORDS) return inline_words[i];
+    i -= SMALL_BITSET_INLINE_WORDS;
+    if (i >= heap_words.size()) {
+      heap_words.resize(i + 1, 0);
+    }
+    return heap_words[i];
+  }
+
+  void trim() {
+    while (!heap_words.empty() && heap_words.back() == 0) {
+      heap_words.pop_back();
+    }
+  }
+};
+}  // namespace CORE::Internal::Bitset
+
+namespace std {
+template <>
+struct hash<CORE::Internal::Bitset::SmallBitset> {
+  size_t operator()(const CORE::Internal::Bitset::SmallBitset& bitset) const {
+    return bitset.hash();
+  }
+};
+}  // namespace std
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <gmpxx.h>
-
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -11,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/logical_cea/logical_cea.hpp"
 #include "core_server/internal/evaluation/logical_cea/transformations/optimizations/add_unique_initial_state.hpp"
 #include "core_server/internal/evaluation/logical_cea/transformations/optimizations/remove_epsilon_transitions.hpp"
@@ -24,7 +23,7 @@ struct CEA {
   using IsMarked = bool;
   using NodeId = uint64_t;
   using Transition = std::tuple<PredicateSet, IsMarked, NodeId>;
-  using States = mpz_class;
+  using States = Bitset::SmallBitset;
 
   uint64_t amount_of_states;
   std::vector<std::set<Transition>> transitions;
@@ -45,7 +44,9 @@ struct CEA {
     auto initial_states_list = logical_cea.get_initial_states();
     assert(initial_states_list.size() == 1);
     initial_state = initial_states_list[0];
-    final_states = logical_cea.final_states;
+    for (uint64_t final_state : logical_cea.get_final_states()) {
+      final_states.set(final_state);
+    }
   }
 
   void add_n_states(uint64_t n) {
@@ -57,15 +58,7 @@ struct CEA {
 
   std::vector<int64_t> get_final_states() {
     std::vector<int64_t> out;
-    States final_states_copy = final_states;
-    int64_t current_pos = 0;
-    while (final_states_copy != 0) {
-      if ((final_states_copy & 1) != 0) {
-        out.push_back(current_pos);
-      }
-      final_states_copy >>= 1;
-      current_pos++;
-    }
+    final_states.for_each_set_bit([&](uint64_t state) { out.push_back(state); });
     return out;
   }
 
@@ -76,7 +69,7 @@ struct CEA {
       "CEA\n"
       "    Q = {0.." + std::to_string(amount_of_states - 1) + "}\n"
       "    q0 = " + std::to_string(initial_state) + "\n"
-      "    F = (bitset) " + final_states.get_str(2) + "\n"
+      "    F = (bitset) " + final_states.to_string() + "\n"
       "    Δ : {PredicateSet × Marked → FinalState}" + "\n";
     // clang-format on
     for (size_t i = 0; i < transitions.size(); i++) {
@@ -1,14 +1,19 @@
 #pragma once
-#include <gmpxx.h>
 
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <set>
 #include <string>
 #include <tracy/Tracy.hpp>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/cea/cea.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
 #include "core_server/internal/evaluation/predicate_set.hpp"
 #include "state.hpp"
 #include "state_manager.hpp"
@@ -18,6 +23,7 @@ class DetCEA {
   using State = Det::State;
   using States = Det::State::States;
   using StateManager = Det::StateManager;
+  using SmallBitset = Bitset::SmallBitset;
 
  public:
   State* initial_state;
@@ -26,12 +32,13 @@ class DetCEA {
   CEA cea;
   uint64_t n_nexts = 0;
   uint64_t n_hits = 0;
+  MiniPool::PoolCompactionTimer compaction_timer;
 
  public:
   StateManager state_manager;
 
   DetCEA(CEA&& cea) : cea(cea), state_manager() {
-    mpz_class initial_bitset_1 = mpz_class(1) << cea.initial_state;
+    SmallBitset initial_bitset_1 = SmallBitset::with_bit(cea.initial_state);
     State* initial_state = state_manager.create_or_return_existing_state(initial_bitset_1,
                                                                          cea);
     this->initial_state = initial_state;
@@ -39,14 +46,15 @@ class DetCEA {
   }
 
   // DetCEA(const DetCEA& other) : cea(other.cea), state_manager() {
-  //   mpz_class initial_bitset_1 = mpz_class(1) << cea.initial_state;
+  //   SmallBitset initial_bitset_1 = SmallBitset::with_bit(cea.initial_state);
   //   State* initial_state = state_manager.create_or_return_existing_state(initial_bitset_1,
   //                                                                        cea);
   //   this->initial_state = initial_state;
   //   this->initial_state->pin();
   // }
 
-  States next(State* state, mpz_class evaluation, const uint64_t& current_iteration) {
+  States
+  next(State* state, const SmallBitset& evaluation, const uint64_t& current_iteration) {
     ZoneScopedN("DetCEA::next");
     assert(state != nullptr);
     n_nexts++;
@@ -58,9 +66,67 @@ class DetCEA {
     return next_states;
   }
 
+  /**
+   * Creates the states reachable from the initial state before the first
+   * tuple, until the automaton has maximum_states states (the last transition
+   * computed can add one more). From each state it follows the evaluation
+   * where no predicate holds and, for each transition of the state, the
+   * evaluation where only the predicates it requires hold. Those transitions
+   * are memoized, the other evaluations are still computed on the first tuple
+   * that has them.
+   * @return The amount of states of the automaton.
+   */
+  uint64_t materialize(uint64_t maximum_states) {
+    ZoneScopedN("DetCEA::materialize");
+    std::vector<State*> pending = {initial_state};
+    std::unordered_set<State*> visited = {initial_state};
+    for (size_t i = 0; i < pending.size(); i++) {
+      for (const SmallBitset& evaluation : witness_evaluations(pending[i])) {
+        if (get_amount_of_states() >= maximum_states) {
+          return get_amount_of_states();
+        }
+        States next_states = next(pending[i], evaluation, 0);
+        for (State* state : {next_states.marked_state, next_states.unmarked_state}) {
+          if (visited.insert(state).second) {
+            pending.push_back(state);
+          }
+        }
+      }
+    }
+    return get_amount_of_states();
+  }
+
+  // Memoized transitions, to size the TransitionTable of the states.
+  uint64_t get_amount_of_nexts() const { return n_nexts; }
+
+  uint64_t get_amount_of_hits() const { return n_hits; }
+
+  uint64_t get_amount_of_misses() const { return n_nexts - n_hits; }
+
+  uint64_t get_amount_of_states() const { return state_manager.amount_of_states(); }
+
+  /**
+   * Compacts the states, see StateManager::compact, if the utilization of
+   * their pools stayed under the threshold of the settings for its period.
+   * @return The bytes released.
+   */
+  uint64_t compact_if_underused(const MiniPool::PoolCompactionSettings& settings,
+                                std::chrono::steady_clock::time_point now) {
+    if (!compaction_timer.should_compact(settings,
+                                         state_manager.live_bytes(),
+                                         state_manager.retained_bytes(),
+                                         now)) {
+      return 0;
+    }
+    return state_manager.compact();
+  }
+
   std::string to_string() {
     std::string out = "";
-    out += "Initial state: " + initial_state->states.get_str(2) + "\n";
+    out += "Initial state: " + initial_state->states.to_string() + "\n";
+    out += "Transitions: " + std::to_string(n_nexts) + " nexts, "
+           + std::to_string(n_hits) + " hits, " + std::to_string(get_amount_of_misses())
+           + " misses\n";
     out += "State manager:\n";
     out += state_manager.to_string();
     return out;
@@ -68,11 +134,11 @@ class DetCEA {
 
  private:
   States compute_next_states(State* state,
-                             mpz_class& evaluation,
+                             const SmallBitset& evaluation,
                              const uint64_t& current_iteration) {
     auto computed_bitsets = compute_next_bitsets(state, evaluation);
-    mpz_class marked_bitset = computed_bitsets.first;
-    mpz_class unmarked_bitset = computed_bitsets.second;
+    SmallBitset& marked_bitset = computed_bitsets.first;
+    SmallBitset& unmarked_bitset = computed_bitsets.second;
     State* marked_state = state_manager.create_or_return_existing_state(marked_bitset,
                                                                         cea);
     State* unmarked_state = state_manager.create_or_return_existing_state(unmarked_bitset,
@@ -80,42 +146,41 @@ class DetCEA {
     return {marked_state, unmarked_state};
   }
 
-  std::pair<mpz_class, mpz_class>
-  compute_next_bitsets(State* state, mpz_class evaluation) {
+  // The evaluations that materialize follows from the state.
+  std::set<SmallBitset> witness_evaluations(State* state) const {
+    std::set<SmallBitset> out = {SmallBitset()};
+    state->states.for_each_set_bit([&](uint64_t state) {
+      for (const auto& transition : cea.transitions[state]) {
+        const PredicateSet& predicate = std::get<0>(transition);
+        if (predicate.type == PredicateSet::Satisfiable) {
+          out.insert(predicate.predicates & predicate.mask);
+        }
+      }
+    });
+    return out;
+  }
+
+  std::pair<SmallBitset, SmallBitset>
+  compute_next_bitsets(State* state, const SmallBitset& evaluation) {
     assert(state != nullptr);
     // TODO: State is not nullptr but is giving a segfault.
-    auto states_bitset = state->states;
-    auto states_vector = get_states_from_mpz_class(state->states);
-    mpz_class new_marked_states = 0;
-    mpz_class new_unmarked_states = 0;
-    for (uint64_t state : states_vector) {
-      for (auto transition : cea.transitions[state]) {
-        PredicateSet& predicate = std::get<0>(transition);
+    SmallBitset new_marked_states;
+    SmallBitset new_unmarked_states;
+    state->states.for_each_set_bit([&](uint64_t state) {
+      for (const auto& transition : cea.transitions[state]) {
+        const PredicateSet& predicate = std::get<0>(transition);
         if (predicate.is_satisfied_by(evaluation)) {
           bool is_marked = std::get<1>(transition);
           uint64_t target_node = std::get<2>(transition);
           if (is_marked) {
-            new_marked_states |= mpz_class(1) << target_node;
+            new_marked_states.set(target_node);
           } else {
-            new_unmarked_states |= mpz_class(1) << target_node;
+            new_unmarked_states.set(target_node);
           }
         }
       }
-    }
-    return {new_marked_states, new_unmarked_states};
-  }
-
-  std::vector<uint64_t> get_states_from_mpz_class(mpz_class states) {
-    std::vector<uint64_t> out;
-    int64_t current_pos = 0;
-    while (states != 0) {
-      if ((states & 1) != 0) {
-        out.push_back(current_pos);
-      }
-      states >>= 1;
-      current_pos++;
-    }
-    return out;
+    });
+    return {std::move(new_marked_states), std::move(new_unmarked_states)};
   }
 };
 }  // namespace CORE::Internal::CEA
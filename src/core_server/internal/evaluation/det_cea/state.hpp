@@ -1,18 +1,19 @@
 #pragma once
-#include <gmpxx.h>
 
 #include <atomic>
 #include <cassert>
 #include <cstdint>
-#include <map>
 #include <utility>
 
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/cea/cea.hpp"
+#include "transition_table.hpp"
 
 namespace CORE::Internal::CEA::Det {
 
 class State {
   friend class StateManager;
+  using SmallBitset = Bitset::SmallBitset;
 
  private:
   struct StatesData {
@@ -35,7 +36,7 @@ class State {
   };
 
   uint64_t id;
-  mpz_class states;
+  SmallBitset states;
   // The id is stored in the transitions because in the future we might
   // want to remove some states. And to remove them we can
   CEA& cea;
@@ -46,25 +47,26 @@ class State {
   State* next_evictable_state = nullptr;
 
  private:
-  inline static uint64_t IdCounter = 0;
+  // Shared by the DetCEAs of every thread.
+  inline static std::atomic<uint64_t> IdCounter = 0;
   uint64_t ref_count = 0;
-  std::map<mpz_class, StatesData> transitions;
+  TransitionTable<StatesData> transitions;
 
  public:
-  State(mpz_class states, CEA& cea)
-      : id(IdCounter++),
+  State(const SmallBitset& states, CEA& cea)
+      : id(IdCounter.fetch_add(1, std::memory_order_relaxed)),
         states(states),
         cea(cea),
-        is_final((states & cea.final_states) != 0),
-        is_empty(states == 0) {}
+        is_final(states.intersects(cea.final_states)),
+        is_empty(states.none()) {}
 
-  void reset(mpz_class states, CEA& cea) {
-    this->id = IdCounter++;
+  void reset(const SmallBitset& states, CEA& cea) {
+    this->id = IdCounter.fetch_add(1, std::memory_order_relaxed);
     this->states = states;
     this->cea = cea;
     this->ref_count = 0;
-    is_final = (states & cea.final_states) != 0;
-    is_empty = states == 0;
+    is_final = states.intersects(cea.final_states);
+    is_empty = states.none();
     transitions.clear();
   }
 
@@ -75,29 +77,28 @@ class State {
     ref_count -= 1;
   }
 
-  States next(mpz_class evaluation, uint64_t& n_hits) {
+  States next(const SmallBitset& evaluation, uint64_t& n_hits) {
     assert(next_evictable_state == nullptr && prev_evictable_state == nullptr);
-    auto it = transitions.find(evaluation);
-    if (it != transitions.end()) {
-      StatesData states_data = it->second;
-      if (!states_data.is_consistent()) {
-        transitions.erase(it);
+    StatesData* states_data = transitions.find(evaluation);
+    if (states_data != nullptr) {
+      if (!states_data->is_consistent()) {
+        transitions.erase(evaluation);
       } else {
         n_hits++;
-        return {states_data.marked_state, states_data.unmarked_state};
+        return {states_data->marked_state, states_data->unmarked_state};
       }
     }
     return {nullptr, nullptr};
   }
 
-  void add_transition(mpz_class evaluation, States next_states) {
+  void add_transition(const SmallBitset& evaluation, States next_states) {
     assert(!transitions.contains(evaluation));
     assert(next_states.unmarked_state != nullptr && next_states.marked_state != nullptr);
-    transitions.insert(std::make_pair(evaluation,
-                                      StatesData{next_states.marked_state->id,
-                                                 next_states.marked_state,
-                                                 next_states.unmarked_state->id,
-                                                 next_states.unmarked_state}));
+    transitions.insert(evaluation,
+                       StatesData{next_states.marked_state->id,
+                                  next_states.marked_state,
+                                  next_states.unmarked_state->id,
+                                  next_states.unmarked_state});
   }
 
   bool is_evictable() { return ref_count == 0; }
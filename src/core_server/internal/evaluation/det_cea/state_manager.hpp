@@ -1,14 +1,16 @@
 #pragma once
 
-#include <gmpxx.h>
-
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
-#include <map>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/cea/cea.hpp"
 #include "core_server/internal/evaluation/minipool/minipool.hpp"
 #include "state.hpp"
@@ -22,19 +24,27 @@ const size_t STATE_MANAGER_MAX_SIZE = 4;
  * The Node Manager class stores the pointers to all allocated
  * state nodes. When we need a state node, but we are out of memory,
  * we remove one of the existing nodes and reuse it.
+ *
+ * After a burst of pinned states the newest minipools can be given back with
+ * compact once none of their states is pinned anymore.
  */
 class StateManager {
   using StatePool = MiniPool::MiniPool<State>;
   using States = Det::State::States;
+  using SmallBitset = Bitset::SmallBitset;
 
  private:
   size_t amount_of_used_states{0};
   size_t amount_of_allowed_states;
+  size_t amount_of_pinned_states{0};
+  // Capacity of every minipool.
+  size_t amount_of_states_in_pools{STATE_MANAGER_STARTING_SIZE};
+  uint64_t amount_of_released_bytes{0};
   StatePool* minipool_head = nullptr;
   State* evictable_state_head = nullptr;
   State* evictable_state_tail = nullptr;
   std::vector<State*> states;
-  std::map<mpz_class, uint64_t> states_bitset_to_index;
+  std::unordered_map<SmallBitset, uint64_t> states_bitset_to_index;
 
  public:
   StateManager()
@@ -44,6 +54,9 @@ class StateManager {
   StateManager(StateManager&& other) noexcept
       : amount_of_used_states(other.amount_of_used_states),
         amount_of_allowed_states(other.amount_of_allowed_states),
+        amount_of_pinned_states(other.amount_of_pinned_states),
+        amount_of_states_in_pools(other.amount_of_states_in_pools),
+        amount_of_released_bytes(other.amount_of_released_bytes),
         minipool_head(other.minipool_head) {
     other.minipool_head = nullptr;
   }
@@ -57,6 +70,9 @@ class StateManager {
   }
 
   void pin_state(State* const state) {
+    if (state->is_evictable()) {
+      amount_of_pinned_states++;
+    }
     state->pin();
     unset_evictable_state(state);
   }
@@ -65,22 +81,73 @@ class StateManager {
     for (State* state : evicted_states) {
       state->unpin();
       if (state->is_evictable()) {
+        amount_of_pinned_states--;
         set_evictable_state(state);
       }
     }
   }
 
+  size_t amount_of_states() const { return amount_of_used_states; }
+
+  uint64_t retained_bytes() const { return amount_of_states_in_pools * sizeof(State); }
+
+  // Of the pinned states, the evictable ones are only a cache.
+  uint64_t live_bytes() const { return amount_of_pinned_states * sizeof(State); }
+
+  uint64_t released_bytes() const { return amount_of_released_bytes; }
+
+  /**
+   * Releases the newest minipools whose states are all unpinned, never the
+   * first one. The transitions of the other states can lead to the released
+   * ones, so every memoized transition is dropped. Must be called between
+   * two tuples, when the evaluators only hold pinned states.
+   * @return The bytes released.
+   */
+  uint64_t compact() {
+    std::unordered_set<State*> released_states;
+    uint64_t released = 0;
+    while (minipool_head->prev() != nullptr && has_no_pinned_states(*minipool_head)) {
+      StatePool* released_minipool = minipool_head;
+      std::span released_minipool_states(released_minipool->data(),
+                                         released_minipool->size());
+      for (State& state : released_minipool_states) {
+        unset_evictable_state(&state);
+        released_states.insert(&state);
+      }
+      minipool_head = released_minipool->prev();
+      minipool_head->set_next(nullptr);
+      amount_of_used_states -= released_minipool->size();
+      amount_of_states_in_pools -= released_minipool->capacity();
+      released += released_minipool->capacity() * sizeof(State);
+      delete released_minipool;
+    }
+    if (released == 0) {
+      return 0;
+    }
+    std::erase_if(states, [&](State* state) { return released_states.contains(state); });
+    states_bitset_to_index.clear();
+    for (size_t i = 0; i < states.size(); i++) {
+      states_bitset_to_index[states[i]->states] = i;
+      states[i]->transitions.clear();
+    }
+    amount_of_allowed_states = std::min(amount_of_allowed_states,
+                                        std::max(STATE_MANAGER_MAX_SIZE,
+                                                 amount_of_states_in_pools));
+    amount_of_released_bytes += released;
+    return released;
+  }
+
   std::string to_string() {
     std::string out = "";
     out += "Number of initialized states: " + std::to_string(states.size()) + "\n";
     out += "Initialized States:\n";
     for (auto& state : states) {
-      out += state->states.get_str(2);
+      out += state->states.to_string();
     }
     return out;
   }
 
-  State* create_or_return_existing_state(mpz_class bitset, CEA& cea) {
+  State* create_or_return_existing_state(const SmallBitset& bitset, CEA& cea) {
     auto it = states_bitset_to_index.find(bitset);
     if (it != states_bitset_to_index.end()) {
       assert(it->second < states.size());
@@ -143,10 +210,17 @@ class StateManager {
     new_minipool->set_prev(minipool_head);
 
     minipool_head = new_minipool;
+    amount_of_states_in_pools += new_minipool->capacity();
 
     return new_size;
   }
 
+  bool has_no_pinned_states(StatePool& minipool) const {
+    return std::all_of(minipool.data(),
+                       minipool.data() + minipool.size(),
+                       [](State& state) { return state.is_evictable(); });
+  }
+
   void set_evictable_state(State* const& state) {
     assert(state->is_evictable());
     assert_state_list_consistency();
@@ -202,7 +276,7 @@ class StateManager {
 
   template <class... Args>
   void reset_state(State* const& state, Args&&... args) {
-    mpz_class old_states = state->states;
+    SmallBitset old_states = state->states;
     unset_evictable_state(state);
     state->reset(std::forward<Args>(args)...);
     states_bitset_to_index[state->states] = states_bitset_to_index[old_states];
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+
+namespace CORE::Internal::CEA::Det {
+
+const size_t TRANSITION_TABLE_STARTING_CAPACITY = 8;
+const size_t TRANSITION_TABLE_MAX_SIZE = 256;
+
+/**
+ * Memoized transitions of a single DetCEA state, keyed by the predicate
+ * evaluation of a tuple. It is an open addressing hash table with linear
+ * probing that holds at most max_size entries. Once it is full, the least
+ * recently used entry is evicted to make room for a new one.
+ *
+ * The evaluation where no predicate is satisfied is by far the most common
+ * one on selective queries, so it is stored in a dedicated slot that is
+ * never evicted and does not need to be hashed.
+ */
+template <typename Value>
+class TransitionTable {
+  using SmallBitset = Bitset::SmallBitset;
+
+  struct Entry {
+    SmallBitset key;
+    Value value;
+    size_t hash;
+    uint64_t last_used;
+    bool is_occupied = false;
+  };
+
+ private:
+  std::vector<Entry> entries;
+  size_t amount_of_entries = 0;
+  size_t max_size;
+  uint64_t current_use = 0;
+  std::optional<Value> empty_evaluation_value;
+
+ public:
+  TransitionTable(size_t max_size = TRANSITION_TABLE_MAX_SIZE) : max_size(max_size) {
+    assert(max_size > 0);
+  }
+
+  /**
+   * @return A pointer to the stored value, or nullptr if it is not stored.
+   * The pointer is invalidated by the next insert or erase.
+   */
+  Value* find(const SmallBitset& key) {
+    if (key.none()) {
+      return empty_evaluation_value.has_value() ? &empty_evaluation_value.value()
+                                                : nullptr;
+    }
+    if (amount_of_entries == 0) return nullptr;
+    size_t hash = key.hash();
+    size_t pos = find_position(key, hash);
+    if (!entries[pos].is_occupied) return nullptr;
+    entries[pos].last_used = ++current_use;
+    return &entries[pos].value;
+  }
+
+  bool contains(const SmallBitset& key) {
+    if (key.none()) return empty_evaluation_value.has_value();
+    if (amount_of_entries == 0) return false;
+    return entries[find_position(key, key.hash())].is_occupied;
+  }
+
+  void insert(const SmallBitset& key, Value value) {
+    if (key.none()) {
+      empty_evaluation_value = std::move(value);
+      return;
+    }
+    size_t hash = key.hash();
+    if (amount_of_entries > 0) {
+      size_t pos = find_position(key, hash);
+      if (entries[pos].is_occupied) {
+        entries[pos].value = std::move(value);
+        entries[pos].last_used = ++current_use;
+        return;
+      }
+    }
+    if (amount_of_entries >= max_size) {
+      evict_least_recently_used();
+    }
+    if (2 * (amount_of_entries + 1) > entries.size()) {
+      grow();
+    }
+    size_t pos = find_position(key, hash);
+    entries[pos] = Entry{key, std::move(value), hash, ++current_use, true};
+    amount_of_entries++;
+  }
+
+  void erase(const SmallBitset& key) {
+    if (key.none()) {
+      empty_evaluation_value.reset();
+      return;
+    }
+    if (amount_of_entries == 0) return;
+    size_t pos = find_position(key, key.hash());
+    if (entries[pos].is_occupied) {
+      erase_position(pos);
+    }
+  }
+
+  /**
+   * Removes every entry but keeps the allocated capacity.
+   */
+  void clear() {
+    for (Entry& entry : entries) {
+      entry.is_occupied = false;
+    }
+    amount_of_entries = 0;
+    current_use = 0;
+    empty_evaluation_value.reset();
+  }
+
+  size_t size() const {
+    return amount_of_entries + (empty_evaluation_value.has_value() ? 1 : 0);
+  }
+
+  size_t capacity() const { return entries.size(); }
+
+ private:
+  size_t mask() const { return entries.size() - 1; }
+
+  // Position of the key if present, otherwise the first empty position of its probe.
+  size_t find_position(const SmallBitset& key, size_t hash) const {
+    assert(!entries.empty() && amount_of_entries < entries.size());
+    size_t pos = hash & mask();
+    while (entries[pos].is_occupied
+           && (entries[pos].hash != hash || !(entries[pos].key == key))) {
+      pos = (pos + 1) & mask();
+    }
+    return pos;
+  }
+
+  void grow() {
+    size_t new_capacity = entries.empty() ? TRANSITION_TABLE_STARTING_CAPACITY
+                                          : entries.size() * 2;
+    std::vector<Entry> old_entries = std::move(entries);
+    entries = std::vector<Entry>(new_capacity);
+    for (Entry& entry : old_entries) {
+      if (entry.is_occupied) {
+        size_t pos = entry.hash & mask();
+        while (entries[pos].is_occupied) {
+          pos = (pos + 1) & mask();
+        }
+        entries[pos] = std::move(entry);
+      }
+    }
+  }
+
+  /**
+   * Linear scan, only done on a miss of a full table, which already has to
+   * compute the next states of the DetCEA.
+   */
+  void evict_least_recently_used() {
+    size_t least_recently_used = entries.size();
+    for (size_t pos = 0; pos < entries.size(); pos++) {
+      if (entries[pos].is_occupied
+          && (least_recently_used == entries.size()
+              || entries[pos].last_used < entries[least_recently_used].last_used)) {
+        least_recently_used = pos;
+      }
+    }
+    assert(least_recently_used != entries.size());
+    erase_position(least_recently_used);
+  }
+
+  // Backward shift deletion, so no tombstones are needed.
+  void erase_position(size_t hole) {
+    assert(entries[hole].is_occupied);
+    entries[hole].is_occupied = false;
+    amount_of_entries--;
+    size_t pos = (hole + 1) & mask();
+    while (entries[pos].is_occupied) {
+      size_t home = entries[pos].hash & mask();
+      // Move the entry into the hole if its home is not in (hole, pos].
+      bool home_in_between = hole <= pos ? (hole < home && home <= pos)
+                                         : (hole < home || home <= pos);
+      if (!home_in_between) {
+        entries[hole] = std::move(entries[pos]);
+        entries[pos].is_occupied = false;
+        hole = pos;
+      }
+      pos = (pos + 1) & mask();
+    }
+  }
+};
+}  // namespace CORE::Internal::CEA::Det
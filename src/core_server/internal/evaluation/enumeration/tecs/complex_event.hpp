@@ -21,7 +21,12 @@ class ComplexEvent {
                  complex_event)
       : start(complex_event.first.first),
         end(complex_event.first.second),
-        event_tuples(complex_event.second) {}
+        event_tuples(std::move(complex_event.second)) {}
+
+  ComplexEvent(uint64_t start,
+               uint64_t end,
+               std::vector<RingTupleQueue::Tuple>&& event_tuples)
+      : start(start), end(end), event_tuples(std::move(event_tuples)) {}
 
   template <bool event_info>
   std::string to_string() const {
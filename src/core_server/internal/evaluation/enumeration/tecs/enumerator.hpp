@@ -1,6 +1,9 @@
 #pragma once
 #include <algorithm>
-#include <stack>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "complex_event.hpp"
@@ -9,6 +12,16 @@
 
 namespace CORE::Internal::tECS {
 
+/**
+ * Enumerates the complex events of a tECS node with a depth first search.
+ *
+ * The tuples of the current branch are kept in a single path vector. A
+ * union node only pushes its right child together with the length of the
+ * path at that point, so taking the next branch truncates the path back to
+ * that length instead of copying it. Each complex event then costs time
+ * proportional to its length, and once the vectors have grown no memory is
+ * allocated other than the tuples of the complex event returned.
+ */
 class Enumerator {
   friend class iterator;
 
@@ -37,14 +50,17 @@ class Enumerator {
     }
   };
 
-  std::stack<std::pair<Node*, std::vector<RingTupleQueue::Tuple>>> stack;
+  // Branches left to explore and the length of the path when they were found.
+  std::vector<std::pair<Node*, size_t>> stack;
+  // Tuples of the current branch, from the last one to the first one.
+  std::vector<RingTupleQueue::Tuple> path;
   uint64_t original_pos;
   uint64_t last_time_to_consider;
-  std::pair<std::pair<uint64_t, uint64_t>, std::vector<RingTupleQueue::Tuple>> next_value;
+  uint64_t next_start = 0;
   Node* original_node{nullptr};
   tECS* tecs{nullptr};
   TimeReservator* time_reservator{nullptr};
-  TimeReservator::Node* time_reserved_node{nullptr};
+  TimeReservator::Slot* time_reservation{nullptr};
   int64_t enumeration_limit;
 
  public:
@@ -62,10 +78,10 @@ class Enumerator {
         time_reservator(time_reservator),
         enumeration_limit(enumeration_limit) {
     assert(time_reservator != nullptr);
-    time_reserved_node = time_reservator->reserve(last_time_to_consider);
+    time_reservation = time_reservator->reserve(last_time_to_consider);
     assert(node != nullptr);
     if (node->max() >= last_time_to_consider) {
-      stack.push({node, {}});
+      stack.push_back({node, 0});
     }
   }
 
@@ -80,17 +96,18 @@ class Enumerator {
   // Allow move constructor
   Enumerator(Enumerator&& other) noexcept
       : stack(std::move(other.stack)),
+        path(std::move(other.path)),
         original_pos(other.original_pos),
         last_time_to_consider(other.last_time_to_consider),
-        next_value(std::move(other.next_value)),
+        next_start(other.next_start),
         original_node(other.original_node),
         tecs(other.tecs),
         time_reservator(other.time_reservator),
-        time_reserved_node(other.time_reserved_node),
+        time_reservation(other.time_reservation),
         enumeration_limit(other.enumeration_limit) {
     other.tecs = nullptr;
     other.time_reservator = nullptr;
-    other.time_reserved_node = nullptr;
+    other.time_reservation = nullptr;
   }
 
   // Allow move assignment
@@ -98,17 +115,18 @@ class Enumerator {
     if (this != &other) {
       cleanup();
       stack = std::move(other.stack);
+      path = std::move(other.path);
       original_pos = other.original_pos;
       last_time_to_consider = other.last_time_to_consider;
-      next_value = std::move(other.next_value);
+      next_start = other.next_start;
       original_node = other.original_node;
       tecs = other.tecs;
       time_reservator = other.time_reservator;
-      time_reserved_node = other.time_reserved_node;
+      time_reservation = other.time_reservation;
       enumeration_limit = other.enumeration_limit;
       other.tecs = nullptr;
       other.time_reservator = nullptr;
-      other.time_reserved_node = nullptr;
+      other.time_reservation = nullptr;
     }
     return *this;
   }
@@ -117,7 +135,7 @@ class Enumerator {
       : original_node(nullptr),
         tecs(nullptr),
         time_reservator{nullptr},
-        time_reserved_node{nullptr} {}  // Empty enumerator
+        time_reservation{nullptr} {}  // Empty enumerator
 
   ~Enumerator() {
     if (tecs != nullptr) {
@@ -129,10 +147,72 @@ class Enumerator {
 
   iterator end() { return iterator(*this, true); }
 
+  /**
+   * The amount of complex events that the enumeration outputs, without
+   * enumerating them. The complex events of a node are those of its
+   * children whose maximum start is in the time window, so they are counted
+   * bottom up with the count of each node memoized, in time proportional to
+   * the nodes reachable in the time window instead of the complex events.
+   * Counts that do not fit in 64 bits saturate.
+   */
+  uint64_t count() const {
+    ZoneScopedN("Internal::Enumerator::count");
+    if (original_node == nullptr || original_node->max() < last_time_to_consider
+        || enumeration_limit == 0) {
+      return 0;
+    }
+    std::unordered_map<Node*, uint64_t> counts;
+    std::vector<Node*> pending = {original_node};
+    while (!pending.empty()) {
+      Node* node = pending.back();
+      if (counts.contains(node)) {
+        pending.pop_back();
+        continue;
+      }
+      if (node->is_bottom()) {
+        counts[node] = 1;
+        pending.pop_back();
+        continue;
+      }
+      // The children are counted before their parent.
+      Node* left = node->is_output() ? tecs->next(node) : tecs->get_left(node);
+      Node* right = nullptr;
+      if (node->is_union()) {
+        right = tecs->get_right(node);
+        if (right->max() < last_time_to_consider) {
+          right = nullptr;
+        }
+      }
+      auto left_count = counts.find(left);
+      auto right_count = right != nullptr ? counts.find(right) : counts.end();
+      if (left_count == counts.end()) {
+        pending.push_back(left);
+      }
+      if (right != nullptr && right_count == counts.end()) {
+        pending.push_back(right);
+      }
+      if (pending.back() == node) {
+        uint64_t count = left_count->second;
+        if (right != nullptr) {
+          uint64_t right_value = right_count->second;
+          count = count > UINT64_MAX - right_value ? UINT64_MAX : count + right_value;
+        }
+        counts[node] = count;
+        pending.pop_back();
+      }
+    }
+    uint64_t count = counts[original_node];
+    if (enumeration_limit > 0) {
+      count = std::min(count, static_cast<uint64_t>(enumeration_limit));
+    }
+    return count;
+  }
+
   void reset() {
-    stack = {};
+    stack.clear();
+    path.clear();
     if (original_node != nullptr && original_node->max() >= last_time_to_consider) {
-      stack.push({original_node, {}});
+      stack.push_back({original_node, 0});
     }
   };
 
@@ -140,21 +220,23 @@ class Enumerator {
   bool has_next() {
     ZoneScopedN("Internal::Enumerator::has_next");
     while (!stack.empty()) {
-      Node* current_node = stack.top().first;
-      std::vector<RingTupleQueue::Tuple> tuples = stack.top().second;
-      stack.pop();
+      auto [current_node, path_length] = stack.back();
+      stack.pop_back();
+      // Backtrack to the union node where this branch was found.
+      path.erase(path.begin() + path_length, path.end());
       while (true) {
         if (current_node->is_bottom()) {
-          next_value = {{current_node->pos(), original_pos}, tuples};
+          next_start = current_node->pos();
           return true;
         } else if (current_node->is_output()) {
-          tuples.push_back(current_node->get_tuple());
-          current_node = current_node->next();
+          path.push_back(tecs->get_tuple(current_node));
+          current_node = tecs->next(current_node);
         } else if (current_node->is_union()) {
-          if (current_node->get_right()->max() >= last_time_to_consider) {
-            stack.push({current_node->get_right(), tuples});
+          Node* right = tecs->get_right(current_node);
+          if (right->max() >= last_time_to_consider) {
+            stack.push_back({right, path.size()});
           }
-          current_node = current_node->get_left();
+          current_node = tecs->get_left(current_node);
         }
       }
     }
@@ -164,8 +246,9 @@ class Enumerator {
   /// It requires has_next to be evaluated before.
   ComplexEvent next() {
     ZoneScopedN("Internal::Enumerator::next");
-    std::reverse(next_value.second.begin(), next_value.second.end());
-    return ComplexEvent(next_value);
+    return ComplexEvent(next_start,
+                        original_pos,
+                        std::vector<RingTupleQueue::Tuple>(path.rbegin(), path.rend()));
   }
 
   inline void cleanup() {
@@ -173,9 +256,9 @@ class Enumerator {
       assert(tecs != nullptr);
       tecs->unpin(original_node);
       assert(time_reservator != nullptr);
-      assert(time_reserved_node != nullptr);
-      time_reservator->remove_node(time_reserved_node);
-      time_reserved_node = nullptr;
+      assert(time_reservation != nullptr);
+      time_reservator->release(time_reservation);
+      time_reservation = nullptr;
       tecs = nullptr;
     }
   }
@@ -4,16 +4,28 @@
 #include <cassert>
 #include <cwchar>
 
-#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
-
 namespace CORE::Internal::tECS {
+
+/**
+ * Position of a node in the memory pools of its NodeManager, which resolves
+ * it with NodeManager::node_at. The nodes are linked by their ids instead
+ * of pointers, so that long windows fit twice the nodes in the same memory.
+ */
+using NodeId = uint32_t;
+
+// The type of a node is packed in the bits of its left id that are left.
+const uint32_t NODE_ID_BITS = 29;
+const NodeId NULL_NODE_ID = (NodeId{1} << NODE_ID_BITS) - 1;
+// Nodes that a NodeManager can address, NULL_NODE_ID is not one of them.
+const uint64_t MAXIMUM_AMOUNT_OF_NODES = NULL_NODE_ID;
+
 class Node {
   friend class NodeManager;
   friend class TimeListManager;
   friend class tECS;
 
  private:
-  enum class NodeType {
+  enum class NodeType : uint32_t {
     BOTTOM,
     UNION,
     OUTPUT,
@@ -21,22 +33,24 @@ class Node {
     TIME_LIST_HEAD,
     TIME_LIST_TAIL,
   };
-  NodeType node_type;
-
-  Node* left = nullptr;
 
   union {
-    Node* right = nullptr;
-    RingTupleQueue::Tuple tuple;
+    // The tuple of bottom and output nodes without its schemas, which are
+    // the same for every node and kept by the NodeManager.
+    uint64_t* tuple_data = nullptr;
+    NodeId right;
   };
 
+  NodeId left : NODE_ID_BITS = NULL_NODE_ID;
+  uint32_t node_type : 32 - NODE_ID_BITS;
+
   union {
-    uint64_t ref_count{0};
-    Node* next_free_node;
+    uint32_t ref_count{0};
+    NodeId next_free_node;
   };
 
-  Node* time_list_left;
-  Node* time_list_right;
+  NodeId time_list_left = NULL_NODE_ID;
+  NodeId time_list_right = NULL_NODE_ID;
 
  public:
   uint64_t maximum_start;
@@ -48,119 +62,87 @@ class Node {
    */
 
   /* BOTTOM Node */
-  Node(RingTupleQueue::Tuple tuple, uint64_t timestamp) {
-    reset(tuple, timestamp);  //Se llama a reset para evitar repetir codigo
+  Node(uint64_t* tuple_data, uint64_t timestamp) {
+    reset(tuple_data, timestamp);  //Se llama a reset para evitar repetir codigo
   }
 
   // TODO: Check if I really need a tuple.
 
-  void reset(RingTupleQueue::Tuple tuple, uint64_t timestamp) {
-    left = nullptr;
-    this->tuple = tuple;
+  void reset(uint64_t* tuple_data, uint64_t timestamp) {
+    left = NULL_NODE_ID;
+    this->tuple_data = tuple_data;
     this->timestamp = timestamp;
-    this->node_type = NodeType::BOTTOM;
+    set_type(NodeType::BOTTOM);
     this->maximum_start = timestamp;
     this->ref_count = 0;  // Ahora parte con ref_count 0 (lo mismo para los demas casos)
   }
 
   /* OUTPUT Node */
-  Node(Node* node, RingTupleQueue::Tuple tuple, uint64_t timestamp) {
-    assert(node != nullptr);
-    reset(node, tuple,
+  Node(NodeId left_id, Node& node, uint64_t* tuple_data, uint64_t timestamp) {
+    reset(left_id, node, tuple_data,
           timestamp);  //Se llama a reset para evitar repetir codigo
   }
 
-  void reset(Node* node, RingTupleQueue::Tuple tuple, uint64_t timestamp) {
-    this->left = node;
-    this->tuple = tuple;
+  void reset(NodeId left_id, Node& node, uint64_t* tuple_data, uint64_t timestamp) {
+    assert(left_id != NULL_NODE_ID);
+    this->left = left_id;
+    this->tuple_data = tuple_data;
     this->timestamp = timestamp;
-    this->node_type = NodeType::OUTPUT;
-    assert(left != nullptr);
-    node->ref_count += 1;  // Se suma la referencia al nodo hijo para no reciclarla (como antes)
-    maximum_start = left->maximum_start;
+    set_type(NodeType::OUTPUT);
+    node.ref_count += 1;  // Se suma la referencia al nodo hijo para no reciclarla (como antes)
+    maximum_start = node.maximum_start;
     this->ref_count = 0;
   }
 
   /* UNION Node */
-  Node(Node* left, Node* right) { reset(left, right); }
-
-  void reset(Node* left, Node* right) {
-    this->node_type = NodeType::UNION;
-    assert(left != nullptr);
-    assert(right != nullptr);
-    left->ref_count += 1;  // Se suma la referencia a cada hijo para no reciclarlas
-    right->ref_count += 1;
-    this->left = left;
-    this->right = right;
+  Node(NodeId left_id, Node& left, NodeId right_id, Node& right) {
+    reset(left_id, left, right_id, right);
+  }
+
+  void reset(NodeId left_id, Node& left, NodeId right_id, Node& right) {
+    set_type(NodeType::UNION);
+    assert(left_id != NULL_NODE_ID);
+    assert(right_id != NULL_NODE_ID);
+    left.ref_count += 1;  // Se suma la referencia a cada hijo para no reciclarlas
+    right.ref_count += 1;
+    this->left = left_id;
+    this->right = right_id;
     timestamp = {};  // TODO: this is not neccessary right?
-    assert(this->left->maximum_start >= this->right->maximum_start);
-    maximum_start = this->left->maximum_start;
+    assert(left.maximum_start >= right.maximum_start);
+    maximum_start = left.maximum_start;
     this->ref_count = 0;
   }
 
   /* TIME_LIST_HEAD/TAIL Nodes */
-  Node(NodeType node_type) : node_type(node_type) { reset(node_type); }
+  Node(NodeType node_type) { reset(node_type); }
 
   void reset(NodeType node_type) {
     assert(node_type == NodeType::TIME_LIST_HEAD || node_type == NodeType::TIME_LIST_TAIL);
-    this->node_type = node_type;
+    set_type(node_type);
     maximum_start = UINT64_MAX;
     this->ref_count = 1;  // Se mantiene en 1 dado que en teoria se ocupa siempre
   }
 
-  bool is_union() const { return node_type == NodeType::UNION; }
+  bool is_union() const { return type() == NodeType::UNION; }
 
-  bool is_output() const { return node_type == NodeType::OUTPUT; }
+  bool is_output() const { return type() == NodeType::OUTPUT; }
 
-  bool is_bottom() const { return node_type == NodeType::BOTTOM; }
+  bool is_bottom() const { return type() == NodeType::BOTTOM; }
 
-  bool is_dead() const { return node_type == NodeType::DEAD; }
+  bool is_dead() const { return type() == NodeType::DEAD; }
 
   uint64_t pos() const {
     assert(!is_union());
     return timestamp;
   }
 
-  RingTupleQueue::Tuple get_tuple() const {
-    assert(!is_union());
-    return tuple;
-  }
-
-  Node* next() const {
-    assert(is_output());
-    assert(left != nullptr);
-    return left;
-  }
-
-  Node* get_left() const {
-    assert(is_union());
-    return left;
-  }
-
-  Node* get_right() const {
-    assert(is_union());
-    return right;
-  }
-
   uint64_t max() const { return maximum_start; }
 
-  std::string to_string(size_t depth = 0) const {
-    std::string out = "";
-    for (size_t i = 0; i < depth; i++) {
-      out += "    ";
-    }
-    if (is_bottom()) {
-      out += "Bottom(" + std::to_string(tuple.id()) + ")";
-    } else if (is_output()) {
-      out += "Output(" + std::to_string(tuple.id()) + ")\n";
-      out += left->to_string(depth + 1);
-    } else {
-      out += "Union\n";
-      out += left->to_string(depth + 1);
-      out += "\n";
-      out += right->to_string(depth + 1);
-    }
-    return out;
-  }
+ private:
+  NodeType type() const { return static_cast<NodeType>(node_type); }
+
+  void set_type(NodeType type) { node_type = static_cast<uint32_t>(type); }
 };
+
+static_assert(sizeof(Node) == 40);
 }  // namespace CORE::Internal::tECS
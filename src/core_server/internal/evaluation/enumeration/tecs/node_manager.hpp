@@ -1,9 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "core_server/internal/evaluation/minipool/minipool.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "node.hpp"
 #include "time_list_manager.hpp"
 
@@ -15,6 +24,20 @@ const size_t MEMORY_POOL_STARTING_SIZE = 2048;
  * The Node Manager class stores the pointers to all allocated
  * ECSNode's. When an ECSNode is no longer used, i.e, when the amount
  * of references to it has become 0, that memory is available to be recycled.
+ *
+ * The pool i has starting_size * 2^i nodes, the ones with the ids from
+ * starting_size * (2^i - 1), so the pool of an id is found with its
+ * highest bit. The schemas of the tuples are the same for every node, they
+ * are kept here instead of in each node.
+ *
+ * Every minipool has its own list of free nodes and the nodes are recycled
+ * from the oldest minipool first, so that after a burst the newest ones
+ * drain and compact can release them. The nodes never move, their pointers
+ * are held by the union lists and the enumerators.
+ *
+ * The addresses of the pools are in a fixed array, so an enumerator
+ * consumed in another thread can read the nodes of its output while new
+ * pools are added.
  */
 class NodeManager {
   typedef MiniPool::MiniPool<Node> NodePool;
@@ -25,44 +48,145 @@ class NodeManager {
   std::atomic<uint64_t>& expiration_time;
 
  private:
+  // The addresses of the nodes of a minipool, so that the node of an id is
+  // at address_of_id_0 + id * sizeof(Node).
+  struct PoolAddresses {
+    uintptr_t begin;
+    uintptr_t size_in_bytes;
+    uintptr_t address_of_id_0;
+  };
+
+  struct FreeNodes {
+    NodeId head = NULL_NODE_ID;
+    uint64_t size = 0;
+  };
+
+  uint64_t starting_size_log2;
   NodePool* minipool_head = nullptr;
-  Node* recyclable_node_head = nullptr;
+  // Indexed from the oldest minipool, the first amount_of_pools are in use.
+  // Every id is below MAXIMUM_AMOUNT_OF_NODES, so there are less than
+  // NODE_ID_BITS pools.
+  std::array<PoolAddresses, NODE_ID_BITS> pool_addresses;
+  uint64_t amount_of_pools = 1;
+  // Indexed as pool_addresses, bit i of pools_with_free_nodes is set if the
+  // minipool i has free nodes.
+  std::vector<FreeNodes> free_nodes;
+  uint64_t pools_with_free_nodes = 0;
+  uint64_t amount_of_free_nodes = 0;
+  uint64_t amount_of_released_bytes = 0;
+  RingTupleQueue::TupleSchemas* tuple_schemas = nullptr;
   TimeListManager time_list_manager;
+  // Capacity of every minipool, kept so that it is read in O(1).
+  size_t amount_of_nodes_in_pools{0};
 
  public:
   NodeManager(size_t starting_size, std::atomic<uint64_t>& event_time_of_expiration)
-      : minipool_head(new NodePool(starting_size)),
-        recyclable_node_head(nullptr),
+      : starting_size_log2(std::bit_width(std::bit_ceil(starting_size)) - 1),
+        minipool_head(new NodePool(std::bit_ceil(starting_size))),
+        pool_addresses{addresses_of_pool(0, *minipool_head)},
+        free_nodes(1),
         time_list_manager(*this),
-        expiration_time(event_time_of_expiration) {}
+        expiration_time(event_time_of_expiration) {
+    assert(starting_size >= 2 && "The time list nodes are in the first minipool.");
+    amount_of_nodes_in_pools = minipool_head->capacity();
+  }
 
   NodeManager(NodeManager&& other) = default;
 
   ~NodeManager() {
     for (NodePool* mp = minipool_head; mp != nullptr;) {
-      NodePool* next = mp->next();
+      NodePool* prev = mp->prev();
       delete mp;
-      mp = next;
+      mp = prev;
     }
   }
 
-  template <class... Args>
-  Node* alloc(Args&&... args) {
-    Node* out = get_node_to_recycle_or_increase_mempool_size_if_necessary();
-    if (out != nullptr) {
-      out->reset(std::forward<Args>(args)...);
-    } else {
-      out = allocate_a_new_node(std::forward<Args>(args)...);
+  /* BOTTOM Node */
+  Node* alloc(RingTupleQueue::Tuple& tuple, uint64_t timestamp) {
+    record_tuple_schemas(tuple);
+    return alloc_node(tuple.get_data(), timestamp);
+  }
+
+  /* OUTPUT Node */
+  Node* alloc(Node* node, RingTupleQueue::Tuple& tuple, uint64_t timestamp) {
+    assert(node != nullptr);
+    record_tuple_schemas(tuple);
+    return alloc_node(id_of(node), *node, tuple.get_data(), timestamp);
+  }
+
+  /* UNION Node */
+  Node* alloc(Node* left, Node* right) {
+    assert(left != nullptr && right != nullptr);
+    return alloc_node(id_of(left), *left, id_of(right), *right);
+  }
+
+  Node* node_at(NodeId id) const {
+    assert(id != NULL_NODE_ID);
+    uint64_t pool = pool_of(id);
+    assert(pool < pool_addresses.size());
+    return reinterpret_cast<Node*>(pool_addresses[pool].address_of_id_0
+                                   + uint64_t{id} * sizeof(Node));
+  }
+
+  /**
+   * The pools are searched from the newest one, which has at least half of
+   * the nodes, so this is usually resolved with the first one or two.
+   */
+  NodeId id_of(const Node* node) const {
+    auto address = reinterpret_cast<uintptr_t>(node);
+    for (uint64_t pool = amount_of_pools; pool-- > 0;) {
+      const PoolAddresses& addresses = pool_addresses[pool];
+      if (address - addresses.begin < addresses.size_in_bytes) {
+        return (address - addresses.address_of_id_0) / sizeof(Node);
+      }
     }
-    time_list_manager.add_node(out);
-    return out;
+    assert(false && "The node is not in the pools of the NodeManager.");
+    return NULL_NODE_ID;
+  }
+
+  RingTupleQueue::Tuple tuple_of(const Node& node) const {
+    assert(!node.is_union());
+    return RingTupleQueue::Tuple(node.tuple_data, tuple_schemas);
+  }
+
+  size_t amount_of_nodes_allocated() const { return amount_of_nodes_in_pools; }
+
+  uint64_t retained_bytes() const { return amount_of_nodes_in_pools * sizeof(Node); }
+
+  // Of the nodes that are not free, the unreachable ones that were not
+  // recycled yet included.
+  uint64_t live_bytes() const {
+    uint64_t unused_nodes = minipool_head->capacity() - minipool_head->size();
+    return (amount_of_nodes_in_pools - unused_nodes - amount_of_free_nodes)
+           * sizeof(Node);
+  }
+
+  uint64_t released_bytes() const { return amount_of_released_bytes; }
+
+  // Marks as dead every node that left the time window.
+  void remove_expired_nodes() {
+    while (time_list_manager.remove_a_dead_node_if_possible(expiration_time.load()))
+      ;
   }
 
-  size_t amount_of_nodes_allocated() const {
-    size_t amount = 0;
-    for (NodePool* mpool = minipool_head; mpool != nullptr; mpool = mpool->prev())
-      amount += mpool->capacity();
-    return amount;
+  /**
+   * Releases the newest minipools whose nodes are all free, never the first
+   * one, which has the nodes of the time list. The free nodes release their
+   * children first, a free node of an old minipool can be the only one that
+   * holds the nodes of a new one. The nodes that are reachable from a pinned
+   * node are never free, so the enumerators are not affected.
+   * @return The bytes released.
+   */
+  uint64_t compact() {
+    remove_expired_nodes();
+    release_children_of_free_nodes();
+    uint64_t released = 0;
+    while (amount_of_pools > 1
+           && free_nodes.back().size == minipool_head->size()) {
+      released += release_minipool_head();
+    }
+    amount_of_released_bytes += released;
+    return released;
   }
 
   void increase_ref_count(Node* node) { node->ref_count++; }
@@ -70,63 +194,173 @@ class NodeManager {
   void decrease_ref_count(Node* node) {
     assert(node != nullptr);
     node->ref_count--;
-    try_to_mark_node_as_unused(node);
+    if (node->ref_count == 0) {
+      add_to_list_of_free_memory(id_of(node), *node);
+    }
   }
 
-  void mark_as_dead(Node* node) {
-    assert(node != nullptr);
-    assert(node->node_type != Node::NodeType::DEAD);
-    switch (node->node_type) {
+  void mark_as_dead(Node& node) {
+    assert(!node.is_dead());
+    switch (node.type()) {
       case Node::NodeType::UNION:
-        decrease_ref_count(node->right);
-        node->right = nullptr;
+        decrease_ref_count(node.right);
+        node.right = NULL_NODE_ID;
         [[fallthrough]];
       case Node::NodeType::OUTPUT:
-        decrease_ref_count(node->left);
-        node->left = nullptr;
+        decrease_ref_count(node.left);
+        node.left = NULL_NODE_ID;
         [[fallthrough]];
       default:
-        node->node_type = Node::NodeType::DEAD;
+        node.set_type(Node::NodeType::DEAD);
     }
   }
 
   size_t get_amount_of_nodes_used() const { return amount_of_nodes_used; }
 
+  size_t get_amount_of_recycled_nodes() const { return amount_of_recycled_nodes; }
+
   TimeReservator& get_time_reservator() {
     return time_list_manager.get_time_reservator();
   }
 
  private:
-  Node* get_node_to_recycle_or_increase_mempool_size_if_necessary() {
+  friend class TimeListManager;
+
+  template <class... Args>
+  Node* alloc_node(Args&&... args) {
+    NodeId id = get_node_to_recycle_or_increase_mempool_size_if_necessary();
+    Node* out;
+    if (id != NULL_NODE_ID) {
+      out = node_at(id);
+      out->reset(std::forward<Args>(args)...);
+    } else {
+      id = next_id_of_minipool_head();
+      out = allocate_a_new_node(std::forward<Args>(args)...);
+    }
+    time_list_manager.add_node(id, *out);
+    return out;
+  }
+
+  // Used by the TimeListManager for its head and tail, before any other node.
+  NodeId alloc_time_list_node(Node::NodeType node_type) {
+    assert(!minipool_head->is_full());
+    NodeId id = next_id_of_minipool_head();
+    minipool_head->alloc(node_type);
+    return id;
+  }
+
+  void record_tuple_schemas(RingTupleQueue::Tuple& tuple) {
+    assert(tuple_schemas == nullptr || tuple_schemas == tuple.get_schemas());
+    // Written once, the enumerators of other threads read it.
+    if (tuple_schemas == nullptr) [[unlikely]] {
+      tuple_schemas = tuple.get_schemas();
+    }
+  }
+
+  uint64_t pool_of(NodeId id) const {
+    return std::bit_width((uint64_t{id} >> starting_size_log2) + 1) - 1;
+  }
+
+  uint64_t first_id_of_pool(uint64_t pool) const {
+    return ((uint64_t{1} << pool) - 1) << starting_size_log2;
+  }
+
+  uint64_t size_of_pool(uint64_t pool) const {
+    return std::min(uint64_t{1} << (pool + starting_size_log2),
+                    MAXIMUM_AMOUNT_OF_NODES - first_id_of_pool(pool));
+  }
+
+  NodeId next_id_of_minipool_head() const {
+    return first_id_of_pool(amount_of_pools - 1) + minipool_head->size();
+  }
+
+  NodeId get_node_to_recycle_or_increase_mempool_size_if_necessary() {
     if (!minipool_head->is_full()) {
-      return nullptr;
+      return NULL_NODE_ID;
     }
-    if (recyclable_node_head == nullptr) {
+    if (pools_with_free_nodes == 0) {
       if (time_list_manager.remove_a_dead_node_if_possible(expiration_time.load())) {
-        while (time_list_manager.remove_a_dead_node_if_possible(expiration_time.load()))
-          ;
-        if (recyclable_node_head != nullptr) {
+        remove_expired_nodes();
+        if (pools_with_free_nodes != 0) {
           return get_node_to_recycle();
         }
       };
       increase_mempool_size();
-      return nullptr;
+      return NULL_NODE_ID;
     }
     return get_node_to_recycle();
   }
 
   void increase_mempool_size() {
-    NodePool* new_minipool = new NodePool(minipool_head->size() * 2);
+    uint64_t pool = amount_of_pools;
+    static_assert(NODE_ID_BITS < 64, "The pools with free nodes are a 64-bit mask.");
+    if (first_id_of_pool(pool) >= MAXIMUM_AMOUNT_OF_NODES) {
+      throw std::runtime_error("The tECS has more nodes than its ids can address.");
+    }
+    assert(pool < pool_addresses.size());
+    NodePool* new_minipool = new NodePool(size_of_pool(pool));
     minipool_head->set_next(new_minipool);
     new_minipool->set_prev(minipool_head);
+    amount_of_nodes_in_pools += new_minipool->capacity();
 
     minipool_head = new_minipool;
+    pool_addresses[pool] = addresses_of_pool(pool, *minipool_head);
+    amount_of_pools++;
+    free_nodes.emplace_back();
+  }
+
+  // The minipool head is the last one and all of its nodes are free.
+  uint64_t release_minipool_head() {
+    uint64_t pool = amount_of_pools - 1;
+    NodePool* released_minipool = minipool_head;
+    minipool_head = released_minipool->prev();
+    minipool_head->set_next(nullptr);
+    amount_of_nodes_in_pools -= released_minipool->capacity();
+    amount_of_free_nodes -= free_nodes[pool].size;
+    pools_with_free_nodes &= ~(uint64_t{1} << pool);
+    amount_of_pools--;
+    free_nodes.pop_back();
+    uint64_t released = released_minipool->capacity() * sizeof(Node);
+    delete released_minipool;
+    return released;
   }
 
-  Node* get_node_to_recycle() {
-    Node* node_to_recycle = recyclable_node_head;
-    advance_recyclable_nodes_list_head();
-    time_list_manager.remove_node(node_to_recycle);
+  /**
+   * Takes the free nodes out of the time list, which releases their
+   * children. The nodes freed meanwhile are pushed before the ones already
+   * visited in the list of their pool, so each pass only visits new ones.
+   */
+  void release_children_of_free_nodes() {
+    std::vector<NodeId> visited(free_nodes.size(), NULL_NODE_ID);
+    bool has_freed_nodes = true;
+    while (has_freed_nodes) {
+      has_freed_nodes = false;
+      for (uint64_t pool = 0; pool < free_nodes.size(); pool++) {
+        while (free_nodes[pool].head != visited[pool]) {
+          NodeId first = free_nodes[pool].head;
+          for (NodeId id = first; id != visited[pool];) {
+            NodeId next = node_at(id)->next_free_node;
+            time_list_manager.remove_node(id);
+            id = next;
+          }
+          visited[pool] = first;
+          has_freed_nodes = true;
+        }
+      }
+    }
+  }
+
+  PoolAddresses addresses_of_pool(uint64_t pool, NodePool& minipool) const {
+    auto begin = reinterpret_cast<uintptr_t>(minipool.data());
+    return {begin,
+            size_of_pool(pool) * sizeof(Node),
+            begin - first_id_of_pool(pool) * sizeof(Node)};
+  }
+
+  NodeId get_node_to_recycle() {
+    NodeId id_to_recycle = pop_free_node();
+    Node* node_to_recycle = node_at(id_to_recycle);
+    time_list_manager.remove_node(id_to_recycle);
     if (node_to_recycle->is_union()) {
       decrease_ref_count(node_to_recycle->left);
       decrease_ref_count(node_to_recycle->right);
@@ -135,12 +369,22 @@ class NodeManager {
     } else {
       assert(node_to_recycle->is_bottom() || node_to_recycle->is_dead());
     }
-    return node_to_recycle;
+    return id_to_recycle;
   }
 
-  void advance_recyclable_nodes_list_head() {
-    recyclable_node_head = recyclable_node_head->next_free_node;
+  // From the oldest minipool with free nodes.
+  NodeId pop_free_node() {
+    assert(pools_with_free_nodes != 0);
+    uint64_t pool = std::countr_zero(pools_with_free_nodes);
+    FreeNodes& free = free_nodes[pool];
+    NodeId id = free.head;
+    free.head = node_at(id)->next_free_node;
+    if (--free.size == 0) {
+      pools_with_free_nodes &= ~(uint64_t{1} << pool);
+    }
+    --amount_of_free_nodes;
     ++amount_of_recycled_nodes;
+    return id;
   }
 
   template <class... Args>
@@ -149,31 +393,37 @@ class NodeManager {
     return minipool_head->alloc(std::forward<Args>(args)...);
   }
 
-  void try_to_mark_node_as_unused(Node* node) {
+  void decrease_ref_count(NodeId id) {
+    Node* node = node_at(id);
+    node->ref_count--;
     if (node->ref_count == 0) {
-      add_to_list_of_free_memory(node);
+      add_to_list_of_free_memory(id, *node);
     }
   }
 
-  void add_to_list_of_free_memory(Node* node) {
-    node->next_free_node = recyclable_node_head;
-    recyclable_node_head = node;
+  void add_to_list_of_free_memory(NodeId id, Node& node) {
+    uint64_t pool = pool_of(id);
+    FreeNodes& free = free_nodes[pool];
+    node.next_free_node = free.head;
+    free.head = id;
+    free.size++;
+    pools_with_free_nodes |= uint64_t{1} << pool;
+    ++amount_of_free_nodes;
   }
 
  private:
   /// For debugging.
   std::string print_free_node_list() {
     std::string out;
-    out += "Free memory list: ";
-    for (Node* node = recyclable_node_head; node != nullptr; node = node->next_free_node) {
-      // Transform the node pointer to string
-      std::stringstream ss;
-      ss << node;
-      std::string node_as_string = ss.str();
-      out += node_as_string;
-      out += "-> ";
+    for (uint64_t pool = 0; pool < free_nodes.size(); pool++) {
+      out += "Free memory list of pool " + std::to_string(pool) + ": ";
+      for (NodeId id = free_nodes[pool].head; id != NULL_NODE_ID;
+           id = node_at(id)->next_free_node) {
+        out += std::to_string(id);
+        out += "-> ";
+      }
+      out += "\n";
     }
-    out += "\n";
     return out;
   }
 };
@@ -1,26 +1,34 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "node.hpp"
 #include "node_manager.hpp"
 #include "time_reservator.hpp"
+#include "union_list.hpp"
 
 namespace CORE::Internal::tECS {
 
 class tECS {
   // tECS manages nodes and union lists, by default all operations take
   // ownership of the node passed.
-  using UnionList = std::vector<Node*>;
 
  public:
   TimeReservator* time_reservator;
 
  private:
   NodeManager node_manager;
+  MiniPool::PoolCompactionTimer compaction_timer;
 
  public:
   tECS(std::atomic<uint64_t>& event_time_of_expiration)
@@ -28,12 +36,91 @@ class tECS {
     time_reservator = &node_manager.get_time_reservator();
   }
 
+  size_t amount_of_nodes_allocated() const {
+    return node_manager.amount_of_nodes_allocated();
+  }
+
+  size_t amount_of_nodes_used() const { return node_manager.get_amount_of_nodes_used(); }
+
+  size_t amount_of_nodes_recycled() const {
+    return node_manager.get_amount_of_recycled_nodes();
+  }
+
+  uint64_t retained_bytes() const { return node_manager.retained_bytes(); }
+
+  uint64_t live_bytes() const { return node_manager.live_bytes(); }
+
+  uint64_t released_bytes() const { return node_manager.released_bytes(); }
+
+  // See NodeManager::compact.
+  uint64_t compact() { return node_manager.compact(); }
+
+  /**
+   * Compacts the pools if their utilization stayed under the threshold of
+   * the settings for its period, the nodes that left the time window are
+   * freed before measuring it.
+   * @return The bytes released.
+   */
+  uint64_t compact_if_underused(const MiniPool::PoolCompactionSettings& settings,
+                                std::chrono::steady_clock::time_point now) {
+    node_manager.remove_expired_nodes();
+    if (!compaction_timer.should_compact(settings,
+                                         node_manager.live_bytes(),
+                                         node_manager.retained_bytes(),
+                                         now)) {
+      return 0;
+    }
+    return node_manager.compact();
+  }
+
+  /// The child of an output node, the rest of its complex events.
+  Node* next(const Node* node) const {
+    assert(node->is_output());
+    return node_manager.node_at(node->left);
+  }
+
+  Node* get_left(const Node* node) const {
+    assert(node->is_union());
+    return node_manager.node_at(node->left);
+  }
+
+  Node* get_right(const Node* node) const {
+    assert(node->is_union());
+    return node_manager.node_at(node->right);
+  }
+
+  RingTupleQueue::Tuple get_tuple(const Node* node) const {
+    return node_manager.tuple_of(*node);
+  }
+
+  std::string to_string(const Node* node, size_t depth = 0) const {
+    std::string out = "";
+    for (size_t i = 0; i < depth; i++) {
+      out += "    ";
+    }
+    if (node->is_bottom()) {
+      out += "Bottom(" + std::to_string(get_tuple(node).id()) + ")";
+    } else if (node->is_output()) {
+      out += "Output(" + std::to_string(get_tuple(node).id()) + ")\n";
+      out += to_string(next(node), depth + 1);
+    } else {
+      out += "Union\n";
+      out += to_string(get_left(node), depth + 1);
+      out += "\n";
+      out += to_string(get_right(node), depth + 1);
+    }
+    return out;
+  }
+
   void pin(Node* node) { node_manager.increase_ref_count(node); }
 
   void pin(UnionList& ulist) {
     for (auto node : ulist) {
       pin(node);
     }
+    if (!ulist.merged_prefixes.empty()) {
+      pin(ulist.merged_prefixes.back());
+    }
   }
 
   /**
@@ -43,9 +130,12 @@ class tECS {
   void unpin(Node* node) { node_manager.decrease_ref_count(node); }
 
   void unpin(UnionList& ulist) {
-    for (auto& node : ulist) {
+    for (auto node : ulist) {
       unpin(node);
     }
+    if (!ulist.merged_prefixes.empty()) {
+      unpin(ulist.merged_prefixes.back());
+    }
   }
 
   /**
@@ -74,8 +164,8 @@ class tECS {
    */
   [[nodiscard]] Node* new_union(Node* node_1, Node* node_2) {
     assert(node_1 != nullptr && node_2 != nullptr);
-    assert(node_1->node_type != Node::NodeType::DEAD);
-    assert(node_2->node_type != Node::NodeType::DEAD);
+    assert(!node_1->is_dead());
+    assert(!node_2->is_dead());
     assert(node_1->max() == node_2->max());
     if (!node_1->is_union()) {
       return new_direct_union(node_1, node_2);
@@ -88,8 +178,8 @@ class tECS {
 
   [[nodiscard]] Node* new_direct_union(Node* node_1, Node* node_2) {
     assert(node_1 != nullptr && node_2 != nullptr);
-    assert(node_1->node_type != Node::NodeType::DEAD);
-    assert(node_2->node_type != Node::NodeType::DEAD);
+    assert(!node_1->is_dead());
+    assert(!node_2->is_dead());
     return node_manager.alloc(node_1, node_2);
   }
 
@@ -100,74 +190,112 @@ class tECS {
   UnionList new_ulist(Node* node) {
     assert(!node->is_union());
     pin(node);
-    return {node};
+    UnionList ulist;
+    ulist.nodes.push_back(node);
+    return ulist;
   }
 
   /// Inserts the node in the ulist, maintaining the max-sorted invariant.
   [[nodiscard]] UnionList insert(UnionList&& ulist, Node* node) {
     assert_required_properties_of_union_list(ulist);
     assert(node->max() <= ulist[0]->max());
-    if (ulist.size() == 1) {
-      ulist.push_back(node);
-      pin(node);
-      assert_required_properties_of_union_list(ulist);
-      return std::move(ulist);
-    }
-    // TODO: binary search would be better on large lists.
-    int64_t i;
-    for (i = 1; i < ulist.size(); i++) {
-      if (ulist[i]->max() == node->max()) {
-        Node* union_node = new_union(ulist[i], node);
-        pin(union_node);
-        unpin(ulist[i]);
-        ulist[i] = union_node;
-        break;
-      }
-      if (ulist[i]->max() < node->max()) {
-        pin(node);
-        ulist.insert(ulist.begin() + i, node);
-        break;
-      }
-    }
-    if (i == ulist.size()) {
+    std::vector<Node*>& nodes = ulist.nodes;
+    // After the first node the maximum starts are decreasing.
+    auto it = std::partition_point(nodes.begin() + 1, nodes.end(), [&](Node* other) {
+      return other->max() > node->max();
+    });
+    size_t idx = it - nodes.begin();
+    if (it != nodes.end() && (*it)->max() == node->max()) {
+      Node* union_node = new_union(*it, node);
+      pin(union_node);
+      unpin(*it);
+      *it = union_node;
+    } else {
       pin(node);
-      ulist.push_back(node);
+      nodes.insert(it, node);
     }
-
+    keep_merged_prefixes(ulist, idx);
     assert_required_properties_of_union_list(ulist);
     return std::move(ulist);
   }
 
+  /**
+   * Removes the nodes whose maximum start is lower than the given time. The
+   * first node must not be one of them, so they are at the end of the list.
+   */
+  void remove_nodes_out_of_time(UnionList& ulist, uint64_t time_of_expiration) {
+    assert_required_properties_of_union_list(ulist);
+    assert(ulist[0]->max() >= time_of_expiration);
+    std::vector<Node*>& nodes = ulist.nodes;
+    auto it = std::partition_point(nodes.begin() + 1, nodes.end(), [&](Node* node) {
+      return node->max() >= time_of_expiration;
+    });
+    size_t new_size = it - nodes.begin();
+    for (; it != nodes.end(); ++it) {
+      unpin(*it);
+    }
+    nodes.resize(new_size);
+    keep_merged_prefixes(ulist, new_size);
+  }
+
+  /**
+   * The unions of the prefixes are kept in the list, so only the unions of
+   * the nodes after the last change of the list are created. The node
+   * returned is pinned by the list while it does not change.
+   */
   /*       _\|/_
            (o o)
    +----oOO-{_}-OOo---------------------------------------+
    |From the union list: n0, n1, ... nk creates this node:|
-   |     u                                                |
-   |    / \                                               |
-   |  n0   u1                                             |
-   |      /  \                                            |
-   |     n1   u2                                          |
-   |         /  \                                         |
-   |        n2   \                                        |
-   |              uk-1                                    |
-   |             /   \                                    |
-   |           nk-1   nk                                  |
+   |                  u                                   |
+   |                 / \                                  |
+   |               uk-1  nk                               |
+   |               /  \                                   |
+   |             ...   nk-1                               |
+   |             /                                        |
+   |           u1                                         |
+   |          /  \                                        |
+   |        n0    n1                                      |
    +-----------------------------------------------------*/
   Node* merge(UnionList& ulist) {
     assert_required_properties_of_union_list(ulist);
-    Node* tail = ulist.back();
-    for (auto rit = ulist.rbegin() + 1; rit != ulist.rend(); ++rit) {
-      assert(*rit != nullptr && tail != nullptr);
-      Node* node_1 = *rit;
-      assert(node_1->node_type != Node::NodeType::DEAD);
-      assert(tail->node_type != Node::NodeType::DEAD);
-      tail = node_manager.alloc(node_1, tail);
+    std::vector<Node*>& prefixes = ulist.merged_prefixes;
+    if (prefixes.size() == ulist.size()) {
+      return prefixes.back();
+    }
+    Node* previous_merge = prefixes.empty() ? nullptr : prefixes.back();
+    if (prefixes.empty()) {
+      prefixes.push_back(ulist[0]);
     }
-    assert(tail != nullptr);
-    return tail;
+    for (size_t idx = prefixes.size(); idx < ulist.size(); idx++) {
+      Node* node = ulist[idx];
+      assert(node != nullptr && prefixes.back() != nullptr);
+      assert(!node->is_dead());
+      assert(!prefixes.back()->is_dead());
+      prefixes.push_back(node_manager.alloc(prefixes.back(), node));
+    }
+    pin(prefixes.back());
+    if (previous_merge != nullptr) {
+      unpin(previous_merge);
+    }
+    return prefixes.back();
   }
 
  private:
+  // Keeps the merged prefixes of the first nodes, which did not change.
+  void keep_merged_prefixes(UnionList& ulist, size_t amount_of_nodes) {
+    std::vector<Node*>& prefixes = ulist.merged_prefixes;
+    if (prefixes.size() <= amount_of_nodes) {
+      return;
+    }
+    Node* previous_merge = prefixes.back();
+    prefixes.resize(amount_of_nodes);
+    if (!prefixes.empty()) {
+      pin(prefixes.back());
+    }
+    unpin(previous_merge);
+  }
+
   void assert_required_properties_of_union_list(UnionList& union_list) {
     assert(union_list.size() >= 1);
     assert(union_list[0] != nullptr);
@@ -216,13 +344,15 @@ class tECS {
   Node* create_first_intermediate_union_node(Node* node_1, Node* node_2) {
     assert(node_1 != nullptr);
     assert(node_2 != nullptr);
-    assert(node_1->right->node_type != Node::NodeType::DEAD);
-    assert(node_2->right->node_type != Node::NodeType::DEAD);
+    assert(!get_right(node_1)->is_dead());
+    assert(!get_right(node_2)->is_dead());
     Node* u2;
-    if (node_1->max() >= node_2->max()) {
-      u2 = node_manager.alloc(node_1->right, node_2->right);
+    // The maximum starts of node_1 and node_2 are the same, the ones of their
+    // right children decide the order.
+    if (get_right(node_1)->max() >= get_right(node_2)->max()) {
+      u2 = node_manager.alloc(get_right(node_1), get_right(node_2));
     } else {
-      u2 = node_manager.alloc(node_2->right, node_1->right);
+      u2 = node_manager.alloc(get_right(node_2), get_right(node_1));
     }
     assert(u2 != nullptr);
     return u2;
@@ -231,10 +361,10 @@ class tECS {
   Node* create_second_intermediate_union_node(Node* node_2, Node* u2) {
     assert(node_2 != nullptr);
     assert(u2 != nullptr);
-    assert(node_2->left != nullptr);
-    assert(node_2->left->node_type != Node::NodeType::DEAD);
-    assert(u2->node_type != Node::NodeType::DEAD);
-    Node* u1 = node_manager.alloc(node_2->left, u2);
+    assert(node_2->left != NULL_NODE_ID);
+    assert(!get_left(node_2)->is_dead());
+    assert(!u2->is_dead());
+    Node* u1 = node_manager.alloc(get_left(node_2), u2);
     assert(u1 != nullptr);
     return u1;
   }
@@ -242,10 +372,10 @@ class tECS {
   Node* create_union_of_output_and_intermediate_node(Node* node_1, Node* u2) {
     assert(node_1 != nullptr);
     assert(u2 != nullptr);
-    assert(node_1->left != nullptr);
-    assert(node_1->left->node_type != Node::NodeType::DEAD);
-    assert(u2->node_type != Node::NodeType::DEAD);
-    Node* new_node = node_manager.alloc(node_1->left, u2);
+    assert(node_1->left != NULL_NODE_ID);
+    assert(!get_left(node_1)->is_dead());
+    assert(!u2->is_dead());
+    Node* new_node = node_manager.alloc(get_left(node_1), u2);
     assert(new_node != nullptr);
     return new_node;
   }
@@ -12,53 +12,58 @@ namespace CORE::Internal::tECS {
 
 TimeListManager::TimeListManager(NodeManager& node_manager)
     : node_manager(node_manager),
-      head(std::make_unique<Node>(Node::NodeType::TIME_LIST_HEAD)),
-      tail(std::make_unique<Node>(Node::NodeType::TIME_LIST_TAIL)),
-      time_reservator() {
-  head->time_list_left = head.get();
-  head->time_list_right = tail.get();
-  tail->time_list_left = head.get();
-  tail->time_list_right = tail.get();
+      time_reservator(),
+      head(node_manager.alloc_time_list_node(Node::NodeType::TIME_LIST_HEAD)),
+      tail(node_manager.alloc_time_list_node(Node::NodeType::TIME_LIST_TAIL)) {
+  Node* head_node = node_manager.node_at(head);
+  Node* tail_node = node_manager.node_at(tail);
+  head_node->time_list_left = head;
+  head_node->time_list_right = tail;
+  tail_node->time_list_left = head;
+  tail_node->time_list_right = tail;
 }
 
-void TimeListManager::add_node(Node* node) {
+void TimeListManager::add_node(NodeId id, Node& node) {
   // HEAD <-> previous_right               <- now
   // HEAD <-> node <-> previous_right      <- wanted
-  Node* previous_right = head->time_list_right;
+  Node* head_node = node_manager.node_at(head);
+  NodeId previous_right = head_node->time_list_right;
 
-  head->time_list_right = node;
-  node->time_list_left = head.get();
+  head_node->time_list_right = id;
+  node.time_list_left = head;
 
-  node->time_list_right = previous_right;
-  previous_right->time_list_left = node;
+  node.time_list_right = previous_right;
+  node_manager.node_at(previous_right)->time_list_left = id;
 }
 
 bool TimeListManager::remove_a_dead_node_if_possible(uint64_t maximum_start_limit) {
   uint64_t limit = std::min(maximum_start_limit,
                             time_reservator.get_smallest_reserved_time());
-  if (tail->time_list_left->maximum_start < limit) {
-    remove_node(tail->time_list_left);
+  NodeId last = node_manager.node_at(tail)->time_list_left;
+  if (node_manager.node_at(last)->maximum_start < limit) {
+    remove_node(last);
     return true;
   }
   return false;
 }
 
-void TimeListManager::remove_node(Node* node) {
-  assert(node != nullptr);
-  if (node->time_list_left != nullptr) {
-    assert(node->time_list_right != nullptr);
+void TimeListManager::remove_node(NodeId id) {
+  assert(id != NULL_NODE_ID);
+  Node* node = node_manager.node_at(id);
+  if (node->time_list_left != NULL_NODE_ID) {
+    assert(node->time_list_right != NULL_NODE_ID);
 
     // Prev <-> node <-> Post          <- current
     // Prev <-> Post                   <- wanted
-    Node* prev = node->time_list_left;
-    Node* post = node->time_list_right;
-    node->time_list_left = nullptr;
-    node->time_list_right = nullptr;
+    NodeId prev = node->time_list_left;
+    NodeId post = node->time_list_right;
+    node->time_list_left = NULL_NODE_ID;
+    node->time_list_right = NULL_NODE_ID;
 
-    prev->time_list_right = post;
-    post->time_list_left = prev;
+    node_manager.node_at(prev)->time_list_right = post;
+    node_manager.node_at(post)->time_list_left = prev;
 
-    node_manager.mark_as_dead(node);
+    node_manager.mark_as_dead(*node);
   }
 }
 }  // namespace CORE::Internal::tECS
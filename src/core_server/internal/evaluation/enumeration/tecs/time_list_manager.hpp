@@ -21,15 +21,16 @@ class NodeManager;
 class TimeListManager {
   NodeManager& node_manager;
   TimeReservator time_reservator;
-  std::unique_ptr<Node> head;
-  std::unique_ptr<Node> tail;
+  // The head and tail are nodes of the node manager, so that they have ids.
+  NodeId head;
+  NodeId tail;
 
  public:
   TimeListManager(NodeManager& node_manager);
 
-  void add_node(Node* node);
+  void add_node(NodeId id, Node& node);
   bool remove_a_dead_node_if_possible(uint64_t maximum_start_limit);
-  void remove_node(Node* node);
+  void remove_node(NodeId id);
 
   TimeReservator& get_time_reservator() { return time_reservator; }
 };
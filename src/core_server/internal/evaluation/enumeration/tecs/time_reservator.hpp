@@ -1,131 +1,119 @@
 #pragma once
-#include <unistd.h>
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
-#include <cstdlib>
-#include <iostream>
 #include <memory>
-#include <mutex>
-#include <utility>
+#include <vector>
 
 namespace CORE::Internal::tECS {
 
+const size_t TIME_RESERVATOR_SLOTS_PER_BLOCK = 64;
+
+/**
+ * The times reserved by the enumerators of a tECS. Nodes whose maximum start
+ * is at least the smallest reserved time are not recycled, since an
+ * enumerator can still reach them.
+ *
+ * The thread that owns the tECS reserves the times and reads the smallest
+ * one, while any thread can release a reservation, so an enumerator can be
+ * consumed in another thread. None of them takes a lock: releasing a slot is
+ * a single atomic store.
+ *
+ * The slots are preallocated in blocks that form a queue in the order the
+ * times were reserved. The enumerators of a tECS reserve non decreasing
+ * times, so the smallest reserved time is the one of the oldest slot that is
+ * still reserved, which is kept by advancing over the released ones. Blocks
+ * whose slots were all released are reused.
+ */
 class TimeReservator {
  public:
-  class Node {
+  class Slot {
     friend class TimeReservator;
-    std::unique_ptr<Node> right{nullptr};
-    Node* left{nullptr};
-    uint64_t time_reservation;
-
-   public:
-    Node(uint64_t time_reservation) : time_reservation(time_reservation) {}
+    std::atomic<uint64_t> time{UINT64_MAX};
   };
 
  private:
-  std::unique_ptr<Node> head;
-  Node* tail{nullptr};
-  std::mutex mtx;
+  struct Block {
+    std::array<Slot, TIME_RESERVATOR_SLOTS_PER_BLOCK> slots;
+    Block* next{nullptr};
+  };
 
- public:
-  TimeReservator() : head(std::make_unique<Node>(UINT64_MAX)) {
-    head->right = std::make_unique<Node>(UINT64_MAX);
-    head->right->left = head.get();
-    tail = head->right.get();
-    assert(list_is_well_formed());
-  }
+  std::vector<std::unique_ptr<Block>> blocks;
+  std::vector<Block*> free_blocks;
+  Block* oldest_block;
+  size_t oldest_slot{0};
+  Block* newest_block;
+  size_t next_slot{0};
+#ifndef NDEBUG
+  uint64_t last_reserved_time{0};
+#endif
 
-  TimeReservator(TimeReservator&& other) noexcept {
-    std::lock_guard<std::mutex> lock(mtx);
-    other.head = std::move(head);
-    other.tail = tail;
+ public:
+  TimeReservator() {
+    blocks.push_back(std::make_unique<Block>());
+    oldest_block = blocks.back().get();
+    newest_block = oldest_block;
   }
 
-  Node* reserve(uint64_t time) {
-    auto new_node = std::make_unique<Node>(time);
-
-    std::lock_guard<std::mutex> lock(mtx);
-    assert(list_is_well_formed());
-    new_node->right = std::move(head->right);
-    assert(new_node->right != nullptr);
-    new_node->right->left = new_node.get();
-
-    new_node->left = head.get();
-    head->right = std::move(new_node);
-    auto out = head->right.get();
-    assert(list_is_well_formed());
-    assert(list_contains(out));
-    return out;
+  TimeReservator(TimeReservator&& other) noexcept = default;
+
+  Slot* reserve(uint64_t time) {
+    assert(time != UINT64_MAX);
+    assert(time >= last_reserved_time);
+#ifndef NDEBUG
+    last_reserved_time = time;
+#endif
+    if (next_slot == TIME_RESERVATOR_SLOTS_PER_BLOCK) {
+      newest_block->next = get_free_block();
+      newest_block = newest_block->next;
+      next_slot = 0;
+    }
+    Slot* slot = &newest_block->slots[next_slot++];
+    assert(slot->time.load(std::memory_order_relaxed) == UINT64_MAX);
+    slot->time.store(time, std::memory_order_relaxed);
+    return slot;
   }
 
+  /// UINT64_MAX if no time is reserved.
   uint64_t get_smallest_reserved_time() {
-    std::lock_guard<std::mutex> lock(mtx);
-    return tail->left->time_reservation;
-  }
-
-  void remove_node(Node* node) {
-    std::lock_guard<std::mutex> lock(mtx);
-    assert(list_is_well_formed());
-    assert(list_contains(node));
-    node->right->left = node->left;
-    node->left->right = std::move(node->right);
-    assert(list_is_well_formed());
-  }
-
- private:
-  bool list_is_well_formed() {
-    if (head == nullptr || tail == nullptr) {
-      std::cout << "Head or tail is nullptr" << std::endl;
-      return false;
-    }
-
-    Node* current = head.get();
-    Node* previous = nullptr;
-
-    // Loop through the list from head to tail.
-    while (current != nullptr) {
-      if (current->right == nullptr && current != tail) {
-        std::cout << "Right of a non-tail node is nullptr" << std::endl;
-        return false;
-      }
-
-      if (current->left == nullptr && current != head.get()) {
-        std::cout << "Left of a non-head node is nullptr" << std::endl;
-        return false;
+    while (oldest_block != newest_block || oldest_slot != next_slot) {
+      if (oldest_slot == TIME_RESERVATOR_SLOTS_PER_BLOCK) {
+        Block* released_block = oldest_block;
+        oldest_block = released_block->next;
+        oldest_slot = 0;
+        released_block->next = nullptr;
+        free_blocks.push_back(released_block);
+        continue;
       }
-
-      if (current->right != nullptr && current->right->left != current) {
-        std::cout << "Right node's left does not point back to node" << std::endl;
-        return false;
-      }
-
-      if (current->left != nullptr && current->left->right.get() != current) {
-        std::cout << "Left node's right does not point back to node" << std::endl;
-        return false;
+      // Acquire so that the reads of the enumerator that held the slot happen
+      // before the nodes it read are recycled.
+      uint64_t time = oldest_block->slots[oldest_slot].time.load(
+        std::memory_order_acquire);
+      if (time != UINT64_MAX) {
+        return time;
       }
-
-      previous = current;
-      current = current->right.get();
-    }
-
-    if (previous != tail) {
-      std::cout << "Did not reach tail starting from head" << std::endl;
-      return false;
+      oldest_slot++;
     }
+    return UINT64_MAX;
+  }
 
-    return true;
+  void release(Slot* slot) {
+    assert(slot->time.load(std::memory_order_relaxed) != UINT64_MAX);
+    slot->time.store(UINT64_MAX, std::memory_order_release);
   }
 
-  bool list_contains(Node* node) {
-    Node* current = head.get();
-    while (current != nullptr) {
-      if (current == node) {
-        return true;
-      }
-      current = current->right.get();
+ private:
+  Block* get_free_block() {
+    if (free_blocks.empty()) {
+      blocks.push_back(std::make_unique<Block>());
+      return blocks.back().get();
     }
-    return false;
+    Block* block = free_blocks.back();
+    free_blocks.pop_back();
+    return block;
   }
 };
 }  // namespace CORE::Internal::tECS
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "node.hpp"
+
+namespace CORE::Internal::tECS {
+
+/**
+ * Nodes of the tECS sorted by maximum start: the first node has the highest
+ * one and every node after it has a lower maximum start than the node before.
+ * The tECS creates and modifies them, and pins the nodes they hold.
+ *
+ * tECS::merge memoizes the union of every prefix of the list, the union of
+ * the first i + 1 nodes is (union of the first i nodes) u nodes[i]. Removing
+ * nodes from the end keeps the shorter prefixes, and inserting a node keeps
+ * the prefixes before it, so merging the list again only creates the unions
+ * of the nodes after the first change.
+ */
+class UnionList {
+  friend class tECS;
+
+  std::vector<Node*> nodes = {};
+  // merged_prefixes[i] is the union of nodes[0..i], only the last one is pinned.
+  std::vector<Node*> merged_prefixes = {};
+
+ public:
+  UnionList() = default;
+
+  size_t size() const { return nodes.size(); }
+
+  bool empty() const { return nodes.empty(); }
+
+  Node* operator[](size_t idx) const { return nodes[idx]; }
+
+  auto begin() const { return nodes.begin(); }
+
+  auto end() const { return nodes.end(); }
+};
+}  // namespace CORE::Internal::tECS
@@ -1,8 +1,8 @@
 #pragma once
-#include <gmpxx.h>
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
@@ -11,19 +11,22 @@
 
 #include "core_server/internal/ceql/query/consume_by.hpp"
 #include "core_server/internal/ceql/query/limit.hpp"
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "det_cea/det_cea.hpp"
 #include "det_cea/state.hpp"
 #include "enumeration/tecs/enumerator.hpp"
 #include "enumeration/tecs/tecs.hpp"
+#include "enumeration/tecs/union_list.hpp"
 #include "predicate_evaluator.hpp"
 #include "tracy/Tracy.hpp"
 
 namespace CORE::Internal::Evaluation {
 class Evaluator {
  private:
-  using UnionList = std::vector<tECS::Node*>;
+  using UnionList = tECS::UnionList;
   using State = CEA::Det::State;
   using States = CEA::Det::State::States;
   using Node = tECS::Node;
@@ -94,6 +97,45 @@ class Evaluator {
         consumption_policy(consumption_policy),
         enumeration_limit(enumeration_limit) {}
 
+  /**
+   * The evaluator is idle when none of its union lists can still be
+   * extended inside the time window, so it can be cleared and reused.
+   */
+  bool is_idle() {
+    if (should_reset.load()) {
+      return true;
+    }
+    for (State* p : historic_ordered_keys) {
+      assert(historic_union_list_map.contains(p));
+      if (!is_ul_out_time_window(historic_union_list_map[p])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Releases every state and union list, leaving the evaluator as if it
+   * was just created. The memory of the tECS is kept to be reused.
+   */
+  void clear() {
+    reset();
+    historic_union_list_map.clear();
+    should_reset.store(false);
+  }
+
+  const tECS::tECS& get_tecs_reference() const { return tecs; }
+
+  // See tECS::compact_if_underused, called between two tuples.
+  uint64_t compact_tecs_if_underused(const MiniPool::PoolCompactionSettings& settings,
+                                     std::chrono::steady_clock::time_point now) {
+    return tecs.compact_if_underused(settings, now);
+  }
+
+  size_t memory_usage_bytes() const {
+    return sizeof(Evaluator) + tecs.amount_of_nodes_allocated() * sizeof(tECS::Node);
+  }
+
   std::optional<tECS::Enumerator>
   next(RingTupleQueue::Tuple tuple, uint64_t current_time) {
     ZoneScopedN("Evaluator::next");
@@ -110,7 +152,7 @@ class Evaluator {
       should_reset.store(false);
     }
 
-    mpz_class predicates_satisfied = tuple_evaluator(tuple);
+    Bitset::SmallBitset predicates_satisfied = tuple_evaluator(tuple);
     current_union_list_map = {};
     current_ordered_keys = {};
     final_states.clear();
@@ -167,26 +209,18 @@ class Evaluator {
 
   bool is_ul_out_time_window(const UnionList& ul) {
     ZoneScopedN("Evaluator::is_ul_out_time_window");
-    return (ul.at(0)->maximum_start < event_time_of_expiration);
+    return (ul[0]->maximum_start < event_time_of_expiration);
   }
 
   void remove_out_of_time_nodes_ul(UnionList& ul) {
     ZoneScopedN("Evaluator::remove_dead_nodes_ul");
-    for (auto it = ul.begin(); it != ul.end();) {
-      Node* ul_node = *it;
-      if (ul_node->maximum_start < event_time_of_expiration) {
-        it = ul.erase(it);
-        tecs.unpin(ul_node);
-      } else {
-        ++it;
-      }
-    }
+    tecs.remove_nodes_out_of_time(ul, event_time_of_expiration);
   }
 
   void exec_trans(RingTupleQueue::Tuple& tuple,
                   State* p,
                   UnionList&& ul,
-                  mpz_class& t,
+                  const Bitset::SmallBitset& t,
                   uint64_t current_time) {
     // exec_trans places all the code of add into exec_trans.
     ZoneScopedN("Evaluator::exec_trans");
@@ -205,7 +239,7 @@ class Evaluator {
         UnionList new_ulist = tecs.new_ulist(new_node);
         current_ordered_keys.push_back(marked_state);
         cea.state_manager.pin_state(marked_state);
-        current_union_list_map[marked_state] = new_ulist;
+        current_union_list_map[marked_state] = std::move(new_ulist);
         if (marked_state->is_final) {
           final_states.push_back(marked_state);
         }
@@ -219,7 +253,7 @@ class Evaluator {
       } else {
         current_ordered_keys.push_back(unmarked_state);
         cea.state_manager.pin_state(unmarked_state);
-        current_union_list_map[unmarked_state] = ul;
+        current_union_list_map[unmarked_state] = std::move(ul);
         recycle_ulist = true;
         if (unmarked_state->is_final) {
           final_states.push_back(unmarked_state);
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/predicate_set.hpp"
 #include "shared/datatypes/aliases/event_type_id.hpp"
 #include "shared/datatypes/aliases/stream_type_id.hpp"
@@ -70,12 +71,9 @@ struct LogicalCEA {
       query_event_name_id = query_catalog.get_query_event_name_id_from_event_name(
         event_name);
 
-    mpz_class stream_predicate_position = mpz_class(1) << query_stream_id;
-    mpz_class event_name_predicate_position = mpz_class(1)
-                                              << (number_of_streams + query_event_name_id);
-
-    mpz_class expected_eval = stream_predicate_position | event_name_predicate_position;
-    mpz_class predicate_mask = expected_eval;
+    Bitset::SmallBitset expected_eval = Bitset::SmallBitset::with_bit(query_stream_id);
+    expected_eval.set(number_of_streams + query_event_name_id);
+    Bitset::SmallBitset predicate_mask = expected_eval;
 
     auto stream_event_id_iter = stream_event_to_id.find({stream_name, event_name});
     uint64_t stream_event_id = (stream_event_id_iter != stream_event_to_id.end())
@@ -108,11 +106,9 @@ struct LogicalCEA {
       query_event_name_id = query_catalog.get_query_event_name_id_from_event_name(
         event_name);
 
-    mpz_class event_name_predicate_position = mpz_class(1)
-                                              << (number_of_streams + query_event_name_id);
-
-    mpz_class expected_eval = event_name_predicate_position;
-    mpz_class predicate_mask = expected_eval;
+    Bitset::SmallBitset expected_eval = Bitset::SmallBitset::with_bit(
+      number_of_streams + query_event_name_id);
+    Bitset::SmallBitset predicate_mask = expected_eval;
 
     VariablesToMark event_mark = mpz_class(1)
                                  << (stream_event_to_id.size() + query_event_name_id);
@@ -12,6 +12,7 @@
 
 #include "core_server/internal/ceql/cel_formula/filters/atomic_filter.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/logical_cea/logical_cea.hpp"
 #include "core_server/internal/evaluation/logical_cea/transformations/logical_cea_transformer.hpp"
 #include "core_server/internal/evaluation/predicate_set.hpp"
@@ -39,8 +40,8 @@ class ApplyAtomicFilter : public LogicalCEATransformer<ApplyAtomicFilter> {
     assert(
       physical_predicate_id != std::numeric_limits<uint64_t>::max()
       && "Physical predicate ID should be added to query before creating the automaton.");
-    predicate_set = PredicateSet(mpz_class(1) << physical_predicate_id,
-                                 mpz_class(1) << physical_predicate_id);
+    predicate_set = PredicateSet(Bitset::SmallBitset::with_bit(physical_predicate_id),
+                                 Bitset::SmallBitset::with_bit(physical_predicate_id));
   }
 
   ApplyAtomicFilter(
@@ -64,8 +65,8 @@ class ApplyAtomicFilter : public LogicalCEATransformer<ApplyAtomicFilter> {
     assert(
       physical_predicate_id != std::numeric_limits<uint64_t>::max()
       && "Physical predicate ID should be added to query before creating the automaton.");
-    predicate_set = PredicateSet(mpz_class(1) << physical_predicate_id,
-                                 mpz_class(1) << physical_predicate_id);
+    predicate_set = PredicateSet(Bitset::SmallBitset::with_bit(physical_predicate_id),
+                                 Bitset::SmallBitset::with_bit(physical_predicate_id));
   }
 
   ApplyAtomicFilter(
@@ -87,8 +88,8 @@ class ApplyAtomicFilter : public LogicalCEATransformer<ApplyAtomicFilter> {
     assert(
       physical_predicate_id != std::numeric_limits<uint64_t>::max()
       && "Physical predicate ID should be added to query before creating the automaton.");
-    predicate_set = PredicateSet(mpz_class(1) << physical_predicate_id,
-                                 mpz_class(1) << physical_predicate_id);
+    predicate_set = PredicateSet(Bitset::SmallBitset::with_bit(physical_predicate_id),
+                                 Bitset::SmallBitset::with_bit(physical_predicate_id));
   }
 
   LogicalCEA eval(LogicalCEA&& cea) {
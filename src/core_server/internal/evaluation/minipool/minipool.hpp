@@ -28,6 +28,9 @@ class MiniPool {
 
   bool is_full() const { return item_container.size() >= capacity_; }
 
+  // The items are stored contiguously from here and never move.
+  item* data() { return item_container.data(); }
+
   MiniPool* next() const { return next_; }
 
   void set_next(MiniPool* mp) { next_ = mp; }
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace CORE::Internal::MiniPool {
+
+// Tuples an evaluator receives between two checks of the utilization of its pools.
+const uint64_t POOL_COMPACTION_CHECK_INTERVAL = 4096;
+
+/**
+ * When the structures built on MiniPools give their newest pools back. The
+ * pools are compacted once the live fraction of their memory stays under
+ * utilization_threshold for period. The utilization is only checked while
+ * the evaluator receives tuples, so an idle query keeps its memory.
+ */
+struct PoolCompactionSettings {
+  // 0 disables the compaction.
+  double utilization_threshold = 0.25;
+  std::chrono::steady_clock::duration period = std::chrono::seconds(10);
+};
+
+/**
+ * Remembers since when the utilization of some pools is under the threshold
+ * of the settings. Once that lasts a whole period should_compact returns
+ * true and the period starts again, so pools that are still in use are
+ * retried every period until they drain.
+ */
+class PoolCompactionTimer {
+  std::optional<std::chrono::steady_clock::time_point> underused_since = {};
+
+ public:
+  bool should_compact(const PoolCompactionSettings& settings,
+                      uint64_t live_bytes,
+                      uint64_t retained_bytes,
+                      std::chrono::steady_clock::time_point now) {
+    if (settings.utilization_threshold <= 0
+        || static_cast<double>(live_bytes)
+             >= settings.utilization_threshold * static_cast<double>(retained_bytes)) {
+      underused_since.reset();
+      return false;
+    }
+    if (!underused_since.has_value()) {
+      underused_since = now;
+    }
+    if (now - *underused_since < settings.period) {
+      return false;
+    }
+    underused_since = now;
+    return true;
+  }
+};
+}  // namespace CORE::Internal::MiniPool
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <tracy/Tracy.hpp>
 
@@ -38,6 +40,12 @@ class AndPredicate : public PhysicalPredicate {
     return true;
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    return builder.all_of(predicates.size(), [&](size_t i) {
+      return predicates[i]->compile(builder);
+    });
+  }
+
   std::string to_string() const override {
     std::string out = predicates[0]->to_string();
     for (int i = 1; i < predicates.size(); i++) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include "cassert"
@@ -33,6 +35,19 @@ class CheckEventNamePredicate : public PhysicalPredicate {
     return tuple_event_name_type_id == event_name_type_id;
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    // Only depends on the event type, so it is known in a program of one.
+    std::optional<Types::UniqueEventTypeId> event_type = builder.event_type();
+    if (!event_type.has_value()
+        || !query_catalog.is_unique_event_id_relevant_to_query(event_type.value())) {
+      return builder.call_predicate(*this);
+    }
+    Types::EventNameTypeId
+      event_name_type = query_catalog.event_name_id_from_unique_event_id(
+        event_type.value());
+    return builder.literal(event_name_type == event_name_type_id);
+  }
+
   std::string to_string() const override {
     std::string out = "IS ";
     for (auto id : admissible_event_types) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <cwchar>
 #include <memory>
 #include <tracy/Tracy.hpp>
@@ -52,6 +53,12 @@ class CompareMathExprs : public PhysicalPredicate {
       assert(false && "Operator() not implemented for some ComparisonType");
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    uint32_t left_register = left->compile(builder);
+    uint32_t right_register = right->compile(builder);
+    return builder.compare<ValueType>(Comp, left_register, right_register);
+  }
+
   std::string to_string() const override {
     if constexpr (Comp == ComparisonType::EQUALS)
       return left->to_string() + "==" + right->to_string();
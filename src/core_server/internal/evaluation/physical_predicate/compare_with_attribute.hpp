@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <cwchar>
 #include <tracy/Tracy.hpp>
+#include <type_traits>
 
 #include "cassert"
 #include "comparison_type.hpp"
@@ -59,6 +61,20 @@ class CompareWithAttribute : public PhysicalPredicate {
     }
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    if constexpr (!std::is_same_v<LeftValueType, RightValueType>
+                  && (std::is_same_v<LeftValueType, std::string_view>
+                      || std::is_same_v<RightValueType, std::string_view>)) {
+      return builder.literal(false);
+    } else {
+      // Same conversions as comparing the values directly.
+      using CommonType = std::common_type_t<LeftValueType, RightValueType>;
+      uint32_t first = builder.load_attribute<CommonType, LeftValueType>(first_pos);
+      uint32_t second = builder.load_attribute<CommonType, RightValueType>(second_pos);
+      return builder.compare<CommonType>(Comp, first, second);
+    }
+  }
+
   std::string to_string() const override {
     if constexpr (Comp == ComparisonType::EQUALS)
       return "Event[" + std::to_string(first_pos) + "] == Event["
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <tracy/Tracy.hpp>
 
 #include "cassert"
@@ -61,6 +62,11 @@ class CompareWithConstant : public PhysicalPredicate {
   template <typename T>
   inline static constexpr bool has_to_string_v = has_to_string<T>::value;
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    uint32_t attribute = builder.load_attribute<ValueType, ValueType>(pos_to_compare);
+    return builder.compare<ValueType>(Comp, attribute, builder.literal(constant_val));
+  }
+
   std::string to_string() const override {
     if constexpr (!has_to_string_v<ValueType>) {
       if constexpr (Comp == ComparisonType::EQUALS)
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 #include "comparison_type.hpp"
 #include "core_server/internal/evaluation/physical_predicate/math_expr/math_expr.hpp"
 #include "physical_predicate.hpp"
@@ -39,6 +43,20 @@ class InRangePredicate : public PhysicalPredicate {
            && (left->eval(tuple) <= upper_bound->eval(tuple));
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    uint32_t left_register = left->compile(builder);
+    return builder.all_of(2, [&](size_t i) {
+      if (i == 0) {
+        return builder.compare<ValueType>(ComparisonType::GREATER_EQUALS,
+                                          left_register,
+                                          lower_bound->compile(builder));
+      }
+      return builder.compare<ValueType>(ComparisonType::LESS_EQUALS,
+                                        left_register,
+                                        upper_bound->compile(builder));
+    });
+  }
+
   std::string to_string() const override {
     return left->to_string() + "IN RANGE (" + lower_bound->to_string()
            + upper_bound->to_string() + ")";
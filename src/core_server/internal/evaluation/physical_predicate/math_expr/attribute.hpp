@@ -1,5 +1,6 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <tracy/Tracy.hpp>
 
@@ -43,5 +44,14 @@ class Attribute : public MathExpr<GlobalType> {
   std::string to_string() const override {
     return "Attribute[" + std::to_string(pos) + "]";
   }
+
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    if constexpr (std::is_same_v<GlobalType, std::string_view>
+                  && !std::is_same_v<LocalType, std::string_view>) {
+      return builder.call_math_expr<GlobalType>(*this);
+    } else {
+      return builder.load_attribute<GlobalType, LocalType>(pos);
+    }
+  }
 };
 }  // namespace CORE::Internal::CEA
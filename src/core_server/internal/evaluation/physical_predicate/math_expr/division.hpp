@@ -1,5 +1,6 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 
@@ -33,5 +34,17 @@ class Division : public MathExpr<Type> {
   std::string to_string() const override {
     return "(" + left->to_string() + " / " + right->to_string() + ")";
   }
+
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    if constexpr (!std::is_arithmetic<Type>::value) {
+      return builder.call_math_expr<Type>(*this);
+    } else {
+      uint32_t left_register = left->compile(builder);
+      uint32_t right_register = right->compile(builder);
+      return builder.arithmetic<Type>(Evaluation::PredicateOpCode::DIVIDE,
+                                      left_register,
+                                      right_register);
+    }
+  }
 };
 }  // namespace CORE::Internal::CEA
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <tracy/Tracy.hpp>
 #include <type_traits>
@@ -43,5 +44,9 @@ class Literal : public MathExpr<Type> {
       return std::to_string(val);
     }
   }
+
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    return builder.literal<Type>(val);
+  }
 };
 }  // namespace CORE::Internal::CEA
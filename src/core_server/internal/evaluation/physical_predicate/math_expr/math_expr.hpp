@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "core_server/internal/evaluation/predicate_program/predicate_program_builder.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 
 namespace CORE::Internal::CEA {
@@ -14,5 +16,13 @@ class MathExpr {
   virtual ~MathExpr() = default;
   virtual Type eval(RingTupleQueue::Tuple&) = 0;
   virtual std::string to_string() const = 0;
+
+  /**
+   * Emits the instructions that compute eval(tuple) and returns the register
+   * with the result. By default the compiled program calls eval.
+   */
+  virtual uint32_t compile(Evaluation::PredicateProgramBuilder& builder) {
+    return builder.call_math_expr<Type>(*this);
+  }
 };
 }  // namespace CORE::Internal::CEA
@@ -5,11 +5,14 @@
 #include <cstdlib>
 #include <ctime>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_program_builder.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/value.hpp"
 #include "math_expr.hpp"
@@ -22,19 +25,23 @@ template <typename GlobalType>
 class NonStronglyTypedAttribute : public MathExpr<GlobalType> {
  public:
   std::string name;
-  QueryCatalog& query_catalog;
 
+ private:
+  // Indexed by UniqueEventTypeId, resolved once from the QueryCatalog.
+  std::vector<AttributeOffset> offsets;
+
+ public:
   // If Type == std::string_view, then the underlying string is stored, if not
   // a char is stored.
   typename std::conditional<std::is_same_v<GlobalType, std::string_view>,
                             std::string,
                             char>::type stored_string;
 
-  NonStronglyTypedAttribute(std::string name, QueryCatalog& query_catalog)
-      : name(name), query_catalog(query_catalog) {}
+  NonStronglyTypedAttribute(std::string name, const QueryCatalog& query_catalog)
+      : name(name), offsets(query_catalog.get_attribute_offsets(name)) {}
 
   std::unique_ptr<MathExpr<GlobalType>> clone() const override {
-    return std::make_unique<NonStronglyTypedAttribute<GlobalType>>(name, query_catalog);
+    return std::make_unique<NonStronglyTypedAttribute<GlobalType>>(*this);
   }
 
   ~NonStronglyTypedAttribute() override = default;
@@ -42,22 +49,21 @@ class NonStronglyTypedAttribute : public MathExpr<GlobalType> {
   GlobalType eval(RingTupleQueue::Tuple& tuple) override {
     // It must be determined at the predicate level whether this eval
     // makes sense for the tuple.
-    size_t pos = query_catalog.get_index_attribute(tuple.id(), name);
-    const Types::EventInfo& event_info = query_catalog.get_event_info(tuple.id());
-    assert(event_info.attribute_names_to_ids.contains(name));
-    Types::ValueTypes attribute_type = event_info.attributes_info[pos].value_type;
+    assert(tuple.id() < offsets.size() && offsets[tuple.id()].present);
+    const AttributeOffset& offset = offsets[tuple.id()];
+    uint64_t* position = tuple.at_offset(offset.word_offset);
 
-    switch (attribute_type) {
+    switch (offset.value_type) {
       case Types::ValueTypes::INT64:
-        return eval<int64_t>(tuple, pos);
+        return eval<int64_t>(position);
       case Types::ValueTypes::DOUBLE:
-        return eval<double>(tuple, pos);
+        return eval<double>(position);
       case Types::ValueTypes::BOOL:
-        return eval<bool>(tuple, pos);
+        return eval<bool>(position);
       case Types::ValueTypes::STRING_VIEW:
-        return eval<std::string_view>(tuple, pos);
+        return eval<std::string_view>(position);
       case Types::ValueTypes::DATE:
-        return eval<std::time_t>(tuple, pos);
+        return eval<std::time_t>(position);
       default:
         assert(false
                && "A value type was not implemented in NonStronglytypedAttribute eval");
@@ -67,8 +73,8 @@ class NonStronglyTypedAttribute : public MathExpr<GlobalType> {
   }
 
   template <typename LocalType>
-  GlobalType eval(RingTupleQueue::Tuple& tuple, size_t pos) {
-    RingTupleQueue::Value<LocalType> val(tuple[pos]);
+  GlobalType eval(uint64_t* position) {
+    RingTupleQueue::Value<LocalType> val(position);
     if constexpr (std::is_same_v<GlobalType, LocalType>) {
       return val.get();
     } else if constexpr (std::is_same_v<GlobalType, std::string_view>) {
@@ -83,6 +89,46 @@ class NonStronglyTypedAttribute : public MathExpr<GlobalType> {
     }
   }
 
+  /**
+   * A program of a single event type reads the attribute as an Attribute of
+   * that event type would, the others call eval.
+   */
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    std::optional<uint64_t> event_type = builder.event_type();
+    if (!event_type.has_value() || event_type.value() >= offsets.size()
+        || !offsets[event_type.value()].present) {
+      return builder.call_math_expr<GlobalType>(*this);
+    }
+    const AttributeOffset& offset = offsets[event_type.value()];
+    switch (offset.value_type) {
+      case Types::ValueTypes::INT64:
+        return compile<int64_t>(builder, offset.index);
+      case Types::ValueTypes::DOUBLE:
+        return compile<double>(builder, offset.index);
+      case Types::ValueTypes::BOOL:
+        return compile<bool>(builder, offset.index);
+      case Types::ValueTypes::STRING_VIEW:
+        return compile<std::string_view>(builder, offset.index);
+      case Types::ValueTypes::DATE:
+        return compile<std::time_t>(builder, offset.index);
+      default:
+        return builder.call_math_expr<GlobalType>(*this);
+    }
+  }
+
   std::string to_string() const override { return name; }
+
+ private:
+  template <typename LocalType>
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder, uint64_t index) {
+    if constexpr (std::is_same_v<GlobalType, LocalType>
+                  || (!std::is_same_v<GlobalType, std::string_view>
+                      && !std::is_same_v<LocalType, std::string_view>)) {
+      return builder.load_attribute<GlobalType, LocalType>(index);
+    } else {
+      // Conversions from and to strings are left to eval.
+      return builder.call_math_expr<GlobalType>(*this);
+    }
+  }
 };
 }  // namespace CORE::Internal::CEA
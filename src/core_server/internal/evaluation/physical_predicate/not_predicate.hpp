@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 
 #include "cassert"
@@ -28,6 +29,10 @@ class NotPredicate : public PhysicalPredicate {
 
   bool eval(RingTupleQueue::Tuple& tuple) override { return !predicate->eval(tuple); }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    return builder.negate(predicate->compile(builder));
+  }
+
   std::string to_string() const override { return "NOT " + predicate->to_string(); }
 };
 }  // namespace CORE::Internal::CEA
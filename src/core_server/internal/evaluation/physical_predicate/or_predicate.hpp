@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include "cassert"
@@ -37,6 +39,15 @@ class OrPredicate : public PhysicalPredicate {
     return false;
   }
 
+  uint32_t compile(Evaluation::PredicateProgramBuilder& builder) override {
+    return builder.any_of(predicates.size(), [&](size_t i) {
+      PhysicalPredicate& predicate = *predicates[i];
+      return builder.checking_event_type(predicate.admits_any_event_type,
+                                         predicate.admissible_event_types,
+                                         [&]() { return predicate.compile(builder); });
+    });
+  }
+
   std::string to_string() const override {
     std::string out = predicates[0]->to_string();
     for (int i = 1; i < predicates.size(); i++) {
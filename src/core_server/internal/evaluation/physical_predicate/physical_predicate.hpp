@@ -4,6 +4,7 @@
 #include <set>
 #include <string>
 
+#include "core_server/internal/evaluation/predicate_program/predicate_program_builder.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "shared/datatypes/aliases/event_type_id.hpp"
 
@@ -35,6 +36,14 @@ class PhysicalPredicate {
 
   virtual bool eval(RingTupleQueue::Tuple& tuple) = 0;
 
+  /**
+   * Emits the instructions that compute eval(tuple) and returns the boolean
+   * register with the result. By default the compiled program calls eval.
+   */
+  virtual uint32_t compile(Evaluation::PredicateProgramBuilder& builder) {
+    return builder.call_predicate(*this);
+  }
+
   std::string complete_info_string() const {
     std::string out = "admits any event type: " + std::to_string(admits_any_event_type)
                       + "\n" + " admissible event types:";
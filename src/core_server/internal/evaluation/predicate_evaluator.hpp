@@ -1,37 +1,130 @@
 #pragma once
 
-#include <gmpxx.h>
-
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tracy/Tracy.hpp>
 #include <utility>
 #include <vector>
 
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 #include "core_server/internal/evaluation/physical_predicate/physical_predicate.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_program.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "shared/datatypes/aliases/event_type_id.hpp"
 
 namespace CORE::Internal::Evaluation {
 
+/**
+ * Evaluates every physical predicate of a query on a tuple. The predicates
+ * are dispatched by the event type of the tuple: the first tuple of each
+ * event type compiles a PredicateProgram with only the predicates that
+ * admit it, the others are false. The program reads the attributes at the
+ * word offsets of the schema of the event type. If none of those predicates
+ * reads the tuple (no predicates, event name or stream checks) the result is
+ * constant and is cached instead. The copies of an evaluator share the predicates
+ * but have their own programs.
+ *
+ * When the query shares predicates with the other queries (see
+ * SharedPredicateEvaluator), their results are read from the shared results
+ * of the tuple, and the evaluator only evaluates the rest with a program
+ * compiled for each mapping of the shared results.
+ */
 struct PredicateEvaluator {
   std::vector<std::shared_ptr<CEA::PhysicalPredicate>> predicates;
 
+ private:
+  struct CompiledPredicates {
+    // Empty if the result does not depend on the tuple.
+    std::optional<PredicateProgram> program;
+    Bitset::SmallBitset constant_result;
+
+    Bitset::SmallBitset operator()(RingTupleQueue::Tuple& tuple) {
+      if (program.has_value()) {
+        return program.value()(tuple);
+      }
+      return constant_result;
+    }
+  };
+
+  struct EventTypeDispatch {
+    bool compiled = false;
+    CompiledPredicates all_predicates;
+    // The predicates that are not shared in the mapping of this version.
+    uint64_t shared_mapping_version = 0;
+    CompiledPredicates unshared_predicates;
+  };
+
+  // Indexed by UniqueEventTypeId, grows with the event types that are seen.
+  std::vector<EventTypeDispatch> dispatch_table;
+  // Shared by the copies of the evaluator, they are used by the same thread.
+  std::shared_ptr<const SharedPredicateView> shared_view;
+
+ public:
   PredicateEvaluator(
-    std::vector<std::unique_ptr<CEA::PhysicalPredicate>>&& unique_predicates) {
-    predicates.reserve(unique_predicates.size());
-    for (auto& unique_pred : unique_predicates) {
-      predicates.push_back(std::move(unique_pred));
+    std::vector<std::unique_ptr<CEA::PhysicalPredicate>>&& unique_predicates)
+      : predicates(to_shared(std::move(unique_predicates))) {}
+
+  PredicateEvaluator(std::vector<std::shared_ptr<CEA::PhysicalPredicate>> predicates)
+      : predicates(std::move(predicates)) {}
+
+  Bitset::SmallBitset operator()(RingTupleQueue::Tuple& tuple) {
+    ZoneScopedN("PredicateEvaluator::operator()");
+    Types::UniqueEventTypeId event_type = tuple.id();
+    if (event_type >= dispatch_table.size()) {
+      dispatch_table.resize(event_type + 1);
     }
+    EventTypeDispatch& dispatch = dispatch_table[event_type];
+    const SharedPredicateMapping* shared_mapping = shared_view != nullptr
+                                                     ? shared_view->mapping()
+                                                     : nullptr;
+    if (shared_mapping == nullptr) {
+      if (!dispatch.compiled) {
+        dispatch.all_predicates = compile(event_type, tuple.get_relative_positions());
+        dispatch.compiled = true;
+      }
+      return dispatch.all_predicates(tuple);
+    }
+    if (dispatch.shared_mapping_version != shared_mapping->version) {
+      dispatch.unshared_predicates = compile(event_type,
+                                             tuple.get_relative_positions(),
+                                             shared_view->shared_query_bits());
+      dispatch.shared_mapping_version = shared_mapping->version;
+    }
+    Bitset::SmallBitset out = dispatch.unshared_predicates(tuple);
+    shared_view->read(out);
+    return out;
   }
 
-  mpz_class operator()(RingTupleQueue::Tuple& tuple) {
-    ZoneScopedN("PredicateEvaluator::operator()");
-    mpz_class out = 0;
-    mpz_class one = 1;
+  void use_shared_results(std::shared_ptr<const SharedPredicateView> view) {
+    shared_view = std::move(view);
+  }
+
+  // Null if the evaluator does not use shared results.
+  const SharedPredicateView* get_shared_view() const { return shared_view.get(); }
+
+  /**
+   * @return Whether the result of event_type is cached instead of evaluated,
+   *         known after the first tuple of the event type that is not shared.
+   */
+  bool has_constant_result(Types::UniqueEventTypeId event_type) const {
+    return event_type < dispatch_table.size() && dispatch_table[event_type].compiled
+           && !dispatch_table[event_type].all_predicates.program.has_value();
+  }
+
+  /**
+   * Evaluates the predicates one by one with their virtual calls, the same
+   * result as operator(). Kept as the reference of the compiled program.
+   */
+  Bitset::SmallBitset eval_with_virtual_calls(RingTupleQueue::Tuple& tuple) {
+    ZoneScopedN("PredicateEvaluator::eval_with_virtual_calls");
+    Bitset::SmallBitset out;
     for (size_t i = 0; i < predicates.size(); i++) {
       if ((*predicates[i])(tuple)) {
-        out |= one << i;
+        out.set(i);
       }
     }
     return out;
@@ -44,6 +137,31 @@ struct PredicateEvaluator {
     }
     return out;
   }
+
+ private:
+  CompiledPredicates compile(Types::UniqueEventTypeId event_type,
+                             const std::vector<uint64_t>& word_offsets,
+                             const Bitset::SmallBitset& excluded = {}) {
+    CompiledPredicates out;
+    PredicateProgram program(predicates, event_type, word_offsets, excluded);
+    std::optional<Bitset::SmallBitset> constant_result = program.constant_result();
+    if (constant_result.has_value()) {
+      out.constant_result = constant_result.value();
+    } else {
+      out.program = std::move(program);
+    }
+    return out;
+  }
+
+  static std::vector<std::shared_ptr<CEA::PhysicalPredicate>>
+  to_shared(std::vector<std::unique_ptr<CEA::PhysicalPredicate>>&& unique_predicates) {
+    std::vector<std::shared_ptr<CEA::PhysicalPredicate>> out;
+    out.reserve(unique_predicates.size());
+    for (auto& unique_pred : unique_predicates) {
+      out.push_back(std::move(unique_pred));
+    }
+    return out;
+  }
 };
 
 }  // namespace CORE::Internal::Evaluation
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+#include <type_traits>
+
+namespace CORE::Internal::Evaluation {
+
+/**
+ * Register banks of a PredicateProgram. Dates are stored as integers, they
+ * are compared and operated exactly as the 64 bit integers they are.
+ */
+enum struct PredicateValueType : uint8_t {
+  INT64,
+  DOUBLE,
+  STRING,
+  BOOL,
+};
+
+static_assert(std::is_integral_v<std::time_t> && sizeof(std::time_t) == sizeof(int64_t),
+              "Dates are stored in the INT64 registers of a PredicateProgram.");
+
+template <typename T>
+constexpr PredicateValueType predicate_value_type() {
+  if constexpr (std::is_same_v<T, double>) {
+    return PredicateValueType::DOUBLE;
+  } else if constexpr (std::is_same_v<T, std::string_view>) {
+    return PredicateValueType::STRING;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return PredicateValueType::BOOL;
+  } else {
+    static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, std::time_t>,
+                  "Type not supported by PredicateProgram registers.");
+    return PredicateValueType::INT64;
+  }
+}
+
+enum struct PredicateOpCode : uint8_t {
+  // dest = tuple[left], read as source_type and converted to type.
+  LOAD,
+  // Like LOAD, where left is the word offset of the attribute in the tuple.
+  LOAD_AT_OFFSET,
+  // dest = left op right, on registers of type.
+  ADD,
+  SUBTRACT,
+  MULTIPLY,
+  DIVIDE,
+  MODULO,
+  // booleans[dest] = left comparison right, on registers of type.
+  COMPARE,
+  // booleans[dest] = !booleans[left].
+  NOT,
+  // booleans[dest] = booleans[left] op booleans[right].
+  AND,
+  OR,
+  // booleans[dest] = booleans[left].
+  COPY,
+  // booleans[dest] = the event type of the tuple is in event_type_sets[left].
+  CHECK_EVENT_TYPE,
+  // Continues at instruction target if booleans[left] == (right != 0).
+  JUMP_IF,
+  // booleans[dest] = predicate->eval(tuple), for predicates with no compilation.
+  CALL_PREDICATE,
+  // dest = math_expr->eval(tuple), for math exprs with no compilation.
+  CALL_MATH_EXPR,
+  // Sets bit right of the result if booleans[left].
+  STORE_RESULT,
+};
+
+/**
+ * A single instruction of a PredicateProgram, the meaning of each field
+ * depends on the op code (see PredicateOpCode). Registers are indices in the
+ * bank of the instruction type, except for boolean operands.
+ */
+struct PredicateInstruction {
+  PredicateOpCode op;
+  PredicateValueType type = PredicateValueType::BOOL;
+  // Type read by the loads, or the CEA::ComparisonType of COMPARE.
+  uint8_t aux = 0;
+  uint32_t left = 0;
+  uint32_t right = 0;
+  uint32_t dest = 0;
+  // Jump target, or the PhysicalPredicate/MathExpr that is called.
+  union {
+    uint64_t target = 0;
+    void* callee;
+  };
+};
+}  // namespace CORE::Internal::Evaluation
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <tracy/Tracy.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+#include "core_server/internal/evaluation/physical_predicate/comparison_type.hpp"
+#include "core_server/internal/evaluation/physical_predicate/math_expr/math_expr.hpp"
+#include "core_server/internal/evaluation/physical_predicate/physical_predicate.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/value.hpp"
+#include "predicate_instruction.hpp"
+#include "predicate_program_builder.hpp"
+#include "shared/datatypes/aliases/event_type_id.hpp"
+
+namespace CORE::Internal::Evaluation {
+
+/**
+ * The physical predicates of a query compiled to a flat array of
+ * instructions (see PredicateProgramBuilder), evaluated with no virtual
+ * calls except for the predicates and MathExprs that have no compilation
+ * (regular expressions, weakly typed attributes, catalog checks).
+ *
+ * Predicates that admit the same event types are evaluated together after
+ * a single event type check, so the values they have in common are shared.
+ * The program keeps its registers, so it must not be shared by threads.
+ *
+ * A program of a single event type only contains the predicates that admit
+ * it and has no event type checks, the other predicates are false.
+ */
+class PredicateProgram {
+  PredicateCode code;
+
+ public:
+  explicit PredicateProgram(
+    const std::vector<std::shared_ptr<CEA::PhysicalPredicate>>& predicates) {
+    struct Group {
+      bool admits_any_event_type;
+      std::set<uint64_t> event_types;
+      std::vector<size_t> predicates;
+    };
+
+    std::vector<Group> groups;
+    for (size_t i = 0; i < predicates.size(); i++) {
+      const CEA::PhysicalPredicate& predicate = *predicates[i];
+      auto group = std::find_if(groups.begin(), groups.end(), [&](const Group& group) {
+        return group.admits_any_event_type == predicate.admits_any_event_type
+               && group.event_types == predicate.admissible_event_types;
+      });
+      if (group == groups.end()) {
+        groups.push_back(
+          {predicate.admits_any_event_type, predicate.admissible_event_types, {}});
+        group = groups.end() - 1;
+      }
+      group->predicates.push_back(i);
+    }
+
+    PredicateProgramBuilder builder;
+    for (const Group& group : groups) {
+      builder.for_event_types(group.admits_any_event_type, group.event_types, [&]() {
+        for (size_t i : group.predicates) {
+          builder.store_result(predicates[i]->compile(builder), i);
+        }
+      });
+    }
+    code = std::move(builder).build();
+  }
+
+  /**
+   * The program of the tuples of event_type. If the word offsets of its
+   * attributes are given, they are read with no schema lookups. The
+   * predicates in excluded are not evaluated, their bits are always unset.
+   */
+  PredicateProgram(const std::vector<std::shared_ptr<CEA::PhysicalPredicate>>& predicates,
+                   Types::UniqueEventTypeId event_type,
+                   std::vector<uint64_t> word_offsets = {},
+                   const Bitset::SmallBitset& excluded = {}) {
+    PredicateProgramBuilder builder(event_type, std::move(word_offsets));
+    for (size_t i = 0; i < predicates.size(); i++) {
+      CEA::PhysicalPredicate& predicate = *predicates[i];
+      if (excluded.test(i)) {
+        continue;
+      }
+      if (predicate.admits_any_event_type
+          || predicate.admissible_event_types.contains(event_type)) {
+        builder.store_result(predicate.compile(builder), i);
+      }
+    }
+    code = std::move(builder).build();
+  }
+
+  // Code emitted by a PredicateProgramBuilder that stores the results itself.
+  explicit PredicateProgram(PredicateCode&& code) : code(std::move(code)) {}
+
+  Bitset::SmallBitset operator()(RingTupleQueue::Tuple& tuple) {
+    ZoneScopedN("PredicateProgram::operator()");
+    Bitset::SmallBitset out;
+    const PredicateInstruction* instructions = code.instructions.data();
+    size_t amount_of_instructions = code.instructions.size();
+    for (size_t pc = 0; pc < amount_of_instructions; pc++) {
+      const PredicateInstruction& instruction = instructions[pc];
+      switch (instruction.op) {
+        case PredicateOpCode::LOAD:
+          load(instruction, tuple[instruction.left]);
+          break;
+        case PredicateOpCode::LOAD_AT_OFFSET:
+          load(instruction, tuple.at_offset(instruction.left));
+          break;
+        case PredicateOpCode::ADD:
+        case PredicateOpCode::SUBTRACT:
+        case PredicateOpCode::MULTIPLY:
+        case PredicateOpCode::DIVIDE:
+        case PredicateOpCode::MODULO:
+          arithmetic(instruction);
+          break;
+        case PredicateOpCode::COMPARE:
+          code.booleans[instruction.dest] = compare(instruction);
+          break;
+        case PredicateOpCode::NOT:
+          code.booleans[instruction.dest] = !code.booleans[instruction.left];
+          break;
+        case PredicateOpCode::AND:
+          code.booleans[instruction.dest] = code.booleans[instruction.left]
+                                            & code.booleans[instruction.right];
+          break;
+        case PredicateOpCode::OR:
+          code.booleans[instruction.dest] = code.booleans[instruction.left]
+                                            | code.booleans[instruction.right];
+          break;
+        case PredicateOpCode::COPY:
+          code.booleans[instruction.dest] = code.booleans[instruction.left];
+          break;
+        case PredicateOpCode::CHECK_EVENT_TYPE: {
+          const std::vector<uint64_t>& event_types = code.event_type_sets
+                                                       [instruction.left];
+          code.booleans[instruction.dest] = std::find(event_types.begin(),
+                                                      event_types.end(),
+                                                      tuple.id())
+                                            != event_types.end();
+          break;
+        }
+        case PredicateOpCode::JUMP_IF:
+          if (static_cast<bool>(code.booleans[instruction.left])
+              == (instruction.right != 0)) {
+            // Jumps only go forward, so target > pc.
+            pc = instruction.target - 1;
+          }
+          break;
+        case PredicateOpCode::CALL_PREDICATE:
+          code.booleans[instruction.dest] = static_cast<CEA::PhysicalPredicate*>(
+                                              instruction.callee)
+                                              ->eval(tuple);
+          break;
+        case PredicateOpCode::CALL_MATH_EXPR:
+          call_math_expr(instruction, tuple);
+          break;
+        case PredicateOpCode::STORE_RESULT:
+          if (code.booleans[instruction.left]) {
+            out.set(instruction.right);
+          }
+          break;
+        default:
+          assert(false && "Unknown PredicateOpCode in PredicateProgram.");
+          break;
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @return The result of every tuple if the program does not read them,
+   *         that is, if every result is known while building.
+   */
+  std::optional<Bitset::SmallBitset> constant_result() const {
+    Bitset::SmallBitset out;
+    for (const PredicateInstruction& instruction : code.instructions) {
+      if (instruction.op != PredicateOpCode::STORE_RESULT) return {};
+      if (code.booleans[instruction.left]) {
+        out.set(instruction.right);
+      }
+    }
+    return out;
+  }
+
+  size_t amount_of_instructions() const { return code.instructions.size(); }
+
+  size_t amount_of_instructions(PredicateOpCode op) const {
+    return std::count_if(code.instructions.begin(),
+                         code.instructions.end(),
+                         [op](const PredicateInstruction& instruction) {
+                           return instruction.op == op;
+                         });
+  }
+
+ private:
+  template <typename T>
+  static T read_number(PredicateValueType type, uint64_t* position) {
+    switch (type) {
+      case PredicateValueType::INT64:
+        return static_cast<T>(RingTupleQueue::Value<int64_t>(position).get());
+      case PredicateValueType::DOUBLE:
+        return static_cast<T>(RingTupleQueue::Value<double>(position).get());
+      case PredicateValueType::BOOL:
+        return static_cast<T>(RingTupleQueue::Value<bool>(position).get());
+      default:
+        assert(false && "A string attribute can not be read as a number.");
+        return {};
+    }
+  }
+
+  void load(const PredicateInstruction& instruction, uint64_t* position) {
+    auto source_type = static_cast<PredicateValueType>(instruction.aux);
+    switch (instruction.type) {
+      case PredicateValueType::INT64:
+        code.integers[instruction.dest] = read_number<int64_t>(source_type, position);
+        break;
+      case PredicateValueType::DOUBLE:
+        code.doubles[instruction.dest] = read_number<double>(source_type, position);
+        break;
+      case PredicateValueType::STRING:
+        code.strings[instruction.dest] = RingTupleQueue::Value<std::string_view>(position)
+                                           .get();
+        break;
+      default:
+        assert(false && "Booleans are not loaded by a PredicateProgram.");
+        break;
+    }
+  }
+
+  template <typename T>
+  static T apply(PredicateOpCode op, T left, T right) {
+    switch (op) {
+      case PredicateOpCode::ADD:
+        return left + right;
+      case PredicateOpCode::SUBTRACT:
+        return left - right;
+      case PredicateOpCode::MULTIPLY:
+        return left * right;
+      case PredicateOpCode::DIVIDE:
+        return left / right;
+      case PredicateOpCode::MODULO:
+        if constexpr (std::is_integral_v<T>) {
+          return left % right;
+        } else {
+          throw std::runtime_error("Cannot eval a modulo on double types");
+        }
+      default:
+        assert(false && "Not an arithmetic PredicateOpCode.");
+        return {};
+    }
+  }
+
+  void arithmetic(const PredicateInstruction& instruction) {
+    if (instruction.type == PredicateValueType::INT64) {
+      code.integers[instruction.dest] = apply(instruction.op,
+                                              code.integers[instruction.left],
+                                              code.integers[instruction.right]);
+    } else {
+      assert(instruction.type == PredicateValueType::DOUBLE);
+      code.doubles[instruction.dest] = apply(instruction.op,
+                                             code.doubles[instruction.left],
+                                             code.doubles[instruction.right]);
+    }
+  }
+
+  template <typename T>
+  static bool compare(uint8_t comparison, const T& left, const T& right) {
+    switch (comparison) {
+      case CEA::ComparisonType::EQUALS:
+        return left == right;
+      case CEA::ComparisonType::GREATER:
+        return left > right;
+      case CEA::ComparisonType::GREATER_EQUALS:
+        return left >= right;
+      case CEA::ComparisonType::LESS_EQUALS:
+        return left <= right;
+      case CEA::ComparisonType::LESS:
+        return left < right;
+      case CEA::ComparisonType::NOT_EQUALS:
+        return left != right;
+      default:
+        assert(false && "Unknown ComparisonType in PredicateProgram.");
+        return false;
+    }
+  }
+
+  bool compare(const PredicateInstruction& instruction) {
+    switch (instruction.type) {
+      case PredicateValueType::INT64:
+        return compare(instruction.aux,
+                       code.integers[instruction.left],
+                       code.integers[instruction.right]);
+      case PredicateValueType::DOUBLE:
+        return compare(instruction.aux,
+                       code.doubles[instruction.left],
+                       code.doubles[instruction.right]);
+      case PredicateValueType::STRING:
+        return compare(instruction.aux,
+                       code.strings[instruction.left],
+                       code.strings[instruction.right]);
+      default:
+        assert(false && "Booleans are not compared by a PredicateProgram.");
+        return false;
+    }
+  }
+
+  template <typename T>
+  T call(const PredicateInstruction& instruction, RingTupleQueue::Tuple& tuple) {
+    return static_cast<CEA::MathExpr<T>*>(instruction.callee)->eval(tuple);
+  }
+
+  void call_math_expr(const PredicateInstruction& instruction,
+                      RingTupleQueue::Tuple& tuple) {
+    switch (instruction.type) {
+      case PredicateValueType::INT64:
+        if (instruction.aux) {
+          code.integers[instruction.dest] = call<std::time_t>(instruction, tuple);
+        } else {
+          code.integers[instruction.dest] = call<int64_t>(instruction, tuple);
+        }
+        break;
+      case PredicateValueType::DOUBLE:
+        code.doubles[instruction.dest] = call<double>(instruction, tuple);
+        break;
+      case PredicateValueType::STRING:
+        code.strings[instruction.dest] = call<std::string_view>(instruction, tuple);
+        break;
+      default:
+        assert(false && "MathExprs do not return booleans.");
+        break;
+    }
+  }
+};
+}  // namespace CORE::Internal::Evaluation
@@ -0,0 +1,488 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/physical_predicate/comparison_type.hpp"
+#include "predicate_instruction.hpp"
+
+namespace CORE::Internal::CEA {
+class PhysicalPredicate;
+
+template <typename Type>
+class MathExpr;
+}  // namespace CORE::Internal::CEA
+
+namespace CORE::Internal::Evaluation {
+
+/**
+ * Instructions and initial registers of a PredicateProgram. Literals are
+ * preloaded in their registers, so they cost nothing per tuple.
+ */
+struct PredicateCode {
+  std::vector<PredicateInstruction> instructions;
+  std::vector<std::vector<uint64_t>> event_type_sets;
+  std::vector<int64_t> integers;
+  std::vector<double> doubles;
+  std::vector<std::string_view> strings;
+  std::vector<char> booleans;
+};
+
+/**
+ * Flattens physical predicates and their MathExprs into a PredicateCode.
+ * Physical predicates and MathExprs emit their own instructions through
+ * their compile methods, which call the methods of this builder.
+ *
+ * Every value is numbered: emitting an instruction that was already emitted
+ * with the same operands returns the register of the first one, so common
+ * subexpressions (an attribute read by several filters, price * volume, a
+ * repeated filter, ...) are computed once per tuple. A value is only reused
+ * while it is known to be computed, that is, values computed inside a
+ * short-circuited branch are forgotten when the branch ends.
+ *
+ * A builder for a single event type compiles the programs of
+ * PredicateEvaluator: its event type checks are resolved while building.
+ */
+class PredicateProgramBuilder {
+  using ValueKey = std::
+    tuple<PredicateOpCode, PredicateValueType, uint8_t, uint32_t, uint32_t, uint64_t>;
+
+  PredicateCode code;
+  std::map<ValueKey, uint32_t> values;
+  std::vector<ValueKey> values_log;
+  // Size of values_log when each open branch started.
+  std::vector<size_t> branches;
+  // Event types that reach each open event type check.
+  std::vector<std::set<uint64_t>> event_type_guards;
+  std::map<std::pair<PredicateValueType, uint64_t>, uint32_t> numeric_literals;
+  std::map<std::string_view, uint32_t> string_literals;
+  std::optional<uint64_t> single_event_type;
+  // Word offsets of the attributes of single_event_type, if they are known.
+  std::vector<uint64_t> word_offsets;
+
+ public:
+  PredicateProgramBuilder() = default;
+
+  /**
+   * Builds a program that is only evaluated on tuples of event_type.
+   */
+  explicit PredicateProgramBuilder(uint64_t event_type)
+      : event_type_guards({{event_type}}), single_event_type(event_type) {}
+
+  /**
+   * Like the builder of event_type, its attributes are read directly at
+   * their word offsets (see RingTupleQueue::Tuple::get_relative_positions).
+   */
+  PredicateProgramBuilder(uint64_t event_type, std::vector<uint64_t> word_offsets)
+      : event_type_guards({{event_type}}),
+        single_event_type(event_type),
+        word_offsets(std::move(word_offsets)) {}
+
+  /**
+   * @return The event type of every evaluated tuple, if there is a single one.
+   */
+  std::optional<uint64_t> event_type() const { return single_event_type; }
+
+  /**
+   * @return A register of type Global with the attribute at pos of the tuple.
+   */
+  template <typename Global, typename Local>
+  uint32_t load_attribute(size_t pos) {
+    static_assert(!std::is_same_v<Global, std::string_view>
+                    || std::is_same_v<Local, std::string_view>,
+                  "Numbers are not converted to strings by a PredicateProgram.");
+    PredicateInstruction instruction{PredicateOpCode::LOAD};
+    instruction.type = predicate_value_type<Global>();
+    instruction.aux = static_cast<uint8_t>(predicate_value_type<Local>());
+    instruction.left = static_cast<uint32_t>(pos);
+    if (!word_offsets.empty()) {
+      assert(pos < word_offsets.size());
+      instruction.op = PredicateOpCode::LOAD_AT_OFFSET;
+      instruction.left = static_cast<uint32_t>(word_offsets[pos]);
+    }
+    return value_of(instruction, instruction.type);
+  }
+
+  template <typename T>
+  uint32_t literal(T value) {
+    constexpr PredicateValueType type = predicate_value_type<T>();
+    if constexpr (type == PredicateValueType::STRING) {
+      if (auto it = string_literals.find(value); it != string_literals.end()) {
+        return it->second;
+      }
+      uint32_t reg = new_register(type);
+      code.strings[reg] = value;
+      string_literals.emplace(value, reg);
+      return reg;
+    } else {
+      uint64_t bits;
+      if constexpr (type == PredicateValueType::DOUBLE) {
+        bits = std::bit_cast<uint64_t>(value);
+      } else {
+        bits = static_cast<uint64_t>(value);
+      }
+      if (auto it = numeric_literals.find({type, bits}); it != numeric_literals.end()) {
+        return it->second;
+      }
+      uint32_t reg = new_register(type);
+      if constexpr (type == PredicateValueType::DOUBLE) {
+        code.doubles[reg] = value;
+      } else if constexpr (type == PredicateValueType::BOOL) {
+        code.booleans[reg] = value;
+      } else {
+        code.integers[reg] = static_cast<int64_t>(value);
+      }
+      numeric_literals.emplace(std::make_pair(type, bits), reg);
+      return reg;
+    }
+  }
+
+  /**
+   * @param op One of ADD, SUBTRACT, MULTIPLY, DIVIDE and MODULO.
+   */
+  template <typename T>
+  uint32_t arithmetic(PredicateOpCode op, uint32_t left, uint32_t right) {
+    static_assert(std::is_arithmetic_v<T>);
+    assert(op >= PredicateOpCode::ADD && op <= PredicateOpCode::MODULO);
+    assert(!(std::is_floating_point_v<T> && op == PredicateOpCode::MODULO));
+    PredicateInstruction instruction{op};
+    instruction.type = predicate_value_type<T>();
+    instruction.left = left;
+    instruction.right = right;
+    return value_of(instruction, instruction.type);
+  }
+
+  /**
+   * @return The boolean register with left comparison right.
+   */
+  template <typename T>
+  uint32_t compare(CEA::ComparisonType comparison, uint32_t left, uint32_t right) {
+    PredicateInstruction instruction{PredicateOpCode::COMPARE};
+    instruction.type = predicate_value_type<T>();
+    instruction.aux = static_cast<uint8_t>(comparison);
+    instruction.left = left;
+    instruction.right = right;
+    return value_of(instruction, PredicateValueType::BOOL);
+  }
+
+  uint32_t negate(uint32_t boolean) {
+    PredicateInstruction instruction{PredicateOpCode::NOT};
+    instruction.left = boolean;
+    return value_of(instruction, PredicateValueType::BOOL);
+  }
+
+  uint32_t call_predicate(CEA::PhysicalPredicate& predicate) {
+    PredicateInstruction instruction{PredicateOpCode::CALL_PREDICATE};
+    instruction.dest = new_register(PredicateValueType::BOOL);
+    instruction.callee = &predicate;
+    code.instructions.push_back(instruction);
+    return instruction.dest;
+  }
+
+  template <typename T>
+  uint32_t call_math_expr(CEA::MathExpr<T>& math_expr) {
+    PredicateInstruction instruction{PredicateOpCode::CALL_MATH_EXPR};
+    instruction.type = predicate_value_type<T>();
+    // Dates might not be the same C++ type as int64_t.
+    instruction.aux = std::is_same_v<T, std::time_t> && !std::is_same_v<T, int64_t>;
+    instruction.dest = new_register(instruction.type);
+    instruction.callee = &math_expr;
+    code.instructions.push_back(instruction);
+    return instruction.dest;
+  }
+
+  /**
+   * Short-circuited conjunction, operand(i) emits the i-th operand and
+   * returns its boolean register.
+   */
+  template <typename Operand>
+  uint32_t all_of(size_t amount, Operand&& operand) {
+    return short_circuit(false, amount, std::forward<Operand>(operand));
+  }
+
+  /**
+   * Short-circuited disjunction, see all_of.
+   */
+  template <typename Operand>
+  uint32_t any_of(size_t amount, Operand&& operand) {
+    return short_circuit(true, amount, std::forward<Operand>(operand));
+  }
+
+  /**
+   * Emits the same check as PhysicalPredicate::operator(): the instructions
+   * of compile_predicate only run for admitted event types.
+   * @return The boolean register that is true if the event type is admitted
+   *         and the predicate holds.
+   */
+  template <typename CompilePredicate>
+  uint32_t checking_event_type(bool admits_any_event_type,
+                               const std::set<uint64_t>& event_types,
+                               CompilePredicate&& compile_predicate) {
+    if (is_admitted(admits_any_event_type, event_types)) {
+      return compile_predicate();
+    }
+    if (is_excluded(admits_any_event_type, event_types)) {
+      return literal(false);
+    }
+    uint32_t out = check_event_type(event_types);
+    size_t jump = jump_if(out, false);
+    event_type_guards.push_back(narrow_guard(event_types));
+    copy(out, compile_predicate());
+    event_type_guards.pop_back();
+    land({jump});
+    return out;
+  }
+
+  /**
+   * Like checking_event_type, for code that does not produce a value.
+   */
+  template <typename Compile>
+  void for_event_types(bool admits_any_event_type,
+                       const std::set<uint64_t>& event_types,
+                       Compile&& compile) {
+    if (is_admitted(admits_any_event_type, event_types)) {
+      compile();
+      return;
+    }
+    if (is_excluded(admits_any_event_type, event_types)) {
+      return;
+    }
+    size_t jump = jump_if(check_event_type(event_types), false);
+    event_type_guards.push_back(narrow_guard(event_types));
+    compile();
+    event_type_guards.pop_back();
+    land({jump});
+  }
+
+  void store_result(uint32_t boolean, size_t bit) {
+    PredicateInstruction instruction{PredicateOpCode::STORE_RESULT};
+    instruction.left = boolean;
+    instruction.right = static_cast<uint32_t>(bit);
+    code.instructions.push_back(instruction);
+  }
+
+  PredicateCode build() && {
+    assert(branches.empty() && "Every branch must be landed before building.");
+    return std::move(code);
+  }
+
+ private:
+  uint32_t new_register(PredicateValueType type) {
+    switch (type) {
+      case PredicateValueType::INT64:
+        code.integers.push_back(0);
+        return static_cast<uint32_t>(code.integers.size() - 1);
+      case PredicateValueType::DOUBLE:
+        code.doubles.push_back(0);
+        return static_cast<uint32_t>(code.doubles.size() - 1);
+      case PredicateValueType::STRING:
+        code.strings.push_back({});
+        return static_cast<uint32_t>(code.strings.size() - 1);
+      case PredicateValueType::BOOL:
+        code.booleans.push_back(false);
+        return static_cast<uint32_t>(code.booleans.size() - 1);
+    }
+    assert(false && "Unknown PredicateValueType in new_register.");
+    return 0;
+  }
+
+  uint32_t value_of(PredicateInstruction instruction, PredicateValueType dest_type) {
+    ValueKey key{instruction.op,
+                 instruction.type,
+                 instruction.aux,
+                 instruction.left,
+                 instruction.right,
+                 instruction.target};
+    if (auto it = values.find(key); it != values.end()) {
+      return it->second;
+    }
+    instruction.dest = new_register(dest_type);
+    code.instructions.push_back(instruction);
+    values.emplace(key, instruction.dest);
+    values_log.push_back(key);
+    return instruction.dest;
+  }
+
+  void copy(uint32_t dest, uint32_t source) {
+    PredicateInstruction instruction{PredicateOpCode::COPY};
+    instruction.left = source;
+    instruction.dest = dest;
+    code.instructions.push_back(instruction);
+  }
+
+  uint32_t check_event_type(const std::set<uint64_t>& event_types) {
+    PredicateInstruction instruction{PredicateOpCode::CHECK_EVENT_TYPE};
+    instruction.left = static_cast<uint32_t>(code.event_type_sets.size());
+    instruction.dest = new_register(PredicateValueType::BOOL);
+    code.event_type_sets.emplace_back(event_types.begin(), event_types.end());
+    code.instructions.push_back(instruction);
+    return instruction.dest;
+  }
+
+  bool is_admitted(bool admits_any_event_type, const std::set<uint64_t>& event_types) {
+    if (admits_any_event_type) return true;
+    if (event_type_guards.empty()) return false;
+    const std::set<uint64_t>& guard = event_type_guards.back();
+    return std::includes(event_types.begin(),
+                         event_types.end(),
+                         guard.begin(),
+                         guard.end());
+  }
+
+  /**
+   * @return The event types that reach a check of event_types.
+   */
+  std::set<uint64_t> narrow_guard(const std::set<uint64_t>& event_types) const {
+    if (event_type_guards.empty()) return event_types;
+    std::set<uint64_t> out;
+    std::set_intersection(event_types.begin(),
+                          event_types.end(),
+                          event_type_guards.back().begin(),
+                          event_type_guards.back().end(),
+                          std::inserter(out, out.begin()));
+    return out;
+  }
+
+  bool is_excluded(bool admits_any_event_type, const std::set<uint64_t>& event_types) {
+    if (admits_any_event_type || event_type_guards.empty()) return false;
+    const std::set<uint64_t>& guard = event_type_guards.back();
+    return std::none_of(guard.begin(), guard.end(), [&](uint64_t event_type) {
+      return event_types.contains(event_type);
+    });
+  }
+
+  /**
+   * Emits a jump to a target that is set by land, the instructions emitted
+   * meanwhile are a branch that might not run.
+   */
+  size_t jump_if(uint32_t boolean, bool value) {
+    PredicateInstruction instruction{PredicateOpCode::JUMP_IF};
+    instruction.left = boolean;
+    instruction.right = value;
+    code.instructions.push_back(instruction);
+    branches.push_back(values_log.size());
+    return code.instructions.size() - 1;
+  }
+
+  void land(const std::vector<size_t>& jumps) {
+    for (size_t jump : jumps) {
+      code.instructions[jump].target = code.instructions.size();
+      assert(!branches.empty());
+      size_t log_size = branches.back();
+      branches.pop_back();
+      for (size_t i = log_size; i < values_log.size(); i++) {
+        values.erase(values_log[i]);
+      }
+      values_log.resize(log_size);
+    }
+  }
+
+  /**
+   * Operands that are cheap and can not fail (no calls, no integer
+   * divisions) are evaluated eagerly and combined with AND/OR, so their
+   * values stay known afterwards. The others are only evaluated if the
+   * result is still undecided: the jump over them is inserted in front of
+   * their instructions once they are emitted.
+   */
+  template <typename Operand>
+  uint32_t short_circuit(bool stop_value, size_t amount, Operand&& operand) {
+    if (amount == 0) {
+      return literal(!stop_value);
+    }
+    PredicateOpCode combine = stop_value ? PredicateOpCode::OR : PredicateOpCode::AND;
+    // Combination of the operands since the last jump.
+    uint32_t combined = operand(0);
+    std::optional<uint32_t> out;
+    std::vector<size_t> jumps;
+    for (size_t i = 1; i < amount; i++) {
+      size_t operand_start = code.instructions.size();
+      size_t operand_log_size = values_log.size();
+      uint32_t value = operand(i);
+      if (can_evaluate_eagerly(operand_start)) {
+        combined = logical(combine, combined, value);
+        continue;
+      }
+      if (!out.has_value()) {
+        out = new_register(PredicateValueType::BOOL);
+      }
+      jumps.push_back(insert_jump_if(
+        operand_start, operand_log_size, out.value(), combined, stop_value));
+      combined = value;
+    }
+    if (!out.has_value()) {
+      return combined;
+    }
+    copy(out.value(), combined);
+    land(jumps);
+    return out.value();
+  }
+
+  /**
+   * Like copying combined into boolean and calling jump_if before emitting
+   * the instructions from start, when values_log had log_size values.
+   * @return The position of the jump.
+   */
+  size_t insert_jump_if(size_t start,
+                        size_t log_size,
+                        uint32_t boolean,
+                        uint32_t combined,
+                        bool value) {
+    PredicateInstruction copy_instruction{PredicateOpCode::COPY};
+    copy_instruction.left = combined;
+    copy_instruction.dest = boolean;
+    PredicateInstruction jump_instruction{PredicateOpCode::JUMP_IF};
+    jump_instruction.left = boolean;
+    jump_instruction.right = value;
+    // The branches of the operand are already landed, so its jumps stay
+    // inside its instructions.
+    for (size_t i = start; i < code.instructions.size(); i++) {
+      if (code.instructions[i].op == PredicateOpCode::JUMP_IF) {
+        assert(code.instructions[i].target >= start);
+        code.instructions[i].target += 2;
+      }
+    }
+    code.instructions.insert(code.instructions.begin() + start,
+                             {copy_instruction, jump_instruction});
+    branches.push_back(log_size);
+    return start + 1;
+  }
+
+  uint32_t logical(PredicateOpCode op, uint32_t left, uint32_t right) {
+    PredicateInstruction instruction{op};
+    instruction.left = std::min(left, right);
+    instruction.right = std::max(left, right);
+    return value_of(instruction, PredicateValueType::BOOL);
+  }
+
+  bool can_evaluate_eagerly(size_t start) const {
+    for (size_t i = start; i < code.instructions.size(); i++) {
+      const PredicateInstruction& instruction = code.instructions[i];
+      switch (instruction.op) {
+        case PredicateOpCode::CALL_PREDICATE:
+        case PredicateOpCode::CALL_MATH_EXPR:
+          return false;
+        case PredicateOpCode::DIVIDE:
+        case PredicateOpCode::MODULO:
+          if (instruction.type == PredicateValueType::INT64) return false;
+          break;
+        default:
+          break;
+      }
+    }
+    return true;
+  }
+};
+}  // namespace CORE::Internal::Evaluation
@@ -1,21 +1,25 @@
 #pragma once
-#include <gmpxx.h>
 
 #include <cstdint>
 #include <iostream>
+#include <string>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
 
 namespace CORE::Internal::CEA {
 
 struct PredicateSet {
+  using SmallBitset = Bitset::SmallBitset;
+
   enum Type { Satisfiable, Contradiction, Tautology };
 
-  mpz_class mask;        // Specifies relevant bits
-  mpz_class predicates;  // expected evaluation
+  SmallBitset mask;        // Specifies relevant bits
+  SmallBitset predicates;  // expected evaluation
   Type type;
 
   PredicateSet(Type type = Contradiction) : mask(0), predicates(0), type(type) {}
 
-  PredicateSet(mpz_class mask, mpz_class predicates)
+  PredicateSet(SmallBitset mask, SmallBitset predicates)
       : mask(mask), predicates(predicates), type(Satisfiable) {}
 
   /**
@@ -29,13 +33,12 @@ struct PredicateSet {
       return PredicateSet(other);
     else if (other.type == Tautology)
       return PredicateSet(*this);
-    mpz_class conflict = (mask & other.mask) & (predicates ^ other.predicates);
-    if (conflict != 0) {
+    if (!predicates.agrees_with_on(other.predicates, mask & other.mask)) {
       return PredicateSet(Contradiction);
     }
 
-    mpz_class combined_mask = mask | other.mask;
-    mpz_class combined_predicates = predicates | other.predicates;
+    SmallBitset combined_mask = mask | other.mask;
+    SmallBitset combined_predicates = predicates | other.predicates;
     PredicateSet combined(combined_mask, combined_predicates);
     return combined;
   }
@@ -47,30 +50,27 @@ struct PredicateSet {
       case Tautology:
         return PredicateSet(Contradiction);
       default:
-        mpz_class unselective_mask = (mpz_class(1) << (amount_of_bits + 1)) - 1;
-        mpz_class new_mask = unselective_mask ^ mask;
-        mpz_class new_predicates = ~predicates;
+        SmallBitset new_mask = mask.complement(amount_of_bits + 1);
+        SmallBitset new_predicates = predicates.complement(amount_of_bits + 1);
         return PredicateSet(new_mask, new_predicates);
     }
   }
 
-  bool is_satisfied_by(const mpz_class& predicate_evaluation) const {
+  bool is_satisfied_by(const SmallBitset& predicate_evaluation) const {
     switch (type) {
       case Contradiction:
         return false;
       case Tautology:
         return true;
       default:
-        mpz_class conflicts = (predicate_evaluation ^ predicates) & mask;
-        return conflicts == 0;
+        return predicate_evaluation.agrees_with_on(predicates, mask);
     }
   }
 
   bool operator==(const PredicateSet other) const {
     if (type != other.type || mask != other.mask) return false;
     if (type == Contradiction || type == Tautology) return true;
-    auto conflicts = static_cast<mpz_class>((predicates ^ other.predicates)) & mask;
-    return conflicts == 0;
+    return predicates.agrees_with_on(other.predicates, mask);
   }
 
   // For set comparison
@@ -79,8 +79,8 @@ struct PredicateSet {
     if (type > other.type) return false;
     if (mask < other.mask) return true;
     if (mask > other.mask) return false;
-    if (mask < other.predicates) return true;
-    return false;
+    // Bits outside of the mask are irrelevant, as in operator==.
+    return (predicates & mask) < (other.predicates & other.mask);
   }
 
   std::string to_string() const {
@@ -88,8 +88,8 @@ struct PredicateSet {
       return "⊥";
     else if (type == Tautology)
       return "⊤";
-    std::string out = predicates.get_str(2);
-    std::string mask_string = mask.get_str(2);
+    std::string out = predicates.to_string();
+    std::string mask_string = mask.to_string();
 
     uint64_t buffer_length = out.size() > mask_string.size()
                                ? out.size() - mask_string.size()
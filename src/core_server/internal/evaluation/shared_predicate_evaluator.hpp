@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <tracy/Tracy.hpp>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+#include "core_server/internal/evaluation/physical_predicate/physical_predicate.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_program.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_program_builder.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "shared/datatypes/aliases/event_type_id.hpp"
+
+namespace CORE::Internal::Evaluation {
+
+// A predicate is only shared if this many queries have it. The others are
+// evaluated by each query, so their evaluation stays parallel.
+const size_t SHARED_PREDICATE_EVALUATION_MINIMUM_QUERIES = 2;
+
+/**
+ * Where each query finds the results of its predicates in the shared
+ * results of an event type.
+ */
+struct SharedPredicateMapping {
+  // Distinct for every mapping, a freed mapping can leave its address to a
+  // new one.
+  uint64_t version = 0;
+  // Indexed by query id, pairs of shared bit and bit of the query.
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> query_bits;
+};
+
+struct SharedPredicateResult {
+  Bitset::SmallBitset shared_bits;
+  // Null if no predicate of the tuple was shared.
+  const SharedPredicateMapping* mapping = nullptr;
+};
+
+/**
+ * The shared results of the tuple that a query is evaluating, set by the
+ * thread of the query and read by its PredicateEvaluators.
+ */
+struct SharedPredicateView {
+  size_t query_id;
+  const SharedPredicateResult* current = nullptr;
+
+  explicit SharedPredicateView(size_t query_id) : query_id(query_id) {}
+
+  /**
+   * @return The mapping of the current tuple, or null if none of the
+   *         predicates of the query were shared in it. A tuple evaluated
+   *         before the query was added does not share them either.
+   */
+  const SharedPredicateMapping* mapping() const {
+    if (current == nullptr || current->mapping == nullptr
+        || query_id >= current->mapping->query_bits.size()
+        || current->mapping->query_bits[query_id].empty()) {
+      return nullptr;
+    }
+    return current->mapping;
+  }
+
+  /**
+   * @return The bits of the query that are shared in the current tuple.
+   */
+  Bitset::SmallBitset shared_query_bits() const {
+    Bitset::SmallBitset out;
+    if (const SharedPredicateMapping* current_mapping = mapping()) {
+      for (auto [shared_bit, query_bit] : current_mapping->query_bits[query_id]) {
+        out.set(query_bit);
+      }
+    }
+    return out;
+  }
+
+  /**
+   * Sets the shared bits of the query that hold in the current tuple.
+   * @return false if no predicate of the query is shared in it.
+   */
+  bool read(Bitset::SmallBitset& out) const {
+    const SharedPredicateMapping* current_mapping = mapping();
+    if (current_mapping == nullptr) {
+      return false;
+    }
+    for (auto [shared_bit, query_bit] : current_mapping->query_bits[query_id]) {
+      if (current->shared_bits.test(shared_bit)) {
+        out.set(query_bit);
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * Evaluates the physical predicates that several queries have in common
+ * once per tuple, before the tuples are handed to the queries.
+ *
+ * The predicates of all the queries are numbered with a
+ * PredicateProgramBuilder per event type, so identical predicates of
+ * different queries (the same attribute compared with the same literal,
+ * ...) end up in the same register. Only the predicates of at least
+ * SHARED_PREDICATE_EVALUATION_MINIMUM_QUERIES queries are compiled into the
+ * PredicateProgram of the event type, each stored as a single shared bit.
+ * Each query then maps the shared bits to its own predicate indices with a
+ * SharedPredicateView, and its PredicateEvaluator evaluates the rest.
+ *
+ * Adding or removing a query compiles again the event types that its
+ * predicates admit into a new Stage, which the producer evaluates from its
+ * next batch on without taking any lock. Event types declared afterwards
+ * are not shared until a query is added or removed.
+ *
+ * The result of the tuple with ring sequence s is kept in the slot
+ * s % (2 * ring capacity). A query reads it before asking the ring for the
+ * next tuple, and the ring never lets the producer get more than its
+ * capacity ahead of a query, so batches of at most maximum_batch_size tuples
+ * never overwrite a slot that is being read.
+ *
+ * The slots point to the mappings of the stage they were evaluated with.
+ * Once every query processed the first tuple evaluated with a stage, the
+ * older stages are not read anymore, so adding or removing a query frees
+ * them.
+ */
+class SharedPredicateEvaluator {
+  static constexpr uint64_t NOT_EVALUATED = UINT64_MAX;
+
+  // Not modified once compiled, and only the producer evaluates the program.
+  struct EventTypeStage {
+    // Empty if the shared results of the event type are constant.
+    std::optional<PredicateProgram> program;
+    Bitset::SmallBitset constant_result;
+    // Null if no predicate of the event type is shared.
+    std::unique_ptr<const SharedPredicateMapping> mapping;
+    size_t amount_of_shared_predicates = 0;
+  };
+
+  // What the producer needs of the queries, not modified once published.
+  struct Stage {
+    size_t amount_of_queries = 0;
+    // Indexed by UniqueEventTypeId, empty if there is nothing to share. The
+    // stages share the event types that were not compiled again.
+    std::vector<std::shared_ptr<EventTypeStage>> dispatch_table;
+    // Sequence of the first tuple evaluated with the stage, set by the producer.
+    std::atomic<uint64_t> first_sequence = NOT_EVALUATED;
+  };
+
+  RingTupleQueue::Queue& queue;
+  std::unique_ptr<SharedPredicateResult[]> results;
+  uint64_t results_mask;
+
+  // The stage of the next batch evaluated.
+  std::atomic<Stage*> published_stage;
+  // Producer local.
+  Stage* current_stage = nullptr;
+
+  // Held by add_query and remove_query, queries are added and removed from
+  // other threads.
+  std::mutex mutex;
+  // Indexed by query id, empty once the query is removed.
+  std::vector<std::vector<std::shared_ptr<CEA::PhysicalPredicate>>> query_predicates;
+  // Indexed by query id, null once the query is removed.
+  std::vector<const std::atomic<uint64_t>*> processed_sequences;
+  size_t amount_of_queries = 0;
+  uint64_t next_mapping_version = 1;
+  // From the oldest stage that the queries might still read to the published one.
+  std::deque<std::unique_ptr<Stage>> stages;
+
+ public:
+  SharedPredicateEvaluator(RingTupleQueue::Queue& queue, size_t ring_capacity)
+      : queue(queue),
+        results(std::make_unique<SharedPredicateResult[]>(2 * ring_capacity)),
+        results_mask(2 * ring_capacity - 1) {
+    assert(ring_capacity > 1 && (ring_capacity & (ring_capacity - 1)) == 0);
+    stages.push_back(std::make_unique<Stage>());
+    published_stage.store(stages.back().get());
+  }
+
+  /**
+   * Registers the predicates of a new query, they are shared from the next
+   * batch evaluated. The query has processed the tuples before its
+   * processed_sequence, so the stages they were evaluated with can be freed.
+   * @return The id of the query for its SharedPredicateView.
+   */
+  size_t add_query(const std::vector<std::shared_ptr<CEA::PhysicalPredicate>>& predicates,
+                   const std::atomic<uint64_t>& processed_sequence) {
+    std::lock_guard lock(mutex);
+    query_predicates.push_back(predicates);
+    processed_sequences.push_back(&processed_sequence);
+    amount_of_queries++;
+    publish_stage(predicates);
+    return query_predicates.size() - 1;
+  }
+
+  /**
+   * Stops sharing the predicates of the query from the next batch
+   * evaluated. The ids of the other queries do not change. Called once
+   * nothing evaluates the tuples of the query.
+   */
+  void remove_query(size_t query_id) {
+    std::lock_guard lock(mutex);
+    assert(query_id < query_predicates.size());
+    assert(amount_of_queries > 0);
+    std::vector<std::shared_ptr<CEA::PhysicalPredicate>> predicates = std::move(
+      query_predicates[query_id]);
+    query_predicates[query_id].clear();
+    processed_sequences[query_id] = nullptr;
+    amount_of_queries--;
+    publish_stage(predicates);
+  }
+
+  size_t maximum_batch_size() const { return (results_mask + 1) / 4; }
+
+  /**
+   * Evaluates the tuples that are going to be pushed to the ring with
+   * sequences first_sequence, first_sequence + 1, ...
+   */
+  void evaluate(std::span<uint64_t* const> tuples, uint64_t first_sequence) {
+    ZoneScopedN("SharedPredicateEvaluator::evaluate");
+    assert(tuples.size() <= maximum_batch_size());
+    Stage* stage = published_stage.load(std::memory_order_acquire);
+    if (stage != current_stage) [[unlikely]] {
+      stage->first_sequence.store(first_sequence, std::memory_order_release);
+      current_stage = stage;
+    }
+    bool is_shared = stage->amount_of_queries
+                     >= SHARED_PREDICATE_EVALUATION_MINIMUM_QUERIES;
+    for (size_t i = 0; i < tuples.size(); i++) {
+      SharedPredicateResult& result = results[(first_sequence + i) & results_mask];
+      if (!is_shared) {
+        result.mapping = nullptr;
+        continue;
+      }
+      RingTupleQueue::Tuple tuple = queue.get_tuple(tuples[i]);
+      if (tuple.id() >= stage->dispatch_table.size()) {
+        result.mapping = nullptr;
+        continue;
+      }
+      EventTypeStage& event_type_stage = *stage->dispatch_table[tuple.id()];
+      result.mapping = event_type_stage.mapping.get();
+      if (result.mapping == nullptr) {
+        continue;
+      }
+      if (event_type_stage.program.has_value()) {
+        result.shared_bits = event_type_stage.program.value()(tuple);
+      } else {
+        result.shared_bits = event_type_stage.constant_result;
+      }
+    }
+  }
+
+  const SharedPredicateResult& result_of(uint64_t sequence) const {
+    return results[sequence & results_mask];
+  }
+
+  /**
+   * @return The amount of distinct results computed for each tuple of
+   *         event_type with the queries added so far.
+   */
+  size_t amount_of_shared_predicates(Types::UniqueEventTypeId event_type) {
+    std::lock_guard lock(mutex);
+    const Stage& stage = *stages.back();
+    if (event_type >= stage.dispatch_table.size()) {
+      return 0;
+    }
+    return stage.dispatch_table[event_type]->amount_of_shared_predicates;
+  }
+
+  // Stages that are not freed yet, the published one included.
+  size_t amount_of_retained_stages() {
+    std::lock_guard lock(mutex);
+    return stages.size();
+  }
+
+ private:
+  /**
+   * Compiles again the event types that the predicates admit, and frees the
+   * stages that the queries do not read anymore.
+   */
+  void publish_stage(
+    const std::vector<std::shared_ptr<CEA::PhysicalPredicate>>& changed_predicates) {
+    ZoneScopedN("SharedPredicateEvaluator::publish_stage");
+    const Stage& previous = *stages.back();
+    auto stage = std::make_unique<Stage>();
+    stage->amount_of_queries = amount_of_queries;
+    if (amount_of_queries >= SHARED_PREDICATE_EVALUATION_MINIMUM_QUERIES) {
+      stage->dispatch_table.resize(queue.amount_of_tuple_types());
+      for (uint64_t event_type = 0; event_type < stage->dispatch_table.size();
+           event_type++) {
+        if (event_type < previous.dispatch_table.size()
+            && !admits_any(changed_predicates, event_type)) {
+          stage->dispatch_table[event_type] = previous.dispatch_table[event_type];
+        } else {
+          stage->dispatch_table[event_type] = compile(event_type);
+        }
+      }
+    }
+    published_stage.store(stage.get(), std::memory_order_release);
+    stages.push_back(std::move(stage));
+    free_unread_stages();
+  }
+
+  void free_unread_stages() {
+    uint64_t minimum_processed_sequence = UINT64_MAX;
+    for (const std::atomic<uint64_t>* processed_sequence : processed_sequences) {
+      if (processed_sequence != nullptr) {
+        minimum_processed_sequence = std::min(minimum_processed_sequence,
+                                              processed_sequence->load(
+                                                std::memory_order_acquire));
+      }
+    }
+    // The newest stage that every query reached, the ones before it were
+    // evaluated on tuples that every query processed.
+    for (size_t i = stages.size() - 1; i > 0; i--) {
+      uint64_t first_sequence = stages[i]->first_sequence.load(std::memory_order_acquire);
+      if (first_sequence != NOT_EVALUATED
+          && first_sequence <= minimum_processed_sequence) {
+        stages.erase(stages.begin(), stages.begin() + i);
+        return;
+      }
+    }
+  }
+
+  static bool admits(const CEA::PhysicalPredicate& predicate,
+                     Types::UniqueEventTypeId event_type) {
+    return predicate.admits_any_event_type
+           || predicate.admissible_event_types.contains(event_type);
+  }
+
+  static bool
+  admits_any(const std::vector<std::shared_ptr<CEA::PhysicalPredicate>>& predicates,
+             Types::UniqueEventTypeId event_type) {
+    return std::any_of(predicates.begin(), predicates.end(), [&](const auto& predicate) {
+      return admits(*predicate, event_type);
+    });
+  }
+
+  /**
+   * Compiles the predicates of every query that admit event_type in a single
+   * builder, and counts the queries that have each resulting register.
+   * @return The register of each predicate of each query, UINT32_MAX if the
+   *         predicate does not admit event_type.
+   */
+  std::vector<std::vector<uint32_t>>
+  number_predicates(Types::UniqueEventTypeId event_type,
+                    std::map<uint32_t, size_t>& amount_of_queries_of_register) const {
+    PredicateProgramBuilder builder(event_type);
+    std::vector<std::vector<uint32_t>> registers(query_predicates.size());
+    for (size_t query_id = 0; query_id < query_predicates.size(); query_id++) {
+      std::set<uint32_t> registers_of_query;
+      for (const auto& predicate : query_predicates[query_id]) {
+        uint32_t result = admits(*predicate, event_type) ? predicate->compile(builder)
+                                                         : UINT32_MAX;
+        registers[query_id].push_back(result);
+        if (result != UINT32_MAX && registers_of_query.insert(result).second) {
+          amount_of_queries_of_register[result]++;
+        }
+      }
+    }
+    return registers;
+  }
+
+  std::shared_ptr<EventTypeStage> compile(Types::UniqueEventTypeId event_type) {
+    ZoneScopedN("SharedPredicateEvaluator::compile");
+    std::map<uint32_t, size_t> amount_of_queries_of_register;
+    std::vector<std::vector<uint32_t>> numbered_registers = number_predicates(
+      event_type, amount_of_queries_of_register);
+    PredicateProgramBuilder builder(event_type);
+    auto mapping = std::make_unique<SharedPredicateMapping>();
+    mapping->query_bits.resize(query_predicates.size());
+    // Every predicate result is a boolean register.
+    std::map<uint32_t, uint32_t> shared_bit_of_register;
+    for (size_t query_id = 0; query_id < query_predicates.size(); query_id++) {
+      const auto& predicates = query_predicates[query_id];
+      for (size_t i = 0; i < predicates.size(); i++) {
+        uint32_t numbered_register = numbered_registers[query_id][i];
+        if (numbered_register == UINT32_MAX
+            || amount_of_queries_of_register[numbered_register]
+                 < SHARED_PREDICATE_EVALUATION_MINIMUM_QUERIES) {
+          continue;
+        }
+        uint32_t result = predicates[i]->compile(builder);
+        auto [it, is_new] = shared_bit_of_register.try_emplace(
+          result, static_cast<uint32_t>(shared_bit_of_register.size()));
+        if (is_new) {
+          builder.store_result(result, it->second);
+        }
+        mapping->query_bits[query_id].emplace_back(it->second, static_cast<uint32_t>(i));
+      }
+    }
+    auto stage = std::make_shared<EventTypeStage>();
+    stage->amount_of_shared_predicates = shared_bit_of_register.size();
+    if (shared_bit_of_register.empty()) {
+      return stage;
+    }
+    PredicateProgram program(std::move(builder).build());
+    std::optional<Bitset::SmallBitset> constant_result = program.constant_result();
+    if (constant_result.has_value()) {
+      stage->constant_result = constant_result.value();
+    } else {
+      stage->program = std::move(program);
+    }
+    mapping->version = next_mapping_version++;
+    stage->mapping = std::move(mapping);
+    return stage;
+  }
+};
+}  // namespace CORE::Internal::Evaluation
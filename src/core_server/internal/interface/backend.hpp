@@ -8,29 +8,40 @@
 #include <cstdint>
 #include <cstring>
 #include <ctime>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
-#include <thread>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
-#include <zmq.hpp>
 
 #include "core_server/internal/ceql/query/query.hpp"
 #include "core_server/internal/ceql/query/within.hpp"
 #include "core_server/internal/coordination/catalog.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/ingest_watermark.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/queries/compiled_query.hpp"
+#include "core_server/internal/interface/queries/compiled_query_cache.hpp"
 #include "core_server/internal/interface/queries/generic_query.hpp"
 #include "core_server/internal/interface/queries/partition_by_query.hpp"
+#include "core_server/internal/interface/queries/result_stage.hpp"
 #include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/buffer_storage.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "queries/simple_query.hpp"
 #include "shared/datatypes/aliases/event_type_id.hpp"
-#include "shared/datatypes/aliases/port_number.hpp"
 #include "shared/datatypes/aliases/stream_type_id.hpp"
 #include "shared/datatypes/catalog/attribute_info.hpp"
 #include "shared/datatypes/catalog/datatypes.hpp"
@@ -38,8 +49,9 @@
 #include "shared/datatypes/catalog/stream_info.hpp"
 #include "shared/datatypes/event.hpp"
 #include "shared/datatypes/parsing/stream_info_parsed.hpp"
+#include "shared/datatypes/query_stats.hpp"
 #include "shared/datatypes/value.hpp"
-#include "shared/networking/message_sender/zmq_message_sender.hpp"
+#include "shared/serializer/flat_stream/flat_stream_reader.hpp"
 #include "tracy/Tracy.hpp"
 
 namespace CORE::Internal::Interface {
@@ -48,35 +60,44 @@ template <typename ResultHandlerT>
 class Backend {
   Internal::Catalog catalog = {};
   RingTupleQueue::Queue queue;
-  std::atomic<Types::PortNumber> next_available_inproc_port{5000};
-
-  std::vector<std::reference_wrapper<std::atomic<uint64_t*>>> last_received_tuple = {};
-  std::vector<uint64_t*> last_sent_tuple = {};
-
-  // TODO: Copied from mediator, check
-  std::vector<std::reference_wrapper<std::atomic<uint64_t>>> query_events_expiration_time =
-    {};
-  std::vector<CEQL::Within::TimeWindowMode> query_events_time_window_mode = {};
-  uint64_t maximum_historic_time_between_events = 0;
-  std::optional<uint64_t> previous_event_sent;
+  // Every query reads the tuples from here, so it has to outlive the queries.
+  Stream::BroadcastRing<uint64_t*> tuple_ring;
+  // Evaluates the predicates that the queries have in common, before pushing
+  // the tuples to the ring.
+  Evaluation::SharedPredicateEvaluator shared_predicate_evaluator{queue,
+                                                                  tuple_ring.capacity()};
+  // Reused buffer with the tuples of the batch being sent.
+  std::vector<uint64_t*> batch_tuples = {};
+
+  // The ring tuple queue recycles the tuples that every query is done with.
+  std::vector<std::reference_wrapper<const IngestWatermark>> query_ingest_watermarks = {};
 
   using QueryVariant = std::variant<std::unique_ptr<SimpleQuery<ResultHandlerT>>,
                                     std::unique_ptr<PartitionByQuery<ResultHandlerT>>>;
 
   std::vector<QueryCatalog> query_catalogs;
   std::vector<QueryVariant> queries;
-  std::vector<Internal::ZMQMessageSender> inner_thread_event_senders = {};
 
- public:
-  Backend() : queue(100'000, &catalog.tuple_schemas) {}
+  PartitionBySettings partition_by_settings;
+  QueryCompilationSettings query_compilation_settings;
+  CompiledQueryCache compiled_query_cache;
+  MiniPool::PoolCompactionSettings pool_compaction_settings;
+  ResultStageSettings result_stage_settings;
 
-  ~Backend() {
-    for (int i = 0; i < last_received_tuple.size(); i++) {
-      while (last_sent_tuple[i] != last_received_tuple[i].get().load()) {
-        std::this_thread::sleep_for(std::chrono::microseconds(50));
-      }
-    }
-  }
+ public:
+  Backend(PartitionBySettings partition_by_settings = {},
+          RingTupleQueue::StorageSettings storage_settings = {},
+          QueryCompilationSettings query_compilation_settings = {},
+          MiniPool::PoolCompactionSettings pool_compaction_settings = {},
+          ResultStageSettings result_stage_settings = {})
+      : queue(100'000, &catalog.tuple_schemas, storage_settings),
+        partition_by_settings(partition_by_settings),
+        query_compilation_settings(query_compilation_settings),
+        compiled_query_cache(query_compilation_settings.compiled_query_cache_size),
+        pool_compaction_settings(pool_compaction_settings),
+        result_stage_settings(result_stage_settings) {}
+
+  ~Backend() { tuple_ring.wait_until_consumed(); }
 
   const Catalog& get_catalog_reference() const { return catalog; }
 
@@ -102,97 +123,269 @@ class Backend {
     return catalog.get_all_streams_info();
   }
 
+  /**
+   * Parses and compiles the query with the given text. The queries with the
+   * same text, up to whitespace and comments, reuse the predicates and the
+   * CEA compiled for the first one while the catalog does not change.
+   */
+  std::shared_ptr<const CompiledQuery> compile_query(std::string_view query_text) {
+    ZoneScopedN("Backend::compile_query");
+    std::string normalized_text = normalize_query_text(query_text);
+    std::shared_ptr<const CompiledQuery> compiled_query = compiled_query_cache.find(
+      normalized_text, catalog.version());
+    if (compiled_query == nullptr) {
+      compiled_query = compile(
+        Parsing::QueryParser::parse_query(std::string(query_text)));
+      compiled_query_cache.insert(std::move(normalized_text),
+                                  catalog.version(),
+                                  compiled_query);
+    }
+    return compiled_query;
+  }
+
   // TODO: Propogate parse error to ClientMessageHandler
+  void declare_query(std::string_view query_text,
+                     std::unique_ptr<ResultHandlerT>&& result_handler) {
+    declare_query(compile_query(query_text), std::move(result_handler));
+  }
+
   void declare_query(Internal::CEQL::Query&& parsed_query,
                      std::unique_ptr<ResultHandlerT>&& result_handler) {
-    if (parsed_query.partition_by.partition_attributes.size() != 0) {
+    declare_query(compile(std::move(parsed_query)), std::move(result_handler));
+  }
+
+  void declare_query(std::shared_ptr<const CompiledQuery> compiled_query,
+                     std::unique_ptr<ResultHandlerT>&& result_handler) {
+    result_handler->set_output(compiled_query->output);
+    if (compiled_query->partition_by.partition_attributes.size() != 0) {
       using QueryDirectType = PartitionByQuery<ResultHandlerT>;
       using QueryBaseType = GenericQuery<PartitionByQuery<ResultHandlerT>, ResultHandlerT>;
 
-      initialize_query<QueryDirectType, QueryBaseType>(std::move(parsed_query),
+      initialize_query<QueryDirectType, QueryBaseType>(std::move(compiled_query),
                                                        std::move(result_handler));
     } else {
       using QueryDirectType = SimpleQuery<ResultHandlerT>;
       using QueryBaseType = GenericQuery<SimpleQuery<ResultHandlerT>, ResultHandlerT>;
 
-      initialize_query<QueryDirectType, QueryBaseType>(std::move(parsed_query),
+      initialize_query<QueryDirectType, QueryBaseType>(std::move(compiled_query),
                                                        std::move(result_handler));
     }
   }
 
+  const CompiledQueryCache& get_compiled_query_cache() const {
+    return compiled_query_cache;
+  }
+
   template <typename QueryDirectType, typename QueryBaseType>
-  void initialize_query(Internal::CEQL::Query&& parsed_query,
+  void initialize_query(std::shared_ptr<const CompiledQuery> compiled_query,
                         std::unique_ptr<ResultHandlerT>&& result_handler) {
-    std::string inproc_receiver_address = "inproc://"
-                                          + std::to_string(next_available_inproc_port++);
-    QueryCatalog query_catalog(catalog, parsed_query.from.streams);
+    QueryCatalog query_catalog(catalog, compiled_query->streams);
     query_catalogs.push_back(query_catalog);
-    queries.emplace_back(std::make_unique<QueryDirectType>(query_catalog,
-                                                           queue,
-                                                           inproc_receiver_address,
-                                                           std::move(result_handler)));
+    if constexpr (std::is_same_v<QueryDirectType, PartitionByQuery<ResultHandlerT>>) {
+      queries.emplace_back(std::make_unique<QueryDirectType>(query_catalog,
+                                                             queue,
+                                                             tuple_ring,
+                                                             shared_predicate_evaluator,
+                                                             std::move(result_handler),
+                                                             partition_by_settings));
+    } else {
+      queries.emplace_back(std::make_unique<QueryDirectType>(query_catalog,
+                                                             queue,
+                                                             tuple_ring,
+                                                             shared_predicate_evaluator,
+                                                             std::move(result_handler)));
+    }
     QueryBaseType* query = static_cast<QueryBaseType*>(
       std::get<std::unique_ptr<QueryDirectType>>(queries.back()).get());
 
-    query->init(std::move(parsed_query));
-    query_events_time_window_mode.push_back(query->time_window.mode);
-    query_events_expiration_time.emplace_back(query->time_of_expiration);
-    last_received_tuple.emplace_back(query->last_received_tuple);
-    last_sent_tuple.push_back(nullptr);
+    query->init(std::move(compiled_query),
+                query_compilation_settings.eager_det_cea_states,
+                pool_compaction_settings,
+                result_stage_settings);
+    query_ingest_watermarks.emplace_back(query->ingest_watermark);
+  }
 
-    zmq::context_t& inproc_context = query->get_inproc_context();
-    inner_thread_event_senders.emplace_back(inproc_receiver_address, inproc_context);
+  /**
+   * Statistics of the partitions of a PARTITION BY query, queries are
+   * numbered in the order they were declared.
+   */
+  std::optional<PartitionByStatistics> get_partition_by_statistics(size_t query_idx) {
+    if (query_idx >= queries.size()) {
+      throw std::runtime_error("Provided query index is not valid.");
+    }
+    auto* query = std::get_if<std::unique_ptr<PartitionByQuery<ResultHandlerT>>>(
+      &queries[query_idx]);
+    if (query == nullptr) {
+      return {};
+    }
+    return (*query)->get_partition_by_statistics();
+  }
+
+  /**
+   * Counters of the automaton and the tECS of a query, queries are numbered
+   * in the order they were declared. Only consistent while the query is
+   * idle, for example after wait_until_processed.
+   */
+  QueryStatistics get_query_statistics(size_t query_idx) {
+    if (query_idx >= queries.size()) {
+      throw std::runtime_error("Provided query index is not valid.");
+    }
+    return std::visit([](auto& query) { return query->get_query_statistics(); },
+                      queries[query_idx]);
+  }
+
+  /**
+   * Memory of the ring tuple queue, it can be read while the events are
+   * being sent.
+   */
+  RingTupleQueue::MemoryUsage get_ring_tuple_queue_memory_usage() const {
+    return queue.get_memory_usage();
+  }
+
+  /**
+   * Runtime statistics of every query, unlike get_query_statistics they can
+   * be read while the events are being sent. Queries must not be declared
+   * meanwhile.
+   */
+  Types::ServerStats get_query_stats() const {
+    Types::ServerStats out;
+    for (size_t query_idx = 0; query_idx < queries.size(); query_idx++) {
+      out.queries.push_back(
+        std::visit([](const auto& query) { return query_stats_of(*query); },
+                   queries[query_idx]));
+    }
+    RingTupleQueue::MemoryUsage memory_usage = queue.get_memory_usage();
+    out.ring_tuple_queue_bytes_allocated = memory_usage.bytes_allocated;
+    out.ring_tuple_queue_bytes_in_use = memory_usage.bytes_in_use;
+    return out;
+  }
+
+  /**
+   * Blocks until every query has processed every event sent so far and
+   * handled its outputs.
+   */
+  void wait_until_processed() {
+    uint64_t sequence = tuple_ring.amount_of_values_pushed();
+    for (auto& query : queries) {
+      std::visit([&](auto& query) { query->wait_until_processed(sequence); }, query);
+    }
   }
 
   void send_event_to_queries(Types::StreamTypeId stream_id, const Types::Event& event) {
-    ZoneScopedN("Backend::send_event_to_queries");
-    RingTupleQueue::Tuple tuple = event_to_tuple(event);
-    uint64_t ns = tuple.nanoseconds();
-    if (!previous_event_sent) {
-      previous_event_sent = ns;
+    send_events_to_queries(stream_id, std::span<const Types::Event>(&event, 1));
+  }
+
+  /**
+   * Writes all the events into the ring tuple queue and hands them to the
+   * queries as a single batch. The space of the ring tuple queue is updated
+   * once per batch.
+   */
+  void send_events_to_queries(Types::StreamTypeId stream_id,
+                              std::span<const Types::Event> events) {
+    ZoneScopedN("Backend::send_events_to_queries");
+    batch_tuples.clear();
+    try {
+      for (const Types::Event& event : events) {
+        RingTupleQueue::Tuple tuple = event_to_tuple(event);
+        batch_tuples.push_back(tuple.get_data());
+      }
+    } catch (std::exception& e) {
+      // The events before the invalid one are still sent.
+      send_batch_tuples();
+      throw;
     }
-    maximum_historic_time_between_events = std::max(maximum_historic_time_between_events,
-                                                    ns - previous_event_sent.value());
-    previous_event_sent = ns;
-    for (int i = 0; i < inner_thread_event_senders.size(); i++) {
-      ZMQMessageSender& sender = inner_thread_event_senders[i];
-      QueryCatalog& query_catalog = query_catalogs[i];
-      if (query_catalog.is_unique_event_id_relevant_to_query(tuple.id())) {
-        last_sent_tuple[i] = tuple.get_data();
-        sender.send(tuple.serialize_data());
+    send_batch_tuples();
+  }
+
+  /**
+   * Same as send_events_to_queries for a flat stream frame, see
+   * flat_stream_format.hpp. The attributes are copied from the frame
+   * directly into the ring tuple queue.
+   */
+  void send_flat_stream_to_queries(std::string_view frame) {
+    ZoneScopedN("Backend::send_flat_stream_to_queries");
+    FlatStreamReader reader(frame);
+    batch_tuples.clear();
+    try {
+      while (std::optional<FlatStreamReader::Event> event = reader.next_event()) {
+        RingTupleQueue::Tuple tuple = flat_event_to_tuple(event.value());
+        batch_tuples.push_back(tuple.get_data());
       }
+    } catch (std::exception& e) {
+      send_batch_tuples();
+      throw;
     }
+    send_batch_tuples();
+  }
 
-    // TODO: Don't do this always.
+ private:
+  std::shared_ptr<const CompiledQuery> compile(Internal::CEQL::Query&& parsed_query) {
+    ZoneScopedN("Backend::compile");
+    QueryCatalog query_catalog(catalog, parsed_query.from.streams);
+    return std::make_shared<const CompiledQuery>(
+      CompiledQuery::compile(std::move(parsed_query), query_catalog));
+  }
+
+  void send_batch_tuples() {
+    // Each query skips the tuples that are not relevant to it.
+    std::span<uint64_t* const> tuples(batch_tuples);
+    while (!tuples.empty()) {
+      std::span<uint64_t* const> part = tuples.first(
+        std::min(tuples.size(), shared_predicate_evaluator.maximum_batch_size()));
+      shared_predicate_evaluator.evaluate(part, tuple_ring.amount_of_values_pushed());
+      tuple_ring.push(part);
+      tuples = tuples.subspan(part.size());
+    }
     update_space_of_ring_tuple_queue();
   }
 
- private:
+  // Runtime statistics of the query, see get_query_stats.
+  template <typename QueryType>
+  static Types::QueryStats query_stats_of(const QueryType& query) {
+    Types::QueryStats out;
+    out.events_processed = query.counters.get_events_processed();
+    out.matches_emitted = query.counters.get_matches_emitted();
+    out.latency_histogram = query.counters.get_latency_histogram();
+    out.evaluation_nanoseconds = query.counters.get_evaluation_nanoseconds();
+    out.emission_nanoseconds = query.counters.get_emission_nanoseconds();
+    out.outputs_dropped = query.counters.get_outputs_dropped();
+    QueryStatistics statistics = query.load_published_statistics();
+    out.det_cea_states = statistics.det_cea_states;
+    out.det_cea_computed_transitions = statistics.det_cea_computed_transitions;
+    out.tecs_nodes_allocated = statistics.tecs_nodes_allocated;
+    out.tecs_nodes_used = statistics.tecs_nodes_used;
+    out.tecs_nodes_recycled = statistics.tecs_nodes_recycled;
+    out.det_cea_retained_bytes = statistics.det_cea_retained_bytes;
+    out.det_cea_live_bytes = statistics.det_cea_live_bytes;
+    out.tecs_retained_bytes = statistics.tecs_retained_bytes;
+    out.tecs_live_bytes = statistics.tecs_live_bytes;
+    out.pool_bytes_released = statistics.pool_bytes_released;
+    if constexpr (std::is_same_v<QueryType, PartitionByQuery<ResultHandlerT>>) {
+      out.live_partitions = query.get_partition_by_statistics().live_partitions;
+    }
+    auto watermark = query.ingest_watermark.load();
+    if (watermark != std::chrono::system_clock::time_point::min()) {
+      out.ingest_watermark = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               watermark.time_since_epoch())
+                               .count();
+    }
+    return out;
+  }
+
+  /**
+   * Every query maps the expiration of its time window, whatever its unit,
+   * back to the time the tuples were ingested, so the queue recycles the
+   * buffers written before the minimum of them.
+   */
   void update_space_of_ring_tuple_queue() {
-    if (query_events_expiration_time.size() != 0) {
-      assert(query_events_expiration_time.size() == query_events_time_window_mode.size());
-      uint64_t consensus = UINT64_MAX;
-      for (size_t i = 0; i < query_events_time_window_mode.size(); i++) {
-        switch (query_events_time_window_mode[i]) {
-          case CEQL::Within::TimeWindowMode::EVENTS:
-            consensus = std::min(query_events_expiration_time[i].get()
-                                   * maximum_historic_time_between_events,
-                                 consensus);
-          case CEQL::Within::TimeWindowMode::ATTRIBUTE:
-            consensus = 0;
-            break;
-          case CEQL::Within::TimeWindowMode::NONE:
-          case CEQL::Within::TimeWindowMode::NANOSECONDS:
-            consensus = std::min(query_events_expiration_time[i].get().load(), consensus);
-            break;
-          default:
-            assert(false
-                   && "Unknown time_window mode in update_space_of_ring_tuple_queue.");
-            break;
-        }
-      }
-      queue.update_overwrite_timepoint(consensus);
+    if (query_ingest_watermarks.empty()) {
+      return;
     }
+    auto consensus = std::chrono::system_clock::time_point::max();
+    for (const IngestWatermark& watermark : query_ingest_watermarks) {
+      consensus = std::min(watermark.load(), consensus);
+    }
+    queue.update_overwrite_timepoint(consensus);
   }
 
   RingTupleQueue::Tuple event_to_tuple(const Types::Event& event) {
@@ -237,6 +430,44 @@ class Backend {
     return queue.get_tuple(data);
   }
 
+  RingTupleQueue::Tuple flat_event_to_tuple(const FlatStreamReader::Event& event) {
+    ZoneScopedN("Backend::flat_event_to_tuple");
+    if (event.event_type_id >= catalog.number_of_events()) {
+      throw std::runtime_error("Provided event type id is not valid.");
+    }
+    const std::vector<RingTupleQueue::SupportedTypes>& schema = catalog.tuple_schemas
+                                                                  .get_schema(
+                                                                    event.event_type_id);
+    size_t attribute_words = 0;
+    for (RingTupleQueue::SupportedTypes type : schema) {
+      attribute_words += RingTupleQueue::Type::type_size(type);
+    }
+    if (attribute_words * sizeof(uint64_t) > event.payload.size()) {
+      throw std::runtime_error("Event had an incorrect number of attributes");
+    }
+
+    uint64_t* data = queue.start_tuple(event.event_type_id);
+    size_t word_index = 0;
+    for (RingTupleQueue::SupportedTypes type : schema) {
+      if (type == RingTupleQueue::SupportedTypes::STRING_VIEW) {
+        std::optional<std::string_view> string = event.string(
+          attribute_words, event.word(word_index), event.word(word_index + 1));
+        if (!string.has_value()) {
+          throw std::runtime_error("A string attribute is out of the event.");
+        }
+        char* chars = queue.writer<std::string>(string->size());
+        memcpy(chars, string->data(), string->size());
+      } else if (type == RingTupleQueue::SupportedTypes::BOOL) {
+        *queue.writer<bool>() = event.word(word_index) != 0;
+      } else {
+        // INT64, DOUBLE and DATE take one word with the same bits as in the tuple.
+        *queue.writer<uint64_t>() = event.word(word_index);
+      }
+      word_index += RingTupleQueue::Type::type_size(type);
+    }
+    return queue.get_tuple(data);
+  }
+
   void write_int(std::shared_ptr<Types::Value>& attr) {
     Types::IntValue* val_ptr = dynamic_cast<Types::IntValue*>(attr.get());
     if (val_ptr == nullptr)
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <tracy/Tracy.hpp>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -18,11 +22,29 @@
 #include "core_server/internal/evaluation/evaluator.hpp"
 #include "core_server/internal/evaluation/predicate_evaluator.hpp"
 #include "core_server/internal/interface/evaluators/generic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/evaluators/vector_hash.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 
 namespace CORE::Internal::Interface {
 
+// Minimum amount of tuples between two sweeps for idle partitions.
+const uint64_t PARTITION_SWEEP_MINIMUM_INTERVAL = 1024;
+
+/**
+ * Evaluates a query with one Evaluator per partition. Partitions that become
+ * idle (see Evaluator::is_idle) are reclaimed in periodic sweeps, their
+ * evaluators are cleared and kept in a pool to be reused by new partitions.
+ * The amount of live partitions can be bounded, see PartitionBySettings.
+ * The sweeps also compact the pools of the DetCEA and of the tECS of every
+ * evaluator, see PoolCompactionSettings.
+ *
+ * With pipelined outputs an evaluator that is removed and does not fit in
+ * the pool is retired instead of destroyed, the query destroys the retired
+ * evaluators once the outputs given before were handled.
+ */
 class DynamicEvaluator : public GenericEvaluator {
   struct EvaluatorArgs {
     Evaluation::PredicateEvaluator tuple_evaluator;
@@ -36,11 +58,42 @@ class DynamicEvaluator : public GenericEvaluator {
                   CEQL::Limit limit)
         : tuple_evaluator(std::move(tuple_evaluator)),
           event_time_of_expiration(event_time_of_expiration),
-          consumption_policy(consumption_policy) {}
+          consumption_policy(consumption_policy),
+          limit(limit) {}
+  };
+
+  static constexpr size_t NO_PARTITION = SIZE_MAX;
+
+  struct Partition {
+    std::unique_ptr<Evaluation::Evaluator> evaluator;
+    std::vector<uint64_t> partition_values;
+    // Doubly linked list from the most to the least recently used partition.
+    size_t more_recently_used = NO_PARTITION;
+    size_t less_recently_used = NO_PARTITION;
   };
 
   EvaluatorArgs evaluator_args;
-  std::vector<std::unique_ptr<Evaluation::Evaluator>> evaluators = {};
+  PartitionBySettings settings;
+
+  std::unordered_map<std::vector<uint64_t>, size_t, VectorHash>
+    partition_values_to_idx = {};
+  std::vector<Partition> partitions = {};
+  std::vector<size_t> free_partition_idxs = {};
+  std::vector<std::unique_ptr<Evaluation::Evaluator>> evaluator_pool = {};
+  // Removed evaluators that do not fit in the pool while pipelined outputs
+  // can still read their tECS.
+  std::vector<std::unique_ptr<Evaluation::Evaluator>> retired_evaluators = {};
+  size_t most_recently_used = NO_PARTITION;
+  size_t least_recently_used = NO_PARTITION;
+  uint64_t tuples_since_last_sweep = 0;
+
+  // Read from other threads.
+  std::atomic<uint64_t> amount_of_live_partitions = 0;
+  std::atomic<uint64_t> amount_of_pooled_evaluators = 0;
+  std::atomic<uint64_t> amount_of_reclaimed_partitions = 0;
+  std::atomic<uint64_t> amount_of_evicted_partitions = 0;
+  std::atomic<uint64_t> amount_of_ignored_tuples = 0;
+  std::atomic<uint64_t> bytes_used = 0;
 
  public:
   DynamicEvaluator(CEA::DetCEA&& cea,
@@ -50,38 +103,243 @@ class DynamicEvaluator : public GenericEvaluator {
                    CEQL::Limit limit,
                    CEQL::Within::TimeWindow time_window,
                    Internal::QueryCatalog& query_catalog,
-                   RingTupleQueue::Queue& queue)
+                   RingTupleQueue::Queue& queue,
+                   PartitionBySettings settings = {})
       : GenericEvaluator(std::move(cea), time_window, query_catalog, queue),
         evaluator_args(std::move(tuple_evaluator),
                        event_time_of_expiration,
                        consumption_policy,
-                       limit) {}
+                       limit),
+        settings(settings) {}
+
+  std::optional<tECS::Enumerator>
+  process_event(RingTupleQueue::Tuple tuple,
+                const std::vector<uint64_t>& partition_values) {
+    return process_event(tuple, tuple_time(tuple), partition_values);
+  }
 
+  /**
+   * Evaluates a tuple whose time was already computed, used when the times
+   * of the tuples depend on tuples that other evaluators receive.
+   */
   std::optional<tECS::Enumerator>
-  process_event(RingTupleQueue::Tuple tuple, size_t evaluator_idx) {
+  process_event(RingTupleQueue::Tuple tuple,
+                uint64_t time,
+                const std::vector<uint64_t>& partition_values) {
     ZoneScopedN("Interface::DynamicEvaluator::process_event");
-    uint64_t time = tuple_time(tuple);
+    // Sweep before evaluating, the enumerator returned now uses its tECS. The
+    // ones of the previous tuples were consumed, unless the outputs are
+    // pipelined, and then their evaluators are pooled or retired.
+    if (++tuples_since_last_sweep
+        >= std::max(PARTITION_SWEEP_MINIMUM_INTERVAL, amount_of_live_partitions.load())) {
+      reclaim_idle_partitions();
+    }
 
-    if (evaluator_idx >= evaluators.size()) {
-      std::unique_ptr<Evaluation::Evaluator> evaluator = std::make_unique<
-        Evaluation::Evaluator>(this->cea,
-                               evaluator_args.tuple_evaluator,
-                               time_window.duration,
-                               evaluator_args.event_time_of_expiration,
-                               evaluator_args.consumption_policy,
-                               evaluator_args.limit);
-      evaluators.push_back(std::move(evaluator));
+    std::optional<size_t> partition_idx = find_or_create_partition(partition_values);
+    if (!partition_idx.has_value()) {
+      amount_of_ignored_tuples.fetch_add(1, std::memory_order_relaxed);
+      return {};
     }
+    mark_as_most_recently_used(partition_idx.value());
 
-    std::optional<tECS::Enumerator> enumerator = evaluators[evaluator_idx]->next(tuple,
-                                                                                 time);
+    std::optional<tECS::Enumerator>
+      enumerator = partitions[partition_idx.value()].evaluator->next(tuple, time);
     if (enumerator.has_value()
         && evaluator_args.consumption_policy == CEQL::ConsumeBy::ConsumptionPolicy::ANY) {
-      for (const auto& evaluator : evaluators) {
-        evaluator->should_reset.store(true);
-      }
+      reset_partitions();
     }
     return enumerator;
   }
+
+  bool has_retired_evaluators() const { return !retired_evaluators.empty(); }
+
+  // Called once no output reads the tECS of the retired evaluators.
+  void destroy_retired_evaluators() { retired_evaluators.clear(); }
+
+  // Every partition starts again from its next tuple, as with CONSUME BY ANY.
+  void reset_partitions() {
+    for (const Partition& partition : partitions) {
+      if (partition.evaluator != nullptr) {
+        partition.evaluator->should_reset.store(true);
+      }
+    }
+  }
+
+  PartitionByStatistics get_statistics() const {
+    return {amount_of_live_partitions.load(std::memory_order_relaxed),
+            amount_of_pooled_evaluators.load(std::memory_order_relaxed),
+            amount_of_reclaimed_partitions.load(std::memory_order_relaxed),
+            amount_of_evicted_partitions.load(std::memory_order_relaxed),
+            amount_of_ignored_tuples.load(std::memory_order_relaxed),
+            bytes_used.load(std::memory_order_relaxed)};
+  }
+
+  QueryStatistics get_query_statistics() const {
+    QueryStatistics out = det_cea_statistics();
+    auto add_tecs = [&](const Evaluation::Evaluator& evaluator) {
+      const tECS::tECS& tecs = evaluator.get_tecs_reference();
+      out.tecs_nodes_allocated += tecs.amount_of_nodes_allocated();
+      out.tecs_nodes_used += tecs.amount_of_nodes_used();
+      out.tecs_nodes_recycled += tecs.amount_of_nodes_recycled();
+      out.tecs_retained_bytes += tecs.retained_bytes();
+      out.tecs_live_bytes += tecs.live_bytes();
+    };
+    for (const Partition& partition : partitions) {
+      if (partition.evaluator != nullptr) {
+        add_tecs(*partition.evaluator);
+      }
+    }
+    for (const auto& evaluator : evaluator_pool) {
+      add_tecs(*evaluator);
+    }
+    return out;
+  }
+
+  /**
+   * Removes every partition that is idle, compacts the pools that stayed
+   * underused and updates the memory estimate and the published statistics.
+   * Called every max(PARTITION_SWEEP_MINIMUM_INTERVAL, live partitions)
+   * tuples, so the cost is amortized to O(1) per tuple.
+   */
+  void reclaim_idle_partitions() {
+    ZoneScopedN("Interface::DynamicEvaluator::reclaim_idle_partitions");
+    tuples_since_last_sweep = 0;
+    bool should_compact = pool_compaction_settings.utilization_threshold > 0;
+    auto now = should_compact ? std::chrono::steady_clock::now()
+                              : std::chrono::steady_clock::time_point{};
+    uint64_t bytes = 0;
+    for (size_t idx = 0; idx < partitions.size(); idx++) {
+      Partition& partition = partitions[idx];
+      if (partition.evaluator == nullptr) continue;
+      if (partition.evaluator->is_idle()) {
+        remove_partition(idx);
+        amount_of_reclaimed_partitions.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        if (should_compact) {
+          pool_bytes_released += partition.evaluator->compact_tecs_if_underused(
+            pool_compaction_settings, now);
+        }
+        bytes += partition.evaluator->memory_usage_bytes();
+      }
+    }
+    for (auto& evaluator : evaluator_pool) {
+      if (should_compact) {
+        pool_bytes_released += evaluator->compact_tecs_if_underused(
+          pool_compaction_settings, now);
+      }
+      bytes += evaluator->memory_usage_bytes();
+    }
+    if (should_compact) {
+      compact_det_cea_if_underused(now);
+    }
+    bytes_used.store(bytes, std::memory_order_relaxed);
+    published_statistics.publish(get_query_statistics());
+  }
+
+ private:
+  std::optional<size_t>
+  find_or_create_partition(const std::vector<uint64_t>& partition_values) {
+    if (auto it = partition_values_to_idx.find(partition_values);
+        it != partition_values_to_idx.end()) [[likely]] {
+      return it->second;
+    }
+    if (settings.maximum_live_partitions != 0
+        && amount_of_live_partitions.load() >= settings.maximum_live_partitions) {
+      switch (settings.eviction_policy) {
+        case PartitionEvictionPolicy::IGNORE_NEW_PARTITIONS:
+          return {};
+        case PartitionEvictionPolicy::LEAST_RECENTLY_USED:
+          assert(least_recently_used != NO_PARTITION);
+          remove_partition(least_recently_used);
+          amount_of_evicted_partitions.fetch_add(1, std::memory_order_relaxed);
+          break;
+        default:
+          assert(false && "Unknown PartitionEvictionPolicy in find_or_create_partition.");
+          break;
+      }
+    }
+
+    size_t idx;
+    if (!free_partition_idxs.empty()) {
+      idx = free_partition_idxs.back();
+      free_partition_idxs.pop_back();
+    } else {
+      idx = partitions.size();
+      partitions.emplace_back();
+    }
+    Partition& partition = partitions[idx];
+    partition.evaluator = get_evaluator();
+    partition.partition_values = partition_values;
+    partition_values_to_idx.emplace(partition_values, idx);
+    amount_of_live_partitions.fetch_add(1, std::memory_order_relaxed);
+    return idx;
+  }
+
+  std::unique_ptr<Evaluation::Evaluator> get_evaluator() {
+    if (!evaluator_pool.empty()) {
+      std::unique_ptr<Evaluation::Evaluator> evaluator = std::move(evaluator_pool.back());
+      evaluator_pool.pop_back();
+      amount_of_pooled_evaluators.fetch_sub(1, std::memory_order_relaxed);
+      return evaluator;
+    }
+    return std::make_unique<
+      Evaluation::Evaluator>(this->cea,
+                             evaluator_args.tuple_evaluator,
+                             time_window.duration,
+                             evaluator_args.event_time_of_expiration,
+                             evaluator_args.consumption_policy,
+                             evaluator_args.limit);
+  }
+
+  void remove_partition(size_t idx) {
+    Partition& partition = partitions[idx];
+    assert(partition.evaluator != nullptr);
+    unlink(idx);
+    partition_values_to_idx.erase(partition.partition_values);
+    partition.partition_values.clear();
+
+    partition.evaluator->clear();
+    if (evaluator_pool.size() < settings.maximum_pooled_evaluators) {
+      evaluator_pool.push_back(std::move(partition.evaluator));
+      amount_of_pooled_evaluators.fetch_add(1, std::memory_order_relaxed);
+    } else if (outputs_are_pipelined) {
+      retired_evaluators.push_back(std::move(partition.evaluator));
+    }
+    partition.evaluator = nullptr;
+    free_partition_idxs.push_back(idx);
+    amount_of_live_partitions.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void mark_as_most_recently_used(size_t idx) {
+    if (most_recently_used == idx) return;
+    unlink(idx);
+    Partition& partition = partitions[idx];
+    partition.less_recently_used = most_recently_used;
+    if (most_recently_used != NO_PARTITION) {
+      partitions[most_recently_used].more_recently_used = idx;
+    }
+    most_recently_used = idx;
+    if (least_recently_used == NO_PARTITION) {
+      least_recently_used = idx;
+    }
+  }
+
+  void unlink(size_t idx) {
+    Partition& partition = partitions[idx];
+    if (partition.more_recently_used != NO_PARTITION) {
+      partitions[partition.more_recently_used].less_recently_used = partition
+                                                                      .less_recently_used;
+    } else if (most_recently_used == idx) {
+      most_recently_used = partition.less_recently_used;
+    }
+    if (partition.less_recently_used != NO_PARTITION) {
+      partitions[partition.less_recently_used].more_recently_used = partition
+                                                                      .more_recently_used;
+    } else if (least_recently_used == idx) {
+      least_recently_used = partition.more_recently_used;
+    }
+    partition.more_recently_used = NO_PARTITION;
+    partition.less_recently_used = NO_PARTITION;
+  }
 };
 }  // namespace CORE::Internal::Interface
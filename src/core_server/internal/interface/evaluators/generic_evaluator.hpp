@@ -2,28 +2,41 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
-#include <tracy/Tracy.hpp>
-#include <unordered_map>
+#include <optional>
 #include <utility>
 
 #include "core_server/internal/ceql/query/within.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/evaluation/det_cea/det_cea.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/interface/evaluators/ingest_watermark.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/evaluators/tuple_time.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
-#include "shared/datatypes/aliases/event_type_id.hpp"
 
 namespace CORE::Internal::Interface {
 
 class GenericEvaluator {
-  uint64_t current_stream_position = 0;
   Internal::QueryCatalog& query_catalog;
   RingTupleQueue::Queue& queue;
-  std::unordered_map<Types::UniqueEventTypeId, uint64_t> indexes{};
+  TupleTime time_of_tuple;
+  // Null if the times are recorded by whoever evaluates them.
+  IngestWatermark* ingest_watermark = nullptr;
+  // The time of the last tuple while it is not recorded in ingest_watermark.
+  std::optional<uint64_t> last_tuple_time = {};
+  uint64_t tuples_since_pool_check = 0;
 
  protected:
   CEA::DetCEA cea;
+  MiniPool::PoolCompactionSettings pool_compaction_settings = {};
+  uint64_t pool_bytes_released = 0;
+  // The outputs are still read after the next tuples are evaluated.
+  bool outputs_are_pipelined = false;
+  // Published by the thread of the evaluator, see load_published_statistics.
+  PublishedQueryStatistics published_statistics;
 
  public:
   std::atomic<uint64_t> time_of_expiration = 0;
@@ -36,37 +49,81 @@ class GenericEvaluator {
       : cea(std::move(cea)),
         time_window(time_window),
         query_catalog(query_catalog),
-        queue(queue) {}
+        queue(queue),
+        time_of_tuple(time_window, query_catalog) {}
+
+  const CEA::DetCEA& get_det_cea_reference() const { return cea; }
+
+  // See DetCEA::materialize, called before the first tuple.
+  void materialize_det_cea(uint64_t maximum_states) { cea.materialize(maximum_states); }
+
+  // The time of every tuple is recorded in it, called before the first tuple.
+  void record_times_in(IngestWatermark& watermark) { ingest_watermark = &watermark; }
+
+  /**
+   * The outputs are handled by another thread while the next tuples are
+   * evaluated, see ResultStage, so they can still read the tECS of any
+   * evaluator. Called before the first tuple.
+   */
+  void pipeline_outputs() { outputs_are_pipelined = true; }
+
+  /**
+   * The time of the tuple evaluated last if record_times_in was not called,
+   * for the thread that records it once the output of the tuple is handled.
+   * Empty if no tuple was evaluated since the last call.
+   */
+  std::optional<uint64_t> take_last_tuple_time() {
+    return std::exchange(last_tuple_time, std::nullopt);
+  }
+
+  // When the DetCEA and the tECS give their pools back, called before the first tuple.
+  void compact_pools_with(const MiniPool::PoolCompactionSettings& settings) {
+    pool_compaction_settings = settings;
+  }
+
+  /**
+   * The last statistics the evaluator published, any thread can read them
+   * while it runs. Every evaluator documents how often it publishes them.
+   */
+  QueryStatistics load_published_statistics() const {
+    return published_statistics.load();
+  }
 
  protected:
-  uint64_t tuple_time(RingTupleQueue::Tuple& tuple) {
-    ZoneScopedN("Interface::GenericEvaluator::tuple_time");
-    uint64_t time;
-    switch (time_window.mode) {
-      case CEQL::Within::TimeWindowMode::NONE:
-      case CEQL::Within::TimeWindowMode::EVENTS:
-        time = current_stream_position++;
-        break;
-      case CEQL::Within::TimeWindowMode::NANOSECONDS:
-        time = tuple.nanoseconds();
-        break;
-      case CEQL::Within::TimeWindowMode::ATTRIBUTE: {
-        Types::UniqueEventTypeId event_type_id = tuple.id();
-        auto index = indexes.find(event_type_id);
-        if (index == indexes.end()) [[unlikely]] {
-          indexes[event_type_id] = query_catalog
-                                     .get_index_attribute(event_type_id,
-                                                          time_window.attribute_name);
-        }
-        uint64_t attribute_index = indexes[event_type_id];
-        time = *tuple[attribute_index];
-        break;
-      }
-      default:
-        assert(false && "Unknown time_window mode in next_data.");
-        break;
+  QueryStatistics det_cea_statistics() const {
+    QueryStatistics out;
+    out.det_cea_states = cea.get_amount_of_states();
+    out.det_cea_computed_transitions = cea.get_amount_of_misses();
+    out.det_cea_retained_bytes = cea.state_manager.retained_bytes();
+    out.det_cea_live_bytes = cea.state_manager.live_bytes();
+    out.pool_bytes_released = pool_bytes_released;
+    return out;
+  }
+
+  /**
+   * True every POOL_COMPACTION_CHECK_INTERVAL tuples while the compaction is
+   * enabled, so the clock is not read for every tuple.
+   */
+  bool should_check_pools() {
+    if (pool_compaction_settings.utilization_threshold <= 0
+        || ++tuples_since_pool_check < MiniPool::POOL_COMPACTION_CHECK_INTERVAL) {
+      return false;
     }
+    tuples_since_pool_check = 0;
+    return true;
+  }
 
+  void compact_det_cea_if_underused(std::chrono::steady_clock::time_point now) {
+    pool_bytes_released += cea.compact_if_underused(pool_compaction_settings, now);
+  }
+
+  uint64_t tuple_time(RingTupleQueue::Tuple& tuple) {
+    uint64_t time = time_of_tuple(tuple);
+    if (ingest_watermark != nullptr) {
+      ingest_watermark->record(time, tuple.timestamp());
+    } else {
+      last_tuple_time = time;
+    }
     return time;
   }
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+#include "core_server/internal/ceql/query/within.hpp"
+
+namespace CORE::Internal::Interface {
+
+// Marks an IngestWatermark keeps for the tuples of a single time window.
+const uint64_t INGEST_WATERMARK_MARKS_PER_WINDOW = 64;
+
+/**
+ * Maps the time of expiration of a query, which is in the unit of its time
+ * window (events, an attribute or nanoseconds), back to the time its tuples
+ * were ingested, which is what the ring tuple queue uses to recycle them.
+ *
+ * The thread that publishes the time of expiration of the query records the
+ * time of every tuple evaluated and advances the watermark after every
+ * tuple, in the order of the stream. Tuples with close times share a mark
+ * that keeps their maximum time, so a mark expires once all its tuples did.
+ * Every tuple ingested before the oldest mark that did not expire is not
+ * needed by the query anymore, even if the times are out of order.
+ */
+class IngestWatermark {
+  using Clock = std::chrono::system_clock;
+
+  struct Mark {
+    uint64_t first_time;
+    uint64_t maximum_time;
+    Clock::time_point ingested;
+  };
+
+  std::deque<Mark> marks = {};
+  uint64_t granularity = 1;
+  // Nothing is recycled until the query processes its first tuple.
+  std::atomic<Clock::rep> watermark = Clock::time_point::min().time_since_epoch().count();
+
+ public:
+  // Called before the query starts.
+  void set_time_window(const CEQL::Within::TimeWindow& time_window) {
+    granularity = std::max<uint64_t>(1,
+                                     time_window.duration
+                                       / INGEST_WATERMARK_MARKS_PER_WINDOW);
+  }
+
+  // Called with the time given to the evaluator for a tuple.
+  void record(uint64_t time, Clock::time_point ingested) {
+    // A time lower than the last mark stays with it, the mark was ingested before.
+    if (!marks.empty()
+        && (time < marks.back().first_time
+            || time - marks.back().first_time < granularity)) {
+      marks.back().maximum_time = std::max(marks.back().maximum_time, time);
+      return;
+    }
+    marks.push_back({time, time, ingested});
+  }
+
+  /**
+   * Called once the tuple ingested at the given time and its output were
+   * processed, evaluated or not.
+   */
+  void advance(Clock::time_point ingested, uint64_t time_of_expiration) {
+    while (!marks.empty() && marks.front().maximum_time < time_of_expiration) {
+      marks.pop_front();
+    }
+    Clock::time_point oldest_needed = marks.empty() ? ingested : marks.front().ingested;
+    // The next tuple could have been ingested in the same clock tick.
+    watermark.store((oldest_needed - Clock::duration(1)).time_since_epoch().count(),
+                    std::memory_order_release);
+  }
+
+  // The tuples ingested up to this time are not needed by the query.
+  Clock::time_point load() const {
+    return Clock::time_point(Clock::duration(watermark.load(std::memory_order_acquire)));
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CORE::Internal::Interface {
+
+const size_t DEFAULT_MAXIMUM_POOLED_EVALUATORS = 64;
+
+/**
+ * Decides what happens when a tuple of a new partition arrives and the
+ * maximum amount of live partitions has already been reached.
+ */
+enum class PartitionEvictionPolicy {
+  // Evict the partition that received a tuple least recently. Its partial
+  // matches are lost.
+  LEAST_RECENTLY_USED,
+  // Keep the live partitions and ignore the tuples of the new partition.
+  IGNORE_NEW_PARTITIONS,
+};
+
+struct PartitionBySettings {
+  // 0 means that the amount of live partitions is not bounded.
+  size_t maximum_live_partitions = 0;
+  PartitionEvictionPolicy eviction_policy = PartitionEvictionPolicy::LEAST_RECENTLY_USED;
+  // Evaluators of reclaimed partitions that are kept to be reused.
+  size_t maximum_pooled_evaluators = DEFAULT_MAXIMUM_POOLED_EVALUATORS;
+  // Threads that evaluate the partitions of each query, every thread owns the
+  // partitions whose values hash to it. With 0 the query thread evaluates
+  // them. The bounds above are split among the threads.
+  size_t worker_threads = 0;
+};
+
+struct PartitionByStatistics {
+  uint64_t live_partitions = 0;
+  uint64_t pooled_evaluators = 0;
+  // Partitions whose union lists all expired from the time window.
+  uint64_t reclaimed_partitions = 0;
+  // Partitions removed by the eviction policy.
+  uint64_t evicted_partitions = 0;
+  uint64_t ignored_tuples = 0;
+  // Estimate of the memory held by the live and pooled evaluators.
+  uint64_t bytes_used = 0;
+};
+}  // namespace CORE::Internal::Interface
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core_server/internal/stream/ring_tuple_queue/ingest_clock.hpp"
+
+namespace CORE::Internal::Interface {
+
+// Bucket i of the latency histogram counts the latencies whose amount of
+// nanoseconds has bit width i, the last bucket counts every longer latency.
+const size_t QUERY_LATENCY_HISTOGRAM_BUCKETS = 40;
+
+/**
+ * Counters of the events of a query, kept while it runs. They are written by
+ * the thread that hands the outputs of the query to its result handler and
+ * read by any thread, except the evaluation time and the outputs dropped,
+ * which are written by the thread that evaluates the events. Every counter
+ * has a single writer, so it is updated with a relaxed load and store, which
+ * costs as much as a plain increment.
+ */
+class QueryCounters {
+  using Clock = std::chrono::system_clock;
+
+  std::atomic<uint64_t> events_processed = 0;
+  std::atomic<uint64_t> matches_emitted = 0;
+  // Time spent evaluating the events and handing their outputs to the result
+  // handler, which can happen in different threads, see ResultStage.
+  std::atomic<uint64_t> evaluation_nanoseconds = 0;
+  std::atomic<uint64_t> emission_nanoseconds = 0;
+  std::atomic<uint64_t> outputs_dropped = 0;
+  // Time since the event was ingested until its output was handled.
+  std::array<std::atomic<uint64_t>, QUERY_LATENCY_HISTOGRAM_BUCKETS>
+    latency_histogram = {};
+  // Writer local.
+  RingTupleQueue::IngestClock clock;
+
+ public:
+  // Called once the output of an event relevant to the query was handled.
+  void record_event(Clock::time_point ingested, bool has_output) {
+    increment(events_processed);
+    if (has_output) {
+      increment(matches_emitted);
+    }
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         clock.now() - ingested)
+                         .count();
+    // The clocks of the queue and of this thread can be slightly apart.
+    uint64_t latency = std::max<int64_t>(0, nanoseconds);
+    size_t bucket = std::min<size_t>(std::bit_width(latency),
+                                     QUERY_LATENCY_HISTOGRAM_BUCKETS - 1);
+    increment(latency_histogram[bucket]);
+  }
+
+  // Called by the thread that evaluates the events.
+  void record_evaluation(Clock::duration duration) {
+    add(evaluation_nanoseconds, duration);
+  }
+
+  // Called by the thread that evaluates the events, see ResultBackpressure.
+  void record_dropped_output() { increment(outputs_dropped); }
+
+  void record_emission(Clock::duration duration) { add(emission_nanoseconds, duration); }
+
+  uint64_t get_events_processed() const {
+    return events_processed.load(std::memory_order_relaxed);
+  }
+
+  // Events whose output had complex events.
+  uint64_t get_matches_emitted() const {
+    return matches_emitted.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_evaluation_nanoseconds() const {
+    return evaluation_nanoseconds.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_emission_nanoseconds() const {
+    return emission_nanoseconds.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_outputs_dropped() const {
+    return outputs_dropped.load(std::memory_order_relaxed);
+  }
+
+  std::vector<uint64_t> get_latency_histogram() const {
+    std::vector<uint64_t> out;
+    out.reserve(QUERY_LATENCY_HISTOGRAM_BUCKETS);
+    for (const auto& bucket : latency_histogram) {
+      out.push_back(bucket.load(std::memory_order_relaxed));
+    }
+    return out;
+  }
+
+ private:
+  static void increment(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static void add(std::atomic<uint64_t>& counter, Clock::duration duration) {
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                         .count();
+    counter.store(counter.load(std::memory_order_relaxed)
+                    + static_cast<uint64_t>(std::max<int64_t>(0, nanoseconds)),
+                  std::memory_order_relaxed);
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace CORE::Internal::Interface {
+
+/**
+ * Size of the structures a query builds while it evaluates. They are not
+ * synchronized with the query thread, so they are only read when the query
+ * is known to be idle, for example after Backend::wait_until_processed.
+ */
+struct QueryStatistics {
+  // States of the DetCEA that are materialized.
+  uint64_t det_cea_states = 0;
+  // Transitions that were not memoized by the DetCEA and had to be computed.
+  uint64_t det_cea_computed_transitions = 0;
+  // Nodes in the memory pools of the tECS of every partition.
+  uint64_t tecs_nodes_allocated = 0;
+  // Nodes created by the tECS of every partition, recycled ones included.
+  uint64_t tecs_nodes_used = 0;
+  // Nodes of the tECS of every partition that were reused once unreachable.
+  uint64_t tecs_nodes_recycled = 0;
+  // Memory of the pools of the DetCEA and the part of it with pinned states.
+  uint64_t det_cea_retained_bytes = 0;
+  uint64_t det_cea_live_bytes = 0;
+  // Memory of the pools of the tECS of every partition and the part of it
+  // with nodes that are not free.
+  uint64_t tecs_retained_bytes = 0;
+  uint64_t tecs_live_bytes = 0;
+  // Given back by the compaction of the pools, see PoolCompactionSettings.
+  uint64_t pool_bytes_released = 0;
+
+  // Adds the statistics of another evaluator of the same query.
+  QueryStatistics& operator+=(const QueryStatistics& other) {
+    det_cea_states += other.det_cea_states;
+    det_cea_computed_transitions += other.det_cea_computed_transitions;
+    tecs_nodes_allocated += other.tecs_nodes_allocated;
+    tecs_nodes_used += other.tecs_nodes_used;
+    tecs_nodes_recycled += other.tecs_nodes_recycled;
+    det_cea_retained_bytes += other.det_cea_retained_bytes;
+    det_cea_live_bytes += other.det_cea_live_bytes;
+    tecs_retained_bytes += other.tecs_retained_bytes;
+    tecs_live_bytes += other.tecs_live_bytes;
+    pool_bytes_released += other.pool_bytes_released;
+    return *this;
+  }
+};
+
+/**
+ * Copy of the QueryStatistics of an evaluator that other threads can read
+ * while it runs. Only the thread of the evaluator publishes it.
+ */
+class PublishedQueryStatistics {
+  std::atomic<uint64_t> det_cea_states = 0;
+  std::atomic<uint64_t> det_cea_computed_transitions = 0;
+  std::atomic<uint64_t> tecs_nodes_allocated = 0;
+  std::atomic<uint64_t> tecs_nodes_used = 0;
+  std::atomic<uint64_t> tecs_nodes_recycled = 0;
+  std::atomic<uint64_t> det_cea_retained_bytes = 0;
+  std::atomic<uint64_t> det_cea_live_bytes = 0;
+  std::atomic<uint64_t> tecs_retained_bytes = 0;
+  std::atomic<uint64_t> tecs_live_bytes = 0;
+  std::atomic<uint64_t> pool_bytes_released = 0;
+
+ public:
+  void publish(const QueryStatistics& statistics) {
+    det_cea_states.store(statistics.det_cea_states, std::memory_order_relaxed);
+    det_cea_computed_transitions.store(statistics.det_cea_computed_transitions,
+                                       std::memory_order_relaxed);
+    tecs_nodes_allocated.store(statistics.tecs_nodes_allocated,
+                               std::memory_order_relaxed);
+    tecs_nodes_used.store(statistics.tecs_nodes_used, std::memory_order_relaxed);
+    tecs_nodes_recycled.store(statistics.tecs_nodes_recycled, std::memory_order_relaxed);
+    det_cea_retained_bytes.store(statistics.det_cea_retained_bytes,
+                                 std::memory_order_relaxed);
+    det_cea_live_bytes.store(statistics.det_cea_live_bytes, std::memory_order_relaxed);
+    tecs_retained_bytes.store(statistics.tecs_retained_bytes, std::memory_order_relaxed);
+    tecs_live_bytes.store(statistics.tecs_live_bytes, std::memory_order_relaxed);
+    pool_bytes_released.store(statistics.pool_bytes_released, std::memory_order_relaxed);
+  }
+
+  QueryStatistics load() const {
+    return {det_cea_states.load(std::memory_order_relaxed),
+            det_cea_computed_transitions.load(std::memory_order_relaxed),
+            tecs_nodes_allocated.load(std::memory_order_relaxed),
+            tecs_nodes_used.load(std::memory_order_relaxed),
+            tecs_nodes_recycled.load(std::memory_order_relaxed),
+            det_cea_retained_bytes.load(std::memory_order_relaxed),
+            det_cea_live_bytes.load(std::memory_order_relaxed),
+            tecs_retained_bytes.load(std::memory_order_relaxed),
+            tecs_live_bytes.load(std::memory_order_relaxed),
+            pool_bytes_released.load(std::memory_order_relaxed)};
+  }
+};
+}  // namespace CORE::Internal::Interface
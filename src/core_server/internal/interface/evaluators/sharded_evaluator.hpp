@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <tracy/Tracy.hpp>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/ceql/query/consume_by.hpp"
+#include "core_server/internal/ceql/query/limit.hpp"
+#include "core_server/internal/ceql/query/within.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/cea/cea.hpp"
+#include "core_server/internal/evaluation/det_cea/det_cea.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/dynamic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/ingest_watermark.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_counters.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/evaluators/thread_wakeup.hpp"
+#include "core_server/internal/interface/evaluators/tuple_time.hpp"
+#include "core_server/internal/interface/evaluators/vector_hash.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/ingest_clock.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+namespace CORE::Internal::Interface {
+
+// Tuples handed to the shards whose outputs were not handled yet, a power of 2.
+const size_t SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES = 1024;
+
+/**
+ * Evaluates a PARTITION BY query in several threads. The partition values
+ * are hashed with VectorHash to a shard, every shard is a DynamicEvaluator
+ * with its own partitions and tECS that runs in its own thread.
+ *
+ * The query thread computes the time of every tuple and hands it to its
+ * shard. A merge thread hands the outputs to the result handler in the
+ * order of the stream and advances processed_sequence, the ingest
+ * watermark and the counters of the query. An enumerator reads
+ * the tECS of its shard, so a shard that outputs waits until the output is
+ * handled before evaluating its next tuple.
+ *
+ * With CONSUME BY ANY an output resets the partitions of every shard, so a
+ * tuple is evaluated only after every tuple before it was handled, and the
+ * shards evaluate one tuple at a time.
+ */
+template <typename ResultHandlerT>
+class ShardedEvaluator {
+  static constexpr size_t NO_SHARD = SIZE_MAX;
+
+  enum class PendingState : uint32_t {
+    EMPTY,
+    QUEUED,
+    EVALUATED,
+  };
+
+  struct PendingTuple {
+    std::atomic<PendingState> state = PendingState::EMPTY;
+    uint64_t sequence = 0;
+    // Tuples not relevant to the query advance processed_sequence only.
+    bool is_relevant = false;
+    size_t shard = NO_SHARD;
+    uint64_t* data = nullptr;
+    uint64_t time = 0;
+    std::vector<uint64_t> partition_values = {};
+    Evaluation::SharedPredicateResult shared_result = {};
+    std::optional<tECS::Enumerator> output = {};
+    uint64_t time_of_expiration = 0;
+  };
+
+  struct alignas(64) Shard {
+    std::unique_ptr<DynamicEvaluator> evaluator;
+    // Null if the predicates of the query are not shared.
+    std::shared_ptr<Evaluation::SharedPredicateView> shared_predicate_view;
+    std::atomic<uint64_t> time_of_expiration = 0;
+    // Positions of the pending tuples of the shard, in order.
+    std::unique_ptr<uint64_t[]> positions;
+    std::atomic<uint64_t> amount_of_positions = 0;
+    // Shard local.
+    uint64_t next_position_idx = 0;
+    uint64_t outputs_produced = 0;
+    uint64_t last_reset_epoch = 0;
+    std::atomic<uint64_t> outputs_handled = 0;
+    ThreadWakeup wakeup;
+    std::thread thread;
+  };
+
+  CEQL::ConsumeBy::ConsumptionPolicy consumption_policy;
+  RingTupleQueue::Queue& queue;
+  ResultHandlerT& result_handler;
+  std::atomic<uint64_t>& processed_sequence;
+  std::atomic<uint64_t>& event_time_of_expiration;
+  // Merge thread local.
+  IngestWatermark& ingest_watermark;
+  QueryCounters& counters;
+  RingTupleQueue::IngestClock merge_clock;
+
+  std::vector<std::unique_ptr<Shard>> shards = {};
+  // Destroyed before the shards, the outputs read their tECS.
+  std::unique_ptr<PendingTuple[]> pending_tuples;
+  uint64_t pending_tuples_mask = SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES - 1;
+  // Query thread local.
+  TupleTime tuple_time;
+  uint64_t next_position = 0;
+  ThreadWakeup query_wakeup;
+
+  alignas(64) std::atomic<uint64_t> merged_position = 0;
+  // Incremented on every output with CONSUME BY ANY.
+  std::atomic<uint64_t> reset_epoch = 0;
+  std::atomic<bool> is_stopped = false;
+  ThreadWakeup merge_wakeup;
+  std::thread merge_thread;
+
+ public:
+  ShardedEvaluator(const CEA::CEA& cea,
+                   const Evaluation::PredicateEvaluator& tuple_evaluator,
+                   std::atomic<uint64_t>& event_time_of_expiration,
+                   CEQL::ConsumeBy::ConsumptionPolicy consumption_policy,
+                   CEQL::Limit limit,
+                   CEQL::Within::TimeWindow time_window,
+                   Internal::QueryCatalog& query_catalog,
+                   RingTupleQueue::Queue& queue,
+                   PartitionBySettings settings,
+                   uint64_t eager_det_cea_states,
+                   const MiniPool::PoolCompactionSettings& pool_compaction_settings,
+                   ResultHandlerT& result_handler,
+                   std::atomic<uint64_t>& processed_sequence,
+                   IngestWatermark& ingest_watermark,
+                   QueryCounters& counters)
+      : consumption_policy(consumption_policy),
+        queue(queue),
+        result_handler(result_handler),
+        processed_sequence(processed_sequence),
+        event_time_of_expiration(event_time_of_expiration),
+        ingest_watermark(ingest_watermark),
+        counters(counters),
+        pending_tuples(
+          std::make_unique<PendingTuple[]>(SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES)),
+        tuple_time(time_window, query_catalog) {
+    static_assert((SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES
+                   & (SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES - 1))
+                  == 0);
+    assert(settings.worker_threads > 0);
+    size_t amount_of_shards = settings.worker_threads;
+    PartitionBySettings shard_settings = settings;
+    if (settings.maximum_live_partitions != 0) {
+      shard_settings.maximum_live_partitions = std::max<size_t>(
+        1, settings.maximum_live_partitions / amount_of_shards);
+    }
+    shard_settings.maximum_pooled_evaluators = settings.maximum_pooled_evaluators
+                                               / amount_of_shards;
+    for (size_t i = 0; i < amount_of_shards; i++) {
+      auto shard = std::make_unique<Shard>();
+      Evaluation::PredicateEvaluator shard_tuple_evaluator = tuple_evaluator;
+      // Every shard points its view to the results of its own tuple.
+      if (tuple_evaluator.get_shared_view() != nullptr) {
+        shard->shared_predicate_view = std::make_shared<Evaluation::SharedPredicateView>(
+          tuple_evaluator.get_shared_view()->query_id);
+        shard_tuple_evaluator.use_shared_results(shard->shared_predicate_view);
+      }
+      shard->evaluator = std::make_unique<DynamicEvaluator>(
+        CEA::DetCEA(CEA::CEA(cea)),
+        std::move(shard_tuple_evaluator),
+        shard->time_of_expiration,
+        consumption_policy,
+        limit,
+        time_window,
+        query_catalog,
+        queue,
+        shard_settings);
+      // Before the thread of the shard starts.
+      if (eager_det_cea_states > 0) {
+        shard->evaluator->materialize_det_cea(eager_det_cea_states);
+      }
+      shard->evaluator->compact_pools_with(pool_compaction_settings);
+      shard->positions = std::make_unique<uint64_t[]>(
+        SHARDED_EVALUATOR_MAXIMUM_PENDING_TUPLES);
+      shards.push_back(std::move(shard));
+    }
+    for (auto& shard : shards) {
+      Shard& owned_shard = *shard;
+      shard->thread = std::thread(
+        [this, &owned_shard]() { evaluate_shard(owned_shard); });
+    }
+    merge_thread = std::thread([this]() { merge_outputs(); });
+  }
+
+  ShardedEvaluator(const ShardedEvaluator&) = delete;
+  ShardedEvaluator& operator=(const ShardedEvaluator&) = delete;
+
+  /**
+   * Stops the threads, the outputs that were not handled yet are dropped.
+   * The query thread must not hand any more tuples.
+   */
+  ~ShardedEvaluator() {
+    is_stopped.store(true, std::memory_order_release);
+    merge_wakeup.wake_up();
+    merge_thread.join();
+    for (auto& shard : shards) {
+      shard->wakeup.wake_up();
+      shard->thread.join();
+    }
+  }
+
+  /**
+   * Called by the query thread for a tuple that no shard evaluates. The
+   * result handler receives an empty output if the tuple is relevant to the
+   * query, as with a single evaluator.
+   */
+  void skip_tuple(RingTupleQueue::Tuple tuple, uint64_t sequence, bool is_relevant) {
+    PendingTuple& pending = claim_pending_tuple(sequence);
+    pending.is_relevant = is_relevant;
+    pending.shard = NO_SHARD;
+    pending.data = tuple.get_data();
+    pending.state.store(PendingState::EVALUATED, std::memory_order_release);
+    merge_wakeup.wake_up();
+  }
+
+  /**
+   * Called by the query thread for every relevant tuple with partition
+   * values, in the order of the stream.
+   * @param shared_result Copied, null if the predicates are not shared.
+   */
+  void process_event(RingTupleQueue::Tuple tuple,
+                     uint64_t sequence,
+                     const std::vector<uint64_t>& partition_values,
+                     const Evaluation::SharedPredicateResult* shared_result) {
+    ZoneScopedN("Interface::ShardedEvaluator::process_event");
+    uint64_t time = tuple_time(tuple);
+    uint64_t position = next_position;
+    PendingTuple& pending = claim_pending_tuple(sequence);
+    pending.is_relevant = true;
+    pending.shard = VectorHash{}(partition_values) % shards.size();
+    pending.data = tuple.get_data();
+    pending.time = time;
+    pending.partition_values = partition_values;
+    if (shared_result != nullptr) {
+      pending.shared_result = *shared_result;
+    } else {
+      pending.shared_result.mapping = nullptr;
+    }
+    pending.state.store(PendingState::QUEUED, std::memory_order_relaxed);
+
+    Shard& shard = *shards[pending.shard];
+    uint64_t amount = shard.amount_of_positions.load(std::memory_order_relaxed);
+    // There are never more positions queued than pending tuples.
+    shard.positions[amount & pending_tuples_mask] = position;
+    shard.amount_of_positions.store(amount + 1, std::memory_order_release);
+    shard.wakeup.wake_up();
+  }
+
+  PartitionByStatistics get_statistics() const {
+    PartitionByStatistics out;
+    for (const auto& shard : shards) {
+      PartitionByStatistics statistics = shard->evaluator->get_statistics();
+      out.live_partitions += statistics.live_partitions;
+      out.pooled_evaluators += statistics.pooled_evaluators;
+      out.reclaimed_partitions += statistics.reclaimed_partitions;
+      out.evicted_partitions += statistics.evicted_partitions;
+      out.ignored_tuples += statistics.ignored_tuples;
+      out.bytes_used += statistics.bytes_used;
+    }
+    return out;
+  }
+
+  // Every shard determinizes the automaton on its own, so its states add up.
+  QueryStatistics get_query_statistics() const {
+    return sum_of_shards([](const DynamicEvaluator& evaluator) {
+      return evaluator.get_query_statistics();
+    });
+  }
+
+  QueryStatistics load_published_statistics() const {
+    return sum_of_shards([](const DynamicEvaluator& evaluator) {
+      return evaluator.load_published_statistics();
+    });
+  }
+
+  size_t amount_of_shards() const { return shards.size(); }
+
+ private:
+  template <typename StatisticsOf>
+  QueryStatistics sum_of_shards(StatisticsOf&& statistics_of) const {
+    QueryStatistics out;
+    for (const auto& shard : shards) {
+      out += statistics_of(*shard->evaluator);
+    }
+    return out;
+  }
+
+  PendingTuple& claim_pending_tuple(uint64_t sequence) {
+    PendingTuple& pending = pending_tuples[next_position & pending_tuples_mask];
+    query_wakeup.wait_until([&]() {
+      return pending.state.load(std::memory_order_acquire) == PendingState::EMPTY;
+    });
+    next_position++;
+    pending.sequence = sequence;
+    return pending;
+  }
+
+  bool is_consume_by_any() const {
+    return consumption_policy == CEQL::ConsumeBy::ConsumptionPolicy::ANY;
+  }
+
+  void evaluate_shard(Shard& shard) {
+    ZoneScopedN("Interface::ShardedEvaluator::evaluate_shard");
+    while (true) {
+      shard.wakeup.wait_until([&]() {
+        return is_stopped.load(std::memory_order_acquire)
+               || shard.amount_of_positions.load(std::memory_order_acquire)
+                    != shard.next_position_idx;
+      });
+      if (is_stopped.load(std::memory_order_acquire)) return;
+      uint64_t position = shard.positions[shard.next_position_idx & pending_tuples_mask];
+      shard.next_position_idx++;
+      PendingTuple& pending = pending_tuples[position & pending_tuples_mask];
+
+      if (is_consume_by_any()) {
+        shard.wakeup.wait_until([&]() {
+          return is_stopped.load(std::memory_order_acquire)
+                 || merged_position.load(std::memory_order_acquire) == position;
+        });
+        if (is_stopped.load(std::memory_order_acquire)) return;
+        // An output of another shard consumed every partial match.
+        uint64_t epoch = reset_epoch.load(std::memory_order_acquire);
+        if (epoch != shard.last_reset_epoch) {
+          shard.evaluator->reset_partitions();
+          shard.last_reset_epoch = epoch;
+        }
+      }
+
+      if (shard.shared_predicate_view != nullptr) {
+        shard.shared_predicate_view->current = &pending.shared_result;
+      }
+      pending.output = shard.evaluator->process_event(queue.get_tuple(pending.data),
+                                                      pending.time,
+                                                      pending.partition_values);
+      bool has_output = pending.output.has_value();
+      if (has_output) {
+        shard.outputs_produced++;
+        if (is_consume_by_any()) {
+          shard.last_reset_epoch = reset_epoch.fetch_add(1, std::memory_order_acq_rel)
+                                   + 1;
+        }
+      }
+      pending.time_of_expiration = shard.time_of_expiration.load(
+        std::memory_order_relaxed);
+      pending.state.store(PendingState::EVALUATED, std::memory_order_release);
+      merge_wakeup.wake_up();
+
+      if (has_output) {
+        shard.wakeup.wait_until([&]() {
+          return is_stopped.load(std::memory_order_acquire)
+                 || shard.outputs_handled.load(std::memory_order_acquire)
+                      == shard.outputs_produced;
+        });
+      }
+    }
+  }
+
+  void merge_outputs() {
+    ZoneScopedN("Interface::ShardedEvaluator::merge_outputs");
+    for (uint64_t position = 0;; position++) {
+      PendingTuple& pending = pending_tuples[position & pending_tuples_mask];
+      merge_wakeup.wait_until([&]() {
+        return is_stopped.load(std::memory_order_acquire)
+               || pending.state.load(std::memory_order_acquire)
+                    == PendingState::EVALUATED;
+      });
+      if (is_stopped.load(std::memory_order_acquire)) return;
+
+      bool has_output = pending.output.has_value();
+      RingTupleQueue::Tuple tuple = queue.get_tuple(pending.data);
+      if (pending.is_relevant) {
+        std::optional<tECS::Enumerator> output = std::move(pending.output);
+        pending.output.reset();
+        auto start = merge_clock.now();
+        result_handler(std::move(output));
+        counters.record_emission(merge_clock.now() - start);
+        counters.record_event(tuple.timestamp(), has_output);
+      }
+      if (pending.shard != NO_SHARD) {
+        // Every tuple before this one was evaluated, so no shard needs the
+        // tuples that expired for it.
+        event_time_of_expiration.store(pending.time_of_expiration);
+        ingest_watermark.record(pending.time, tuple.timestamp());
+        if (has_output) {
+          Shard& shard = *shards[pending.shard];
+          shard.outputs_handled.fetch_add(1, std::memory_order_release);
+          shard.wakeup.wake_up();
+        }
+      }
+      ingest_watermark.advance(tuple.timestamp(),
+                               event_time_of_expiration.load(std::memory_order_relaxed));
+      processed_sequence.store(pending.sequence + 1, std::memory_order_release);
+      pending.state.store(PendingState::EMPTY, std::memory_order_release);
+      query_wakeup.wake_up();
+      merged_position.store(position + 1, std::memory_order_release);
+      if (is_consume_by_any()) {
+        for (auto& shard : shards) {
+          shard->wakeup.wake_up();
+        }
+      }
+    }
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <tracy/Tracy.hpp>
@@ -15,6 +16,7 @@
 #include "core_server/internal/evaluation/evaluator.hpp"
 #include "core_server/internal/evaluation/predicate_evaluator.hpp"
 #include "core_server/internal/interface/evaluators/generic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 
@@ -43,8 +45,28 @@ class SingleEvaluator : public GenericEvaluator {
   std::optional<tECS::Enumerator> process_event(RingTupleQueue::Tuple tuple) {
     ZoneScopedN("Interface::SingleEvaluator::process_event");
     uint64_t time = tuple_time(tuple);
+    // The enumerators of the previous tuples were consumed or pin their nodes.
+    if (should_check_pools()) {
+      auto now = std::chrono::steady_clock::now();
+      pool_bytes_released += evaluator.compact_tecs_if_underused(pool_compaction_settings,
+                                                                 now);
+      compact_det_cea_if_underused(now);
+    }
 
-    return evaluator.next(tuple, time);
+    std::optional<tECS::Enumerator> output = evaluator.next(tuple, time);
+    // Every counter is read in O(1), so they are published after every tuple.
+    published_statistics.publish(get_query_statistics());
+    return output;
+  }
+
+  QueryStatistics get_query_statistics() const {
+    QueryStatistics out = det_cea_statistics();
+    out.tecs_nodes_allocated = evaluator.get_tecs_reference().amount_of_nodes_allocated();
+    out.tecs_nodes_used = evaluator.get_tecs_reference().amount_of_nodes_used();
+    out.tecs_nodes_recycled = evaluator.get_tecs_reference().amount_of_nodes_recycled();
+    out.tecs_retained_bytes = evaluator.get_tecs_reference().retained_bytes();
+    out.tecs_live_bytes = evaluator.get_tecs_reference().live_bytes();
+    return out;
   }
 };
 }  // namespace CORE::Internal::Interface
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace CORE::Internal::Interface {
+
+// Times a thread waiting on a ThreadWakeup polls before going to sleep.
+const size_t THREAD_WAKEUP_SPINS_BEFORE_SLEEP = 256;
+
+/**
+ * Lets a thread sleep until a condition holds. The threads that can make it
+ * hold call wake_up after changing it, which costs no system call when
+ * nobody is sleeping.
+ */
+class ThreadWakeup {
+  std::atomic<uint32_t> wakeup_signal = 0;
+  std::atomic<uint64_t> amount_of_sleepers = 0;
+
+ public:
+  template <typename Condition>
+  void wait_until(Condition&& condition) {
+    for (size_t spins = 0; !condition(); spins++) {
+      if (spins < THREAD_WAKEUP_SPINS_BEFORE_SLEEP) {
+        std::this_thread::yield();
+        continue;
+      }
+      amount_of_sleepers.fetch_add(1, std::memory_order_seq_cst);
+      uint32_t signal = wakeup_signal.load(std::memory_order_seq_cst);
+      if (!condition()) {
+        wakeup_signal.wait(signal);
+      }
+      amount_of_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void wake_up() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (amount_of_sleepers.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+      wakeup_signal.fetch_add(1, std::memory_order_seq_cst);
+      wakeup_signal.notify_all();
+    }
+  }
+};
+}  // namespace CORE::Internal::Interface
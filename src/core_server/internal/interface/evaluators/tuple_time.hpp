@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <tracy/Tracy.hpp>
+#include <vector>
+
+#include "core_server/internal/ceql/query/within.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "shared/datatypes/aliases/event_type_id.hpp"
+
+namespace CORE::Internal::Interface {
+
+/**
+ * The time of the tuples of a query in the unit of its time window: their
+ * position in the stream, their nanoseconds or their time attribute. Must be
+ * called once for every tuple relevant to the query, in order.
+ */
+class TupleTime {
+  uint64_t current_stream_position = 0;
+  CEQL::Within::TimeWindowMode mode;
+  // Of the time attribute, indexed by UniqueEventTypeId.
+  std::vector<AttributeOffset> time_attribute_offsets{};
+
+ public:
+  TupleTime(const CEQL::Within::TimeWindow& time_window,
+            Internal::QueryCatalog& query_catalog)
+      : mode(time_window.mode) {
+    if (mode == CEQL::Within::TimeWindowMode::ATTRIBUTE) {
+      time_attribute_offsets = query_catalog.get_attribute_offsets(
+        time_window.attribute_name);
+    }
+  }
+
+  uint64_t operator()(RingTupleQueue::Tuple& tuple) {
+    ZoneScopedN("Interface::TupleTime::operator()");
+    switch (mode) {
+      case CEQL::Within::TimeWindowMode::NONE:
+      case CEQL::Within::TimeWindowMode::EVENTS:
+        return current_stream_position++;
+      case CEQL::Within::TimeWindowMode::NANOSECONDS:
+        return tuple.nanoseconds();
+      case CEQL::Within::TimeWindowMode::ATTRIBUTE: {
+        Types::UniqueEventTypeId event_type_id = tuple.id();
+        if (event_type_id >= time_attribute_offsets.size()
+            || !time_attribute_offsets[event_type_id].present) [[unlikely]] {
+          throw std::runtime_error("attribute_name not found");
+        }
+        return *tuple.at_offset(time_attribute_offsets[event_type_id].word_offset);
+      }
+      default:
+        assert(false && "Unknown time_window mode in next_data.");
+        return 0;
+    }
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CORE::Internal::Interface {
+
+// https://stackoverflow.com/questions/664014/what-integer-hash-function-are-good-that-accepts-an-integer-hash-key/12996028#12996028
+struct VectorHash {
+  std::size_t operator()(const std::vector<uint64_t>& vec) const noexcept {
+    std::size_t seed = vec.size();
+    for (const auto& x : vec) {
+      seed ^= hash(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+
+  uint64_t hash(uint64_t x) const noexcept {
+    x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+    x = x ^ (x >> 31);
+    return x;
+  }
+};
+}  // namespace CORE::Internal::Interface
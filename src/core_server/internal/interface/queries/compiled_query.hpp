@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/ceql/cel_formula/formula/visitors/formula_to_logical_cea.hpp"
+#include "core_server/internal/ceql/query/consume_by.hpp"
+#include "core_server/internal/ceql/query/limit.hpp"
+#include "core_server/internal/ceql/query/partition_by.hpp"
+#include "core_server/internal/ceql/query/query.hpp"
+#include "core_server/internal/ceql/query/select.hpp"
+#include "core_server/internal/ceql/query/within.hpp"
+#include "core_server/internal/ceql/query_transformer/annotate_predicates_with_new_physical_predicates.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/cea/cea.hpp"
+#include "core_server/internal/evaluation/physical_predicate/physical_predicate.hpp"
+
+namespace CORE::Internal::Interface {
+
+/**
+ * Everything a query needs from its CEQL::Query to be evaluated: the
+ * physical predicates, the optimized CEA and the clauses read while it runs.
+ * It is not modified once compiled, so the queries with the same text share
+ * it (see CompiledQueryCache), each one determinizes its own copy of the CEA.
+ */
+struct CompiledQuery {
+  std::set<std::string> streams;
+  CEQL::PartitionBy partition_by;
+  CEQL::Within::TimeWindow time_window;
+  CEQL::ConsumeBy::ConsumptionPolicy consumption_policy;
+  CEQL::Limit limit;
+  CEQL::Select::Output output;
+  std::vector<std::shared_ptr<CEA::PhysicalPredicate>> predicates;
+  CEA::CEA cea;
+
+  // The query catalog must be the one of the streams of the query.
+  static CompiledQuery compile(CEQL::Query&& query, QueryCatalog& query_catalog) {
+    CEQL::AnnotatePredicatesWithNewPhysicalPredicates transformer(query_catalog);
+    query = transformer(std::move(query));
+
+    auto visitor = CEQL::FormulaToLogicalCEA(query_catalog);
+    query.where.formula->accept_visitor(visitor);
+    if (!query.select.is_star) {
+      query.select.formula->accept_visitor(visitor);
+    }
+
+    std::vector<std::shared_ptr<CEA::PhysicalPredicate>> predicates;
+    for (auto& predicate : transformer.physical_predicates) {
+      predicates.push_back(std::move(predicate));
+    }
+    return {std::move(query.from.streams),
+            std::move(query.partition_by),
+            query.within.time_window,
+            query.consume_by.policy,
+            query.limit,
+            query.select.output,
+            std::move(predicates),
+            CEA::CEA(std::move(visitor.current_cea))};
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "core_server/internal/interface/queries/compiled_query.hpp"
+
+namespace CORE::Internal::Interface {
+
+const size_t DEFAULT_COMPILED_QUERY_CACHE_SIZE = 256;
+
+struct QueryCompilationSettings {
+  // Compiled queries kept to be reused by the queries declared with the same
+  // text, 0 disables the cache.
+  size_t compiled_query_cache_size = DEFAULT_COMPILED_QUERY_CACHE_SIZE;
+  // States of the DetCEA of a query that are created before it receives its
+  // first tuple, see DetCEA::materialize. With 0 they are created on demand.
+  uint64_t eager_det_cea_states = 0;
+};
+
+/**
+ * The text of a query without comments and with every run of whitespace
+ * outside of string literals, quoted identifiers and regexes replaced by a
+ * single space. Two texts with the same normalization parse to the same query.
+ */
+inline std::string normalize_query_text(std::string_view text) {
+  std::string out;
+  out.reserve(text.size());
+  bool pending_space = false;
+  size_t i = 0;
+  while (i < text.size()) {
+    char c = text[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = true;
+      i++;
+    } else if (text.substr(i, 2) == "--") {
+      pending_space = true;
+      while (i < text.size() && text[i] != '\n' && text[i] != '\r') i++;
+    } else if (text.substr(i, 2) == "/*") {
+      pending_space = true;
+      size_t end = text.find("*/", i + 2);
+      i = end == std::string_view::npos ? text.size() : end + 2;
+    } else {
+      if (pending_space && !out.empty()) {
+        out += ' ';
+      }
+      pending_space = false;
+      if (c == '\'' || c == '`') {
+        // Quotes inside are escaped by doubling them, which this also copies.
+        size_t end = text.find(c, i + 1);
+        end = end == std::string_view::npos ? text.size() : end + 1;
+        out += text.substr(i, end - i);
+        i = end;
+      } else if (text.substr(i, 2) == "<<") {
+        // As the REGEX mode of the lexer, which ends at >> unless it is \>.
+        size_t end = i + 2;
+        while (end < text.size() && text.substr(end, 2) != ">>") {
+          end += text.substr(end, 2) == "\\>" ? 2 : 1;
+        }
+        end = std::min(end + 2, text.size());
+        out += text.substr(i, end - i);
+        i = end;
+      } else {
+        out += c;
+        i++;
+      }
+    }
+  }
+  return out;
+}
+
+/**
+ * The compiled queries most recently declared, keyed by their normalized
+ * text. A compiled query depends on the catalog, so each one records the
+ * version of the catalog it was compiled with and is not reused after the
+ * catalog changes. Used by the thread that declares the queries.
+ */
+class CompiledQueryCache {
+  struct Entry {
+    std::string normalized_text;
+    uint64_t catalog_version;
+    std::shared_ptr<const CompiledQuery> compiled_query;
+  };
+
+  size_t maximum_size;
+  // Most recently used first.
+  std::list<Entry> entries;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+
+ public:
+  CompiledQueryCache(size_t maximum_size = DEFAULT_COMPILED_QUERY_CACHE_SIZE)
+      : maximum_size(maximum_size) {}
+
+  CompiledQueryCache(const CompiledQueryCache&) = delete;
+  CompiledQueryCache& operator=(const CompiledQueryCache&) = delete;
+
+  /**
+   * @return The query compiled from the normalized text with the catalog
+   * version, or null if it is not cached.
+   */
+  std::shared_ptr<const CompiledQuery>
+  find(const std::string& normalized_text, uint64_t catalog_version) {
+    auto it = index.find(normalized_text);
+    if (it == index.end() || it->second->catalog_version != catalog_version) {
+      misses++;
+      return nullptr;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->compiled_query;
+  }
+
+  void insert(std::string normalized_text,
+              uint64_t catalog_version,
+              std::shared_ptr<const CompiledQuery> compiled_query) {
+    if (maximum_size == 0) {
+      return;
+    }
+    if (auto it = index.find(normalized_text); it != index.end()) {
+      erase(it->second);
+    }
+    if (entries.size() == maximum_size) {
+      erase(std::prev(entries.end()));
+    }
+    entries.push_front(
+      {std::move(normalized_text), catalog_version, std::move(compiled_query)});
+    index.emplace(entries.front().normalized_text, entries.begin());
+  }
+
+  size_t size() const { return entries.size(); }
+
+  uint64_t get_amount_of_hits() const { return hits; }
+
+  uint64_t get_amount_of_misses() const { return misses; }
+
+ private:
+  void erase(std::list<Entry>::iterator entry) {
+    index.erase(entry->normalized_text);
+    entries.erase(entry);
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -2,28 +2,36 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <cstring>
-#include <exception>
-#include <iostream>
 #include <memory>
 #include <optional>
-#include <string>
 #include <thread>
 #include <tracy/Tracy.hpp>
 #include <utility>
-#include <zmq.hpp>
 
-#include "core_server/internal/ceql/query/query.hpp"
 #include "core_server/internal/ceql/query/within.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/generic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/ingest_watermark.hpp"
+#include "core_server/internal/interface/evaluators/query_counters.hpp"
+#include "core_server/internal/interface/queries/compiled_query.hpp"
+#include "core_server/internal/interface/queries/result_stage.hpp"
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/ingest_clock.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
-#include "shared/networking/message_receiver/zmq_message_receiver.hpp"
-#include "shared/networking/message_sender/zmq_message_sender.hpp"
 
 namespace CORE::Internal::Interface {
+
+// Times wait_until_processed polls before sleeping between polls.
+const size_t GENERIC_QUERY_SPINS_BEFORE_SLEEP = 1024;
+
 template <typename Derived, typename ResultHandlerT>
 class GenericQuery {
  protected:
@@ -31,88 +39,209 @@ class GenericQuery {
   Internal::QueryCatalog query_catalog;
   RingTupleQueue::Queue& queue;
   std::unique_ptr<ResultHandlerT> result_handler;
-
-  // Receiver for tuples
-  std::string receiver_address;
-  Internal::ZMQMessageReceiver receiver;
-  std::atomic<bool> stop_condition = false;
+  Evaluation::SharedPredicateEvaluator& shared_predicate_evaluator;
+  // Points to the shared results of the tuple being processed.
+  std::shared_ptr<Evaluation::SharedPredicateView> shared_predicate_view;
+
+  // Tuples sent by the backend, shared by all the queries.
+  Stream::BroadcastRing<uint64_t*>& tuple_ring;
+  Stream::BroadcastRing<uint64_t*>::ReaderId tuple_ring_reader;
+  // Sequence in the ring of the next tuple to process, the tuples before it
+  // and their outputs are done.
+  std::atomic<uint64_t> processed_sequence = 0;
   std::thread worker_thread;
+  // The evaluator whose outputs process_tuple hands to the result handler,
+  // null if the derived query hands them itself.
+  GenericEvaluator* query_thread_evaluator = nullptr;
+  // Null if the query thread hands the outputs to the result handler.
+  std::unique_ptr<ResultStage<ResultHandlerT>> result_stage;
+  // Query thread local.
+  RingTupleQueue::IngestClock query_thread_clock;
 
  public:
-  std::atomic<uint64_t*> last_received_tuple = nullptr;
   std::atomic<uint64_t> time_of_expiration = 0;
   CEQL::Within::TimeWindow time_window;
+  // Tuples of the ring tuple queue that the query does not need anymore.
+  IngestWatermark ingest_watermark;
+  // Written by the thread that handles the outputs of the query.
+  QueryCounters counters;
 
   GenericQuery(Internal::QueryCatalog query_catalog,
                RingTupleQueue::Queue& queue,
-               std::string inproc_receiver_address,
+               Stream::BroadcastRing<uint64_t*>& tuple_ring,
+               Evaluation::SharedPredicateEvaluator& shared_predicate_evaluator,
                std::unique_ptr<ResultHandlerT>&& result_handler)
       : query_catalog(query_catalog),
         queue(queue),
-        receiver_address(inproc_receiver_address),
-        receiver(receiver_address),
-        result_handler(std::move(result_handler)) {}
-
-  void init(Internal::CEQL::Query&& query) {
-    create_query(std::move(query));
+        result_handler(std::move(result_handler)),
+        shared_predicate_evaluator(shared_predicate_evaluator),
+        tuple_ring(tuple_ring) {}
+
+  /**
+   * Creates the evaluator of the query and starts it. With
+   * eager_det_cea_states > 0 the automaton creates up to that many states
+   * before the first tuple, see DetCEA::materialize. With
+   * result_stage_settings.maximum_pending_outputs > 0 the outputs are
+   * handled in a thread of their own, see ResultStage.
+   */
+  void init(std::shared_ptr<const CompiledQuery> compiled_query,
+            uint64_t eager_det_cea_states = 0,
+            MiniPool::PoolCompactionSettings pool_compaction_settings = {},
+            ResultStageSettings result_stage_settings = {}) {
+    create_query(std::move(compiled_query),
+                 eager_det_cea_states,
+                 pool_compaction_settings);
+    query_thread_evaluator = static_cast<Derived*>(this)->get_query_thread_evaluator();
+    if (query_thread_evaluator != nullptr) {
+      if (result_stage_settings.maximum_pending_outputs > 0) {
+        // The result stage records the times once their outputs are handled.
+        query_thread_evaluator->pipeline_outputs();
+        result_stage = std::make_unique<ResultStage<ResultHandlerT>>(
+          result_stage_settings,
+          *result_handler,
+          processed_sequence,
+          ingest_watermark,
+          counters);
+      } else {
+        query_thread_evaluator->record_times_in(ingest_watermark);
+      }
+    }
     start();
   }
 
   virtual ~GenericQuery() { stop(); };
 
-  zmq::context_t& get_inproc_context() { return receiver.get_context(); }
-
   ResultHandlerT& get_result_handler_reference() const { return *result_handler; }
 
+  /**
+   * Blocks until every tuple before sequence was processed and its output
+   * handled. Unlike BroadcastRing::wait_until_consumed, this also waits for
+   * the last tuple read to be evaluated.
+   */
+  void wait_until_processed(uint64_t sequence) const {
+    for (size_t spins = 0; processed_sequence.load(std::memory_order_acquire) < sequence;
+         spins++) {
+      if (spins < GENERIC_QUERY_SPINS_BEFORE_SLEEP) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+  }
+
+ protected:
+  /**
+   * Called by create_query, the predicates of tuple_evaluator are evaluated
+   * once for every query that shares them.
+   */
+  void share_predicates(Evaluation::PredicateEvaluator& tuple_evaluator) {
+    shared_predicate_view = std::make_shared<Evaluation::SharedPredicateView>(
+      shared_predicate_evaluator.add_query(tuple_evaluator.predicates,
+                                           processed_sequence));
+    tuple_evaluator.use_shared_results(shared_predicate_view);
+  }
+
  private:
-  void create_query(Internal::CEQL::Query&& query) {
-    static_cast<Derived*>(this)->create_query(std::move(query));
+  void create_query(std::shared_ptr<const CompiledQuery> compiled_query,
+                    uint64_t eager_det_cea_states,
+                    const MiniPool::PoolCompactionSettings& pool_compaction_settings) {
+    static_cast<Derived*>(this)->create_query(std::move(compiled_query),
+                                              eager_det_cea_states,
+                                              pool_compaction_settings);
   }
 
   void start() {
+    tuple_ring_reader = tuple_ring.subscribe();
+    processed_sequence.store(tuple_ring.read_sequence_of(tuple_ring_reader));
     worker_thread = std::thread([&]() {
       ZoneScopedN("QueryImpl::start::worker_thread");  //NOLINT
       result_handler->start();
-      while (!stop_condition) {
-        std::string serialized_message = receiver.receive();
-        std::optional<RingTupleQueue::Tuple> tuple = serialized_message_to_tuple(
-          serialized_message);
-        if (!tuple.has_value()) {
-          continue;
-        }
-        last_received_tuple.store(tuple->get_data());
-        std::optional<tECS::Enumerator> output = process_event(tuple.value());
-        (*result_handler)(std::move(output));
+      uint64_t sequence = processed_sequence.load(std::memory_order_relaxed);
+      // The ring returns nothing once stop unsubscribes this query.
+      while (std::optional<uint64_t*> data = tuple_ring.next(tuple_ring_reader)) {
+        RingTupleQueue::Tuple tuple = queue.get_tuple(data.value());
+        static_cast<Derived*>(this)->process_tuple(tuple, sequence++);
       }
     });
   }
 
-  void stop() {
-    try {
-      ZMQMessageSender sender(receiver_address, receiver.get_context());
-      stop_condition = true;
-      sender.send("STOP");
-      worker_thread.join();
-    } catch (std::exception& e) {
-      std::cout << "Exception: " << e.what() << std::endl;
+ protected:
+  /**
+   * Evaluates the tuple with the given ring sequence and hands its output to
+   * the result handler, or to the result stage that hands it. A derived
+   * query that evaluates in other threads replaces it, and then advances
+   * processed_sequence itself.
+   */
+  void process_tuple(RingTupleQueue::Tuple tuple, uint64_t sequence) {
+    bool is_relevant = query_catalog.is_unique_event_id_relevant_to_query(tuple.id());
+    std::optional<tECS::Enumerator> output = {};
+    if (is_relevant) {
+      if (shared_predicate_view != nullptr) {
+        shared_predicate_view->current = &shared_predicate_evaluator.result_of(sequence);
+      }
+      auto start = query_thread_clock.now();
+      output = process_event(tuple);
+      counters.record_evaluation(query_thread_clock.now() - start);
+    }
+    if (result_stage != nullptr) {
+      result_stage->push(sequence,
+                         is_relevant,
+                         tuple.timestamp(),
+                         query_thread_evaluator->take_last_tuple_time(),
+                         time_of_expiration.load(std::memory_order_relaxed),
+                         std::move(output));
+      return;
     }
+    if (is_relevant) {
+      bool has_output = output.has_value();
+      auto start = query_thread_clock.now();
+      (*result_handler)(std::move(output));
+      counters.record_emission(query_thread_clock.now() - start);
+      counters.record_event(tuple.timestamp(), has_output);
+    }
+    ingest_watermark.advance(tuple.timestamp(),
+                             time_of_expiration.load(std::memory_order_relaxed));
+    processed_sequence.store(sequence + 1, std::memory_order_release);
   }
 
-  std::optional<tECS::Enumerator> process_event(RingTupleQueue::Tuple tuple) {
-    return static_cast<Derived*>(this)->process_event(tuple);
+  /**
+   * Called by the query thread, returns once the outputs of every tuple
+   * evaluated were handled and destroyed, so nothing reads the tECS of the
+   * evaluators that produced them.
+   */
+  void wait_until_outputs_handled() {
+    if (result_stage != nullptr) {
+      result_stage->wait_until_handled();
+    }
+  }
+
+  // Called by the destructor of a derived query that owns other threads or
+  // whose evaluator the result stage reads, so the query thread stops before
+  // the members of the derived query go away.
+  void stop() {
+    stop_threads();
+    // The other queries stop sharing its predicates from the next batch.
+    if (shared_predicate_view != nullptr) {
+      shared_predicate_evaluator.remove_query(shared_predicate_view->query_id);
+      shared_predicate_view = nullptr;
+    }
   }
 
-  std::optional<RingTupleQueue::Tuple>
-  serialized_message_to_tuple(std::string& serialized_message) {
-    if (serialized_message == "STOP") {
-      return {};
+  // The query thread and the result stage, a derived query that evaluates
+  // in other threads stops them afterwards and then calls stop.
+  void stop_threads() {
+    if (worker_thread.joinable()) {
+      tuple_ring.unsubscribe(tuple_ring_reader);
+      worker_thread.join();
+    }
+    if (result_stage != nullptr) {
+      result_stage->stop();
     }
-    assert(serialized_message.size() == sizeof(uint64_t*));
+  }
 
-    uint64_t* data;
-    memcpy(&data, &serialized_message[0], sizeof(uint64_t*));
-    RingTupleQueue::Tuple tuple = queue.get_tuple(data);
-    return tuple;
+ private:
+  std::optional<tECS::Enumerator> process_event(RingTupleQueue::Tuple tuple) {
+    return static_cast<Derived*>(this)->process_event(tuple);
   }
 };
 }  // namespace CORE::Internal::Interface
@@ -7,22 +7,26 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
-#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "core_server/internal/ceql/cel_formula/formula/visitors/formula_to_logical_cea.hpp"
-#include "core_server/internal/ceql/query/query.hpp"
-#include "core_server/internal/ceql/query_transformer/annotate_predicates_with_new_physical_predicates.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/evaluation/cea/cea.hpp"
 #include "core_server/internal/evaluation/det_cea/det_cea.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
 #include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
 #include "core_server/internal/interface/evaluators/dynamic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/generic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/evaluators/sharded_evaluator.hpp"
+#include "core_server/internal/interface/queries/compiled_query.hpp"
 #include "core_server/internal/interface/queries/generic_query.hpp"
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "shared/datatypes/aliases/event_type_id.hpp"
@@ -32,94 +36,174 @@ namespace CORE::Internal::Interface {
 template <typename ResultHandlerT>
 class PartitionByQuery
     : public GenericQuery<PartitionByQuery<ResultHandlerT>, ResultHandlerT> {
-  // https://stackoverflow.com/questions/664014/what-integer-hash-function-are-good-that-accepts-an-integer-hash-key/12996028#12996028
-  struct VectorHash {
-    std::size_t operator()(const std::vector<uint64_t> vec) const noexcept {
-      std::size_t seed = vec.size();
-      for (const auto& x : vec) {
-        seed ^= hash(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-      }
-      return seed;
-    }
-
-    uint64_t hash(uint64_t x) const noexcept {
-      x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
-      x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
-      x = x ^ (x >> 31);
-      return x;
-    }
-  };
-
-  friend GenericQuery<PartitionByQuery<ResultHandlerT>, ResultHandlerT>;
+  using Base = GenericQuery<PartitionByQuery<ResultHandlerT>, ResultHandlerT>;
+  friend Base;
 
-  std::optional<CEQL::Query> query;
+  std::shared_ptr<const CompiledQuery> compiled_query;
+  // Only one of them is created, see PartitionBySettings::worker_threads.
   std::unique_ptr<DynamicEvaluator> evaluator;
-  std::unordered_map<std::vector<uint64_t>, size_t, VectorHash>
-    partition_by_attrs_to_evaluator_idx;
+  std::unique_ptr<ShardedEvaluator<ResultHandlerT>> sharded_evaluator;
+  PartitionBySettings partition_by_settings;
+
+  // Reused buffer for the values of the partition by attributes of a tuple.
+  std::vector<uint64_t> tuple_values = {};
 
   // Use optional to show that event type has already been processed and should not be consumed by any evaluator
+  // The indexes are the word offsets of the attributes in the tuples.
   std::unordered_map<Types::UniqueEventTypeId, std::optional<std::vector<uint64_t>>>
     event_id_to_tuple_idx;
 
  public:
   PartitionByQuery(Internal::QueryCatalog query_catalog,
                    RingTupleQueue::Queue& queue,
-                   std::string inproc_receiver_address,
-                   std::unique_ptr<ResultHandlerT>&& result_handler)
-      : GenericQuery<PartitionByQuery<ResultHandlerT>, ResultHandlerT>(
-        query_catalog,
-        queue,
-        inproc_receiver_address,
-        std::move(result_handler)) {}
-
- private:
-  void create_query(Internal::CEQL::Query&& query) {
-    Internal::CEQL::AnnotatePredicatesWithNewPhysicalPredicates transformer(
-      this->query_catalog);
-
-    query = transformer(std::move(query));
+                   Stream::BroadcastRing<uint64_t*>& tuple_ring,
+                   Evaluation::SharedPredicateEvaluator& shared_predicate_evaluator,
+                   std::unique_ptr<ResultHandlerT>&& result_handler,
+                   PartitionBySettings partition_by_settings = {})
+      : Base(query_catalog,
+             queue,
+             tuple_ring,
+             shared_predicate_evaluator,
+             std::move(result_handler)),
+        partition_by_settings(partition_by_settings) {}
+
+  // The shards and the result stage use the members of this query. The
+  // shards read the shared predicate results until they are destroyed.
+  ~PartitionByQuery() {
+    this->stop_threads();
+    sharded_evaluator = nullptr;
+    this->stop();
+  }
 
-    auto predicates = std::move(transformer.physical_predicates);
+  // The statistics are empty until create_query made an evaluator.
+  PartitionByStatistics get_partition_by_statistics() const {
+    if (sharded_evaluator != nullptr) {
+      return sharded_evaluator->get_statistics();
+    }
+    if (evaluator != nullptr) {
+      return evaluator->get_statistics();
+    }
+    return {};
+  }
 
-    auto tuple_evaluator = Internal::Evaluation::PredicateEvaluator(std::move(predicates));
+  QueryStatistics get_query_statistics() const {
+    if (sharded_evaluator != nullptr) {
+      return sharded_evaluator->get_query_statistics();
+    }
+    if (evaluator != nullptr) {
+      return evaluator->get_query_statistics();
+    }
+    return {};
+  }
 
-    auto visitor = Internal::CEQL::FormulaToLogicalCEA(this->query_catalog);
-    query.where.formula->accept_visitor(visitor);
-    if (!query.select.is_star) {
-      query.select.formula->accept_visitor(visitor);
+  // Can be read while the query runs, published on every sweep of the partitions.
+  QueryStatistics load_published_statistics() const {
+    if (sharded_evaluator != nullptr) {
+      return sharded_evaluator->load_published_statistics();
+    }
+    if (evaluator != nullptr) {
+      return evaluator->load_published_statistics();
     }
+    return {};
+  }
 
-    Internal::CEA::DetCEA cea(Internal::CEA::CEA(std::move(visitor.current_cea)));
+ private:
+  void create_query(std::shared_ptr<const CompiledQuery> compiled_query,
+                    uint64_t eager_det_cea_states,
+                    const MiniPool::PoolCompactionSettings& pool_compaction_settings) {
+    auto tuple_evaluator = Internal::Evaluation::PredicateEvaluator(
+      compiled_query->predicates);
+    this->share_predicates(tuple_evaluator);
+
+    this->time_window = compiled_query->time_window;
+    this->ingest_watermark.set_time_window(this->time_window);
+    this->compiled_query = std::move(compiled_query);
+
+    if (partition_by_settings.worker_threads > 0) {
+      sharded_evaluator = std::make_unique<ShardedEvaluator<ResultHandlerT>>(
+        this->compiled_query->cea,
+        tuple_evaluator,
+        this->time_of_expiration,
+        this->compiled_query->consumption_policy,
+        this->compiled_query->limit,
+        this->time_window,
+        this->query_catalog,
+        this->queue,
+        partition_by_settings,
+        eager_det_cea_states,
+        pool_compaction_settings,
+        *this->result_handler,
+        this->processed_sequence,
+        this->ingest_watermark,
+        this->counters);
+      return;
+    }
+    evaluator = std::make_unique<DynamicEvaluator>(
+      Internal::CEA::DetCEA(Internal::CEA::CEA(this->compiled_query->cea)),
+      std::move(tuple_evaluator),
+      this->time_of_expiration,
+      this->compiled_query->consumption_policy,
+      this->compiled_query->limit,
+      this->time_window,
+      this->query_catalog,
+      this->queue,
+      partition_by_settings);
+    if (eager_det_cea_states > 0) {
+      evaluator->materialize_det_cea(eager_det_cea_states);
+    }
+    evaluator->compact_pools_with(pool_compaction_settings);
+  }
 
-    this->time_window = query.within.time_window;
-    this->query = std::make_optional(std::move(query));
+  // Null with worker threads, the ShardedEvaluator handles the outputs.
+  GenericEvaluator* get_query_thread_evaluator() { return evaluator.get(); }
 
-    evaluator = std::make_unique<DynamicEvaluator>(std::move(cea),
-                                                   std::move(tuple_evaluator),
-                                                   this->time_of_expiration,
-                                                   this->query.value().consume_by.policy,
-                                                   this->query.value().limit,
-                                                   this->time_window,
-                                                   this->query_catalog,
-                                                   this->queue);
+  void process_tuple(RingTupleQueue::Tuple tuple, uint64_t sequence) {
+    if (sharded_evaluator == nullptr) {
+      Base::process_tuple(tuple, sequence);
+      return;
+    }
+    if (!this->query_catalog.is_unique_event_id_relevant_to_query(tuple.id())) {
+      sharded_evaluator->skip_tuple(tuple, sequence, false);
+      return;
+    }
+    std::optional<std::vector<uint64_t>>& tuple_indexes = get_tuple_indexes(tuple);
+    if (!tuple_indexes.has_value()) {
+      sharded_evaluator->skip_tuple(tuple, sequence, true);
+      return;
+    }
+    const Evaluation::SharedPredicateResult* shared_result = nullptr;
+    if (this->shared_predicate_view != nullptr) {
+      shared_result = &this->shared_predicate_evaluator.result_of(sequence);
+    }
+    sharded_evaluator->process_event(tuple,
+                                     sequence,
+                                     get_partition_values(tuple, tuple_indexes.value()),
+                                     shared_result);
   }
 
   std::optional<tECS::Enumerator> process_event(RingTupleQueue::Tuple tuple) {
-    std::optional<std::vector<uint64_t>>* tuple_indexes;
-    if (auto it = event_id_to_tuple_idx.find(tuple.id());
-        it != event_id_to_tuple_idx.end()) [[likely]] {
-      tuple_indexes = &(it->second);
-    } else {
-      tuple_indexes = find_tuple_indexes(tuple);
+    std::optional<std::vector<uint64_t>>& tuple_indexes = get_tuple_indexes(tuple);
+    if (!tuple_indexes.has_value()) {
+      return {};
     }
 
-    if (!tuple_indexes->has_value()) {
-      return {};
+    std::vector<uint64_t>& partition_values = get_partition_values(
+      tuple, tuple_indexes.value());
+    std::optional<tECS::Enumerator> output = evaluator->process_event(tuple,
+                                                                      partition_values);
+    if (evaluator->has_retired_evaluators()) {
+      this->wait_until_outputs_handled();
+      evaluator->destroy_retired_evaluators();
     }
+    return output;
+  }
 
-    size_t evaluator_idx = find_or_create_evaluator_index_from_tuple_indexes(
-      tuple, tuple_indexes->value());
-    return evaluator->process_event(tuple, evaluator_idx);
+  std::optional<std::vector<uint64_t>>& get_tuple_indexes(RingTupleQueue::Tuple& tuple) {
+    if (auto it = event_id_to_tuple_idx.find(tuple.id());
+        it != event_id_to_tuple_idx.end()) [[likely]] {
+      return it->second;
+    }
+    return *find_tuple_indexes(tuple);
   }
 
   std::optional<std::vector<uint64_t>>* find_tuple_indexes(RingTupleQueue::Tuple& tuple) {
@@ -127,19 +211,20 @@ class PartitionByQuery
 
     Types::UniqueEventTypeId event_id = tuple.id();
     const Types::EventInfo& event_info = this->query_catalog.get_event_info(event_id);
+    const std::vector<uint64_t>& word_offsets = tuple.get_relative_positions();
 
-    assert(query.has_value());
-    for (auto& attr_group : query.value().partition_by.partition_attributes) {
+    assert(compiled_query != nullptr);
+    for (auto& attr_group : compiled_query->partition_by.partition_attributes) {
       for (auto& attr : attr_group) {
         if (auto it_attr_id = event_info.attribute_names_to_ids.find(attr.value);
             it_attr_id != event_info.attribute_names_to_ids.end()) {
-          tuple_indexes.push_back(it_attr_id->second);
+          tuple_indexes.push_back(word_offsets[it_attr_id->second]);
           break;
         }
       }
     }
 
-    if (tuple_indexes.size() < query.value().partition_by.partition_attributes.size()) {
+    if (tuple_indexes.size() < compiled_query->partition_by.partition_attributes.size()) {
       // Could not find any attr for the attr_group in tuple.
       return &(event_id_to_tuple_idx.emplace(event_id, std::nullopt).first->second);
     } else {
@@ -148,26 +233,13 @@ class PartitionByQuery
     }
   }
 
-  size_t
-  find_or_create_evaluator_index_from_tuple_indexes(RingTupleQueue::Tuple& tuple,
-                                                    std::vector<uint64_t>& tuple_indexes) {
-    std::vector<uint64_t> tuple_values = {};
-    tuple_values.reserve(tuple_indexes.size());
-
+  std::vector<uint64_t>& get_partition_values(RingTupleQueue::Tuple& tuple,
+                                              std::vector<uint64_t>& tuple_indexes) {
+    tuple_values.clear();
     for (const auto& tuple_index : tuple_indexes) {
-      tuple_values.emplace_back(*tuple[tuple_index]);
-    }
-
-    if (auto evaluator_it = partition_by_attrs_to_evaluator_idx.find(tuple_values);
-        evaluator_it != partition_by_attrs_to_evaluator_idx.end()) [[likely]] {
-      return evaluator_it->second;
-    } else {
-      return partition_by_attrs_to_evaluator_idx
-        .emplace(std::piecewise_construct,
-                 std::forward_as_tuple(tuple_values),
-                 std::forward_as_tuple(partition_by_attrs_to_evaluator_idx.size()))
-        .first->second;
+      tuple_values.emplace_back(*tuple.at_offset(tuple_index));
     }
+    return tuple_values;
   }
 };
 }  // namespace CORE::Internal::Interface
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <tracy/Tracy.hpp>
+#include <utility>
+
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/evaluators/ingest_watermark.hpp"
+#include "core_server/internal/interface/evaluators/query_counters.hpp"
+#include "core_server/internal/interface/evaluators/thread_wakeup.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/ingest_clock.hpp"
+
+namespace CORE::Internal::Interface {
+
+// Events read by the query whose outputs were not handled yet, a power of 2.
+const size_t RESULT_STAGE_MAXIMUM_PENDING_EVENTS = 1024;
+
+/**
+ * Decides what the evaluation does when an event has an output and the
+ * maximum amount of pending outputs has already been reached.
+ */
+enum class ResultBackpressure {
+  // Wait until the result thread handles an output.
+  BLOCK,
+  // Drop the output, its event is handled as if it had none.
+  DROP_OUTPUTS,
+};
+
+struct ResultStageSettings {
+  // Outputs evaluated and not handled yet. With 0 the query thread hands
+  // every output to the result handler before evaluating the next event.
+  size_t maximum_pending_outputs = 0;
+  ResultBackpressure backpressure = ResultBackpressure::BLOCK;
+};
+
+/**
+ * Hands the outputs of a query to its result handler in a thread of its
+ * own, so a slow result handler does not stall the evaluation of the next
+ * events.
+ *
+ * The query thread pushes every event it reads into a bounded ring, with
+ * its output if it has one. The result thread hands them to the result
+ * handler in the order of the stream and then does what the query thread
+ * does without a result stage: it updates the counters, the ingest
+ * watermark and processed_sequence. So the tuples of an output are not
+ * recycled before it is handled.
+ *
+ * A pending enumerator pins its nodes and reserves its time in the tECS,
+ * so the evaluator can add nodes meanwhile. Unpinning them changes the
+ * tECS, so the handled enumerators are left in the ring, and the query
+ * thread destroys them when it pushes the next events.
+ */
+template <typename ResultHandlerT>
+class ResultStage {
+  using Clock = std::chrono::system_clock;
+
+  struct PendingEvent {
+    uint64_t sequence = 0;
+    bool is_relevant = false;
+    bool has_output = false;
+    Clock::time_point ingested = {};
+    // The time given to the evaluator, empty if the tuple was not evaluated.
+    std::optional<uint64_t> time = {};
+    uint64_t time_of_expiration = 0;
+    std::optional<tECS::Enumerator> output = {};
+  };
+
+  ResultStageSettings settings;
+  ResultHandlerT& result_handler;
+  std::atomic<uint64_t>& processed_sequence;
+  IngestWatermark& ingest_watermark;
+  QueryCounters& counters;
+
+  std::unique_ptr<PendingEvent[]> pending_events;
+  uint64_t pending_events_mask = RESULT_STAGE_MAXIMUM_PENDING_EVENTS - 1;
+  // Query thread local. The events before released_position were handled and
+  // their outputs destroyed.
+  uint64_t released_position = 0;
+  uint64_t pending_outputs = 0;
+  ThreadWakeup query_wakeup;
+
+  alignas(64) std::atomic<uint64_t> pushed_position = 0;
+  std::atomic<uint64_t> handled_position = 0;
+  std::atomic<bool> is_stopped = false;
+  ThreadWakeup result_wakeup;
+  std::thread result_thread;
+  // Result thread local.
+  RingTupleQueue::IngestClock clock;
+
+ public:
+  ResultStage(ResultStageSettings settings,
+              ResultHandlerT& result_handler,
+              std::atomic<uint64_t>& processed_sequence,
+              IngestWatermark& ingest_watermark,
+              QueryCounters& counters)
+      : settings(settings),
+        result_handler(result_handler),
+        processed_sequence(processed_sequence),
+        ingest_watermark(ingest_watermark),
+        counters(counters),
+        pending_events(
+          std::make_unique<PendingEvent[]>(RESULT_STAGE_MAXIMUM_PENDING_EVENTS)) {
+    static_assert((RESULT_STAGE_MAXIMUM_PENDING_EVENTS
+                   & (RESULT_STAGE_MAXIMUM_PENDING_EVENTS - 1))
+                  == 0);
+    assert(settings.maximum_pending_outputs > 0);
+    result_thread = std::thread([this]() { handle_events(); });
+  }
+
+  ResultStage(const ResultStage&) = delete;
+  ResultStage& operator=(const ResultStage&) = delete;
+
+  ~ResultStage() { stop(); }
+
+  /**
+   * Called by the query thread for every event it reads, in the order of the
+   * stream. The time is the one given to the evaluator, empty if the event
+   * was not evaluated.
+   */
+  void push(uint64_t sequence,
+            bool is_relevant,
+            Clock::time_point ingested,
+            std::optional<uint64_t> time,
+            uint64_t time_of_expiration,
+            std::optional<tECS::Enumerator>&& output) {
+    ZoneScopedN("Interface::ResultStage::push");
+    release_handled_events();
+    if (output.has_value() && pending_outputs >= settings.maximum_pending_outputs) {
+      if (settings.backpressure == ResultBackpressure::DROP_OUTPUTS) {
+        output.reset();
+        counters.record_dropped_output();
+      } else {
+        wait_and_release_until(
+          [&]() { return pending_outputs < settings.maximum_pending_outputs; });
+      }
+    }
+    uint64_t position = pushed_position.load(std::memory_order_relaxed);
+    wait_and_release_until([&]() {
+      return position - released_position < RESULT_STAGE_MAXIMUM_PENDING_EVENTS;
+    });
+
+    PendingEvent& pending = pending_events[position & pending_events_mask];
+    pending.sequence = sequence;
+    pending.is_relevant = is_relevant;
+    pending.has_output = output.has_value();
+    pending.ingested = ingested;
+    pending.time = time;
+    pending.time_of_expiration = time_of_expiration;
+    pending.output = std::move(output);
+    if (pending.has_output) {
+      pending_outputs++;
+    }
+    pushed_position.store(position + 1, std::memory_order_release);
+    result_wakeup.wake_up();
+  }
+
+  /**
+   * Called by the query thread, returns once every event pushed was handled
+   * and its output destroyed.
+   */
+  void wait_until_handled() {
+    wait_and_release_until([&]() {
+      return released_position == pushed_position.load(std::memory_order_relaxed);
+    });
+  }
+
+  /**
+   * Called once the query thread stopped pushing events. The events already
+   * pushed are handled before the result thread stops.
+   */
+  void stop() {
+    if (result_thread.joinable()) {
+      is_stopped.store(true, std::memory_order_release);
+      result_wakeup.wake_up();
+      result_thread.join();
+      release_handled_events();
+    }
+  }
+
+ private:
+  void release_handled_events() {
+    uint64_t handled = handled_position.load(std::memory_order_acquire);
+    for (; released_position < handled; released_position++) {
+      PendingEvent& pending = pending_events[released_position & pending_events_mask];
+      if (pending.has_output) {
+        pending.output.reset();
+        pending_outputs--;
+      }
+    }
+  }
+
+  template <typename Condition>
+  void wait_and_release_until(Condition&& condition) {
+    while (!condition()) {
+      query_wakeup.wait_until([&]() {
+        return handled_position.load(std::memory_order_acquire) > released_position;
+      });
+      release_handled_events();
+    }
+  }
+
+  void handle_events() {
+    ZoneScopedN("Interface::ResultStage::handle_events");
+    for (uint64_t position = 0;; position++) {
+      result_wakeup.wait_until([&]() {
+        return is_stopped.load(std::memory_order_acquire)
+               || pushed_position.load(std::memory_order_acquire) > position;
+      });
+      if (pushed_position.load(std::memory_order_acquire) <= position) {
+        // Stopped with every event handled.
+        return;
+      }
+      handle_event(pending_events[position & pending_events_mask]);
+      handled_position.store(position + 1, std::memory_order_release);
+      query_wakeup.wake_up();
+    }
+  }
+
+  void handle_event(PendingEvent& pending) {
+    ZoneScopedN("Interface::ResultStage::handle_event");
+    if (pending.is_relevant) {
+      Clock::time_point start = clock.now();
+      // The result handler leaves the enumerator in the optional.
+      result_handler(std::move(pending.output));
+      counters.record_emission(clock.now() - start);
+      counters.record_event(pending.ingested, pending.has_output);
+    }
+    if (pending.time.has_value()) {
+      ingest_watermark.record(pending.time.value(), pending.ingested);
+    }
+    ingest_watermark.advance(pending.ingested, pending.time_of_expiration);
+    processed_sequence.store(pending.sequence + 1, std::memory_order_release);
+  }
+};
+}  // namespace CORE::Internal::Interface
@@ -1,20 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
-#include <string>
 #include <utility>
 
-#include "core_server/internal/ceql/cel_formula/formula/visitors/formula_to_logical_cea.hpp"
-#include "core_server/internal/ceql/query/query.hpp"
-#include "core_server/internal/ceql/query_transformer/annotate_predicates_with_new_physical_predicates.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/evaluation/cea/cea.hpp"
 #include "core_server/internal/evaluation/det_cea/det_cea.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
 #include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/generic_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
 #include "core_server/internal/interface/evaluators/single_evaluator.hpp"
+#include "core_server/internal/interface/queries/compiled_query.hpp"
 #include "core_server/internal/interface/queries/generic_query.hpp"
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 
@@ -28,45 +31,64 @@ class SimpleQuery : public GenericQuery<SimpleQuery<ResultHandlerT>, ResultHandl
  public:
   SimpleQuery(Internal::QueryCatalog query_catalog,
               RingTupleQueue::Queue& queue,
-              std::string inproc_receiver_address,
+              Stream::BroadcastRing<uint64_t*>& tuple_ring,
+              Evaluation::SharedPredicateEvaluator& shared_predicate_evaluator,
               std::unique_ptr<ResultHandlerT>&& result_handler)
-      : GenericQuery<SimpleQuery<ResultHandlerT>, ResultHandlerT>(query_catalog,
-                                                                  queue,
-                                                                  inproc_receiver_address,
-                                                                  std::move(
-                                                                    result_handler)) {}
+      : GenericQuery<SimpleQuery<ResultHandlerT>, ResultHandlerT>(
+        query_catalog,
+        queue,
+        tuple_ring,
+        shared_predicate_evaluator,
+        std::move(result_handler)) {}
 
- private:
-  void create_query(Internal::CEQL::Query&& query) {
-    Internal::CEQL::AnnotatePredicatesWithNewPhysicalPredicates transformer(
-      this->query_catalog);
-
-    query = transformer(std::move(query));
-
-    auto predicates = std::move(transformer.physical_predicates);
+  // The result stage reads the tECS of the evaluator.
+  ~SimpleQuery() { this->stop(); }
 
-    auto tuple_evaluator = Internal::Evaluation::PredicateEvaluator(std::move(predicates));
+  // The statistics are empty until create_query made the evaluator.
+  QueryStatistics get_query_statistics() const {
+    if (evaluator != nullptr) {
+      return evaluator->get_query_statistics();
+    }
+    return {};
+  }
 
-    auto visitor = Internal::CEQL::FormulaToLogicalCEA(this->query_catalog);
-    query.where.formula->accept_visitor(visitor);
-    if (!query.select.is_star) {
-      query.select.formula->accept_visitor(visitor);
+  // Can be read while the query runs.
+  QueryStatistics load_published_statistics() const {
+    if (evaluator != nullptr) {
+      return evaluator->load_published_statistics();
     }
+    return {};
+  }
+
+ private:
+  void create_query(std::shared_ptr<const CompiledQuery> compiled_query,
+                    uint64_t eager_det_cea_states,
+                    const MiniPool::PoolCompactionSettings& pool_compaction_settings) {
+    auto tuple_evaluator = Internal::Evaluation::PredicateEvaluator(
+      compiled_query->predicates);
+    this->share_predicates(tuple_evaluator);
 
-    Internal::CEA::DetCEA cea(Internal::CEA::CEA(std::move(visitor.current_cea)));
+    Internal::CEA::DetCEA cea(Internal::CEA::CEA(compiled_query->cea));
 
-    this->time_window = query.within.time_window;
+    this->time_window = compiled_query->time_window;
+    this->ingest_watermark.set_time_window(this->time_window);
 
     evaluator = std::make_unique<SingleEvaluator>(std::move(cea),
                                                   std::move(tuple_evaluator),
                                                   this->time_of_expiration,
-                                                  query.consume_by.policy,
-                                                  query.limit,
+                                                  compiled_query->consumption_policy,
+                                                  compiled_query->limit,
                                                   this->time_window,
                                                   this->query_catalog,
                                                   this->queue);
+    if (eager_det_cea_states > 0) {
+      evaluator->materialize_det_cea(eager_det_cea_states);
+    }
+    evaluator->compact_pools_with(pool_compaction_settings);
   }
 
+  GenericEvaluator* get_query_thread_evaluator() { return evaluator.get(); }
+
   std::optional<tECS::Enumerator> process_event(RingTupleQueue::Tuple tuple) {
     return evaluator->process_event(tuple);
   }
@@ -37,6 +37,7 @@ selection_strategy
 list_of_variables
  : STAR                         # s_star
  | K_NONE                         # s_none
+ | K_COUNT LEFT_PARENTHESIS STAR RIGHT_PARENTHESIS   # s_count
  | s_event_name ( COMMA s_event_name )*   # s_list_of_variables
  ;
 
@@ -209,6 +210,7 @@ keyword
  | K_AS
  | K_BY
  | K_CONSUME
+ | K_COUNT
  | K_DISTINCT
  | K_EVENT
  | K_EVENTS
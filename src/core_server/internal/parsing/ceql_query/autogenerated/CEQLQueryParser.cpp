@@ -66,13 +66,13 @@ void ceqlqueryparserParserInitialize() {
       "'\\d'", "'\\D'", "'\\s'", "'\\S'", "'\\w'", "'\\W'"
     },
     std::vector<std::string>{
-      "", "K_ALL", "K_AND", "K_ANY", "K_AS", "K_BY", "K_CONSUME", "K_LIMIT", 
-      "K_DISTINCT", "K_EVENT", "K_EVENTS", "K_FILTER", "K_FROM", "K_HOURS", 
-      "K_IN", "K_LAST", "K_LIKE", "K_MAX", "K_MINUTES", "K_NEXT", "K_NONE", 
-      "K_NOT", "K_OR", "K_PARTITION", "K_RANGE", "K_SECONDS", "K_SELECT", 
-      "K_STREAM", "K_STRICT", "K_UNLESS", "K_WHERE", "K_WITHIN", "PERCENT", 
-      "PLUS", "MINUS", "STAR", "SLASH", "LE", "LEQ", "GE", "GEQ", "EQ", 
-      "NEQ", "SEMICOLON", "COLON", "COMMA", "DOUBLE_DOT", "LEFT_PARENTHESIS", 
+      "", "K_ALL", "K_AND", "K_ANY", "K_AS", "K_BY", "K_CONSUME", "K_COUNT", 
+      "K_LIMIT", "K_DISTINCT", "K_EVENT", "K_EVENTS", "K_FILTER", "K_FROM", 
+      "K_HOURS", "K_IN", "K_LAST", "K_LIKE", "K_MAX", "K_MINUTES", "K_NEXT", 
+      "K_NONE", "K_NOT", "K_OR", "K_PARTITION", "K_RANGE", "K_SECONDS", 
+      "K_SELECT", "K_STREAM", "K_STRICT", "K_UNLESS", "K_WHERE", "K_WITHIN", 
+      "PERCENT", "PLUS", "MINUS", "STAR", "SLASH", "LE", "LEQ", "GE", "GEQ", 
+      "EQ", "NEQ", "SEMICOLON", "COLON", "COMMA", "DOUBLE_DOT", "LEFT_PARENTHESIS", 
       "RIGHT_PARENTHESIS", "LEFT_SQUARE_BRACKET", "RIGHT_SQUARE_BRACKET", 
       "LEFT_CURLY_BRACKET", "RIGHT_CURLY_BRACKET", "COLON_PLUS", "IDENTIFIER", 
       "DOUBLE_LITERAL", "INTEGER_LITERAL", "NUMERICAL_EXPONENT", "STRING_LITERAL", 
@@ -87,7 +87,7 @@ void ceqlqueryparserParserInitialize() {
     }
   );
   static const int32_t serializedATNSegment[] = {
-  	4,1,91,567,2,0,7,0,2,1,7,1,2,2,7,2,2,3,7,3,2,4,7,4,2,5,7,5,2,6,7,6,2,
+  	4,1,92,571,2,0,7,0,2,1,7,1,2,2,7,2,2,3,7,3,2,4,7,4,2,5,7,5,2,6,7,6,2,
   	7,7,7,2,8,7,8,2,9,7,9,2,10,7,10,2,11,7,11,2,12,7,12,2,13,7,13,2,14,7,
   	14,2,15,7,15,2,16,7,16,2,17,7,17,2,18,7,18,2,19,7,19,2,20,7,20,2,21,7,
   	21,2,22,7,22,2,23,7,23,2,24,7,24,2,25,7,25,2,26,7,26,2,27,7,27,2,28,7,
@@ -129,153 +129,155 @@ void ceqlqueryparserParserInitialize() {
   	50,1,50,4,50,524,8,50,11,50,12,50,525,1,50,1,50,1,51,1,51,1,51,3,51,533,
   	8,51,1,52,1,52,1,52,1,52,1,53,1,53,1,54,1,54,3,54,543,8,54,1,55,1,55,
   	1,55,1,56,1,56,1,57,1,57,1,57,3,57,553,8,57,1,58,1,58,1,58,1,59,1,59,
-  	1,60,1,60,1,61,4,61,563,8,61,11,61,12,61,564,1,61,0,4,12,22,24,30,62,
-  	0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,
-  	50,52,54,56,58,60,62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,94,
-  	96,98,100,102,104,106,108,110,112,114,116,118,120,122,0,9,1,0,37,42,1,
-  	0,41,42,1,0,33,34,2,0,32,32,35,36,2,0,1,6,8,31,2,0,76,77,79,80,5,0,66,
-  	66,68,71,73,75,78,80,82,82,4,0,66,66,68,71,73,75,78,80,1,0,85,90,588,
-  	0,128,1,0,0,0,2,133,1,0,0,0,4,136,1,0,0,0,6,168,1,0,0,0,8,180,1,0,0,0,
-  	10,191,1,0,0,0,12,199,1,0,0,0,14,225,1,0,0,0,16,235,1,0,0,0,18,246,1,
-  	0,0,0,20,248,1,0,0,0,22,260,1,0,0,0,24,309,1,0,0,0,26,324,1,0,0,0,28,
-  	329,1,0,0,0,30,340,1,0,0,0,32,361,1,0,0,0,34,384,1,0,0,0,36,386,1,0,0,
-  	0,38,397,1,0,0,0,40,399,1,0,0,0,42,403,1,0,0,0,44,411,1,0,0,0,46,414,
-  	1,0,0,0,48,417,1,0,0,0,50,420,1,0,0,0,52,425,1,0,0,0,54,433,1,0,0,0,56,
-  	437,1,0,0,0,58,439,1,0,0,0,60,441,1,0,0,0,62,443,1,0,0,0,64,445,1,0,0,
-  	0,66,449,1,0,0,0,68,451,1,0,0,0,70,453,1,0,0,0,72,455,1,0,0,0,74,457,
-  	1,0,0,0,76,461,1,0,0,0,78,470,1,0,0,0,80,474,1,0,0,0,82,480,1,0,0,0,84,
-  	482,1,0,0,0,86,493,1,0,0,0,88,499,1,0,0,0,90,501,1,0,0,0,92,503,1,0,0,
-  	0,94,507,1,0,0,0,96,510,1,0,0,0,98,516,1,0,0,0,100,518,1,0,0,0,102,532,
-  	1,0,0,0,104,534,1,0,0,0,106,538,1,0,0,0,108,542,1,0,0,0,110,544,1,0,0,
-  	0,112,547,1,0,0,0,114,552,1,0,0,0,116,554,1,0,0,0,118,557,1,0,0,0,120,
-  	559,1,0,0,0,122,562,1,0,0,0,124,127,3,4,2,0,125,127,3,2,1,0,126,124,1,
-  	0,0,0,126,125,1,0,0,0,127,130,1,0,0,0,128,126,1,0,0,0,128,129,1,0,0,0,
-  	129,131,1,0,0,0,130,128,1,0,0,0,131,132,5,0,0,1,132,1,1,0,0,0,133,134,
-  	5,62,0,0,134,135,6,1,-1,0,135,3,1,0,0,0,136,138,5,26,0,0,137,139,3,6,
-  	3,0,138,137,1,0,0,0,138,139,1,0,0,0,139,140,1,0,0,0,140,141,3,8,4,0,141,
-  	142,3,10,5,0,142,143,5,30,0,0,143,147,3,12,6,0,144,145,5,23,0,0,145,146,
-  	5,5,0,0,146,148,3,14,7,0,147,144,1,0,0,0,147,148,1,0,0,0,148,151,1,0,
-  	0,0,149,150,5,31,0,0,150,152,3,38,19,0,151,149,1,0,0,0,151,152,1,0,0,
-  	0,152,156,1,0,0,0,153,154,5,6,0,0,154,155,5,5,0,0,155,157,3,18,9,0,156,
-  	153,1,0,0,0,156,157,1,0,0,0,157,160,1,0,0,0,158,159,5,7,0,0,159,161,3,
-  	20,10,0,160,158,1,0,0,0,160,161,1,0,0,0,161,5,1,0,0,0,162,169,5,1,0,0,
-  	163,169,5,3,0,0,164,169,5,15,0,0,165,169,5,17,0,0,166,169,5,19,0,0,167,
-  	169,5,28,0,0,168,162,1,0,0,0,168,163,1,0,0,0,168,164,1,0,0,0,168,165,
-  	1,0,0,0,168,166,1,0,0,0,168,167,1,0,0,0,169,7,1,0,0,0,170,181,5,35,0,
-  	0,171,181,5,20,0,0,172,177,3,54,27,0,173,174,5,45,0,0,174,176,3,54,27,
-  	0,175,173,1,0,0,0,176,179,1,0,0,0,177,175,1,0,0,0,177,178,1,0,0,0,178,
-  	181,1,0,0,0,179,177,1,0,0,0,180,170,1,0,0,0,180,171,1,0,0,0,180,172,1,
-  	0,0,0,181,9,1,0,0,0,182,183,5,12,0,0,183,188,3,58,29,0,184,185,5,45,0,
-  	0,185,187,3,58,29,0,186,184,1,0,0,0,187,190,1,0,0,0,188,186,1,0,0,0,188,
-  	189,1,0,0,0,189,192,1,0,0,0,190,188,1,0,0,0,191,182,1,0,0,0,191,192,1,
-  	0,0,0,192,11,1,0,0,0,193,194,6,6,-1,0,194,195,5,47,0,0,195,196,3,12,6,
-  	0,196,197,5,48,0,0,197,200,1,0,0,0,198,200,3,54,27,0,199,193,1,0,0,0,
-  	199,198,1,0,0,0,200,222,1,0,0,0,201,202,10,4,0,0,202,203,5,43,0,0,203,
-  	221,3,12,6,5,204,205,10,3,0,0,205,206,5,44,0,0,206,221,3,12,6,4,207,208,
-  	10,2,0,0,208,209,5,22,0,0,209,221,3,12,6,3,210,211,10,7,0,0,211,212,5,
-  	4,0,0,212,221,3,56,28,0,213,214,10,6,0,0,214,221,5,33,0,0,215,216,10,
-  	5,0,0,216,221,5,53,0,0,217,218,10,1,0,0,218,219,5,11,0,0,219,221,3,22,
-  	11,0,220,201,1,0,0,0,220,204,1,0,0,0,220,207,1,0,0,0,220,210,1,0,0,0,
-  	220,213,1,0,0,0,220,215,1,0,0,0,220,217,1,0,0,0,221,224,1,0,0,0,222,220,
-  	1,0,0,0,222,223,1,0,0,0,223,13,1,0,0,0,224,222,1,0,0,0,225,226,5,49,0,
-  	0,226,227,3,16,8,0,227,233,5,50,0,0,228,229,5,45,0,0,229,230,5,49,0,0,
-  	230,231,3,16,8,0,231,232,5,50,0,0,232,234,1,0,0,0,233,228,1,0,0,0,233,
-  	234,1,0,0,0,234,15,1,0,0,0,235,240,3,60,30,0,236,237,5,45,0,0,237,239,
-  	3,60,30,0,238,236,1,0,0,0,239,242,1,0,0,0,240,238,1,0,0,0,240,241,1,0,
-  	0,0,241,17,1,0,0,0,242,240,1,0,0,0,243,247,5,3,0,0,244,247,5,23,0,0,245,
-  	247,5,20,0,0,246,243,1,0,0,0,246,244,1,0,0,0,246,245,1,0,0,0,247,19,1,
-  	0,0,0,248,249,3,62,31,0,249,21,1,0,0,0,250,251,6,11,-1,0,251,252,5,47,
-  	0,0,252,253,3,22,11,0,253,254,5,48,0,0,254,261,1,0,0,0,255,256,3,54,27,
-  	0,256,257,5,49,0,0,257,258,3,24,12,0,258,259,5,50,0,0,259,261,1,0,0,0,
-  	260,250,1,0,0,0,260,255,1,0,0,0,261,270,1,0,0,0,262,263,10,2,0,0,263,
-  	264,5,2,0,0,264,269,3,22,11,3,265,266,10,1,0,0,266,267,5,22,0,0,267,269,
-  	3,22,11,2,268,262,1,0,0,0,268,265,1,0,0,0,269,272,1,0,0,0,270,268,1,0,
-  	0,0,270,271,1,0,0,0,271,23,1,0,0,0,272,270,1,0,0,0,273,274,6,12,-1,0,
-  	274,275,5,47,0,0,275,276,3,24,12,0,276,277,5,48,0,0,277,310,1,0,0,0,278,
-  	279,5,21,0,0,279,310,3,24,12,8,280,281,3,30,15,0,281,282,7,0,0,0,282,
-  	283,3,30,15,0,283,310,1,0,0,0,284,285,3,26,13,0,285,286,7,1,0,0,286,287,
-  	3,28,14,0,287,310,1,0,0,0,288,289,3,60,30,0,289,290,5,16,0,0,290,291,
-  	3,74,37,0,291,310,1,0,0,0,292,296,3,60,30,0,293,297,5,14,0,0,294,295,
-  	5,21,0,0,295,297,5,14,0,0,296,293,1,0,0,0,296,294,1,0,0,0,297,298,1,0,
-  	0,0,298,299,3,32,16,0,299,310,1,0,0,0,300,301,3,30,15,0,301,302,5,14,
-  	0,0,302,303,5,24,0,0,303,304,5,47,0,0,304,305,3,30,15,0,305,306,5,45,
-  	0,0,306,307,3,30,15,0,307,308,5,48,0,0,308,310,1,0,0,0,309,273,1,0,0,
-  	0,309,278,1,0,0,0,309,280,1,0,0,0,309,284,1,0,0,0,309,288,1,0,0,0,309,
-  	292,1,0,0,0,309,300,1,0,0,0,310,319,1,0,0,0,311,312,10,5,0,0,312,313,
-  	5,2,0,0,313,318,3,24,12,6,314,315,10,4,0,0,315,316,5,22,0,0,316,318,3,
-  	24,12,5,317,311,1,0,0,0,317,314,1,0,0,0,318,321,1,0,0,0,319,317,1,0,0,
-  	0,319,320,1,0,0,0,320,25,1,0,0,0,321,319,1,0,0,0,322,325,3,68,34,0,323,
-  	325,3,60,30,0,324,322,1,0,0,0,324,323,1,0,0,0,325,27,1,0,0,0,326,330,
-  	3,68,34,0,327,330,3,60,30,0,328,330,3,74,37,0,329,326,1,0,0,0,329,327,
-  	1,0,0,0,329,328,1,0,0,0,330,29,1,0,0,0,331,332,6,15,-1,0,332,333,5,47,
-  	0,0,333,334,3,30,15,0,334,335,5,48,0,0,335,341,1,0,0,0,336,341,3,66,33,
-  	0,337,341,3,60,30,0,338,339,7,2,0,0,339,341,3,30,15,3,340,331,1,0,0,0,
-  	340,336,1,0,0,0,340,337,1,0,0,0,340,338,1,0,0,0,341,350,1,0,0,0,342,343,
-  	10,2,0,0,343,344,7,3,0,0,344,349,3,30,15,3,345,346,10,1,0,0,346,347,7,
-  	2,0,0,347,349,3,30,15,2,348,342,1,0,0,0,348,345,1,0,0,0,349,352,1,0,0,
-  	0,350,348,1,0,0,0,350,351,1,0,0,0,351,31,1,0,0,0,352,350,1,0,0,0,353,
-  	354,5,51,0,0,354,355,3,34,17,0,355,356,5,52,0,0,356,362,1,0,0,0,357,358,
-  	5,51,0,0,358,359,3,36,18,0,359,360,5,52,0,0,360,362,1,0,0,0,361,353,1,
-  	0,0,0,361,357,1,0,0,0,362,33,1,0,0,0,363,368,3,66,33,0,364,365,5,45,0,
-  	0,365,367,3,66,33,0,366,364,1,0,0,0,367,370,1,0,0,0,368,366,1,0,0,0,368,
-  	369,1,0,0,0,369,385,1,0,0,0,370,368,1,0,0,0,371,372,3,62,31,0,372,373,
-  	5,46,0,0,373,374,3,62,31,0,374,385,1,0,0,0,375,376,3,64,32,0,376,377,
-  	5,46,0,0,377,378,3,64,32,0,378,385,1,0,0,0,379,380,3,66,33,0,380,381,
-  	5,46,0,0,381,385,1,0,0,0,382,383,5,46,0,0,383,385,3,66,33,0,384,363,1,
-  	0,0,0,384,371,1,0,0,0,384,375,1,0,0,0,384,379,1,0,0,0,384,382,1,0,0,0,
-  	385,35,1,0,0,0,386,391,3,68,34,0,387,388,5,45,0,0,388,390,3,68,34,0,389,
-  	387,1,0,0,0,390,393,1,0,0,0,391,389,1,0,0,0,391,392,1,0,0,0,392,37,1,
-  	0,0,0,393,391,1,0,0,0,394,398,3,40,20,0,395,398,3,42,21,0,396,398,3,50,
-  	25,0,397,394,1,0,0,0,397,395,1,0,0,0,397,396,1,0,0,0,398,39,1,0,0,0,399,
-  	400,3,62,31,0,400,401,5,10,0,0,401,41,1,0,0,0,402,404,3,44,22,0,403,402,
-  	1,0,0,0,403,404,1,0,0,0,404,406,1,0,0,0,405,407,3,46,23,0,406,405,1,0,
-  	0,0,406,407,1,0,0,0,407,409,1,0,0,0,408,410,3,48,24,0,409,408,1,0,0,0,
-  	409,410,1,0,0,0,410,43,1,0,0,0,411,412,3,66,33,0,412,413,5,13,0,0,413,
-  	45,1,0,0,0,414,415,3,66,33,0,415,416,5,18,0,0,416,47,1,0,0,0,417,418,
-  	3,66,33,0,418,419,5,25,0,0,419,49,1,0,0,0,420,421,3,62,31,0,421,422,5,
-  	49,0,0,422,423,3,70,35,0,423,424,5,50,0,0,424,51,1,0,0,0,425,428,3,54,
-  	27,0,426,427,5,4,0,0,427,429,3,56,28,0,428,426,1,0,0,0,428,429,1,0,0,
-  	0,429,53,1,0,0,0,430,431,3,58,29,0,431,432,5,39,0,0,432,434,1,0,0,0,433,
-  	430,1,0,0,0,433,434,1,0,0,0,434,435,1,0,0,0,435,436,3,56,28,0,436,55,
-  	1,0,0,0,437,438,3,70,35,0,438,57,1,0,0,0,439,440,3,70,35,0,440,59,1,0,
-  	0,0,441,442,3,70,35,0,442,61,1,0,0,0,443,444,5,56,0,0,444,63,1,0,0,0,
-  	445,446,5,55,0,0,446,65,1,0,0,0,447,450,3,62,31,0,448,450,3,64,32,0,449,
-  	447,1,0,0,0,449,448,1,0,0,0,450,67,1,0,0,0,451,452,5,58,0,0,452,69,1,
-  	0,0,0,453,454,5,54,0,0,454,71,1,0,0,0,455,456,7,4,0,0,456,73,1,0,0,0,
-  	457,458,5,63,0,0,458,459,3,76,38,0,459,460,5,64,0,0,460,75,1,0,0,0,461,
-  	466,3,78,39,0,462,463,5,66,0,0,463,465,3,78,39,0,464,462,1,0,0,0,465,
-  	468,1,0,0,0,466,464,1,0,0,0,466,467,1,0,0,0,467,77,1,0,0,0,468,466,1,
-  	0,0,0,469,471,3,80,40,0,470,469,1,0,0,0,471,472,1,0,0,0,472,470,1,0,0,
-  	0,472,473,1,0,0,0,473,79,1,0,0,0,474,476,3,82,41,0,475,477,3,86,43,0,
-  	476,475,1,0,0,0,476,477,1,0,0,0,477,81,1,0,0,0,478,481,3,84,42,0,479,
-  	481,3,98,49,0,480,478,1,0,0,0,480,479,1,0,0,0,481,83,1,0,0,0,482,483,
-  	5,70,0,0,483,484,3,76,38,0,484,485,5,71,0,0,485,85,1,0,0,0,486,494,5,
-  	73,0,0,487,494,5,74,0,0,488,494,5,75,0,0,489,490,5,68,0,0,490,491,3,88,
-  	44,0,491,492,5,69,0,0,492,494,1,0,0,0,493,486,1,0,0,0,493,487,1,0,0,0,
-  	493,488,1,0,0,0,493,489,1,0,0,0,494,87,1,0,0,0,495,500,3,90,45,0,496,
-  	500,3,92,46,0,497,500,3,94,47,0,498,500,3,96,48,0,499,495,1,0,0,0,499,
-  	496,1,0,0,0,499,497,1,0,0,0,499,498,1,0,0,0,500,89,1,0,0,0,501,502,3,
-  	122,61,0,502,91,1,0,0,0,503,504,3,122,61,0,504,505,5,72,0,0,505,506,3,
-  	122,61,0,506,93,1,0,0,0,507,508,3,122,61,0,508,509,5,72,0,0,509,95,1,
-  	0,0,0,510,511,5,72,0,0,511,512,3,122,61,0,512,97,1,0,0,0,513,517,3,100,
-  	50,0,514,517,3,120,60,0,515,517,3,114,57,0,516,513,1,0,0,0,516,514,1,
-  	0,0,0,516,515,1,0,0,0,517,99,1,0,0,0,518,520,5,78,0,0,519,521,5,76,0,
-  	0,520,519,1,0,0,0,520,521,1,0,0,0,521,523,1,0,0,0,522,524,3,102,51,0,
-  	523,522,1,0,0,0,524,525,1,0,0,0,525,523,1,0,0,0,525,526,1,0,0,0,526,527,
-  	1,0,0,0,527,528,5,79,0,0,528,101,1,0,0,0,529,533,3,104,52,0,530,533,3,
-  	120,60,0,531,533,3,106,53,0,532,529,1,0,0,0,532,530,1,0,0,0,532,531,1,
-  	0,0,0,533,103,1,0,0,0,534,535,3,108,54,0,535,536,5,77,0,0,536,537,3,108,
-  	54,0,537,105,1,0,0,0,538,539,3,108,54,0,539,107,1,0,0,0,540,543,3,110,
-  	55,0,541,543,3,112,56,0,542,540,1,0,0,0,542,541,1,0,0,0,543,109,1,0,0,
-  	0,544,545,5,80,0,0,545,546,7,5,0,0,546,111,1,0,0,0,547,548,8,5,0,0,548,
-  	113,1,0,0,0,549,553,3,116,58,0,550,553,5,82,0,0,551,553,3,118,59,0,552,
-  	549,1,0,0,0,552,550,1,0,0,0,552,551,1,0,0,0,553,115,1,0,0,0,554,555,5,
-  	80,0,0,555,556,7,6,0,0,556,117,1,0,0,0,557,558,8,7,0,0,558,119,1,0,0,
-  	0,559,560,7,8,0,0,560,121,1,0,0,0,561,563,5,91,0,0,562,561,1,0,0,0,563,
-  	564,1,0,0,0,564,562,1,0,0,0,564,565,1,0,0,0,565,123,1,0,0,0,54,126,128,
-  	138,147,151,156,160,168,177,180,188,191,199,220,222,233,240,246,260,268,
-  	270,296,309,317,319,324,329,340,348,350,361,368,384,391,397,403,406,409,
-  	428,433,449,466,472,476,480,493,499,516,520,525,532,542,552,564
+  	1,60,1,60,1,61,4,61,563,8,61,11,61,12,61,564,1,61,1,4,1,4,1,4,1,4,0,4,
+  	12,22,24,30,62,0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30,32,34,36,38,
+  	40,42,44,46,48,50,52,54,56,58,60,62,64,66,68,70,72,74,76,78,80,82,84,
+  	86,88,90,92,94,96,98,100,102,104,106,108,110,112,114,116,118,120,122,
+  	0,9,1,0,38,43,1,0,42,43,1,0,34,35,2,0,33,33,36,37,2,0,1,7,9,32,2,0,77,
+  	78,80,81,5,0,67,67,69,72,74,76,79,81,83,83,4,0,67,67,69,72,74,76,79,81,
+  	1,0,86,91,593,0,128,1,0,0,0,2,133,1,0,0,0,4,136,1,0,0,0,6,168,1,0,0,0,
+  	8,180,1,0,0,0,10,191,1,0,0,0,12,199,1,0,0,0,14,225,1,0,0,0,16,235,1,0,
+  	0,0,18,246,1,0,0,0,20,248,1,0,0,0,22,260,1,0,0,0,24,309,1,0,0,0,26,324,
+  	1,0,0,0,28,329,1,0,0,0,30,340,1,0,0,0,32,361,1,0,0,0,34,384,1,0,0,0,36,
+  	386,1,0,0,0,38,397,1,0,0,0,40,399,1,0,0,0,42,403,1,0,0,0,44,411,1,0,0,
+  	0,46,414,1,0,0,0,48,417,1,0,0,0,50,420,1,0,0,0,52,425,1,0,0,0,54,433,
+  	1,0,0,0,56,437,1,0,0,0,58,439,1,0,0,0,60,441,1,0,0,0,62,443,1,0,0,0,64,
+  	445,1,0,0,0,66,449,1,0,0,0,68,451,1,0,0,0,70,453,1,0,0,0,72,455,1,0,0,
+  	0,74,457,1,0,0,0,76,461,1,0,0,0,78,470,1,0,0,0,80,474,1,0,0,0,82,480,
+  	1,0,0,0,84,482,1,0,0,0,86,493,1,0,0,0,88,499,1,0,0,0,90,501,1,0,0,0,92,
+  	503,1,0,0,0,94,507,1,0,0,0,96,510,1,0,0,0,98,516,1,0,0,0,100,518,1,0,
+  	0,0,102,532,1,0,0,0,104,534,1,0,0,0,106,538,1,0,0,0,108,542,1,0,0,0,110,
+  	544,1,0,0,0,112,547,1,0,0,0,114,552,1,0,0,0,116,554,1,0,0,0,118,557,1,
+  	0,0,0,120,559,1,0,0,0,122,562,1,0,0,0,124,127,3,4,2,0,125,127,3,2,1,0,
+  	126,124,1,0,0,0,126,125,1,0,0,0,127,130,1,0,0,0,128,126,1,0,0,0,128,129,
+  	1,0,0,0,129,131,1,0,0,0,130,128,1,0,0,0,131,132,5,0,0,1,132,1,1,0,0,0,
+  	133,134,5,63,0,0,134,135,6,1,-1,0,135,3,1,0,0,0,136,138,5,27,0,0,137,
+  	139,3,6,3,0,138,137,1,0,0,0,138,139,1,0,0,0,139,140,1,0,0,0,140,141,3,
+  	8,4,0,141,142,3,10,5,0,142,143,5,31,0,0,143,147,3,12,6,0,144,145,5,24,
+  	0,0,145,146,5,5,0,0,146,148,3,14,7,0,147,144,1,0,0,0,147,148,1,0,0,0,
+  	148,151,1,0,0,0,149,150,5,32,0,0,150,152,3,38,19,0,151,149,1,0,0,0,151,
+  	152,1,0,0,0,152,156,1,0,0,0,153,154,5,6,0,0,154,155,5,5,0,0,155,157,3,
+  	18,9,0,156,153,1,0,0,0,156,157,1,0,0,0,157,160,1,0,0,0,158,159,5,8,0,
+  	0,159,161,3,20,10,0,160,158,1,0,0,0,160,161,1,0,0,0,161,5,1,0,0,0,162,
+  	169,5,1,0,0,163,169,5,3,0,0,164,169,5,16,0,0,165,169,5,18,0,0,166,169,
+  	5,20,0,0,167,169,5,29,0,0,168,162,1,0,0,0,168,163,1,0,0,0,168,164,1,0,
+  	0,0,168,165,1,0,0,0,168,166,1,0,0,0,168,167,1,0,0,0,169,7,1,0,0,0,170,
+  	181,5,36,0,0,171,181,5,21,0,0,172,177,3,54,27,0,173,174,5,46,0,0,174,
+  	176,3,54,27,0,175,173,1,0,0,0,176,179,1,0,0,0,177,175,1,0,0,0,177,178,
+  	1,0,0,0,178,181,1,0,0,0,179,177,1,0,0,0,180,170,1,0,0,0,180,171,1,0,0,
+  	0,180,567,1,0,0,0,180,172,1,0,0,0,181,9,1,0,0,0,182,183,5,13,0,0,183,
+  	188,3,58,29,0,184,185,5,46,0,0,185,187,3,58,29,0,186,184,1,0,0,0,187,
+  	190,1,0,0,0,188,186,1,0,0,0,188,189,1,0,0,0,189,192,1,0,0,0,190,188,1,
+  	0,0,0,191,182,1,0,0,0,191,192,1,0,0,0,192,11,1,0,0,0,193,194,6,6,-1,0,
+  	194,195,5,48,0,0,195,196,3,12,6,0,196,197,5,49,0,0,197,200,1,0,0,0,198,
+  	200,3,54,27,0,199,193,1,0,0,0,199,198,1,0,0,0,200,222,1,0,0,0,201,202,
+  	10,4,0,0,202,203,5,44,0,0,203,221,3,12,6,5,204,205,10,3,0,0,205,206,5,
+  	45,0,0,206,221,3,12,6,4,207,208,10,2,0,0,208,209,5,23,0,0,209,221,3,12,
+  	6,3,210,211,10,7,0,0,211,212,5,4,0,0,212,221,3,56,28,0,213,214,10,6,0,
+  	0,214,221,5,34,0,0,215,216,10,5,0,0,216,221,5,54,0,0,217,218,10,1,0,0,
+  	218,219,5,12,0,0,219,221,3,22,11,0,220,201,1,0,0,0,220,204,1,0,0,0,220,
+  	207,1,0,0,0,220,210,1,0,0,0,220,213,1,0,0,0,220,215,1,0,0,0,220,217,1,
+  	0,0,0,221,224,1,0,0,0,222,220,1,0,0,0,222,223,1,0,0,0,223,13,1,0,0,0,
+  	224,222,1,0,0,0,225,226,5,50,0,0,226,227,3,16,8,0,227,233,5,51,0,0,228,
+  	229,5,46,0,0,229,230,5,50,0,0,230,231,3,16,8,0,231,232,5,51,0,0,232,234,
+  	1,0,0,0,233,228,1,0,0,0,233,234,1,0,0,0,234,15,1,0,0,0,235,240,3,60,30,
+  	0,236,237,5,46,0,0,237,239,3,60,30,0,238,236,1,0,0,0,239,242,1,0,0,0,
+  	240,238,1,0,0,0,240,241,1,0,0,0,241,17,1,0,0,0,242,240,1,0,0,0,243,247,
+  	5,3,0,0,244,247,5,24,0,0,245,247,5,21,0,0,246,243,1,0,0,0,246,244,1,0,
+  	0,0,246,245,1,0,0,0,247,19,1,0,0,0,248,249,3,62,31,0,249,21,1,0,0,0,250,
+  	251,6,11,-1,0,251,252,5,48,0,0,252,253,3,22,11,0,253,254,5,49,0,0,254,
+  	261,1,0,0,0,255,256,3,54,27,0,256,257,5,50,0,0,257,258,3,24,12,0,258,
+  	259,5,51,0,0,259,261,1,0,0,0,260,250,1,0,0,0,260,255,1,0,0,0,261,270,
+  	1,0,0,0,262,263,10,2,0,0,263,264,5,2,0,0,264,269,3,22,11,3,265,266,10,
+  	1,0,0,266,267,5,23,0,0,267,269,3,22,11,2,268,262,1,0,0,0,268,265,1,0,
+  	0,0,269,272,1,0,0,0,270,268,1,0,0,0,270,271,1,0,0,0,271,23,1,0,0,0,272,
+  	270,1,0,0,0,273,274,6,12,-1,0,274,275,5,48,0,0,275,276,3,24,12,0,276,
+  	277,5,49,0,0,277,310,1,0,0,0,278,279,5,22,0,0,279,310,3,24,12,8,280,281,
+  	3,30,15,0,281,282,7,0,0,0,282,283,3,30,15,0,283,310,1,0,0,0,284,285,3,
+  	26,13,0,285,286,7,1,0,0,286,287,3,28,14,0,287,310,1,0,0,0,288,289,3,60,
+  	30,0,289,290,5,17,0,0,290,291,3,74,37,0,291,310,1,0,0,0,292,296,3,60,
+  	30,0,293,297,5,15,0,0,294,295,5,22,0,0,295,297,5,15,0,0,296,293,1,0,0,
+  	0,296,294,1,0,0,0,297,298,1,0,0,0,298,299,3,32,16,0,299,310,1,0,0,0,300,
+  	301,3,30,15,0,301,302,5,15,0,0,302,303,5,25,0,0,303,304,5,48,0,0,304,
+  	305,3,30,15,0,305,306,5,46,0,0,306,307,3,30,15,0,307,308,5,49,0,0,308,
+  	310,1,0,0,0,309,273,1,0,0,0,309,278,1,0,0,0,309,280,1,0,0,0,309,284,1,
+  	0,0,0,309,288,1,0,0,0,309,292,1,0,0,0,309,300,1,0,0,0,310,319,1,0,0,0,
+  	311,312,10,5,0,0,312,313,5,2,0,0,313,318,3,24,12,6,314,315,10,4,0,0,315,
+  	316,5,23,0,0,316,318,3,24,12,5,317,311,1,0,0,0,317,314,1,0,0,0,318,321,
+  	1,0,0,0,319,317,1,0,0,0,319,320,1,0,0,0,320,25,1,0,0,0,321,319,1,0,0,
+  	0,322,325,3,68,34,0,323,325,3,60,30,0,324,322,1,0,0,0,324,323,1,0,0,0,
+  	325,27,1,0,0,0,326,330,3,68,34,0,327,330,3,60,30,0,328,330,3,74,37,0,
+  	329,326,1,0,0,0,329,327,1,0,0,0,329,328,1,0,0,0,330,29,1,0,0,0,331,332,
+  	6,15,-1,0,332,333,5,48,0,0,333,334,3,30,15,0,334,335,5,49,0,0,335,341,
+  	1,0,0,0,336,341,3,66,33,0,337,341,3,60,30,0,338,339,7,2,0,0,339,341,3,
+  	30,15,3,340,331,1,0,0,0,340,336,1,0,0,0,340,337,1,0,0,0,340,338,1,0,0,
+  	0,341,350,1,0,0,0,342,343,10,2,0,0,343,344,7,3,0,0,344,349,3,30,15,3,
+  	345,346,10,1,0,0,346,347,7,2,0,0,347,349,3,30,15,2,348,342,1,0,0,0,348,
+  	345,1,0,0,0,349,352,1,0,0,0,350,348,1,0,0,0,350,351,1,0,0,0,351,31,1,
+  	0,0,0,352,350,1,0,0,0,353,354,5,52,0,0,354,355,3,34,17,0,355,356,5,53,
+  	0,0,356,362,1,0,0,0,357,358,5,52,0,0,358,359,3,36,18,0,359,360,5,53,0,
+  	0,360,362,1,0,0,0,361,353,1,0,0,0,361,357,1,0,0,0,362,33,1,0,0,0,363,
+  	368,3,66,33,0,364,365,5,46,0,0,365,367,3,66,33,0,366,364,1,0,0,0,367,
+  	370,1,0,0,0,368,366,1,0,0,0,368,369,1,0,0,0,369,385,1,0,0,0,370,368,1,
+  	0,0,0,371,372,3,62,31,0,372,373,5,47,0,0,373,374,3,62,31,0,374,385,1,
+  	0,0,0,375,376,3,64,32,0,376,377,5,47,0,0,377,378,3,64,32,0,378,385,1,
+  	0,0,0,379,380,3,66,33,0,380,381,5,47,0,0,381,385,1,0,0,0,382,383,5,47,
+  	0,0,383,385,3,66,33,0,384,363,1,0,0,0,384,371,1,0,0,0,384,375,1,0,0,0,
+  	384,379,1,0,0,0,384,382,1,0,0,0,385,35,1,0,0,0,386,391,3,68,34,0,387,
+  	388,5,46,0,0,388,390,3,68,34,0,389,387,1,0,0,0,390,393,1,0,0,0,391,389,
+  	1,0,0,0,391,392,1,0,0,0,392,37,1,0,0,0,393,391,1,0,0,0,394,398,3,40,20,
+  	0,395,398,3,42,21,0,396,398,3,50,25,0,397,394,1,0,0,0,397,395,1,0,0,0,
+  	397,396,1,0,0,0,398,39,1,0,0,0,399,400,3,62,31,0,400,401,5,11,0,0,401,
+  	41,1,0,0,0,402,404,3,44,22,0,403,402,1,0,0,0,403,404,1,0,0,0,404,406,
+  	1,0,0,0,405,407,3,46,23,0,406,405,1,0,0,0,406,407,1,0,0,0,407,409,1,0,
+  	0,0,408,410,3,48,24,0,409,408,1,0,0,0,409,410,1,0,0,0,410,43,1,0,0,0,
+  	411,412,3,66,33,0,412,413,5,14,0,0,413,45,1,0,0,0,414,415,3,66,33,0,415,
+  	416,5,19,0,0,416,47,1,0,0,0,417,418,3,66,33,0,418,419,5,26,0,0,419,49,
+  	1,0,0,0,420,421,3,62,31,0,421,422,5,50,0,0,422,423,3,70,35,0,423,424,
+  	5,51,0,0,424,51,1,0,0,0,425,428,3,54,27,0,426,427,5,4,0,0,427,429,3,56,
+  	28,0,428,426,1,0,0,0,428,429,1,0,0,0,429,53,1,0,0,0,430,431,3,58,29,0,
+  	431,432,5,40,0,0,432,434,1,0,0,0,433,430,1,0,0,0,433,434,1,0,0,0,434,
+  	435,1,0,0,0,435,436,3,56,28,0,436,55,1,0,0,0,437,438,3,70,35,0,438,57,
+  	1,0,0,0,439,440,3,70,35,0,440,59,1,0,0,0,441,442,3,70,35,0,442,61,1,0,
+  	0,0,443,444,5,57,0,0,444,63,1,0,0,0,445,446,5,56,0,0,446,65,1,0,0,0,447,
+  	450,3,62,31,0,448,450,3,64,32,0,449,447,1,0,0,0,449,448,1,0,0,0,450,67,
+  	1,0,0,0,451,452,5,59,0,0,452,69,1,0,0,0,453,454,5,55,0,0,454,71,1,0,0,
+  	0,455,456,7,4,0,0,456,73,1,0,0,0,457,458,5,64,0,0,458,459,3,76,38,0,459,
+  	460,5,65,0,0,460,75,1,0,0,0,461,466,3,78,39,0,462,463,5,67,0,0,463,465,
+  	3,78,39,0,464,462,1,0,0,0,465,468,1,0,0,0,466,464,1,0,0,0,466,467,1,0,
+  	0,0,467,77,1,0,0,0,468,466,1,0,0,0,469,471,3,80,40,0,470,469,1,0,0,0,
+  	471,472,1,0,0,0,472,470,1,0,0,0,472,473,1,0,0,0,473,79,1,0,0,0,474,476,
+  	3,82,41,0,475,477,3,86,43,0,476,475,1,0,0,0,476,477,1,0,0,0,477,81,1,
+  	0,0,0,478,481,3,84,42,0,479,481,3,98,49,0,480,478,1,0,0,0,480,479,1,0,
+  	0,0,481,83,1,0,0,0,482,483,5,71,0,0,483,484,3,76,38,0,484,485,5,72,0,
+  	0,485,85,1,0,0,0,486,494,5,74,0,0,487,494,5,75,0,0,488,494,5,76,0,0,489,
+  	490,5,69,0,0,490,491,3,88,44,0,491,492,5,70,0,0,492,494,1,0,0,0,493,486,
+  	1,0,0,0,493,487,1,0,0,0,493,488,1,0,0,0,493,489,1,0,0,0,494,87,1,0,0,
+  	0,495,500,3,90,45,0,496,500,3,92,46,0,497,500,3,94,47,0,498,500,3,96,
+  	48,0,499,495,1,0,0,0,499,496,1,0,0,0,499,497,1,0,0,0,499,498,1,0,0,0,
+  	500,89,1,0,0,0,501,502,3,122,61,0,502,91,1,0,0,0,503,504,3,122,61,0,504,
+  	505,5,73,0,0,505,506,3,122,61,0,506,93,1,0,0,0,507,508,3,122,61,0,508,
+  	509,5,73,0,0,509,95,1,0,0,0,510,511,5,73,0,0,511,512,3,122,61,0,512,97,
+  	1,0,0,0,513,517,3,100,50,0,514,517,3,120,60,0,515,517,3,114,57,0,516,
+  	513,1,0,0,0,516,514,1,0,0,0,516,515,1,0,0,0,517,99,1,0,0,0,518,520,5,
+  	79,0,0,519,521,5,77,0,0,520,519,1,0,0,0,520,521,1,0,0,0,521,523,1,0,0,
+  	0,522,524,3,102,51,0,523,522,1,0,0,0,524,525,1,0,0,0,525,523,1,0,0,0,
+  	525,526,1,0,0,0,526,527,1,0,0,0,527,528,5,80,0,0,528,101,1,0,0,0,529,
+  	533,3,104,52,0,530,533,3,120,60,0,531,533,3,106,53,0,532,529,1,0,0,0,
+  	532,530,1,0,0,0,532,531,1,0,0,0,533,103,1,0,0,0,534,535,3,108,54,0,535,
+  	536,5,78,0,0,536,537,3,108,54,0,537,105,1,0,0,0,538,539,3,108,54,0,539,
+  	107,1,0,0,0,540,543,3,110,55,0,541,543,3,112,56,0,542,540,1,0,0,0,542,
+  	541,1,0,0,0,543,109,1,0,0,0,544,545,5,81,0,0,545,546,7,5,0,0,546,111,
+  	1,0,0,0,547,548,8,5,0,0,548,113,1,0,0,0,549,553,3,116,58,0,550,553,5,
+  	83,0,0,551,553,3,118,59,0,552,549,1,0,0,0,552,550,1,0,0,0,552,551,1,0,
+  	0,0,553,115,1,0,0,0,554,555,5,81,0,0,555,556,7,6,0,0,556,117,1,0,0,0,
+  	557,558,8,7,0,0,558,119,1,0,0,0,559,560,7,8,0,0,560,121,1,0,0,0,561,563,
+  	5,92,0,0,562,561,1,0,0,0,563,564,1,0,0,0,564,562,1,0,0,0,564,565,1,0,
+  	0,0,565,123,1,0,0,0,567,568,5,7,0,0,568,569,5,48,0,0,569,570,5,36,0,0,
+  	570,181,5,49,0,0,54,126,128,138,147,151,156,160,168,177,180,188,191,199,
+  	220,222,233,240,246,260,268,270,296,309,317,319,324,329,340,348,350,361,
+  	368,384,391,397,403,406,409,428,433,449,466,472,476,480,493,499,516,520,
+  	525,532,542,552,564
   };
   staticData->serializedATN = antlr4::atn::SerializedATNView(serializedATNSegment, sizeof(serializedATNSegment) / sizeof(serializedATNSegment[0]));
 
@@ -574,7 +576,7 @@ CEQLQueryParser::Core_queryContext* CEQLQueryParser::core_query() {
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
-      ((1ULL << _la) & 269123594) != 0)) {
+      ((1ULL << _la) & 538247178) != 0)) {
       setState(137);
       selection_strategy();
     }
@@ -895,6 +897,33 @@ std::any CEQLQueryParser::S_noneContext::accept(tree::ParseTreeVisitor *visitor)
   else
     return visitor->visitChildren(this);
 }
+//----------------- S_countContext ------------------------------------------------------------------
+
+tree::TerminalNode* CEQLQueryParser::S_countContext::K_COUNT() {
+  return getToken(CEQLQueryParser::K_COUNT, 0);
+}
+
+tree::TerminalNode* CEQLQueryParser::S_countContext::LEFT_PARENTHESIS() {
+  return getToken(CEQLQueryParser::LEFT_PARENTHESIS, 0);
+}
+
+tree::TerminalNode* CEQLQueryParser::S_countContext::STAR() {
+  return getToken(CEQLQueryParser::STAR, 0);
+}
+
+tree::TerminalNode* CEQLQueryParser::S_countContext::RIGHT_PARENTHESIS() {
+  return getToken(CEQLQueryParser::RIGHT_PARENTHESIS, 0);
+}
+
+CEQLQueryParser::S_countContext::S_countContext(List_of_variablesContext *ctx) { copyFrom(ctx); }
+
+
+std::any CEQLQueryParser::S_countContext::accept(tree::ParseTreeVisitor *visitor) {
+  if (auto parserVisitor = dynamic_cast<CEQLQueryParserVisitor*>(visitor))
+    return parserVisitor->visitS_count(this);
+  else
+    return visitor->visitChildren(this);
+}
 CEQLQueryParser::List_of_variablesContext* CEQLQueryParser::list_of_variables() {
   List_of_variablesContext *_localctx = _tracker.createInstance<List_of_variablesContext>(_ctx, getState());
   enterRule(_localctx, 8, CEQLQueryParser::RuleList_of_variables);
@@ -927,9 +956,23 @@ CEQLQueryParser::List_of_variablesContext* CEQLQueryParser::list_of_variables()
         break;
       }
 
+      case CEQLQueryParser::K_COUNT: {
+        _localctx = _tracker.createInstance<CEQLQueryParser::S_countContext>(_localctx);
+        enterOuterAlt(_localctx, 3);
+        setState(567);
+        match(CEQLQueryParser::K_COUNT);
+        setState(568);
+        match(CEQLQueryParser::LEFT_PARENTHESIS);
+        setState(569);
+        match(CEQLQueryParser::STAR);
+        setState(570);
+        match(CEQLQueryParser::RIGHT_PARENTHESIS);
+        break;
+      }
+
       case CEQLQueryParser::IDENTIFIER: {
         _localctx = _tracker.createInstance<CEQLQueryParser::S_list_of_variablesContext>(_localctx);
-        enterOuterAlt(_localctx, 3);
+        enterOuterAlt(_localctx, 4);
         setState(172);
         s_event_name();
         setState(177);
@@ -2321,7 +2364,7 @@ CEQLQueryParser::PredicateContext* CEQLQueryParser::predicate(int precedence) {
       setState(281);
       _la = _input->LA(1);
       if (!((((_la & ~ 0x3fULL) == 0) &&
-        ((1ULL << _la) & 8658654068736) != 0))) {
+        ((1ULL << _la) & 17317308137472) != 0))) {
       _errHandler->recoverInline(this);
       }
       else {
@@ -2890,7 +2933,7 @@ CEQLQueryParser::Math_exprContext* CEQLQueryParser::math_expr(int precedence) {
           setState(343);
           _la = _input->LA(1);
           if (!((((_la & ~ 0x3fULL) == 0) &&
-            ((1ULL << _la) & 107374182400) != 0))) {
+            ((1ULL << _la) & 214748364800) != 0))) {
           _errHandler->recoverInline(this);
           }
           else {
@@ -4365,6 +4408,10 @@ tree::TerminalNode* CEQLQueryParser::KeywordContext::K_CONSUME() {
   return getToken(CEQLQueryParser::K_CONSUME, 0);
 }
 
+tree::TerminalNode* CEQLQueryParser::KeywordContext::K_COUNT() {
+  return getToken(CEQLQueryParser::K_COUNT, 0);
+}
+
 tree::TerminalNode* CEQLQueryParser::KeywordContext::K_DISTINCT() {
   return getToken(CEQLQueryParser::K_DISTINCT, 0);
 }
@@ -4491,7 +4538,7 @@ CEQLQueryParser::KeywordContext* CEQLQueryParser::keyword() {
     setState(455);
     _la = _input->LA(1);
     if (!((((_la & ~ 0x3fULL) == 0) &&
-      ((1ULL << _la) & 4294967166) != 0))) {
+      ((1ULL << _la) & 8589934334) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -4761,8 +4808,8 @@ CEQLQueryParser::Regexp_elementContext* CEQLQueryParser::regexp_element() {
     _errHandler->sync(this);
 
     _la = _input->LA(1);
-    if (((((_la - 68) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 68)) & 225) != 0)) {
+    if (((((_la - 69) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 69)) & 225) != 0)) {
       setState(475);
       quantifier();
     }
@@ -4832,6 +4879,7 @@ CEQLQueryParser::Regexp_groupContext* CEQLQueryParser::regexp_group() {
       case CEQLQueryParser::K_AS:
       case CEQLQueryParser::K_BY:
       case CEQLQueryParser::K_CONSUME:
+      case CEQLQueryParser::K_COUNT:
       case CEQLQueryParser::K_LIMIT:
       case CEQLQueryParser::K_DISTINCT:
       case CEQLQueryParser::K_EVENT:
@@ -5560,7 +5608,7 @@ CEQLQueryParser::CharacterClassContext* CEQLQueryParser::characterClass() {
       _la = _input->LA(1);
     } while ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & -2) != 0) || ((((_la - 64) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 64)) & 268390399) != 0));
+      ((1ULL << (_la - 64)) & 536780799) != 0));
     setState(527);
     match(CEQLQueryParser::REGEX_R_BRACK);
    
@@ -5820,6 +5868,7 @@ CEQLQueryParser::CcLiteralContext* CEQLQueryParser::ccLiteral() {
       case CEQLQueryParser::K_AS:
       case CEQLQueryParser::K_BY:
       case CEQLQueryParser::K_CONSUME:
+      case CEQLQueryParser::K_COUNT:
       case CEQLQueryParser::K_LIMIT:
       case CEQLQueryParser::K_DISTINCT:
       case CEQLQueryParser::K_EVENT:
@@ -5978,8 +6027,8 @@ CEQLQueryParser::CcEscapesContext* CEQLQueryParser::ccEscapes() {
     match(CEQLQueryParser::REGEX_BACKSLASH);
     setState(545);
     _la = _input->LA(1);
-    if (!(((((_la - 76) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 76)) & 27) != 0))) {
+    if (!(((((_la - 77) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 77)) & 27) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -6048,8 +6097,8 @@ CEQLQueryParser::CcOtherContext* CEQLQueryParser::ccOther() {
     enterOuterAlt(_localctx, 1);
     setState(547);
     _la = _input->LA(1);
-    if (_la == 0 || _la == Token::EOF || (((((_la - 76) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 76)) & 27) != 0))) {
+    if (_la == 0 || _la == Token::EOF || (((((_la - 77) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 77)) & 27) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -6237,8 +6286,8 @@ CEQLQueryParser::EscapesContext* CEQLQueryParser::escapes() {
     match(CEQLQueryParser::REGEX_BACKSLASH);
     setState(555);
     _la = _input->LA(1);
-    if (!(((((_la - 66) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 66)) & 95165) != 0))) {
+    if (!(((((_la - 67) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 67)) & 95165) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -6335,8 +6384,8 @@ CEQLQueryParser::OtherContext* CEQLQueryParser::other() {
     enterOuterAlt(_localctx, 1);
     setState(557);
     _la = _input->LA(1);
-    if (_la == 0 || _la == Token::EOF || (((((_la - 66) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 66)) & 29629) != 0))) {
+    if (_la == 0 || _la == Token::EOF || (((((_la - 67) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 67)) & 29629) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -6413,8 +6462,8 @@ CEQLQueryParser::SharedAtomContext* CEQLQueryParser::sharedAtom() {
     enterOuterAlt(_localctx, 1);
     setState(559);
     _la = _input->LA(1);
-    if (!(((((_la - 85) & ~ 0x3fULL) == 0) &&
-      ((1ULL << (_la - 85)) & 63) != 0))) {
+    if (!(((((_la - 86) & ~ 0x3fULL) == 0) &&
+      ((1ULL << (_la - 86)) & 63) != 0))) {
     _errHandler->recoverInline(this);
     }
     else {
@@ -13,26 +13,26 @@ class  CEQLQueryParser : public antlr4::Parser {
 public:
   enum {
     K_ALL = 1, K_AND = 2, K_ANY = 3, K_AS = 4, K_BY = 5, K_CONSUME = 6, 
-    K_LIMIT = 7, K_DISTINCT = 8, K_EVENT = 9, K_EVENTS = 10, K_FILTER = 11, 
-    K_FROM = 12, K_HOURS = 13, K_IN = 14, K_LAST = 15, K_LIKE = 16, K_MAX = 17, 
-    K_MINUTES = 18, K_NEXT = 19, K_NONE = 20, K_NOT = 21, K_OR = 22, K_PARTITION = 23, 
-    K_RANGE = 24, K_SECONDS = 25, K_SELECT = 26, K_STREAM = 27, K_STRICT = 28, 
-    K_UNLESS = 29, K_WHERE = 30, K_WITHIN = 31, PERCENT = 32, PLUS = 33, 
-    MINUS = 34, STAR = 35, SLASH = 36, LE = 37, LEQ = 38, GE = 39, GEQ = 40, 
-    EQ = 41, NEQ = 42, SEMICOLON = 43, COLON = 44, COMMA = 45, DOUBLE_DOT = 46, 
-    LEFT_PARENTHESIS = 47, RIGHT_PARENTHESIS = 48, LEFT_SQUARE_BRACKET = 49, 
-    RIGHT_SQUARE_BRACKET = 50, LEFT_CURLY_BRACKET = 51, RIGHT_CURLY_BRACKET = 52, 
-    COLON_PLUS = 53, IDENTIFIER = 54, DOUBLE_LITERAL = 55, INTEGER_LITERAL = 56, 
-    NUMERICAL_EXPONENT = 57, STRING_LITERAL = 58, SINGLE_LINE_COMMENT = 59, 
-    MULTILINE_COMMENT = 60, SPACES = 61, UNEXPECTED_CHAR = 62, REGEX_START = 63, 
-    REGEX_END = 64, REGEX_END_ESCAPED = 65, REGEX_PIPE = 66, REGEX_EXCLAMAITON = 67, 
-    REGEX_L_CURLY = 68, REGEX_R_CURLY = 69, REGEX_L_PAR = 70, REGEX_R_PAR = 71, 
-    REGEX_COMMA = 72, REGEX_QUESTION = 73, REGEX_PLUS = 74, REGEX_STAR = 75, 
-    REGEX_HAT = 76, REGEX_HYPHEN = 77, REGEX_L_BRACK = 78, REGEX_R_BRACK = 79, 
-    REGEX_BACKSLASH = 80, REGEX_ALPHA = 81, REGEX_DOT = 82, REGEX_DOUBLED_DOT = 83, 
-    UNRECOGNIZED = 84, REGEX_DECIMAL_DIGIT = 85, REGEX_NOT_DECIMAL_DIGIT = 86, 
-    REGEX_WHITESPACE = 87, REGEX_NOT_WHITESPACE = 88, REGEX_ALPHANUMERIC = 89, 
-    REGEX_NOT_ALPHANUMERIC = 90, REGEX_DIGIT = 91
+    K_COUNT = 7, K_LIMIT = 8, K_DISTINCT = 9, K_EVENT = 10, K_EVENTS = 11, 
+    K_FILTER = 12, K_FROM = 13, K_HOURS = 14, K_IN = 15, K_LAST = 16, K_LIKE = 17, 
+    K_MAX = 18, K_MINUTES = 19, K_NEXT = 20, K_NONE = 21, K_NOT = 22, K_OR = 23, 
+    K_PARTITION = 24, K_RANGE = 25, K_SECONDS = 26, K_SELECT = 27, K_STREAM = 28, 
+    K_STRICT = 29, K_UNLESS = 30, K_WHERE = 31, K_WITHIN = 32, PERCENT = 33, 
+    PLUS = 34, MINUS = 35, STAR = 36, SLASH = 37, LE = 38, LEQ = 39, GE = 40, 
+    GEQ = 41, EQ = 42, NEQ = 43, SEMICOLON = 44, COLON = 45, COMMA = 46, 
+    DOUBLE_DOT = 47, LEFT_PARENTHESIS = 48, RIGHT_PARENTHESIS = 49, LEFT_SQUARE_BRACKET = 50, 
+    RIGHT_SQUARE_BRACKET = 51, LEFT_CURLY_BRACKET = 52, RIGHT_CURLY_BRACKET = 53, 
+    COLON_PLUS = 54, IDENTIFIER = 55, DOUBLE_LITERAL = 56, INTEGER_LITERAL = 57, 
+    NUMERICAL_EXPONENT = 58, STRING_LITERAL = 59, SINGLE_LINE_COMMENT = 60, 
+    MULTILINE_COMMENT = 61, SPACES = 62, UNEXPECTED_CHAR = 63, REGEX_START = 64, 
+    REGEX_END = 65, REGEX_END_ESCAPED = 66, REGEX_PIPE = 67, REGEX_EXCLAMAITON = 68, 
+    REGEX_L_CURLY = 69, REGEX_R_CURLY = 70, REGEX_L_PAR = 71, REGEX_R_PAR = 72, 
+    REGEX_COMMA = 73, REGEX_QUESTION = 74, REGEX_PLUS = 75, REGEX_STAR = 76, 
+    REGEX_HAT = 77, REGEX_HYPHEN = 78, REGEX_L_BRACK = 79, REGEX_R_BRACK = 80, 
+    REGEX_BACKSLASH = 81, REGEX_ALPHA = 82, REGEX_DOT = 83, REGEX_DOUBLED_DOT = 84, 
+    UNRECOGNIZED = 85, REGEX_DECIMAL_DIGIT = 86, REGEX_NOT_DECIMAL_DIGIT = 87, 
+    REGEX_WHITESPACE = 88, REGEX_NOT_WHITESPACE = 89, REGEX_ALPHANUMERIC = 90, 
+    REGEX_NOT_ALPHANUMERIC = 91, REGEX_DIGIT = 92
   };
 
   enum {
@@ -306,6 +306,18 @@ public:
     virtual std::any accept(antlr4::tree::ParseTreeVisitor *visitor) override;
   };
 
+  class  S_countContext : public List_of_variablesContext {
+  public:
+    S_countContext(List_of_variablesContext *ctx);
+
+    antlr4::tree::TerminalNode *K_COUNT();
+    antlr4::tree::TerminalNode *LEFT_PARENTHESIS();
+    antlr4::tree::TerminalNode *STAR();
+    antlr4::tree::TerminalNode *RIGHT_PARENTHESIS();
+
+    virtual std::any accept(antlr4::tree::ParseTreeVisitor *visitor) override;
+  };
+
   List_of_variablesContext* list_of_variables();
 
   class  From_clauseContext : public antlr4::ParserRuleContext {
@@ -1177,6 +1189,7 @@ public:
     antlr4::tree::TerminalNode *K_AS();
     antlr4::tree::TerminalNode *K_BY();
     antlr4::tree::TerminalNode *K_CONSUME();
+    antlr4::tree::TerminalNode *K_COUNT();
     antlr4::tree::TerminalNode *K_DISTINCT();
     antlr4::tree::TerminalNode *K_EVENT();
     antlr4::tree::TerminalNode *K_EVENTS();
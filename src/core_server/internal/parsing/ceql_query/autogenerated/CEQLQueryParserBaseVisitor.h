@@ -59,6 +59,10 @@ public:
     return visitChildren(ctx);
   }
 
+  virtual std::any visitS_count(CEQLQueryParser::S_countContext *ctx) override {
+    return visitChildren(ctx);
+  }
+
   virtual std::any visitS_list_of_variables(CEQLQueryParser::S_list_of_variablesContext *ctx) override {
     return visitChildren(ctx);
   }
@@ -41,6 +41,8 @@ public:
 
     virtual std::any visitS_none(CEQLQueryParser::S_noneContext *context) = 0;
 
+    virtual std::any visitS_count(CEQLQueryParser::S_countContext *context) = 0;
+
     virtual std::any visitS_list_of_variables(CEQLQueryParser::S_list_of_variablesContext *context) = 0;
 
     virtual std::any visitFrom_clause(CEQLQueryParser::From_clauseContext *context) = 0;
@@ -24,11 +24,14 @@ class SelectVisitor : public CEQLQueryParserBaseVisitor {
   std::set<VariableName> variables;
   std::set<std::pair<StreamName, VariableName>> streams_events;
   bool is_star = false;
+  CEQL::Select::Output output = CEQL::Select::Output::COMPLEX_EVENTS;
   std::unique_ptr<CEQL::ProjectionFormula> formula;
 
  public:
   CEQL::Select get_parsed_select() {
-    return CEQL::Select(std::move(strategy), std::move(is_star), std::move(formula));
+    CEQL::Select select(std::move(strategy), std::move(is_star), std::move(formula));
+    select.output = output;
+    return select;
   }
 
   virtual std::any visitCore_query(CEQLQueryParser::Core_queryContext* ctx) override {
@@ -57,6 +60,14 @@ class SelectVisitor : public CEQLQueryParserBaseVisitor {
     return {};
   }
 
+  virtual std::any visitS_count(CEQLQueryParser::S_countContext* ctx) override {
+    assert(variables.empty());
+    assert(streams_events.empty());
+    is_star = true;
+    output = CEQL::Select::Output::COUNT;
+    return {};
+  }
+
   virtual std::any visitS_event_name(CEQLQueryParser::S_event_nameContext* ctx) override {
     if (ctx->stream_name()) {
       streams_events.insert({ctx->stream_name()->getText(), ctx->event_name()->getText()});
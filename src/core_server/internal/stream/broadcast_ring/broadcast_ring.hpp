@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace CORE::Internal::Stream {
+
+const size_t BROADCAST_RING_DEFAULT_CAPACITY = 1 << 16;
+const size_t BROADCAST_RING_DEFAULT_MAXIMUM_READERS = 1024;
+// Times a reader polls an empty ring before going to sleep.
+const size_t BROADCAST_RING_SPINS_BEFORE_SLEEP = 256;
+
+/**
+ * Single producer, multiple consumer broadcast ring. Every value pushed is
+ * seen by every reader, each reader keeps its own read sequence so there is
+ * no per reader copy of the values.
+ *
+ * The producer only synchronizes with the readers when the ring is full or
+ * when a reader is sleeping. Readers consume every value available in a
+ * batch and only go to sleep after polling an empty ring for a while, so a
+ * busy stream does not need any system call.
+ */
+template <typename T>
+class BroadcastRing {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  static constexpr uint64_t INACTIVE_READER = UINT64_MAX;
+
+  struct alignas(64) Reader {
+    // Sequence of the next value to read, written by the reader only.
+    std::atomic<uint64_t> read_sequence = INACTIVE_READER;
+    std::atomic<bool> is_stopped = false;
+    // Values up to this sequence are known to be published, reader local.
+    uint64_t available_sequence = 0;
+  };
+
+ public:
+  using ReaderId = size_t;
+
+ private:
+  std::unique_ptr<T[]> slots;
+  uint64_t mask;
+  std::unique_ptr<Reader[]> readers;
+  size_t maximum_readers;
+  std::atomic<size_t> amount_of_readers = 0;
+
+  alignas(64) std::atomic<uint64_t> write_sequence = 0;
+  // Producer local, every reader is known to be at or after it.
+  uint64_t minimum_read_sequence = 0;
+
+  alignas(64) std::atomic<uint32_t> wakeup_signal = 0;
+  std::atomic<uint64_t> amount_of_sleeping_readers = 0;
+  std::atomic<uint64_t> amount_of_consumption_waiters = 0;
+
+ public:
+  explicit BroadcastRing(size_t capacity = BROADCAST_RING_DEFAULT_CAPACITY,
+                         size_t maximum_readers = BROADCAST_RING_DEFAULT_MAXIMUM_READERS)
+      : slots(std::make_unique<T[]>(capacity)),
+        mask(capacity - 1),
+        readers(std::make_unique<Reader[]>(maximum_readers)),
+        maximum_readers(maximum_readers) {
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0
+           && "The capacity of a BroadcastRing must be a power of 2");
+  }
+
+  /**
+   * Registers a new reader that will see every value pushed from now on.
+   * Can be called while the producer pushes, but not concurrently with
+   * another subscribe.
+   */
+  ReaderId subscribe() {
+    size_t reader_id = amount_of_readers.load();
+    if (reader_id >= maximum_readers) {
+      throw std::runtime_error("Maximum amount of BroadcastRing readers reached.");
+    }
+    Reader& reader = readers[reader_id];
+    // A producer that has not seen the reader yet can overwrite the slots
+    // before the sequences it pushes, so the reader is published holding the
+    // producer back and only then starts after the values already pushed.
+    reader.read_sequence.store(write_sequence.load());
+    amount_of_readers.store(reader_id + 1);
+    uint64_t sequence = write_sequence.load();
+    reader.available_sequence = sequence;
+    reader.read_sequence.store(sequence);
+    return reader_id;
+  }
+
+  /**
+   * Wakes up the reader and makes its next call to next return nothing,
+   * from then on the reader stops holding back the producer.
+   */
+  void unsubscribe(ReaderId reader_id) {
+    assert(reader_id < amount_of_readers.load());
+    readers[reader_id].is_stopped.store(true);
+    wake_up_readers();
+  }
+
+  void push(T value) { push(std::span<const T>(&value, 1)); }
+
+  /**
+   * Publishes the values at once, readers see them as a single batch unless
+   * they do not fit in the ring.
+   */
+  void push(std::span<const T> values) {
+    while (!values.empty()) {
+      uint64_t sequence = write_sequence.load(std::memory_order_relaxed);
+      size_t amount = std::min(values.size(), capacity());
+      if (sequence + amount - minimum_read_sequence > capacity()) [[unlikely]] {
+        wait_for_free_slots(sequence, amount);
+      }
+      for (size_t i = 0; i < amount; i++) {
+        slots[(sequence + i) & mask] = values[i];
+      }
+      write_sequence.store(sequence + amount, std::memory_order_seq_cst);
+      if (amount_of_sleeping_readers.load(std::memory_order_seq_cst) != 0) [[unlikely]] {
+        wake_up_readers();
+      }
+      values = values.subspan(amount);
+    }
+  }
+
+  /**
+   * Blocks until there is a new value for the reader.
+   * @return The value, or nothing if the reader was unsubscribed.
+   */
+  std::optional<T> next(ReaderId reader_id) {
+    Reader& reader = readers[reader_id];
+    uint64_t sequence = reader.read_sequence.load(std::memory_order_relaxed);
+    if (sequence == reader.available_sequence
+        || reader.is_stopped.load(std::memory_order_relaxed)) {
+      if (!wait_for_values(reader, sequence)) {
+        reader.read_sequence.store(INACTIVE_READER);
+        reader.read_sequence.notify_all();
+        return {};
+      }
+    }
+    T value = slots[sequence & mask];
+    reader.read_sequence.store(sequence + 1, std::memory_order_release);
+    if (sequence + 1 == reader.available_sequence) {
+      // End of the batch, somebody might be waiting for the reader to catch up.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (amount_of_consumption_waiters.load(std::memory_order_relaxed) != 0) {
+        reader.read_sequence.notify_all();
+      }
+    }
+    return value;
+  }
+
+  /**
+   * Blocks until every active reader has read every value pushed so far.
+   */
+  void wait_until_consumed() {
+    uint64_t sequence = write_sequence.load();
+    size_t readers_size = amount_of_readers.load();
+    for (size_t i = 0; i < readers_size; i++) {
+      std::atomic<uint64_t>& read_sequence = readers[i].read_sequence;
+      amount_of_consumption_waiters.fetch_add(1);
+      for (uint64_t current = read_sequence.load(); current < sequence;
+           current = read_sequence.load()) {
+        read_sequence.wait(current);
+      }
+      amount_of_consumption_waiters.fetch_sub(1);
+    }
+  }
+
+  uint64_t amount_of_values_pushed() const { return write_sequence.load(); }
+
+  // Sequence of the next value the reader will read.
+  uint64_t read_sequence_of(ReaderId reader_id) const {
+    assert(reader_id < amount_of_readers.load());
+    return readers[reader_id].read_sequence.load();
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+ private:
+  /**
+   * Polls, and eventually sleeps, until a value after sequence is published.
+   * @return false if the reader was unsubscribed meanwhile.
+   */
+  bool wait_for_values(Reader& reader, uint64_t sequence) {
+    for (size_t spins = 0;; spins++) {
+      if (reader.is_stopped.load(std::memory_order_acquire)) {
+        return false;
+      }
+      reader.available_sequence = write_sequence.load(std::memory_order_acquire);
+      if (reader.available_sequence != sequence) {
+        return true;
+      }
+      if (spins < BROADCAST_RING_SPINS_BEFORE_SLEEP) {
+        std::this_thread::yield();
+        continue;
+      }
+      amount_of_sleeping_readers.fetch_add(1, std::memory_order_seq_cst);
+      uint32_t signal = wakeup_signal.load(std::memory_order_seq_cst);
+      if (write_sequence.load(std::memory_order_seq_cst) == sequence
+          && !reader.is_stopped.load(std::memory_order_seq_cst)) {
+        wakeup_signal.wait(signal);
+      }
+      amount_of_sleeping_readers.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void wake_up_readers() {
+    wakeup_signal.fetch_add(1, std::memory_order_seq_cst);
+    wakeup_signal.notify_all();
+  }
+
+  void wait_for_free_slots(uint64_t sequence, size_t amount) {
+    while (true) {
+      minimum_read_sequence = sequence;
+      size_t readers_size = amount_of_readers.load(std::memory_order_acquire);
+      for (size_t i = 0; i < readers_size; i++) {
+        minimum_read_sequence = std::min(minimum_read_sequence,
+                                         readers[i].read_sequence.load(
+                                           std::memory_order_acquire));
+      }
+      if (sequence + amount - minimum_read_sequence <= capacity()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+};
+}  // namespace CORE::Internal::Stream
@@ -0,0 +1,107 @@
+#ifndef BUFFER_STORAGE_HPP
+#define BUFFER_STORAGE_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RingTupleQueue {
+
+// Alignment of the reserved range, so that it can be backed by huge pages.
+const uint64_t BUFFER_STORAGE_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+struct StorageSettings {
+  // Places every buffer in a single range of virtual memory reserved up
+  // front. Its pages are only backed by memory once they are written, so a
+  // new buffer is neither allocated nor zeroed by the ingest thread. When
+  // false, or if the range cannot be reserved, the buffers go to the heap.
+  bool reserve_address_range = false;
+  // Size of the reserved range, once it is full the buffers go to the heap.
+  uint64_t reserved_bytes = uint64_t(64) * 1024 * 1024 * 1024;
+  // Asks the kernel to back the reserved range with transparent huge pages.
+  bool huge_pages = false;
+};
+
+/**
+ * Owns the buffers of a Queue. A buffer never moves once it is allocated,
+ * the tuples point into it, and it lives as long as the storage.
+ */
+class BufferStorage {
+  uint64_t buffer_size;
+  char* reserved_range = nullptr;
+  uint64_t reserved_range_size = 0;
+  uint64_t reserved_range_used = 0;
+  std::vector<std::unique_ptr<uint64_t[]>> heap_buffers = {};
+
+ public:
+  BufferStorage(uint64_t buffer_size, StorageSettings settings)
+      : buffer_size(buffer_size) {
+    if (settings.reserve_address_range) {
+      reserve_address_range(settings);
+    }
+  }
+
+  BufferStorage(const BufferStorage&) = delete;
+  BufferStorage& operator=(const BufferStorage&) = delete;
+
+  ~BufferStorage() {
+    if (reserved_range != nullptr) {
+      munmap(reserved_range, reserved_range_size);
+    }
+  }
+
+  // The contents of the buffer are not initialized.
+  uint64_t* allocate_buffer() {
+    uint64_t buffer_bytes = buffer_size * sizeof(uint64_t);
+    if (reserved_range != nullptr
+        && reserved_range_size - reserved_range_used >= buffer_bytes) {
+      auto buffer = reinterpret_cast<uint64_t*>(reserved_range + reserved_range_used);
+      reserved_range_used += buffer_bytes;
+      return buffer;
+    }
+    heap_buffers.push_back(std::make_unique_for_overwrite<uint64_t[]>(buffer_size));
+    return heap_buffers.back().get();
+  }
+
+ private:
+  void reserve_address_range(const StorageSettings& settings) {
+    uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t size = (settings.reserved_bytes + page_size - 1) / page_size * page_size;
+    // One huge page more so that the start can be aligned.
+    uint64_t mapped_size = size + BUFFER_STORAGE_HUGE_PAGE_SIZE;
+    void* mapped = mmap(nullptr,
+                        mapped_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                        -1,
+                        0);
+    if (mapped == MAP_FAILED) {
+      return;
+    }
+    char* start = static_cast<char*>(mapped);
+    uint64_t misalignment = reinterpret_cast<uintptr_t>(start)
+                            % BUFFER_STORAGE_HUGE_PAGE_SIZE;
+    uint64_t offset = misalignment == 0 ? 0
+                                        : BUFFER_STORAGE_HUGE_PAGE_SIZE - misalignment;
+    if (offset != 0) {
+      munmap(start, offset);
+    }
+    munmap(start + offset + size, BUFFER_STORAGE_HUGE_PAGE_SIZE - offset);
+    reserved_range = start + offset;
+    reserved_range_size = size;
+#ifdef MADV_HUGEPAGE
+    if (settings.huge_pages) {
+      // Only a hint, the range works the same without huge pages.
+      madvise(reserved_range, reserved_range_size, MADV_HUGEPAGE);
+    }
+#endif
+  }
+};
+
+}  // namespace RingTupleQueue
+
+#endif  // BUFFER_STORAGE_HPP
@@ -0,0 +1,82 @@
+#ifndef INGEST_CLOCK_HPP
+#define INGEST_CLOCK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define INGEST_CLOCK_USES_TSC
+#endif
+
+namespace RingTupleQueue {
+
+// Ticks of the time stamp counter between two reads of system_clock.
+const uint64_t INGEST_CLOCK_TICKS_BETWEEN_CALIBRATIONS = uint64_t(1) << 24;
+
+/**
+ * Clock of the ingest timestamps of the tuples. Reading system_clock for
+ * every tuple costs a clock_gettime call, so where there is a time stamp
+ * counter it is read instead. The ticks are converted with the rate measured
+ * since the last calibration, and every calibration reads system_clock again,
+ * so the clock follows it closely. The times returned never decrease.
+ */
+class IngestClock {
+  using Clock = std::chrono::system_clock;
+
+  Clock::time_point anchor_time = Clock::now();
+  Clock::time_point last_time = anchor_time;
+#ifdef INGEST_CLOCK_USES_TSC
+  uint64_t anchor_ticks = __rdtsc();
+  uint64_t next_calibration_ticks = anchor_ticks
+                                    + INGEST_CLOCK_TICKS_BETWEEN_CALIBRATIONS;
+  // Zero until the first calibration, system_clock is read until then.
+  double nanoseconds_per_tick = 0;
+#endif
+
+ public:
+  Clock::time_point now() {
+#ifdef INGEST_CLOCK_USES_TSC
+    uint64_t ticks = __rdtsc();
+    if (ticks >= next_calibration_ticks) [[unlikely]] {
+      calibrate(ticks);
+    }
+    Clock::time_point time;
+    if (nanoseconds_per_tick == 0) [[unlikely]] {
+      time = Clock::now();
+    } else {
+      // The counter of another core can be slightly behind.
+      uint64_t elapsed_ticks = ticks > anchor_ticks ? ticks - anchor_ticks : 0;
+      time = anchor_time
+             + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(
+               static_cast<int64_t>(elapsed_ticks * nanoseconds_per_tick)));
+    }
+    last_time = std::max(last_time, time);
+    return last_time;
+#else
+    last_time = std::max(last_time, Clock::now());
+    return last_time;
+#endif
+  }
+
+ private:
+#ifdef INGEST_CLOCK_USES_TSC
+  void calibrate(uint64_t ticks) {
+    Clock::time_point time = Clock::now();
+    if (time > anchor_time && ticks > anchor_ticks) {
+      nanoseconds_per_tick = std::chrono::duration<double, std::nano>(time - anchor_time)
+                               .count()
+                             / static_cast<double>(ticks - anchor_ticks);
+    }
+    // If the counter was ahead, it goes on from the last time returned.
+    anchor_time = std::max(time, last_time);
+    anchor_ticks = ticks;
+    next_calibration_ticks = ticks + INGEST_CLOCK_TICKS_BETWEEN_CALIBRATIONS;
+  }
+#endif
+};
+
+}  // namespace RingTupleQueue
+
+#endif  // INGEST_CLOCK_HPP
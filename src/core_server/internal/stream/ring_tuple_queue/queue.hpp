@@ -1,6 +1,7 @@
 #ifndef RINGTUPLEQUEUE_HPP
 #define RINGTUPLEQUEUE_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
@@ -11,14 +12,27 @@
 #include <type_traits>
 #include <vector>
 
+#include "buffer_storage.hpp"
+#include "ingest_clock.hpp"
 #include "tuple.hpp"
 
 namespace RingTupleQueue {
 
+/**
+ * Memory of the buffers of a Queue. The buffers in use hold tuples that were
+ * not recycled yet, the rest are free to be written.
+ */
+struct MemoryUsage {
+  uint64_t bytes_allocated = 0;
+  uint64_t bytes_in_use = 0;
+};
+
 class Queue {
   // TODO: Check if memory is being overwriten with start index.
  private:
-  std::vector<std::vector<uint64_t>> buffers;
+  BufferStorage storage;
+  // In the order of the ring, every buffer has buffer_size elements.
+  std::vector<uint64_t*> buffers;
   std::vector<std::chrono::system_clock::time_point> last_updated;
 
   // Oldest buffer that has not yet been overwritten.
@@ -35,19 +49,31 @@ class Queue {
   TupleSchemas* schemas;
   std::chrono::system_clock::time_point overwrite_timepoint;
   std::chrono::system_clock::time_point start_timepoint;
+  // Time of the tuple being written, its variable section may be in another buffer.
+  std::chrono::system_clock::time_point current_tuple_timepoint;
+  IngestClock clock;
+
+  // Read by get_memory_usage from any thread.
+  std::atomic<uint64_t> amount_of_buffers = 1;
+  std::atomic<uint64_t> amount_of_buffers_in_use = 1;
 
  public:
   Tuple get_tuple(uint64_t* data) { return Tuple(data, schemas); }
 
-  explicit Queue(uint64_t buffer_size, TupleSchemas* schemas)
-      : buffer_size(buffer_size),
-        buffers({std::vector<uint64_t>(buffer_size)}),
+  uint64_t amount_of_tuple_types() const { return schemas->size(); }
+
+  explicit Queue(uint64_t buffer_size,
+                 TupleSchemas* schemas,
+                 StorageSettings storage_settings = {})
+      : storage(buffer_size, storage_settings),
+        buffers({storage.allocate_buffer()}),
         last_updated(1),
         start_buffer_index(0),
         constant_section_buffer_index(0),
         constant_section_index(0),
         current_buffer_index(0),
         current_index(0),
+        buffer_size(buffer_size),
         schemas(schemas),
         overwrite_timepoint(std::chrono::system_clock::now()),
         start_timepoint(std::chrono::system_clock::now()) {}
@@ -56,31 +82,31 @@ class Queue {
     uint64_t minimum_size = schemas->get_constant_section_size(tuple_type_id);
     assert(minimum_size < buffer_size);
 
-    if (current_index < buffers[current_buffer_index].size() - minimum_size) {
+    if (current_index < buffer_size - minimum_size) {
       // Current buffer does have enough size.
       constant_section_buffer_index = current_buffer_index;
       constant_section_index = current_index;
       current_index += minimum_size;
     } else {
       // Current buffer does not have enough size.
-      increase_size_if_necessary();
-      current_buffer_index = (current_buffer_index + 1) % buffers.size();
+      move_to_next_buffer();
       constant_section_buffer_index = current_buffer_index;
       constant_section_index = 0;
       current_index = minimum_size;
     }
 
     // Add tuple_type_id and date
-    auto& current_buffer = buffers[constant_section_buffer_index];
+    uint64_t* current_buffer = buffers[constant_section_buffer_index];
     current_buffer[constant_section_index++] = tuple_type_id;
     // get current time_point and cast it to uint64_t
-    auto now = std::chrono::system_clock::now();
+    auto now = clock.now();
     // use memcpy to place it inside the buffer:
     memcpy(&current_buffer[constant_section_index++],
            &now,
            sizeof(std::chrono::system_clock::time_point));
     static_assert(sizeof(std::chrono::system_clock::time_point) <= sizeof(uint64_t));
     last_updated[constant_section_buffer_index] = now;
+    current_tuple_timepoint = now;
 
     return &current_buffer[constant_section_index - 2];
   }
@@ -92,7 +118,7 @@ class Queue {
   template <typename T>
   auto writer() ->
     typename std::enable_if<std::is_trivially_copyable<T>::value, T*>::type {
-    auto& current_buffer = buffers[constant_section_buffer_index];
+    uint64_t* current_buffer = buffers[constant_section_buffer_index];
     auto ptr = &current_buffer[constant_section_index];
     // Advance, ceiling so that we can actually fit if not multiple of sizeof(uin64_t)
     constant_section_index += (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
@@ -105,23 +131,25 @@ class Queue {
                               && std::is_convertible<T, std::string>::value,
                             char*>::type {
     // Update the pointer positions fo the constant sized section
-    auto* current_buffer = &(buffers[current_buffer_index]);
+    uint64_t* current_buffer = buffers[current_buffer_index];
     uint64_t size = (size_in_bytes + 7) / 8;  // Ceiling
     uint64_t index_to_write_in;
-    if (current_index < current_buffer->size() - size) {
+    if (current_index < buffer_size - size) {
       index_to_write_in = current_index;
       current_index += size;
     } else {
-      increase_size_if_necessary();
-      current_buffer_index = (current_buffer_index + 1) % buffers.size();
-      current_buffer = &(buffers[current_buffer_index]);
+      move_to_next_buffer();
+      current_buffer = buffers[current_buffer_index];
       current_index = size;
       index_to_write_in = 0;
     }
-    auto start_ptr = reinterpret_cast<char*>(&((*current_buffer)[index_to_write_in]));
+    // The buffer cannot be recycled while the tuple that points into it is needed.
+    last_updated[current_buffer_index] = std::max(last_updated[current_buffer_index],
+                                                  current_tuple_timepoint);
+    auto start_ptr = reinterpret_cast<char*>(&current_buffer[index_to_write_in]);
     auto end_ptr = &(start_ptr[size_in_bytes]);
 
-    auto& constant_section_buffer = buffers[constant_section_buffer_index];
+    uint64_t* constant_section_buffer = buffers[constant_section_buffer_index];
     char** start_ptr_storage = reinterpret_cast<char**>(
       &constant_section_buffer[constant_section_index++]);
     *start_ptr_storage = start_ptr;
@@ -156,14 +184,30 @@ class Queue {
     overwrite_timepoint = timepoint;
   }
 
+  MemoryUsage get_memory_usage() const {
+    uint64_t buffer_bytes = buffer_size * sizeof(uint64_t);
+    return {.bytes_allocated = amount_of_buffers.load(std::memory_order_relaxed)
+                               * buffer_bytes,
+            .bytes_in_use = amount_of_buffers_in_use.load(std::memory_order_relaxed)
+                            * buffer_bytes};
+  }
+
  private:
+  void move_to_next_buffer() {
+    increase_size_if_necessary();
+    current_buffer_index = (current_buffer_index + 1) % buffers.size();
+    uint64_t in_use = (current_buffer_index + buffers.size() - start_buffer_index)
+                        % buffers.size()
+                      + 1;
+    amount_of_buffers.store(buffers.size(), std::memory_order_relaxed);
+    amount_of_buffers_in_use.store(in_use, std::memory_order_relaxed);
+  }
+
   void increase_size_if_necessary() {
+    update_indices();
     uint64_t next_buffer_index = (current_buffer_index + 1) % buffers.size();
     if (next_buffer_index == start_buffer_index) {
-      update_indices();
-      if (next_buffer_index == start_buffer_index) {
-        insert_a_buffer_after(current_buffer_index);
-      }
+      insert_a_buffer_after(current_buffer_index);
     }
   }
 
@@ -175,7 +219,7 @@ class Queue {
       std::ptrdiff_t buffer_index_ptrdiff = static_cast<std::ptrdiff_t>(buffer_index);
 
       buffers.insert(buffers.begin() + buffer_index_ptrdiff + 1,
-                     std::vector<uint64_t>(buffer_size));
+                     storage.allocate_buffer());
 
       last_updated.insert(last_updated.begin() + buffer_index_ptrdiff + 1,
                           overwrite_timepoint);
@@ -196,10 +240,12 @@ class Queue {
    * If any tuple was added in a time lower than the overwrite_timepoint,
    * it is fair play to remove it. The last_updated shows the last time a
    * new tuple was added to it, therefore, it shows when it is fair play
-   * to recycle all the memory in that buffer.
+   * to recycle all the memory in that buffer. Every buffer up to the
+   * current one that can be recycled is, so the buffers in use are counted.
    */
   void update_indices() {
-    if (last_updated[start_buffer_index] <= overwrite_timepoint) {
+    while (start_buffer_index != current_buffer_index
+           && last_updated[start_buffer_index] <= overwrite_timepoint) {
       start_buffer_index = (start_buffer_index + 1) % buffers.size();
     }
   }
@@ -104,17 +104,14 @@ class TupleSchemas {
     return last_position + size_of_last_element;
   }
 
- private:
-  std::vector<uint64_t> get_positions(uint64_t id) const {
-    if (id >= schemas.size()) {
-      throw std::out_of_range("TupleSchemas::get_positions: id out of range");
-    }
-
+  // Word offsets of the attributes of a tuple of the schema, which is not
+  // required to be added.
+  static std::vector<uint64_t> positions_of(const std::vector<SupportedTypes>& schema) {
     // First transform the types to their respective sizes
     std::vector<uint64_t> sizes;
-    sizes.reserve(schemas[id].size());
-    for (size_t i = 0; i < schemas[id].size(); i++) {
-      sizes.push_back(Type::type_size(schemas[id][i]));
+    sizes.reserve(schema.size());
+    for (size_t i = 0; i < schema.size(); i++) {
+      sizes.push_back(Type::type_size(schema[i]));
     }
     // Then calculate the cumulative sizes in place
     for (int i = 1; i < sizes.size(); i++) {
@@ -129,6 +126,14 @@ class TupleSchemas {
     }
     return positions;
   }
+
+ private:
+  std::vector<uint64_t> get_positions(uint64_t id) const {
+    if (id >= schemas.size()) {
+      throw std::out_of_range("TupleSchemas::get_positions: id out of range");
+    }
+    return positions_of(schemas[id]);
+  }
 };
 
 #endif  // TUPLE_SCHEMA_HPP
@@ -143,6 +148,8 @@ class Tuple {
 
   uint64_t* get_data() const { return data; }
 
+  TupleSchemas* get_schemas() const { return schemas; }
+
   uint64_t id() const { return data[0]; }
 
   const std::vector<SupportedTypes>& get_schema() const {
@@ -182,9 +189,18 @@ class Tuple {
   bool operator==(const RingTupleQueue::Tuple& other) const { return data == other.data; }
 
   uint64_t* operator[](uint64_t index) const {
-    return &data[schemas->get_relative_positions(id())[index]];
+    return at_offset(schemas->get_relative_positions(id())[index]);
+  }
+
+  // Word offsets of the attributes of the tuple, resolved once by readers
+  // that read the attributes of many tuples of the same schema.
+  const std::vector<uint64_t>& get_relative_positions() const {
+    return schemas->get_relative_positions(id());
   }
 
+  // The attribute at a word offset of get_relative_positions.
+  uint64_t* at_offset(uint64_t word_offset) const { return &data[word_offset]; }
+
   uint64_t size() const { return schemas->get_relative_positions(id()).size(); }
 
  private:
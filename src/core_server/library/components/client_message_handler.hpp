@@ -8,10 +8,8 @@
 #include <utility>
 #include <vector>
 
-#include "core_server/internal/ceql/query/query.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/interface/backend.hpp"
-#include "core_server/internal/parsing/ceql_query/parser.hpp"
 #include "core_server/internal/parsing/stream_declaration/parser.hpp"
 #include "shared/datatypes/aliases/event_type_id.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
@@ -21,6 +19,7 @@
 #include "shared/datatypes/client_request.hpp"
 #include "shared/datatypes/client_request_type.hpp"
 #include "shared/datatypes/parsing/stream_info_parsed.hpp"
+#include "shared/datatypes/query_stats.hpp"
 #include "shared/datatypes/server_response.hpp"
 #include "shared/datatypes/server_response_type.hpp"
 #include "shared/serializer/cereal_serializer.hpp"
@@ -86,6 +85,8 @@ class ClientMessageHandler {
         return list_all_streams();
       case Types::ClientRequestType::AddQuery:
         return add_query(request.serialized_request_data);
+      case Types::ClientRequestType::QueryStats:
+        return query_stats();
       default:
         throw std::runtime_error("Not Implemented!");
     }
@@ -158,21 +159,26 @@ class ClientMessageHandler {
   }
 
   Types::ServerResponse add_query(std::string s_query_info) {
-    // TODO: Change this to a CEA. Right now it's a query string that might
-    // Not be correct.
     // TODO: Check if it is possible to parse it.
-    Internal::CEQL::Query parsed_query = Parsing::QueryParser::parse_query(s_query_info);
+    // Parsed only if the same query text was not compiled already.
+    auto compiled_query = backend.compile_query(s_query_info);
 
     std::unique_ptr<HandlerType> result_handler = result_handler_factory.create_handler(
       backend.get_catalog_reference());
     std::optional<Types::PortNumber> possible_port = result_handler->get_port();
-    backend.declare_query(std::move(parsed_query), std::move(result_handler));
+    backend.declare_query(std::move(compiled_query), std::move(result_handler));
 
     return Types::ServerResponse(CerealSerializer<Types::PortNumber>::serialize(
                                    possible_port.value_or(0)),
                                  Types::ServerResponseType::PortNumber);
   }
 
+  Types::ServerResponse query_stats() {
+    Types::ServerStats stats = backend.get_query_stats();
+    return Types::ServerResponse(CerealSerializer<Types::ServerStats>::serialize(stats),
+                                 Types::ServerResponseType::QueryStats);
+  }
+
   // TODO: all queries and port numbers
 };
 
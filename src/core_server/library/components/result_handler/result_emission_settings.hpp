@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace CORE::Library::Components {
+
+const size_t DEFAULT_MAXIMUM_RESULT_BATCH_SIZE = 1024;
+
+/**
+ * How the OnlineResultHandler groups the results published for the
+ * subscriptions in ResultEmissionMode::MatchesOnly. The subscriptions in
+ * ResultEmissionMode::EveryEvent still get one frame per event.
+ */
+struct ResultEmissionSettings {
+  // Maximum amount of enumerators published in a single frame.
+  size_t maximum_batch_size = DEFAULT_MAXIMUM_RESULT_BATCH_SIZE;
+  // How long a result may wait for more results to fill a frame. 0 only
+  // groups the results that are already waiting to be published.
+  std::chrono::milliseconds maximum_batch_latency{0};
+  // Time without frames after which an empty frame is published with the
+  // progress of the query. 0 disables the heartbeats.
+  std::chrono::milliseconds heartbeat_interval{1000};
+};
+}  // namespace CORE::Library::Components
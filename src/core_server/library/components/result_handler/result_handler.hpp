@@ -1,17 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tracy/Tracy.hpp>
 #include <utility>
+#include <vector>
 
+#include "core_server/internal/ceql/query/select.hpp"
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/library/components/result_handler/result_emission_settings.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
 #include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/result_batch.hpp"
+#include "shared/datatypes/result_emission_mode.hpp"
 #include "shared/networking/message_broadcaster/zmq_message_broadcaster.hpp"
 #include "shared/serializer/cereal_serializer.hpp"
 
@@ -22,11 +35,20 @@ class ResultHandler {
  protected:
   std::optional<Types::PortNumber> port{};
   const Internal::QueryCatalog query_catalog;
+  Internal::CEQL::Select::Output output = Internal::CEQL::Select::Output::COMPLEX_EVENTS;
 
  public:
   ResultHandler(const Internal::QueryCatalog query_catalog)
       : query_catalog(query_catalog) {}
 
+  // Set by the backend when the query is declared.
+  void set_output(Internal::CEQL::Select::Output output) { this->output = output; }
+
+  /**
+   * Called for every event relevant to the query, in order. The enumerator
+   * has to be consumed without moving it out, the query destroys it in the
+   * thread that evaluates, see Interface::ResultStage.
+   */
   void operator()(std::optional<Internal::tECS::Enumerator>&& enumerator) {
     static_cast<Derived*>(this)->handle_complex_event(std::move(enumerator));
   }
@@ -36,6 +58,18 @@ class ResultHandler {
   std::optional<Types::PortNumber> get_port() const { return port; }
 
   virtual ~ResultHandler() = default;
+
+ protected:
+  /**
+   * The complex events of the enumerator, or only their amount if the query
+   * selects COUNT(*), which is computed without enumerating them.
+   */
+  Types::Enumerator convert_enumerator(Internal::tECS::Enumerator&& enumerator) const {
+    if (output == Internal::CEQL::Select::Output::COUNT) {
+      return Types::Enumerator(enumerator.count());
+    }
+    return query_catalog.convert_enumerator(std::move(enumerator));
+  }
 };
 
 class OfflineResultHandler : public ResultHandler<OfflineResultHandler> {
@@ -49,6 +83,10 @@ class OfflineResultHandler : public ResultHandler<OfflineResultHandler> {
     if (!internal_enumerator.has_value()) {
       return;
     }
+    if (output == Internal::CEQL::Select::Output::COUNT) {
+      std::cout << "COUNT(*) = " << internal_enumerator->count() << "\n";
+      return;
+    }
     for (const auto& complex_event : internal_enumerator.value()) {
       std::cout << complex_event.to_string<true>() << "\n";
     }
@@ -57,35 +95,204 @@ class OfflineResultHandler : public ResultHandler<OfflineResultHandler> {
   void start_impl() {}
 };
 
+// Longest time the publisher of an OnlineResultHandler goes without reading
+// the subscriptions.
+const std::chrono::milliseconds RESULT_PUBLISHER_POLL_INTERVAL{100};
+
+/**
+ * Publishes the results of a query, see Types::ResultEmissionMode. The query
+ * thread only converts the enumerators that a subscription asked for, and a
+ * publisher thread owns the socket: it serializes, batches and sends them,
+ * and sends the heartbeats even if the query receives no events.
+ */
 class OnlineResultHandler : public ResultHandler<OnlineResultHandler> {
- public:
+  using EnumeratorSerializer = Internal::CerealSerializer<Types::Enumerator>;
+  using CountSerializer = Internal::CerealSerializer<uint64_t>;
+  using ResultBatchSerializer = Internal::CerealSerializer<Types::ResultBatch>;
+
+  struct PendingResult {
+    // Position of the event in the events processed by the query, from 1.
+    uint64_t event_number;
+    Types::Enumerator enumerator;
+    bool is_match;
+  };
+
+  ResultEmissionSettings settings;
   std::unique_ptr<Internal::ZMQMessageBroadcaster> broadcaster;
+  std::thread publisher_thread;
 
+  std::mutex pending_results_mutex;
+  std::condition_variable pending_results_condition;
+  std::vector<PendingResult> pending_results = {};
+  bool stop_publisher = false;
+
+  // Written by the publisher so that the query thread skips unneeded work.
+  // Until the first poll of the subscriptions every result is queued, so
+  // the ones of the first events are not lost.
+  std::atomic<bool> has_every_event_subscribers = true;
+  std::atomic<bool> has_matches_only_subscribers = true;
+  // Incremented by the query thread after queueing the results of each event.
+  std::atomic<uint64_t> amount_of_events_processed = 0;
+
+ public:
   OnlineResultHandler(const Internal::QueryCatalog& query_catalog,
-                      Types::PortNumber assigned_port)
-      : ResultHandler(query_catalog), broadcaster{nullptr} {
+                      Types::PortNumber assigned_port,
+                      ResultEmissionSettings settings = {})
+      : ResultHandler(query_catalog), settings(settings) {
+    assert(settings.maximum_batch_size > 0);
     port = assigned_port;
   }
 
+  ~OnlineResultHandler() {
+    if (publisher_thread.joinable()) {
+      {
+        std::lock_guard lock(pending_results_mutex);
+        stop_publisher = true;
+      }
+      pending_results_condition.notify_one();
+      publisher_thread.join();
+    }
+  }
+
   void start_impl() {
     if (!port.has_value()) {
       throw std::runtime_error("port not defined on OnlineResultHandler when starting");
     }
     broadcaster = std::make_unique<Internal::ZMQMessageBroadcaster>(
       "tcp://*:" + std::to_string(port.value()));
+    publisher_thread = std::thread([this]() { publish_results(); });
   }
 
   void
   handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
-    Types::Enumerator enumerator;
-    if (internal_enumerator.has_value()) {
-      enumerator = query_catalog.convert_enumerator(
-        std::move(internal_enumerator.value()));
+    ZoneScopedN("OnlineResultHandler::handle_complex_event");
+    uint64_t event_number = amount_of_events_processed.load(std::memory_order_relaxed)
+                            + 1;
+    bool every_event = has_every_event_subscribers.load(std::memory_order_relaxed);
+    bool matches_only = has_matches_only_subscribers.load(std::memory_order_relaxed);
+    if (every_event || (matches_only && internal_enumerator.has_value())) {
+      Types::Enumerator enumerator;
+      if (internal_enumerator.has_value()) {
+        enumerator = convert_enumerator(std::move(internal_enumerator.value()));
+      }
+      bool is_match = !enumerator.complex_events.empty()
+                      || enumerator.count.value_or(0) > 0;
+      if (every_event || is_match) {
+        {
+          std::lock_guard lock(pending_results_mutex);
+          pending_results.push_back({event_number, std::move(enumerator), is_match});
+        }
+        pending_results_condition.notify_one();
+      }
     }
-    std::string serialized_enumerator{
-      Internal::CerealSerializer<Types::Enumerator>::serialize(enumerator)};
+    amount_of_events_processed.store(event_number, std::memory_order_release);
+  }
+
+ private:
+  void publish_results() {
+    ZoneScopedN("OnlineResultHandler::publish_results");
+    const std::string every_event_topic = Types::result_emission_topic(
+      Types::ResultEmissionMode::EveryEvent);
+    const std::string matches_only_topic = Types::result_emission_topic(
+      Types::ResultEmissionMode::MatchesOnly);
+    std::vector<PendingResult> results;
+    std::vector<Types::Enumerator> batch;
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point batch_deadline = Clock::time_point::max();
+    Clock::time_point last_batch_time = Clock::now();
+    bool is_stopping = false;
+    while (!is_stopping) {
+      Clock::time_point wakeup_time = Clock::now() + RESULT_PUBLISHER_POLL_INTERVAL;
+      if (!batch.empty()) {
+        wakeup_time = std::min(wakeup_time, batch_deadline);
+      } else if (settings.heartbeat_interval.count() != 0) {
+        wakeup_time = std::min(wakeup_time,
+                               last_batch_time + settings.heartbeat_interval);
+      }
+      {
+        std::unique_lock lock(pending_results_mutex);
+        pending_results_condition.wait_until(lock, wakeup_time, [&]() {
+          return stop_publisher || !pending_results.empty();
+        });
+        is_stopping = stop_publisher;
+      }
+      // Read before taking the results, so every event counted has its results
+      // in the ones taken.
+      uint64_t events_processed = amount_of_events_processed.load(
+        std::memory_order_acquire);
+      {
+        std::lock_guard lock(pending_results_mutex);
+        results.swap(pending_results);
+      }
+
+      broadcaster->update_subscriptions();
+      bool every_event = broadcaster->has_subscribers(every_event_topic);
+      // The clients of EveryEvent subscribe to every frame, they do not ask
+      // for the MatchesOnly ones.
+      bool matches_only = broadcaster->has_topic_subscribers(matches_only_topic);
+      has_every_event_subscribers.store(every_event, std::memory_order_relaxed);
+      has_matches_only_subscribers.store(matches_only, std::memory_order_relaxed);
+
+      for (PendingResult& result : results) {
+        if (every_event) {
+          broadcaster->broadcast(every_event_frame(result.enumerator));
+        }
+        if (matches_only && result.is_match) {
+          if (batch.empty()) {
+            batch_deadline = Clock::now() + settings.maximum_batch_latency;
+          }
+          batch.push_back(std::move(result.enumerator));
+          if (batch.size() == settings.maximum_batch_size) {
+            publish_batch(matches_only_topic, batch, result.event_number);
+            last_batch_time = Clock::now();
+          }
+        }
+      }
+      results.clear();
 
-    broadcaster->broadcast(serialized_enumerator);
+      Clock::time_point now = Clock::now();
+      if (!batch.empty()) {
+        if (now >= batch_deadline || is_stopping) {
+          publish_batch(matches_only_topic, batch, events_processed);
+          last_batch_time = now;
+        }
+      } else if (settings.heartbeat_interval.count() != 0
+                 && now - last_batch_time >= settings.heartbeat_interval) {
+        if (matches_only) {
+          publish_batch(matches_only_topic, batch, events_processed);
+        }
+        last_batch_time = now;
+      }
+    }
+  }
+
+  /**
+   * Without a topic, the EveryEvent frames are the bare Enumerators. The
+   * queries that select COUNT(*) send their counts with a topic instead, so
+   * the Enumerator frames of the other queries do not change.
+   */
+  std::string every_event_frame(const Types::Enumerator& enumerator) const {
+    if (output == Internal::CEQL::Select::Output::COUNT) {
+      return Types::RESULT_COUNT_TOPIC
+             + CountSerializer::serialize(enumerator.count.value_or(0));
+    }
+    return EnumeratorSerializer::serialize(enumerator);
+  }
+
+  void publish_batch(const std::string& topic,
+                     std::vector<Types::Enumerator>& batch,
+                     uint64_t events_processed) {
+    ZoneScopedN("OnlineResultHandler::publish_batch");
+    Types::ResultBatch result_batch(events_processed, {});
+    if (output == Internal::CEQL::Select::Output::COUNT) {
+      for (const Types::Enumerator& enumerator : batch) {
+        result_batch.counts.push_back(enumerator.count.value_or(0));
+      }
+    } else {
+      result_batch.enumerators = std::move(batch);
+    }
+    broadcaster->broadcast(topic + ResultBatchSerializer::serialize(result_batch));
+    batch.clear();
   }
 };
 
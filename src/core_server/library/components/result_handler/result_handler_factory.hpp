@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/library/components/result_handler/result_emission_settings.hpp"
 #include "core_server/library/components/result_handler/result_handler.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
 
@@ -35,14 +36,20 @@ class OnlineResultHandlerFactory
     : public ResultHandlerFactory<OnlineResultHandlerFactory, OnlineResultHandler> {
  public:
   std::atomic<Types::PortNumber>& next_available_port;
+  ResultEmissionSettings result_emission_settings;
 
  public:
-  OnlineResultHandlerFactory(std::atomic<Types::PortNumber>& next_available_port)
-      : ResultHandlerFactory(), next_available_port(next_available_port) {}
+  OnlineResultHandlerFactory(std::atomic<Types::PortNumber>& next_available_port,
+                             ResultEmissionSettings result_emission_settings = {})
+      : ResultHandlerFactory(),
+        next_available_port(next_available_port),
+        result_emission_settings(result_emission_settings) {}
 
   std::unique_ptr<OnlineResultHandler>
   create_handler_impl(Internal::QueryCatalog query_catalog) {
-    return std::make_unique<OnlineResultHandler>(query_catalog, next_available_port++);
+    return std::make_unique<OnlineResultHandler>(query_catalog,
+                                                 next_available_port++,
+                                                 result_emission_settings);
   }
 };
 
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
 #include "core_server/internal/interface/backend.hpp"
+#include "core_server/library/components/stream_listeners/stream_batch_settings.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
 #include "shared/datatypes/stream.hpp"
 
@@ -12,20 +19,32 @@ class OfflineStreamsListener {
 
  private:
   Backend& backend;
+  StreamBatchSettings batch_settings;
 
  public:
-  OfflineStreamsListener(Backend& backend, Types::PortNumber port_number)
-      : backend(backend) {}
+  OfflineStreamsListener(Backend& backend,
+                         Types::PortNumber port_number,
+                         StreamBatchSettings batch_settings = {})
+      : backend(backend), batch_settings(batch_settings) {
+    assert(batch_settings.maximum_batch_size > 0);
+  }
 
   // Delete Copy constructor and assigment as that should not be done with the stream listener
   OfflineStreamsListener(const OfflineStreamsListener&) = delete;
   OfflineStreamsListener& operator=(const OfflineStreamsListener&) = delete;
 
   void receive_stream(const Types::Stream& stream) {
-    for (const auto& event : stream.events) {
-      backend.send_event_to_queries(stream.id, event);
+    std::span<const Types::Event> events(stream.events);
+    while (!events.empty()) {
+      size_t batch_size = std::min(events.size(), batch_settings.maximum_batch_size);
+      backend.send_events_to_queries(stream.id, events.first(batch_size));
+      events = events.subspan(batch_size);
     }
   }
+
+  void receive_flat_stream(std::string_view frame) {
+    backend.send_flat_stream_to_queries(frame);
+  }
 };
 
 }  // namespace CORE::Library::Components
@@ -1,18 +1,28 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <ostream>
+#include <span>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "core_server/internal/interface/backend.hpp"
+#include "core_server/library/components/stream_listeners/stream_batch_settings.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
 #include "shared/datatypes/stream.hpp"
 #include "shared/networking/message_receiver/zmq_message_receiver.hpp"
 #include "shared/networking/message_sender/zmq_message_sender.hpp"
 #include "shared/serializer/cereal_serializer.hpp"
+#include "shared/serializer/flat_stream/flat_stream_reader.hpp"
 
 namespace CORE::Library::Components {
 
@@ -26,12 +36,21 @@ class OnlineStreamsListener {
   Internal::ZMQMessageReceiver receiver;
   std::thread worker_thread;
   std::atomic<bool> stop_condition;
+  StreamBatchSettings batch_settings;
+
+  // Events received but not yet sent to the backend, all from batch_stream_id.
+  std::vector<Types::Event> batch = {};
+  Types::StreamTypeId batch_stream_id = 0;
 
  public:
-  OnlineStreamsListener(Backend& backend, Types::PortNumber port_number)
+  OnlineStreamsListener(Backend& backend,
+                        Types::PortNumber port_number,
+                        StreamBatchSettings batch_settings = {})
       : backend(backend),
         receiver_port(port_number),
-        receiver("tcp://*:" + std::to_string(port_number)) {
+        receiver("tcp://*:" + std::to_string(port_number)),
+        batch_settings(batch_settings) {
+    assert(batch_settings.maximum_batch_size > 0);
     start();
   }
 
@@ -46,16 +65,53 @@ class OnlineStreamsListener {
     stop_condition = false;
     worker_thread = std::thread([&]() {
       while (!stop_condition) {
-        std::string s_message = receiver.receive();
-        Types::Stream stream = Internal::CerealSerializer<Types::Stream>::deserialize(
-          s_message);
-        for (auto& event : stream.events) {
-          backend.send_event_to_queries(stream.id, event);
+        add_to_batch(receiver.receive());
+        // Keep filling the batch with the streams that arrive meanwhile.
+        auto deadline = std::chrono::steady_clock::now()
+                        + batch_settings.maximum_batch_latency;
+        while (batch.size() < batch_settings.maximum_batch_size && !stop_condition) {
+          auto remaining = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      deadline - std::chrono::steady_clock::now()),
+                                    std::chrono::milliseconds(0));
+          std::optional<std::string> s_message = receiver.receive(remaining);
+          if (!s_message.has_value()) {
+            break;
+          }
+          add_to_batch(std::move(s_message.value()));
         }
+        send_batch();
       }
     });
   }
 
+  void add_to_batch(std::string s_message) {
+    if (Internal::FlatStreamReader::is_flat_stream(s_message)) {
+      // Already in the layout of the ring tuple queue, sent as is to keep the order.
+      send_batch();
+      backend.send_flat_stream_to_queries(s_message);
+      return;
+    }
+    Types::Stream stream = Internal::CerealSerializer<Types::Stream>::deserialize(
+      s_message);
+    if (stream.id != batch_stream_id) {
+      send_batch();
+      batch_stream_id = stream.id;
+    }
+    for (Types::Event& event : stream.events) {
+      batch.push_back(std::move(event));
+      if (batch.size() == batch_settings.maximum_batch_size) {
+        send_batch();
+      }
+    }
+  }
+
+  void send_batch() {
+    if (!batch.empty()) {
+      backend.send_events_to_queries(batch_stream_id, batch);
+      batch.clear();
+    }
+  }
+
   void stop() {
     try {
       Internal::ZMQMessageSender sender("tcp://localhost:"
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace CORE::Library::Components {
+
+const size_t DEFAULT_MAXIMUM_STREAM_BATCH_SIZE = 1024;
+
+/**
+ * How the stream listeners group events before handing them to the backend.
+ * Larger batches amortize the work done per send, at the cost of delaying
+ * the first events of the batch.
+ */
+struct StreamBatchSettings {
+  // Maximum amount of events sent to the backend at once.
+  size_t maximum_batch_size = DEFAULT_MAXIMUM_STREAM_BATCH_SIZE;
+  // How long the online listener waits for more streams to fill a batch.
+  // 0 only batches the streams that were already received.
+  std::chrono::milliseconds maximum_batch_latency{0};
+};
+}  // namespace CORE::Library::Components
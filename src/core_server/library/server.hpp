@@ -1,15 +1,24 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include "core_server/internal/coordination/query_catalog.hpp"
 #include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/library/components/result_handler/result_emission_settings.hpp"
 #include "core_server/library/components/result_handler/result_handler_factory.hpp"
 #include "core_server/library/components/router.hpp"
 #include "core_server/library/components/stream_listeners/offline/offline_streams_listener.hpp"
 #include "core_server/library/components/stream_listeners/online/online_streams_listener.hpp"
+#include "core_server/library/components/stream_listeners/stream_batch_settings.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
+#include "shared/datatypes/query_stats.hpp"
 #include "shared/datatypes/stream.hpp"
 
 namespace CORE::Library {
@@ -19,15 +28,17 @@ namespace CORE::Library {
  * except that it can receive events directly. This means we do not need to use
  * serialization or networking to send events to and from the server.
  *
+ * The results are given to the handlers created by ResultHandlerFactoryT,
+ * OfflineServer prints them.
+ *
  * Given the starting_port:
  *
  *  Router(message_handler) = starting_port
  *
  *  Stream Listener = starting_port + 1
  **/
-class OfflineServer {
-  using ResultHandlerFactoryT = Components::OfflineResultHandlerFactory;
-
+template <typename ResultHandlerFactoryT>
+class BasicOfflineServer {
   std::atomic<Types::PortNumber> next_available_port;
 
   using HandlerType = typename std::invoke_result_t<
@@ -36,21 +47,47 @@ class OfflineServer {
     Internal::QueryCatalog>::element_type;
   Internal::Interface::Backend<HandlerType> backend;
 
-  ResultHandlerFactoryT result_handler_factory{};
+  ResultHandlerFactoryT result_handler_factory;
   Components::Router<ResultHandlerFactoryT> router;
   Components::OfflineStreamsListener<HandlerType> stream_listener;
 
  public:
-  OfflineServer(Types::PortNumber starting_port)
+  BasicOfflineServer(Types::PortNumber starting_port,
+                     Internal::Interface::PartitionBySettings partition_by_settings = {},
+                     Components::StreamBatchSettings stream_batch_settings = {},
+                     ResultHandlerFactoryT result_handler_factory = {})
       : next_available_port(starting_port),
-        router{backend, next_available_port++, result_handler_factory},
-        stream_listener{backend, next_available_port++} {}
+        backend(partition_by_settings),
+        result_handler_factory(std::move(result_handler_factory)),
+        router{backend, next_available_port++, this->result_handler_factory},
+        stream_listener{backend, next_available_port++, stream_batch_settings} {}
 
   void receive_stream(const Types::Stream& stream) {
     stream_listener.receive_stream(stream);
   }
+
+  void receive_flat_stream(std::string_view frame) {
+    stream_listener.receive_flat_stream(frame);
+  }
+
+  /**
+   * Blocks until every query has processed the events received so far.
+   */
+  void wait_until_processed() { backend.wait_until_processed(); }
+
+  Internal::Interface::QueryStatistics get_query_statistics(size_t query_idx) {
+    return backend.get_query_statistics(query_idx);
+  }
+
+  RingTupleQueue::MemoryUsage get_ring_tuple_queue_memory_usage() const {
+    return backend.get_ring_tuple_queue_memory_usage();
+  }
+
+  Types::ServerStats get_query_stats() const { return backend.get_query_stats(); }
 };
 
+using OfflineServer = BasicOfflineServer<Components::OfflineResultHandlerFactory>;
+
 /**
  * Instances an online server which means we use networking and serialization
  * to receive events and send the results back to the clients.
@@ -79,11 +116,15 @@ class OnlineServer {
   Components::OnlineStreamsListener<HandlerType> stream_listener;
 
  public:
-  OnlineServer(Types::PortNumber starting_port)
+  OnlineServer(Types::PortNumber starting_port,
+               Internal::Interface::PartitionBySettings partition_by_settings = {},
+               Components::StreamBatchSettings stream_batch_settings = {},
+               Components::ResultEmissionSettings result_emission_settings = {})
       : next_available_port(starting_port),
-        result_handler_factory{next_available_port},
+        backend(partition_by_settings),
+        result_handler_factory{next_available_port, result_emission_settings},
         router{backend, next_available_port++, result_handler_factory},
-        stream_listener{backend, next_available_port++} {}
+        stream_listener{backend, next_available_port++, stream_batch_settings} {}
 
   void receive_stream(const Types::Stream& stream) {
     static_assert("in memory receive_stream not supported on online server");
@@ -5,6 +5,7 @@
 #include "shared/datatypes/stream.hpp"
 #include "shared/networking/message_sender/zmq_message_sender.hpp"
 #include "shared/serializer/cereal_serializer.hpp"
+#include "shared/serializer/flat_stream/flat_stream_builder.hpp"
 
 namespace CORE {
 class Streamer {
@@ -23,6 +24,16 @@ class Streamer {
     send_stream({stream_id, {event}});
   }
 
+  /**
+   * Sends the events of the builder in the flat binary format, which the
+   * server copies without deserializing into Values, and clears the builder.
+   * Both ends must have the same byte order.
+   */
+  void send_stream(Internal::FlatStreamBuilder& builder) {
+    sender.send(builder.build());
+    builder.clear();
+  }
+
   // TODO: Send a stream through a CSV file and an AttributesInfo vector.
   void send_streams(std::string csv_path, std::vector<Types::AttributeInfo> attributes);
 };
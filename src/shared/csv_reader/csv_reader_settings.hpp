@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CORE::Internal {
+
+const size_t DEFAULT_CSV_CHUNK_SIZE = 1 << 20;
+const size_t DEFAULT_MAXIMUM_CSV_CHUNKS_AHEAD = 8;
+
+/**
+ * How a MappedCSVReader splits the file. Each chunk becomes a flat stream
+ * frame, so smaller chunks reach the queries sooner and larger ones amortize
+ * the work done per frame.
+ */
+struct CSVReaderSettings {
+  // Amount of bytes of each chunk, it is extended to the end of its last line.
+  size_t chunk_size = DEFAULT_CSV_CHUNK_SIZE;
+  // Threads that parse the chunks while the previous ones are consumed.
+  // 0 parses every chunk in the thread that reads the file.
+  size_t parser_threads = 0;
+  // Maximum amount of parsed chunks waiting to be consumed, bounds the memory
+  // used when the parsers are faster than the consumer.
+  size_t maximum_chunks_ahead = DEFAULT_MAXIMUM_CSV_CHUNKS_AHEAD;
+};
+}  // namespace CORE::Internal
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tracy/Tracy.hpp>
+#include <utility>
+#include <vector>
+
+#include "shared/csv_reader/csv_reader_settings.hpp"
+#include "shared/csv_reader/mapped_file.hpp"
+#include "shared/datatypes/aliases/event_type_id.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/catalog/event_info.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/serializer/flat_stream/flat_stream_builder.hpp"
+
+namespace CORE::Internal {
+
+/**
+ * Reads a csv file with the same format as StreamInfo::get_events_from_csv
+ * (a header, then an event name and its attributes per line) into flat
+ * stream frames, see flat_stream_format.hpp.
+ *
+ * The file is mapped in memory and split in chunks of whole lines, every
+ * field is parsed where it is, and each chunk is handed over as soon as it
+ * is parsed. Nothing is kept after a frame is consumed, so the memory used
+ * does not depend on the size of the file. With parser threads, the chunks
+ * are parsed in parallel but still consumed in the order of the file.
+ */
+class MappedCSVReader {
+  struct EventDescription {
+    Types::UniqueEventTypeId id;
+    std::vector<Types::ValueTypes> types;
+  };
+
+  Types::StreamInfo stream_info;
+  CSVReaderSettings settings;
+  MappedFile file;
+  std::map<std::string, EventDescription, std::less<>> events_by_name;
+
+ public:
+  MappedCSVReader(const Types::StreamInfo& stream_info,
+                  const std::string& csv_path,
+                  CSVReaderSettings settings = {})
+      : stream_info(stream_info), settings(settings), file(csv_path) {
+    assert(settings.chunk_size > 0);
+    assert(settings.maximum_chunks_ahead > 0);
+    for (const Types::EventInfo& event_info : stream_info.events_info) {
+      if (events_by_name.contains(event_info.name)) {
+        throw std::runtime_error("Stream has two events info with same name");
+      }
+      EventDescription& description = events_by_name[event_info.name];
+      description.id = event_info.id;
+      for (const Types::AttributeInfo& attribute_info : event_info.attributes_info) {
+        description.types.push_back(attribute_info.value_type);
+      }
+    }
+  }
+
+  /**
+   * Calls consume with the frame of every chunk, in the order of the file.
+   * An invalid line throws after every frame before it was consumed.
+   * @return The amount of events read.
+   */
+  template <typename Consumer>
+  uint64_t read_frames(Consumer&& consume) {
+    std::vector<std::string_view> chunks = split_in_chunks();
+    if (settings.parser_threads == 0) {
+      uint64_t amount_of_events = 0;
+      FlatStreamBuilder builder(stream_info);
+      for (std::string_view chunk : chunks) {
+        parse_chunk(chunk, builder);
+        amount_of_events += builder.size();
+        consume(std::string_view(builder.build()));
+      }
+      return amount_of_events;
+    }
+    return read_frames_in_parallel(chunks, std::forward<Consumer>(consume));
+  }
+
+ private:
+  std::vector<std::string_view> split_in_chunks() const {
+    std::string_view contents = file.contents();
+    // Skip header.
+    size_t header_end = contents.find('\n');
+    contents.remove_prefix(header_end == std::string_view::npos ? contents.size()
+                                                                : header_end + 1);
+    std::vector<std::string_view> chunks;
+    while (!contents.empty()) {
+      size_t chunk_size = std::min(settings.chunk_size, contents.size());
+      size_t chunk_end = contents.find('\n', chunk_size - 1);
+      chunk_end = chunk_end == std::string_view::npos ? contents.size() : chunk_end + 1;
+      chunks.push_back(contents.substr(0, chunk_end));
+      contents.remove_prefix(chunk_end);
+    }
+    return chunks;
+  }
+
+  void parse_chunk(std::string_view chunk, FlatStreamBuilder& builder) const {
+    ZoneScopedN("MappedCSVReader::parse_chunk");
+    builder.clear();
+    while (!chunk.empty()) {
+      size_t line_end = chunk.find('\n');
+      std::string_view line = chunk.substr(0, line_end);
+      chunk.remove_prefix(line_end == std::string_view::npos ? chunk.size()
+                                                             : line_end + 1);
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (!line.empty()) {
+        parse_line(line, builder);
+      }
+    }
+  }
+
+  void parse_line(std::string_view line, FlatStreamBuilder& builder) const {
+    std::string_view fields = line;
+    std::string_view name = next_field(fields);
+    auto event = events_by_name.find(name);
+    if (event == events_by_name.end()) {
+      throw std::runtime_error("Unknown event " + std::string(name)
+                               + " in csv line: " + std::string(line));
+    }
+    builder.add_event(event->second.id);
+    for (Types::ValueTypes type : event->second.types) {
+      if (fields.data() == nullptr) {
+        throw std::runtime_error("Missing attributes in csv line: " + std::string(line));
+      }
+      std::string_view field = next_field(fields);
+      switch (type) {
+        case Types::ValueTypes::INT64:
+          builder.add_int(parse_number<int64_t>(field, line));
+          break;
+        case Types::ValueTypes::STRING_VIEW:
+          builder.add_string(field);
+          break;
+        case Types::ValueTypes::DOUBLE:
+          builder.add_double(parse_number<double>(field, line));
+          break;
+        case Types::ValueTypes::BOOL:
+          builder.add_bool(field == "true");
+          break;
+        case Types::ValueTypes::DATE:
+          throw std::runtime_error("Date not currently implemented in csv reader");
+      }
+    }
+    // As in get_events_from_csv, the fields after the attributes are ignored.
+  }
+
+  /**
+   * Removes the first field from fields. After the last field, fields has no
+   * data, which tells an empty last field apart from a missing one.
+   */
+  static std::string_view next_field(std::string_view& fields) {
+    size_t comma = fields.find(',');
+    if (comma == std::string_view::npos) {
+      std::string_view out = fields;
+      fields = {};
+      return out;
+    }
+    std::string_view out = fields.substr(0, comma);
+    fields.remove_prefix(comma + 1);
+    return out;
+  }
+
+  /**
+   * Parses the number at the start of the field, as std::stoll and std::stod
+   * do in get_events_from_csv: leading whitespace and a plus sign are skipped,
+   * and anything after the number is ignored.
+   */
+  template <typename T>
+  static T parse_number(std::string_view field, std::string_view line) {
+    size_t start = field.find_first_not_of(" \t\n\v\f\r");
+    field.remove_prefix(start == std::string_view::npos ? field.size() : start);
+    if (field.starts_with('+') && !field.starts_with("+-")) {
+      field.remove_prefix(1);
+    }
+    T value;
+    auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (error != std::errc()) {
+      throw std::runtime_error("Invalid number " + std::string(field)
+                               + " in csv line: " + std::string(line));
+    }
+    return value;
+  }
+
+  template <typename Consumer>
+  uint64_t read_frames_in_parallel(const std::vector<std::string_view>& chunks,
+                                   Consumer&& consume) {
+    struct ParsedChunk {
+      bool parsed = false;
+      std::string frame;
+      uint64_t amount_of_events = 0;
+      std::exception_ptr error;
+    };
+
+    std::vector<ParsedChunk> parsed_chunks(chunks.size());
+    std::mutex mutex;
+    std::condition_variable chunk_parsed;
+    std::condition_variable chunk_consumed;
+    size_t next_to_parse = 0;
+    size_t next_to_consume = 0;
+    bool stopped = false;
+
+    auto parse_chunks = [&]() {
+      FlatStreamBuilder builder(stream_info);
+      std::unique_lock lock(mutex);
+      while (true) {
+        chunk_consumed.wait(lock, [&]() {
+          return stopped || next_to_parse == chunks.size()
+                 || next_to_parse < next_to_consume + settings.maximum_chunks_ahead;
+        });
+        if (stopped || next_to_parse == chunks.size()) return;
+        size_t index = next_to_parse++;
+        lock.unlock();
+        ParsedChunk parsed_chunk;
+        try {
+          parse_chunk(chunks[index], builder);
+          parsed_chunk.amount_of_events = builder.size();
+          parsed_chunk.frame = builder.build();
+        } catch (...) {
+          parsed_chunk.error = std::current_exception();
+        }
+        lock.lock();
+        parsed_chunk.parsed = true;
+        parsed_chunks[index] = std::move(parsed_chunk);
+        chunk_parsed.notify_all();
+      }
+    };
+
+    std::vector<std::thread> parsers;
+    auto stop_parsers = [&]() {
+      {
+        std::lock_guard lock(mutex);
+        stopped = true;
+      }
+      chunk_consumed.notify_all();
+      for (std::thread& parser : parsers) {
+        parser.join();
+      }
+    };
+
+    uint64_t amount_of_events = 0;
+    try {
+      for (size_t i = 0; i < settings.parser_threads; i++) {
+        parsers.emplace_back(parse_chunks);
+      }
+      for (size_t i = 0; i < chunks.size(); i++) {
+        ParsedChunk parsed_chunk;
+        {
+          std::unique_lock lock(mutex);
+          chunk_parsed.wait(lock, [&]() { return parsed_chunks[i].parsed; });
+          parsed_chunk = std::move(parsed_chunks[i]);
+          next_to_consume = i + 1;
+        }
+        chunk_consumed.notify_all();
+        if (parsed_chunk.error) {
+          std::rethrow_exception(parsed_chunk.error);
+        }
+        amount_of_events += parsed_chunk.amount_of_events;
+        consume(std::string_view(parsed_chunk.frame));
+      }
+    } catch (...) {
+      stop_parsers();
+      throw;
+    }
+    stop_parsers();
+    return amount_of_events;
+  }
+};
+}  // namespace CORE::Internal
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace CORE::Internal {
+
+/**
+ * A read only file mapped in memory. The pages are loaded by the kernel as
+ * they are read, so a file of any size is available without copying it.
+ */
+class MappedFile {
+  void* data = nullptr;
+  size_t size = 0;
+
+ public:
+  explicit MappedFile(const std::string& path) {
+    int file_descriptor = open(path.c_str(), O_RDONLY);
+    if (file_descriptor == -1) {
+      throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+    }
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) == -1) {
+      int error = errno;
+      close(file_descriptor);
+      throw std::runtime_error("Could not stat " + path + ": " + std::strerror(error));
+    }
+    size = static_cast<size_t>(file_stat.st_size);
+    if (size > 0) {
+      data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    }
+    int error = errno;
+    close(file_descriptor);
+    if (data == MAP_FAILED) {
+      data = nullptr;
+      throw std::runtime_error("Could not map " + path + ": " + std::strerror(error));
+    }
+    if (data != nullptr) {
+      // Only a hint, the file is read front to back.
+      madvise(data, size, MADV_SEQUENTIAL);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (data != nullptr) {
+      munmap(data, size);
+    }
+  }
+
+  std::string_view contents() const {
+    return {static_cast<const char*>(data), size};
+  }
+};
+}  // namespace CORE::Internal
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "shared/datatypes/complex_event.hpp"
@@ -17,11 +19,17 @@ namespace CORE::Types {
  */
 struct Enumerator {
   std::vector<ComplexEvent> complex_events{};  // TODO: Create it with tecs.
+  // Set instead of the complex events by the queries that select COUNT(*).
+  // Not serialized, the counts are sent in frames of their own, see
+  // Types::RESULT_COUNT_TOPIC.
+  std::optional<uint64_t> count{};
 
   Enumerator() noexcept = default;
 
   Enumerator(std::vector<ComplexEvent>&& events) noexcept : complex_events(events) {}
 
+  explicit Enumerator(uint64_t count) noexcept : count(count) {}
+
   ~Enumerator() noexcept = default;
 
   Enumerator& operator=(Enumerator&& other) = default;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace CORE::Types {
+
+/**
+ * Runtime statistics of a query, taken while it runs. The counters of the
+ * automaton and the tECS of a PARTITION BY query are refreshed on every sweep
+ * of its partitions, so they can be slightly behind.
+ */
+struct QueryStats {
+  // Events relevant to the query that were evaluated and handled.
+  uint64_t events_processed = 0;
+  // Events whose output had complex events.
+  uint64_t matches_emitted = 0;
+  uint64_t det_cea_states = 0;
+  uint64_t det_cea_computed_transitions = 0;
+  uint64_t tecs_nodes_allocated = 0;
+  uint64_t tecs_nodes_used = 0;
+  uint64_t tecs_nodes_recycled = 0;
+  // Memory of the pools of the automaton and the tECS, and the part of it
+  // that is in use. The compaction of the pools gave back pool_bytes_released.
+  uint64_t det_cea_retained_bytes = 0;
+  uint64_t det_cea_live_bytes = 0;
+  uint64_t tecs_retained_bytes = 0;
+  uint64_t tecs_live_bytes = 0;
+  uint64_t pool_bytes_released = 0;
+  // Time spent evaluating the events and handing their outputs to the result
+  // handler, the evaluation is not timed if worker threads evaluate the
+  // partitions of the query.
+  uint64_t evaluation_nanoseconds = 0;
+  uint64_t emission_nanoseconds = 0;
+  // Outputs dropped because too many were waiting to be handled.
+  uint64_t outputs_dropped = 0;
+  // Zero unless the query has a PARTITION BY.
+  uint64_t live_partitions = 0;
+  // Nanoseconds since the epoch, the query does not need the tuples of the
+  // ring tuple queue ingested up to then. Zero while it needs all of them.
+  int64_t ingest_watermark = 0;
+  // Bucket i counts the events whose time from ingestion until their output
+  // was handled has i bits in nanoseconds, the last one every longer time.
+  std::vector<uint64_t> latency_histogram{};
+
+  template <class Archive>
+  void serialize(Archive& archive) {
+    archive(events_processed,
+            matches_emitted,
+            det_cea_states,
+            det_cea_computed_transitions,
+            tecs_nodes_allocated,
+            tecs_nodes_used,
+            tecs_nodes_recycled,
+            det_cea_retained_bytes,
+            det_cea_live_bytes,
+            tecs_retained_bytes,
+            tecs_live_bytes,
+            pool_bytes_released,
+            evaluation_nanoseconds,
+            emission_nanoseconds,
+            outputs_dropped,
+            live_partitions,
+            ingest_watermark,
+            latency_histogram);
+  }
+};
+
+/**
+ * Response to ClientRequestType::QueryStats. The queries are in the order
+ * they were declared. The ring tuple queue is shared by every query, its
+ * buffers are recycled once every query is past their tuples.
+ */
+struct ServerStats {
+  std::vector<QueryStats> queries{};
+  uint64_t ring_tuple_queue_bytes_allocated = 0;
+  uint64_t ring_tuple_queue_bytes_in_use = 0;
+
+  template <class Archive>
+  void serialize(Archive& archive) {
+    archive(queries, ring_tuple_queue_bytes_allocated, ring_tuple_queue_bytes_in_use);
+  }
+};
+}  // namespace CORE::Types
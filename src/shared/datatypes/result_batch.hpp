@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "shared/datatypes/enumerator.hpp"
+
+namespace CORE::Types {
+/**
+ * Frame of ResultEmissionMode::MatchesOnly. A batch without enumerators is a
+ * heartbeat that only reports the progress of the query.
+ */
+struct ResultBatch {
+  // Every match of the first amount_of_events_processed events evaluated by
+  // the query was already sent, in this batch or a previous one.
+  uint64_t amount_of_events_processed = 0;
+  std::vector<Enumerator> enumerators{};
+  // The counts of the matches of a query that selects COUNT(*), instead of
+  // its enumerators.
+  std::vector<uint64_t> counts{};
+
+  ResultBatch() noexcept = default;
+
+  ResultBatch(uint64_t amount_of_events_processed,
+              std::vector<Enumerator>&& enumerators) noexcept
+      : amount_of_events_processed(amount_of_events_processed),
+        enumerators(std::move(enumerators)) {}
+
+  template <class Archive>
+  void serialize(Archive& archive) {
+    archive(amount_of_events_processed, enumerators, counts);
+  }
+};
+}  // namespace CORE::Types
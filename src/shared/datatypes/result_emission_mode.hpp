@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+namespace CORE::Types {
+/**
+ * How a client receives the results of a query. The EveryEvent frames are
+ * the serialized Enumerators as they always were, so their clients subscribe
+ * to every frame of the query. The MatchesOnly frames start with
+ * RESULT_BATCH_TOPIC, so the server only prepares them if somebody
+ * subscribed to it, see result_emission_topic. The EveryEvent frames of a
+ * query that selects COUNT(*) are its counts instead, see RESULT_COUNT_TOPIC.
+ */
+enum struct ResultEmissionMode {
+  // One serialized Enumerator for every event processed by the query, even
+  // if it has no complex events.
+  EveryEvent,
+  // Serialized ResultBatches with only the non-empty Enumerators, plus
+  // periodic empty batches as heartbeats.
+  MatchesOnly,
+};
+
+// No serialized Enumerator starts with it: its first 8 bytes would be the
+// amount of complex events, more than 10^18 in either byte order.
+const std::string RESULT_BATCH_TOPIC = "COREBTCH";
+// Starts the EveryEvent frames of a query that selects COUNT(*), followed by
+// the serialized count. No serialized Enumerator starts with it either.
+const std::string RESULT_COUNT_TOPIC = "CORECNT_";
+
+/**
+ * Prefix of the frames published for the mode, empty for EveryEvent.
+ */
+inline std::string result_emission_topic(ResultEmissionMode mode) {
+  return mode == ResultEmissionMode::MatchesOnly ? RESULT_BATCH_TOPIC : "";
+}
+
+/**
+ * Whether a frame received by a subscriber of the mode is of that mode. The
+ * EveryEvent subscribers also receive the MatchesOnly frames of the query
+ * when another client subscribed to them.
+ */
+inline bool is_result_emission_frame(ResultEmissionMode mode, const std::string& frame) {
+  bool is_result_batch = frame.starts_with(RESULT_BATCH_TOPIC);
+  return is_result_batch == (mode == ResultEmissionMode::MatchesOnly);
+}
+
+/**
+ * The serialized Enumerator or ResultBatch of a frame of the mode.
+ */
+inline std::string
+result_emission_payload(ResultEmissionMode mode, const std::string& frame) {
+  return frame.substr(result_emission_topic(mode).size());
+}
+
+// Whether the payload of an EveryEvent frame is a count, see RESULT_COUNT_TOPIC.
+inline bool is_result_count_payload(const std::string& payload) {
+  return payload.starts_with(RESULT_COUNT_TOPIC);
+}
+}  // namespace CORE::Types
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
 #include <zmq.hpp>
 
 #include "shared/networking/message_broadcaster/message_broadcaster.hpp"
@@ -7,7 +10,7 @@ namespace CORE::Internal {
 class ZMQMessageBroadcaster {
  public:
   ZMQMessageBroadcaster(const std::string& address)
-      : context(1), socket(context, zmq::socket_type::pub) {
+      : context(1), socket(context, zmq::socket_type::xpub) {
     socket.bind(address);
   }
 
@@ -16,8 +19,52 @@ class ZMQMessageBroadcaster {
     socket.send(zmq_message, zmq::send_flags::none);
   }
 
+  /**
+   * Reads the subscriptions and unsubscriptions received so far without
+   * blocking. A topic is only reported once while any subscriber keeps it.
+   */
+  void update_subscriptions() {
+    zmq::message_t zmq_message;
+    while (socket.recv(zmq_message, zmq::recv_flags::dontwait)) {
+      if (zmq_message.size() == 0) continue;
+      const char* data = static_cast<const char*>(zmq_message.data());
+      std::string topic(data + 1, zmq_message.size() - 1);
+      if (data[0] == 1) {
+        subscribed_topics.insert(std::move(topic));
+      } else {
+        subscribed_topics.erase(topic);
+      }
+    }
+  }
+
+  /**
+   * Whether a message that starts with the topic would reach a subscriber,
+   * as of the last update_subscriptions.
+   */
+  bool has_subscribers(std::string_view topic) const {
+    for (const std::string& subscribed_topic : subscribed_topics) {
+      if (topic.starts_with(subscribed_topic)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Like has_subscribers, without counting the subscribers to every message.
+   */
+  bool has_topic_subscribers(std::string_view topic) const {
+    for (const std::string& subscribed_topic : subscribed_topics) {
+      if (!subscribed_topic.empty() && topic.starts_with(subscribed_topic)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
  private:
   zmq::context_t context;
   zmq::socket_t socket;
+  std::set<std::string> subscribed_topics;
 };
 }  // namespace CORE::Internal
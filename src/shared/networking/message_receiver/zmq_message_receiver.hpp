@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+#include <string>
 #include <zmq.hpp>
 
 #include "shared/networking/message_receiver/message_receiver.hpp"
@@ -26,6 +29,19 @@ class ZMQMessageReceiver : MessageReceiver {
     return std::string(static_cast<char*>(zmq_message.data()), zmq_message.size());
   }
 
+  /**
+   * Waits at most timeout for a message, a timeout of 0 only returns a
+   * message that was already received.
+   */
+  std::optional<std::string> receive(std::chrono::milliseconds timeout) {
+    zmq::pollitem_t items[] = {{socket, 0, ZMQ_POLLIN, 0}};
+    zmq::poll(&items[0], 1, timeout);
+    if (!(items[0].revents & ZMQ_POLLIN)) {
+      return {};
+    }
+    return receive();
+  }
+
   zmq::context_t& get_context() { return context; }
 };
 }  // namespace CORE::Internal
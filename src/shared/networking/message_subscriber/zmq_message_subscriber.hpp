@@ -1,5 +1,7 @@
 #pragma once
 #include <iostream>
+#include <optional>
+#include <string>
 #include <zmq.hpp>
 
 #include "shared/networking/message_subscriber/message_subscriber.hpp"
@@ -12,10 +14,13 @@ class ZMQMessageSubscriber {
   zmq::socket_t socket;
 
  public:
-  ZMQMessageSubscriber(const std::string& address)
+  /**
+   * Only receives the messages that start with the topic, by default all.
+   */
+  ZMQMessageSubscriber(const std::string& address, const std::string& topic = "")
       : context(1), socket(context, zmq::socket_type::sub) {
     socket.connect(address);
-    socket.set(zmq::sockopt::subscribe, "");  // Subscribe to all messages
+    socket.set(zmq::sockopt::subscribe, topic);
   }
 
   std::string receive() {
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "shared/datatypes/aliases/event_type_id.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/catalog/event_info.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/serializer/flat_stream/flat_stream_format.hpp"
+
+namespace CORE::Internal {
+
+/**
+ * Builds a flat stream frame (see flat_stream_format.hpp) row by row:
+ *
+ *   FlatStreamBuilder builder(stream_info);
+ *   builder.add_event(sell_id).add_string("MSFT").add_int(101);
+ *   std::string frame = builder.build();
+ *
+ * Every attribute is checked against the declared type of the event, so a
+ * frame that is built successfully only fails on the server if the stream
+ * declaration changed.
+ */
+class FlatStreamBuilder {
+  std::map<Types::UniqueEventTypeId, std::vector<Types::ValueTypes>> event_types;
+  Types::StreamTypeId stream_id;
+
+  std::vector<uint64_t> words;
+  uint64_t amount_of_events = 0;
+
+  // State of the event being built.
+  const std::vector<Types::ValueTypes>* current_types = nullptr;
+  size_t current_attribute = 0;
+  size_t current_event_start = 0;
+  std::string current_strings;
+
+ public:
+  explicit FlatStreamBuilder(const Types::StreamInfo& stream_info)
+      : stream_id(stream_info.id) {
+    for (const Types::EventInfo& event_info : stream_info.events_info) {
+      std::vector<Types::ValueTypes>& types = event_types[event_info.id];
+      for (const Types::AttributeInfo& attribute_info : event_info.attributes_info) {
+        types.push_back(attribute_info.value_type);
+      }
+    }
+    clear();
+  }
+
+  FlatStreamBuilder& add_event(Types::UniqueEventTypeId event_type_id) {
+    finish_event();
+    auto it = event_types.find(event_type_id);
+    if (it == event_types.end()) {
+      throw std::runtime_error("The event type " + std::to_string(event_type_id)
+                               + " is not part of the stream.");
+    }
+    current_types = &it->second;
+    current_attribute = 0;
+    current_event_start = words.size();
+    words.push_back(event_type_id);
+    words.push_back(0);  // Amount of words, set in finish_event.
+    amount_of_events++;
+    return *this;
+  }
+
+  FlatStreamBuilder& add_int(int64_t value) {
+    return add_word(Types::INT64, std::bit_cast<uint64_t>(value));
+  }
+
+  FlatStreamBuilder& add_double(double value) {
+    return add_word(Types::DOUBLE, std::bit_cast<uint64_t>(value));
+  }
+
+  FlatStreamBuilder& add_bool(bool value) {
+    return add_word(Types::BOOL, static_cast<uint64_t>(value));
+  }
+
+  FlatStreamBuilder& add_date(std::time_t value) {
+    static_assert(sizeof(std::time_t) == sizeof(uint64_t));
+    return add_word(Types::DATE, std::bit_cast<uint64_t>(value));
+  }
+
+  FlatStreamBuilder& add_string(std::string_view value) {
+    check_next_attribute(Types::STRING_VIEW);
+    words.push_back(current_strings.size());
+    words.push_back(value.size());
+    current_strings.append(value);
+    current_attribute++;
+    return *this;
+  }
+
+  uint64_t size() const { return amount_of_events; }
+
+  /**
+   * @return The frame with every event added since the last clear.
+   */
+  std::string build() {
+    finish_event();
+    words[2] = amount_of_events;
+    std::string frame(words.size() * sizeof(uint64_t), '\0');
+    memcpy(frame.data(), words.data(), frame.size());
+    return frame;
+  }
+
+  /**
+   * Removes every event, keeping the allocated memory to build the next frame.
+   */
+  void clear() {
+    words.clear();
+    words.push_back(FLAT_STREAM_MAGIC);
+    words.push_back(stream_id);
+    words.push_back(0);
+    amount_of_events = 0;
+    current_types = nullptr;
+    current_strings.clear();
+  }
+
+ private:
+  FlatStreamBuilder& add_word(Types::ValueTypes value_type, uint64_t word) {
+    check_next_attribute(value_type);
+    words.push_back(word);
+    current_attribute++;
+    return *this;
+  }
+
+  void check_next_attribute(Types::ValueTypes value_type) {
+    if (current_types == nullptr) {
+      throw std::runtime_error("add_event must be called before adding attributes.");
+    }
+    if (current_attribute >= current_types->size()) {
+      throw std::runtime_error("The event has more attributes than declared.");
+    }
+    if ((*current_types)[current_attribute] != value_type) {
+      throw std::runtime_error("The attribute " + std::to_string(current_attribute)
+                               + " of the event has a different type than declared.");
+    }
+  }
+
+  void finish_event() {
+    if (current_types == nullptr) {
+      return;
+    }
+    if (current_attribute != current_types->size()) {
+      throw std::runtime_error("The event has fewer attributes than declared.");
+    }
+    size_t string_words = flat_stream_padded_words(current_strings.size());
+    size_t strings_start = words.size();
+    words.resize(words.size() + string_words, 0);
+    if (!current_strings.empty()) {
+      memcpy(&words[strings_start], current_strings.data(), current_strings.size());
+    }
+    words[current_event_start + 1] = words.size() - current_event_start
+                                     - FLAT_STREAM_EVENT_HEADER_WORDS;
+    current_types = nullptr;
+    current_strings.clear();
+  }
+};
+}  // namespace CORE::Internal
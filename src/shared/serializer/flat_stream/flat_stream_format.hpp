@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "shared/datatypes/catalog/datatypes.hpp"
+
+/**
+ * Flat binary encoding of a stream of events, an alternative to serializing a
+ * Types::Stream with cereal. Every field is a uint64_t word in the native byte
+ * order, so the streamer and the server are expected to share it.
+ *
+ *   FLAT_STREAM_MAGIC | stream id | amount of events | event...
+ *
+ * Every event is:
+ *
+ *   event type id | amount of words that follow | attribute words | string bytes
+ *
+ * The attribute words are laid out like the constant section of a tuple in
+ * the RingTupleQueue: a word for each INT64, DOUBLE, BOOL and DATE attribute,
+ * and two words for each STRING_VIEW attribute, the offset of its bytes from
+ * the start of the string bytes and its length. The string bytes are padded
+ * to a multiple of a word.
+ */
+namespace CORE::Internal {
+
+const uint64_t FLAT_STREAM_MAGIC = 0x54414C46'45524F43;  // "COREFLAT"
+const size_t FLAT_STREAM_HEADER_WORDS = 3;
+const size_t FLAT_STREAM_EVENT_HEADER_WORDS = 2;
+
+inline size_t flat_stream_attribute_words(Types::ValueTypes value_type) {
+  switch (value_type) {
+    case Types::INT64:
+    case Types::DOUBLE:
+    case Types::BOOL:
+    case Types::DATE:
+      return 1;
+    case Types::STRING_VIEW:
+      return 2;
+    default:
+      throw std::runtime_error("Unknown value type in flat_stream_attribute_words.");
+  }
+}
+
+inline size_t flat_stream_padded_words(size_t amount_of_bytes) {
+  return (amount_of_bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+
+// The frame is not necessarily aligned to a word.
+inline uint64_t flat_stream_read_word(const char* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(uint64_t));
+  return word;
+}
+}  // namespace CORE::Internal
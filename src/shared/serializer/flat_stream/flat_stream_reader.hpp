@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "shared/datatypes/aliases/event_type_id.hpp"
+#include "shared/datatypes/aliases/stream_type_id.hpp"
+#include "shared/serializer/flat_stream/flat_stream_format.hpp"
+
+namespace CORE::Internal {
+
+/**
+ * Iterates the events of a flat stream frame (see flat_stream_format.hpp)
+ * without copying it. Only the framing is validated here, checking the
+ * attributes against the declared event types is left to the caller.
+ */
+class FlatStreamReader {
+ public:
+  struct Event {
+    Types::UniqueEventTypeId event_type_id;
+    // Attribute words followed by the string bytes.
+    std::string_view payload;
+
+    uint64_t word(size_t index) const {
+      return flat_stream_read_word(&payload[index * sizeof(uint64_t)]);
+    }
+
+    /**
+     * @return The bytes of a string attribute given its offset and length words,
+     * or nothing if they are out of the payload.
+     */
+    std::optional<std::string_view>
+    string(size_t attribute_words, uint64_t offset, uint64_t length) const {
+      size_t strings_start = attribute_words * sizeof(uint64_t);
+      if (strings_start > payload.size() || offset > payload.size() - strings_start
+          || length > payload.size() - strings_start - offset) {
+        return {};
+      }
+      return payload.substr(strings_start + offset, length);
+    }
+  };
+
+ private:
+  std::string_view frame;
+  Types::StreamTypeId stream_id;
+  uint64_t amount_of_events;
+  uint64_t amount_of_events_read = 0;
+  size_t position = FLAT_STREAM_HEADER_WORDS * sizeof(uint64_t);
+
+ public:
+  static bool is_flat_stream(std::string_view message) {
+    return message.size() >= FLAT_STREAM_HEADER_WORDS * sizeof(uint64_t)
+           && flat_stream_read_word(message.data()) == FLAT_STREAM_MAGIC;
+  }
+
+  explicit FlatStreamReader(std::string_view frame) : frame(frame) {
+    if (!is_flat_stream(frame) || frame.size() % sizeof(uint64_t) != 0) {
+      throw std::runtime_error("The message is not a flat stream frame.");
+    }
+    stream_id = flat_stream_read_word(&frame[sizeof(uint64_t)]);
+    amount_of_events = flat_stream_read_word(&frame[2 * sizeof(uint64_t)]);
+  }
+
+  Types::StreamTypeId get_stream_id() const { return stream_id; }
+
+  uint64_t get_amount_of_events() const { return amount_of_events; }
+
+  /**
+   * @return The next event, or nothing once every event was read.
+   */
+  std::optional<Event> next_event() {
+    if (amount_of_events_read == amount_of_events) {
+      if (position != frame.size()) {
+        throw std::runtime_error("The flat stream frame has trailing data.");
+      }
+      return {};
+    }
+    size_t remaining_words = (frame.size() - position) / sizeof(uint64_t);
+    if (remaining_words < FLAT_STREAM_EVENT_HEADER_WORDS) {
+      throw std::runtime_error("The flat stream frame is truncated.");
+    }
+    Types::UniqueEventTypeId event_type_id = flat_stream_read_word(&frame[position]);
+    uint64_t payload_words = flat_stream_read_word(&frame[position + sizeof(uint64_t)]);
+    if (payload_words > remaining_words - FLAT_STREAM_EVENT_HEADER_WORDS) {
+      throw std::runtime_error("The flat stream frame is truncated.");
+    }
+    position += FLAT_STREAM_EVENT_HEADER_WORDS * sizeof(uint64_t);
+    std::string_view payload = frame.substr(position, payload_words * sizeof(uint64_t));
+    position += payload.size();
+    amount_of_events_read++;
+    return Event{event_type_id, payload};
+  }
+};
+}  // namespace CORE::Internal
@@ -0,0 +1,427 @@
+#include <sched.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core_client/client.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "core_server/library/components/result_handler/result_handler_factory.hpp"
+#include "core_server/library/server.hpp"
+#include "shared/csv_reader/mapped_csv_reader.hpp"
+#include "shared/datatypes/aliases/port_number.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+
+/**
+ * Runs every query of a suite (for example src/targets/experiments/taxis)
+ * through an OfflineServer and reports, per query, the events per second,
+ * the latency percentiles, the peak resident memory, the tECS nodes and the
+ * DetCEA states as JSON.
+ *
+ * The csv is parsed into flat stream frames once, before any measurement,
+ * and each repetition uses a new server so that no state is shared between
+ * runs. The latency of an output is the time from the write of its last
+ * event into the ring tuple queue until the output is enumerated.
+ *
+ * Usage: core_bench [options] <declaration> <csv> <query file or directory>
+ *   --warmup N        Runs per query that are not measured, 1 by default.
+ *   --repetitions N   Measured runs per query, 5 by default.
+ *   --cpus LIST       Pins the benchmark to the cpus, for example 0,2-3.
+ *   --partition-by-threads N
+ *                     Evaluates the partitions of PARTITION BY queries in N
+ *                     threads, 0 (in the query thread) by default.
+ *   --output FILE     Writes the JSON to FILE instead of the standard output.
+ */
+
+using namespace CORE;
+
+namespace {
+const Types::PortNumber BENCHMARK_STARTING_PORT = 5000;
+
+struct BenchmarkOptions {
+  uint64_t warmup = 1;
+  uint64_t repetitions = 5;
+  std::optional<std::string> cpus;
+  uint64_t partition_by_threads = 0;
+  std::optional<std::string> output_path;
+  std::string declaration_path;
+  std::string data_path;
+  std::string queries_path;
+};
+
+// Written by the query thread, read once the server finished processing.
+struct RunRecorder {
+  uint64_t complex_events = 0;
+  std::vector<std::chrono::nanoseconds> latencies;
+};
+
+class BenchmarkResultHandler
+    : public Library::Components::ResultHandler<BenchmarkResultHandler> {
+  RunRecorder& recorder;
+
+ public:
+  BenchmarkResultHandler(const Internal::QueryCatalog& query_catalog,
+                         RunRecorder& recorder)
+      : ResultHandler(query_catalog), recorder(recorder) {}
+
+  void
+  handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
+    if (!internal_enumerator.has_value()) {
+      return;
+    }
+    std::optional<std::chrono::system_clock::time_point> event_time;
+    for (const auto& complex_event : internal_enumerator.value()) {
+      recorder.complex_events++;
+      if (!event_time.has_value() && !complex_event.event_tuples.empty()) {
+        event_time = complex_event.event_tuples.back().timestamp();
+      }
+    }
+    if (event_time.has_value()) {
+      recorder.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now() - event_time.value()));
+    }
+  }
+
+  void start_impl() {}
+};
+
+class BenchmarkResultHandlerFactory
+    : public Library::Components::ResultHandlerFactory<BenchmarkResultHandlerFactory,
+                                                       BenchmarkResultHandler> {
+  RunRecorder* recorder;
+
+ public:
+  BenchmarkResultHandlerFactory(RunRecorder* recorder = nullptr) : recorder(recorder) {}
+
+  std::unique_ptr<BenchmarkResultHandler>
+  create_handler_impl(Internal::QueryCatalog query_catalog) {
+    assert(recorder != nullptr);
+    return std::make_unique<BenchmarkResultHandler>(query_catalog, *recorder);
+  }
+};
+
+using BenchmarkServer = Library::BasicOfflineServer<BenchmarkResultHandlerFactory>;
+
+struct RunMeasurement {
+  double events_per_second;
+  uint64_t complex_events;
+  uint64_t peak_rss_bytes;
+  std::vector<std::chrono::nanoseconds> latencies;
+  Internal::Interface::QueryStatistics statistics;
+  RingTupleQueue::MemoryUsage ring_tuple_queue_memory;
+};
+
+std::string read_file(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file: " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+std::vector<std::string> query_paths(const std::string& path) {
+  if (!std::filesystem::is_directory(path)) {
+    return {path};
+  }
+  std::vector<std::string> out;
+  for (const auto& entry : std::filesystem::directory_iterator(path)) {
+    if (entry.is_regular_file()) {
+      out.push_back(entry.path().string());
+    }
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+// Parses a list like 0,2-3.
+void pin_to_cpus(const std::string& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  std::stringstream list(cpus);
+  std::string range;
+  while (std::getline(list, range, ',')) {
+    size_t dash = range.find('-');
+    size_t first = std::stoull(range.substr(0, dash));
+    size_t last = dash == std::string::npos ? first : std::stoull(range.substr(dash + 1));
+    for (size_t cpu = first; cpu <= last; cpu++) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  // Every thread created afterwards, query threads included, inherits it.
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    throw std::runtime_error("Could not pin the benchmark to cpus " + cpus);
+  }
+}
+
+// Makes VmHWM start again from the current resident memory.
+void reset_peak_rss() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+}
+
+uint64_t peak_rss_bytes() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with("VmHWM:")) {
+      return std::stoull(line.substr(6)) * 1024;
+    }
+  }
+  return 0;
+}
+
+struct BenchmarkState {
+  const BenchmarkOptions& options;
+  Types::PortNumber next_port = BENCHMARK_STARTING_PORT;
+  std::string declaration;
+  // Parsed with the stream info of the first server, every server declares
+  // the same stream so they get the same ids.
+  std::vector<std::string> frames;
+  uint64_t amount_of_events = 0;
+
+  RunMeasurement run(const std::string& query) {
+    RunRecorder recorder;
+    Types::PortNumber port = next_port;
+    next_port += 2;
+    BenchmarkServer server{port,
+                           {.worker_threads = options.partition_by_threads},
+                           {},
+                           BenchmarkResultHandlerFactory(&recorder)};
+    Client client{"tcp://localhost", port};
+    Types::StreamInfo stream_info = client.declare_stream(declaration);
+    if (frames.empty()) {
+      Internal::MappedCSVReader reader(stream_info, options.data_path);
+      amount_of_events = reader.read_frames(
+        [&](std::string_view frame) { frames.emplace_back(frame); });
+    }
+    client.add_query(query);
+
+    reset_peak_rss();
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& frame : frames) {
+      server.receive_flat_stream(frame);
+    }
+    server.wait_until_processed();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    RunMeasurement measurement;
+    measurement.events_per_second = amount_of_events
+                                    / std::chrono::duration<double>(elapsed).count();
+    measurement.complex_events = recorder.complex_events;
+    measurement.peak_rss_bytes = peak_rss_bytes();
+    measurement.latencies = std::move(recorder.latencies);
+    measurement.statistics = server.get_query_statistics(0);
+    measurement.ring_tuple_queue_memory = server.get_ring_tuple_queue_memory_usage();
+    return measurement;
+  }
+};
+
+std::string json_string(std::string_view value) {
+  std::string out = "\"";
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out += escaped;
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out + "\"";
+}
+
+// Nearest rank percentile of sorted values.
+uint64_t percentile(const std::vector<std::chrono::nanoseconds>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[rank].count();
+}
+
+void write_query_json(std::ostream& out,
+                      const std::string& path,
+                      const std::string& query,
+                      std::vector<RunMeasurement>& runs) {
+  std::vector<double> throughputs;
+  std::vector<std::chrono::nanoseconds> latencies;
+  uint64_t peak_rss = 0;
+  for (const RunMeasurement& run : runs) {
+    throughputs.push_back(run.events_per_second);
+    latencies.insert(latencies.end(), run.latencies.begin(), run.latencies.end());
+    peak_rss = std::max(peak_rss, run.peak_rss_bytes);
+  }
+  std::sort(throughputs.begin(), throughputs.end());
+  std::sort(latencies.begin(), latencies.end());
+  // Every run evaluates the same events, the structures are the same size.
+  const Internal::Interface::QueryStatistics& statistics = runs.back().statistics;
+
+  out << "    {\n";
+  out << "      \"path\": " << json_string(path) << ",\n";
+  out << "      \"query\": " << json_string(query) << ",\n";
+  out << "      \"complex_events\": " << runs.back().complex_events << ",\n";
+  out << "      \"events_per_second\": [";
+  for (size_t i = 0; i < runs.size(); i++) {
+    out << (i == 0 ? "" : ", ") << static_cast<uint64_t>(runs[i].events_per_second);
+  }
+  out << "],\n";
+  out << "      \"best_events_per_second\": " << static_cast<uint64_t>(throughputs.back())
+      << ",\n";
+  out << "      \"median_events_per_second\": "
+      << static_cast<uint64_t>(throughputs[throughputs.size() / 2]) << ",\n";
+  out << "      \"latency_ns\": {\"p50\": " << percentile(latencies, 0.5)
+      << ", \"p90\": " << percentile(latencies, 0.9)
+      << ", \"p99\": " << percentile(latencies, 0.99)
+      << ", \"max\": " << (latencies.empty() ? 0 : latencies.back().count()) << "},\n";
+  out << "      \"peak_rss_bytes\": " << peak_rss << ",\n";
+  out << "      \"tecs_nodes_allocated\": " << statistics.tecs_nodes_allocated << ",\n";
+  out << "      \"tecs_nodes_used\": " << statistics.tecs_nodes_used << ",\n";
+  out << "      \"tecs_retained_bytes\": " << statistics.tecs_retained_bytes << ",\n";
+  out << "      \"tecs_live_bytes\": " << statistics.tecs_live_bytes << ",\n";
+  out << "      \"det_cea_states\": " << statistics.det_cea_states << ",\n";
+  out << "      \"det_cea_computed_transitions\": "
+      << statistics.det_cea_computed_transitions << ",\n";
+  out << "      \"det_cea_retained_bytes\": " << statistics.det_cea_retained_bytes
+      << ",\n";
+  out << "      \"pool_bytes_released\": " << statistics.pool_bytes_released << ",\n";
+  out << "      \"ring_tuple_queue_bytes_allocated\": "
+      << runs.back().ring_tuple_queue_memory.bytes_allocated << ",\n";
+  out << "      \"ring_tuple_queue_bytes_in_use\": "
+      << runs.back().ring_tuple_queue_memory.bytes_in_use << "\n";
+  out << "    }";
+}
+
+BenchmarkOptions parse_options(int argc, char** argv) {
+  BenchmarkOptions options;
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if (argument.starts_with("--")) {
+      if (i + 1 == argc) {
+        throw std::runtime_error("Missing value of " + argument);
+      }
+      std::string value = argv[++i];
+      if (argument == "--warmup") {
+        options.warmup = std::stoull(value);
+      } else if (argument == "--repetitions") {
+        options.repetitions = std::stoull(value);
+      } else if (argument == "--cpus") {
+        options.cpus = value;
+      } else if (argument == "--partition-by-threads") {
+        options.partition_by_threads = std::stoull(value);
+      } else if (argument == "--output") {
+        options.output_path = value;
+      } else {
+        throw std::runtime_error("Unknown option " + argument);
+      }
+    } else {
+      positional.push_back(std::move(argument));
+    }
+  }
+  if (positional.size() != 3) {
+    throw std::runtime_error("Expected the declaration, the csv and the queries.");
+  }
+  if (options.repetitions == 0) {
+    throw std::runtime_error("There must be at least one repetition.");
+  }
+  options.declaration_path = positional[0];
+  options.data_path = positional[1];
+  options.queries_path = positional[2];
+  return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchmarkOptions options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (std::exception& e) {
+    std::cout << e.what() << "\nUsage: " << argv[0]
+              << " [--warmup N] [--repetitions N] [--cpus LIST]"
+                 " [--partition-by-threads N] [--output FILE]"
+                 " <declaration> <csv> <query file or directory>"
+              << std::endl;
+    return 1;
+  }
+
+  try {
+    if (options.cpus.has_value()) {
+      pin_to_cpus(options.cpus.value());
+    }
+    BenchmarkState state{options};
+    state.declaration = read_file(options.declaration_path);
+
+    std::ofstream output_file;
+    if (options.output_path.has_value()) {
+      output_file.open(options.output_path.value());
+      if (!output_file.is_open()) {
+        throw std::runtime_error("Could not open file: " + options.output_path.value());
+      }
+    }
+    std::ostream& out = options.output_path.has_value() ? output_file : std::cout;
+
+    std::vector<std::string> paths = query_paths(options.queries_path);
+    out << "{\n  \"data\": " << json_string(options.data_path) << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n";
+    out << "  \"partition_by_threads\": " << options.partition_by_threads << ",\n";
+    out << "  \"queries\": [\n";
+    for (size_t i = 0; i < paths.size(); i++) {
+      std::string query = read_file(paths[i]);
+      std::cerr << "Running " << paths[i] << std::endl;
+      for (uint64_t run = 0; run < options.warmup; run++) {
+        state.run(query);
+      }
+      std::vector<RunMeasurement> runs;
+      for (uint64_t run = 0; run < options.repetitions; run++) {
+        runs.push_back(state.run(query));
+      }
+      write_query_json(out, paths[i], query, runs);
+      out << (i + 1 == paths.size() ? "\n" : ",\n");
+    }
+    out << "  ],\n  \"events\": " << state.amount_of_events << "\n}" << std::endl;
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
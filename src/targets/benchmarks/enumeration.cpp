@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/enumeration/tecs/complex_event.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/union_list.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+/**
+ * Measures the enumeration of tECS DAGs that produce many complex events,
+ * comparing tECS::Enumerator with the previous enumeration that copied the
+ * tuples of the current branch on every union node, and with
+ * Enumerator::count, which counts them without enumerating. The DAGs are built
+ * directly with the tECS, so nothing else is measured:
+ *
+ *  - any: the DAG of SELECT * WHERE SELL+ under skip till any match, every
+ *    subset of the events that contains the last one (2^(n-1) outputs).
+ *  - contiguous: every run of consecutive events that ends in the last
+ *    one (n outputs of length 1 to n), as produced by long sequences.
+ *
+ * Usage: benchmark_enumeration [any events] [contiguous events] [repetitions]
+ */
+
+using namespace CORE::Internal;
+
+namespace {
+struct DAG {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{100'000, &schemas};
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS::tECS tecs{event_time_of_expiration};
+  tECS::Node* root = nullptr;
+  uint64_t last_position = 0;
+
+  DAG() { schemas.add_schema({RingTupleQueue::SupportedTypes::INT64}); }
+
+  RingTupleQueue::Tuple new_tuple(uint64_t pos) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = pos;
+    return queue.get_tuple(data);
+  }
+
+  void build_any(uint64_t amount_of_events) {
+    // Nodes of the subsets that end in each position, sorted by decreasing max.
+    std::vector<tECS::Node*> ulist;
+    for (uint64_t pos = 1; pos <= amount_of_events; pos++) {
+      RingTupleQueue::Tuple tuple = new_tuple(pos);
+      tECS::UnionList predecessors = tecs.new_ulist(tecs.new_bottom(tuple, pos));
+      for (tECS::Node* node : ulist) {
+        predecessors = tecs.insert(std::move(predecessors), node);
+      }
+      root = tecs.new_extend(tecs.merge(predecessors), tuple, pos);
+      tecs.pin(root);
+      ulist.insert(ulist.begin(), root);
+    }
+    last_position = amount_of_events;
+  }
+
+  void build_contiguous(uint64_t amount_of_events) {
+    for (uint64_t pos = 1; pos <= amount_of_events; pos++) {
+      RingTupleQueue::Tuple tuple = new_tuple(pos);
+      tECS::UnionList predecessors = tecs.new_ulist(tecs.new_bottom(tuple, pos));
+      if (root != nullptr) {
+        predecessors = tecs.insert(std::move(predecessors), root);
+      }
+      root = tecs.new_extend(tecs.merge(predecessors), tuple, pos);
+      tecs.pin(root);
+    }
+    last_position = amount_of_events;
+  }
+};
+
+struct Result {
+  uint64_t complex_events = 0;
+  uint64_t tuples = 0;
+  uint64_t checksum = 0;
+
+  void add(uint64_t start, const std::vector<RingTupleQueue::Tuple>& tuples) {
+    complex_events++;
+    this->tuples += tuples.size();
+    checksum += start * tuples.size()
+                + (tuples.empty() ? 0 : *tuples.front()[0] + *tuples.back()[0]);
+  }
+
+  bool operator==(const Result& other) const = default;
+};
+
+Result enumerate(DAG& dag) {
+  Result result;
+  dag.tecs.pin(dag.root);
+  tECS::Enumerator enumerator(dag.root,
+                              dag.last_position,
+                              dag.last_position,
+                              dag.tecs,
+                              dag.tecs.time_reservator,
+                              -1);
+  for (tECS::ComplexEvent complex_event : enumerator) {
+    result.add(complex_event.start, complex_event.event_tuples);
+  }
+  return result;
+}
+
+uint64_t count(DAG& dag) {
+  dag.tecs.pin(dag.root);
+  tECS::Enumerator enumerator(dag.root,
+                              dag.last_position,
+                              dag.last_position,
+                              dag.tecs,
+                              dag.tecs.time_reservator,
+                              -1);
+  return enumerator.count();
+}
+
+// The enumeration before the shared path, kept as the baseline.
+Result enumerate_with_copies(DAG& dag) {
+  Result result;
+  std::vector<std::pair<tECS::Node*, std::vector<RingTupleQueue::Tuple>>> stack;
+  stack.push_back({dag.root, {}});
+  while (!stack.empty()) {
+    tECS::Node* current_node = stack.back().first;
+    std::vector<RingTupleQueue::Tuple> tuples = stack.back().second;
+    stack.pop_back();
+    while (true) {
+      if (current_node->is_bottom()) {
+        std::reverse(tuples.begin(), tuples.end());
+        result.add(current_node->pos(), tuples);
+        break;
+      } else if (current_node->is_output()) {
+        tuples.push_back(dag.tecs.get_tuple(current_node));
+        current_node = dag.tecs.next(current_node);
+      } else {
+        stack.push_back({dag.tecs.get_right(current_node), tuples});
+        current_node = dag.tecs.get_left(current_node);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename Function>
+double best_seconds(uint64_t repetitions, Function&& function) {
+  double best = 0;
+  for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                   - start)
+                       .count();
+    best = repetition == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+void benchmark(std::string name, DAG& dag, uint64_t repetitions) {
+  Result result;
+  double seconds = best_seconds(repetitions, [&]() { result = enumerate(dag); });
+  Result baseline_result;
+  double baseline_seconds = best_seconds(repetitions, [&]() {
+    baseline_result = enumerate_with_copies(dag);
+  });
+  if (!(result == baseline_result)) {
+    throw std::runtime_error("The enumerations of " + name + " do not match.");
+  }
+  uint64_t counted = 0;
+  double count_seconds = best_seconds(repetitions, [&]() { counted = count(dag); });
+  if (counted != result.complex_events) {
+    throw std::runtime_error("The count of " + name + " does not match.");
+  }
+  std::cout << name << ": " << result.complex_events << " complex events, "
+            << result.tuples << " tuples" << std::endl;
+  std::cout << "Enumerator, " << name << ": "
+            << static_cast<uint64_t>(result.complex_events / seconds)
+            << " complex events/s" << std::endl;
+  std::cout << "Copying baseline, " << name << ": "
+            << static_cast<uint64_t>(result.complex_events / baseline_seconds)
+            << " complex events/s" << std::endl;
+  std::cout << "Count, " << name << ": "
+            << static_cast<uint64_t>(result.complex_events / count_seconds)
+            << " complex events/s" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 4) {
+    std::cout << "Usage: " << argv[0]
+              << " [any events] [contiguous events] [repetitions]" << std::endl;
+    return 1;
+  }
+  uint64_t any_events = argc >= 2 ? std::stoull(argv[1]) : 18;
+  uint64_t contiguous_events = argc >= 3 ? std::stoull(argv[2]) : 4000;
+  uint64_t repetitions = argc == 4 ? std::stoull(argv[3]) : 5;
+
+  try {
+    DAG any;
+    any.build_any(any_events);
+    benchmark("any", any, repetitions);
+
+    DAG contiguous;
+    contiguous.build_contiguous(contiguous_events);
+    benchmark("contiguous", contiguous, repetitions);
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
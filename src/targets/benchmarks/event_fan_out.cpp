@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
+#include "shared/networking/message_receiver/zmq_message_receiver.hpp"
+#include "shared/networking/message_sender/zmq_message_sender.hpp"
+
+/**
+ * Measures how many events per second the backend can hand to its query
+ * threads, comparing one ZMQ inproc socket per query (the previous fan-out)
+ * with the shared BroadcastRing. Each query thread only reads the tuple
+ * pointer, so this isolates the cost of the fan-out itself.
+ *
+ * Usage: benchmark_event_fan_out [events] [repetitions]
+ */
+
+using namespace CORE::Internal;
+
+namespace {
+const std::vector<size_t> AMOUNTS_OF_QUERIES = {1, 8, 64};
+
+struct Measurement {
+  double best_events_per_second = 0;
+  double total_seconds = 0;
+  uint64_t repetitions = 0;
+
+  void add(uint64_t amount_of_events, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    best_events_per_second = std::max(best_events_per_second, amount_of_events / seconds);
+    total_seconds += seconds;
+    repetitions++;
+  }
+
+  void print(std::string name, uint64_t amount_of_events) const {
+    std::cout << name << ": best " << static_cast<uint64_t>(best_events_per_second)
+              << " events/s, mean "
+              << static_cast<uint64_t>(amount_of_events * repetitions / total_seconds)
+              << " events/s" << std::endl;
+  }
+};
+
+// Every query thread adds the values it receives to its checksum.
+std::chrono::steady_clock::duration
+fan_out_with_zmq(std::vector<uint64_t>& tuples, std::vector<uint64_t>& checksums) {
+  size_t amount_of_queries = checksums.size();
+  std::vector<std::unique_ptr<ZMQMessageReceiver>> receivers;
+  std::vector<std::unique_ptr<ZMQMessageSender>> senders;
+  for (size_t i = 0; i < amount_of_queries; i++) {
+    std::string address = "inproc://fan_out_" + std::to_string(i);
+    receivers.push_back(std::make_unique<ZMQMessageReceiver>(address));
+    senders.push_back(
+      std::make_unique<ZMQMessageSender>(address, receivers.back()->get_context()));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < amount_of_queries; i++) {
+    threads.emplace_back([&receiver = *receivers[i], &checksum = checksums[i]]() {
+      uint64_t sum = 0;
+      while (true) {
+        std::string message = receiver.receive();
+        if (message == "STOP") break;
+        uint64_t* data;
+        memcpy(&data, &message[0], sizeof(uint64_t*));
+        sum += *data;
+      }
+      checksum = sum;
+    });
+  }
+  for (uint64_t& tuple : tuples) {
+    uint64_t* data = &tuple;
+    std::string message(sizeof(uint64_t*), '\0');
+    memcpy(&message[0], &data, sizeof(uint64_t*));
+    for (auto& sender : senders) {
+      sender->send(message);
+    }
+  }
+  for (auto& sender : senders) {
+    sender->send("STOP");
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return std::chrono::steady_clock::now() - start;
+}
+
+std::chrono::steady_clock::duration
+fan_out_with_broadcast_ring(std::vector<uint64_t>& tuples,
+                            std::vector<uint64_t>& checksums) {
+  size_t amount_of_queries = checksums.size();
+  Stream::BroadcastRing<uint64_t*> ring;
+  std::vector<Stream::BroadcastRing<uint64_t*>::ReaderId> readers;
+  for (size_t i = 0; i < amount_of_queries; i++) {
+    readers.push_back(ring.subscribe());
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < amount_of_queries; i++) {
+    threads.emplace_back([&ring, reader = readers[i], &checksum = checksums[i]]() {
+      uint64_t sum = 0;
+      while (std::optional<uint64_t*> data = ring.next(reader)) {
+        sum += *data.value();
+      }
+      checksum = sum;
+    });
+  }
+  for (uint64_t& tuple : tuples) {
+    ring.push(&tuple);
+  }
+  ring.wait_until_consumed();
+  for (auto reader : readers) {
+    ring.unsubscribe(reader);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return std::chrono::steady_clock::now() - start;
+}
+
+void check_checksums(const std::vector<uint64_t>& checksums, uint64_t amount_of_events) {
+  uint64_t expected = amount_of_events * (amount_of_events + 1) / 2;
+  for (uint64_t checksum : checksums) {
+    if (checksum != expected) {
+      throw std::runtime_error("A query did not receive every event.");
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 3) {
+    std::cout << "Usage: " << argv[0] << " [events] [repetitions]" << std::endl;
+    return 1;
+  }
+  uint64_t amount_of_events = argc >= 2 ? std::stoull(argv[1]) : 1'000'000;
+  uint64_t repetitions = argc == 3 ? std::stoull(argv[2]) : 5;
+
+  try {
+    std::vector<uint64_t> tuples(amount_of_events);
+    for (uint64_t i = 0; i < amount_of_events; i++) {
+      tuples[i] = i + 1;
+    }
+    std::cout << "Events: " << amount_of_events << std::endl;
+
+    for (size_t amount_of_queries : AMOUNTS_OF_QUERIES) {
+      Measurement zmq_measurement;
+      Measurement ring_measurement;
+      for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+        std::vector<uint64_t> checksums(amount_of_queries, 0);
+        zmq_measurement.add(amount_of_events, fan_out_with_zmq(tuples, checksums));
+        check_checksums(checksums, amount_of_events);
+
+        checksums.assign(amount_of_queries, 0);
+        ring_measurement.add(amount_of_events,
+                             fan_out_with_broadcast_ring(tuples, checksums));
+        check_checksums(checksums, amount_of_events);
+      }
+      std::string queries = std::to_string(amount_of_queries) + " queries";
+      zmq_measurement.print("ZMQ inproc, " + queries, amount_of_events);
+      ring_measurement.print("BroadcastRing, " + queries, amount_of_events);
+    }
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/ceql/cel_formula/formula/visitors/formula_to_logical_cea.hpp"
+#include "core_server/internal/ceql/query/query.hpp"
+#include "core_server/internal/ceql/query_transformer/annotate_predicates_with_new_physical_predicates.hpp"
+#include "core_server/internal/coordination/catalog.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/cea/cea.hpp"
+#include "core_server/internal/evaluation/det_cea/det_cea.hpp"
+#include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/interface/evaluators/single_evaluator.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/internal/parsing/stream_declaration/parser.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+
+/**
+ * Measures the per-event throughput of the evaluation hot path of a single
+ * query: the PredicateEvaluator alone, both its compiled PredicateProgram and
+ * the virtual calls of the physical predicates it replaces, and the whole
+ * Evaluator (predicate evaluation, DetCEA transitions and tECS updates). The
+ * events are read and written into the ring tuple queue before the
+ * measurements start, and no ZMQ or result handling is involved.
+ *
+ * Usage: benchmark_predicate_evaluation <query> <declaration> <csv> [repetitions]
+ */
+
+using namespace CORE;
+using namespace CORE::Internal;
+
+namespace {
+std::string read_file(std::string path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file: " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+template <typename ValueT>
+ValueT& value_as(const std::shared_ptr<Types::Value>& attr) {
+  ValueT* val_ptr = dynamic_cast<ValueT*>(attr.get());
+  if (val_ptr == nullptr) {
+    throw std::runtime_error("An attribute does not match its declared type.");
+  }
+  return *val_ptr;
+}
+
+RingTupleQueue::Tuple
+write_tuple(RingTupleQueue::Queue& queue, Catalog& catalog, const Types::Event& event) {
+  const Types::EventInfo& event_info = catalog.get_event_info(event.event_type_id);
+  uint64_t* data = queue.start_tuple(event.event_type_id);
+  for (size_t i = 0; i < event_info.attributes_info.size(); i++) {
+    const std::shared_ptr<Types::Value>& attr = event.attributes[i];
+    switch (event_info.attributes_info[i].value_type) {
+      case Types::INT64:
+        *queue.writer<int64_t>() = value_as<Types::IntValue>(attr).val;
+        break;
+      case Types::DOUBLE:
+        *queue.writer<double>() = value_as<Types::DoubleValue>(attr).val;
+        break;
+      case Types::BOOL:
+        *queue.writer<bool>() = value_as<Types::BoolValue>(attr).val;
+        break;
+      case Types::STRING_VIEW: {
+        std::string& val = value_as<Types::StringValue>(attr).val;
+        memcpy(queue.writer<std::string>(val.size()), val.data(), val.size());
+        break;
+      }
+      case Types::DATE:
+        *queue.writer<std::time_t>() = value_as<Types::DateValue>(attr).val;
+        break;
+      default:
+        throw std::runtime_error("Unknown value type in write_tuple.");
+    }
+  }
+  return queue.get_tuple(data);
+}
+
+struct Measurement {
+  double best_events_per_second = 0;
+  double total_seconds = 0;
+  uint64_t repetitions = 0;
+
+  void add(uint64_t amount_of_events, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    best_events_per_second = std::max(best_events_per_second, amount_of_events / seconds);
+    total_seconds += seconds;
+    repetitions++;
+  }
+
+  void print(std::string name, uint64_t amount_of_events) const {
+    std::cout << name << ": best " << static_cast<uint64_t>(best_events_per_second)
+              << " events/s, mean "
+              << static_cast<uint64_t>(amount_of_events * repetitions / total_seconds)
+              << " events/s" << std::endl;
+  }
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 4 && argc != 5) {
+    std::cout << "Usage: " << argv[0] << " <query> <declaration> <csv> [repetitions]"
+              << std::endl;
+    return 1;
+  }
+  uint64_t repetitions = argc == 5 ? std::stoull(argv[4]) : 5;
+
+  try {
+    Catalog catalog;
+    Types::StreamInfo stream_info = catalog.add_stream_type(
+      Parsing::StreamParser::parse_stream(read_file(argv[2])));
+    std::vector<Types::Event> events = stream_info.get_events_from_csv(argv[3]);
+
+    RingTupleQueue::Queue queue(100'000, &catalog.tuple_schemas);
+    std::vector<RingTupleQueue::Tuple> tuples;
+    tuples.reserve(events.size());
+    for (const Types::Event& event : events) {
+      tuples.push_back(write_tuple(queue, catalog, event));
+    }
+    std::cout << "Events: " << tuples.size() << std::endl;
+
+    Measurement predicates_measurement;
+    Measurement virtual_predicates_measurement;
+    Measurement evaluation_measurement;
+    for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+      CEQL::Query query = Parsing::QueryParser::parse_query(read_file(argv[1]));
+      if (repetition == 0 && query.partition_by.partition_attributes.size() != 0) {
+        std::cout << "PARTITION BY is ignored, the query is evaluated as a single "
+                     "partition."
+                  << std::endl;
+      }
+      QueryCatalog query_catalog(catalog, query.from.streams);
+      CEQL::AnnotatePredicatesWithNewPhysicalPredicates transformer(query_catalog);
+      query = transformer(std::move(query));
+      Evaluation::PredicateEvaluator tuple_evaluator(
+        std::move(transformer.physical_predicates));
+
+      auto visitor = CEQL::FormulaToLogicalCEA(query_catalog);
+      query.where.formula->accept_visitor(visitor);
+      if (!query.select.is_star) {
+        query.select.formula->accept_visitor(visitor);
+      }
+      CEA::DetCEA cea(CEA::CEA(std::move(visitor.current_cea)));
+
+      Evaluation::PredicateEvaluator predicates_only = tuple_evaluator;
+      uint64_t satisfied = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (RingTupleQueue::Tuple& tuple : tuples) {
+        satisfied += predicates_only(tuple) != 0;
+      }
+      predicates_measurement.add(tuples.size(), std::chrono::steady_clock::now() - start);
+
+      uint64_t virtual_satisfied = 0;
+      start = std::chrono::steady_clock::now();
+      for (RingTupleQueue::Tuple& tuple : tuples) {
+        virtual_satisfied += predicates_only.eval_with_virtual_calls(tuple) != 0;
+      }
+      virtual_predicates_measurement.add(tuples.size(),
+                                         std::chrono::steady_clock::now() - start);
+      // Every result is compared once, the counts on every repetition.
+      bool matches = satisfied == virtual_satisfied;
+      for (size_t i = 0; repetition == 0 && matches && i < tuples.size(); i++) {
+        matches = predicates_only(tuples[i])
+                  == predicates_only.eval_with_virtual_calls(tuples[i]);
+      }
+      if (!matches) {
+        throw std::runtime_error(
+          "The PredicateProgram does not match the virtual predicates.");
+      }
+
+      std::atomic<uint64_t> time_of_expiration = 0;
+      Interface::SingleEvaluator evaluator(std::move(cea),
+                                           std::move(tuple_evaluator),
+                                           time_of_expiration,
+                                           query.consume_by.policy,
+                                           query.limit,
+                                           query.within.time_window,
+                                           query_catalog,
+                                           queue);
+      uint64_t outputs = 0;
+      start = std::chrono::steady_clock::now();
+      for (RingTupleQueue::Tuple& tuple : tuples) {
+        outputs += evaluator.process_event(tuple).has_value();
+      }
+      evaluation_measurement.add(tuples.size(), std::chrono::steady_clock::now() - start);
+
+      if (repetition == repetitions - 1) {
+        std::cout << "Events satisfying some predicate: " << satisfied << std::endl;
+        std::cout << "Events with output: " << outputs << std::endl;
+        const CEA::DetCEA& det_cea = evaluator.get_det_cea_reference();
+        std::cout << "DetCEA transitions: " << det_cea.get_amount_of_hits() << " hits, "
+                  << det_cea.get_amount_of_misses() << " misses" << std::endl;
+        predicates_measurement.print("PredicateEvaluator", tuples.size());
+        virtual_predicates_measurement.print("Virtual predicates", tuples.size());
+        evaluation_measurement.print("Evaluator", tuples.size());
+      }
+    }
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core_server/internal/stream/ring_tuple_queue/buffer_storage.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/ingest_clock.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+/**
+ * Measures how many tuples per second RingTupleQueue::Queue writes with
+ * start_tuple and writer, for a tuple like the ones of the stocks stream
+ * (a string and three numbers). Nothing is recycled, so the queue grows
+ * during the whole run, which is what happens under ingest before the
+ * queries catch up. Every storage of the buffers is compared:
+ *
+ *  - heap: a buffer is allocated on the heap when the queue is full.
+ *  - reserved: the buffers are slices of a range of virtual memory
+ *    reserved up front, backed by memory once written.
+ *  - reserved with huge pages: the same, backed by transparent huge pages.
+ *
+ * It also measures the clock of the ingest timestamps against system_clock.
+ *
+ * Usage: benchmark_ring_tuple_queue [tuples] [repetitions]
+ */
+
+using namespace RingTupleQueue;
+
+namespace {
+const uint64_t BUFFER_SIZE = 100'000;
+const std::vector<std::string_view> NAMES = {"MSFT", "INTL", "AMZN", "GOOG"};
+
+struct Measurement {
+  double best_per_second = 0;
+  double total_seconds = 0;
+  uint64_t repetitions = 0;
+
+  void add(uint64_t amount, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    best_per_second = std::max(best_per_second, amount / seconds);
+    total_seconds += seconds;
+    repetitions++;
+  }
+
+  void print(std::string name, uint64_t amount, std::string unit) const {
+    std::cout << name << ": best " << static_cast<uint64_t>(best_per_second) << " "
+              << unit << "/s, mean "
+              << static_cast<uint64_t>(amount * repetitions / total_seconds) << " "
+              << unit << "/s" << std::endl;
+  }
+};
+
+std::chrono::steady_clock::duration
+write_tuples(uint64_t amount_of_tuples, StorageSettings settings, uint64_t& checksum) {
+  TupleSchemas schemas;
+  uint64_t id = schemas.add_schema({SupportedTypes::STRING_VIEW,
+                                    SupportedTypes::INT64,
+                                    SupportedTypes::DOUBLE,
+                                    SupportedTypes::INT64});
+  auto start = std::chrono::steady_clock::now();
+  Queue queue(BUFFER_SIZE, &schemas, settings);
+  for (uint64_t i = 0; i < amount_of_tuples; i++) {
+    uint64_t* data = queue.start_tuple(id);
+    std::string_view name = NAMES[i % NAMES.size()];
+    char* chars = queue.writer<std::string>(name.size());
+    memcpy(chars, name.data(), name.size());
+    *queue.writer<int64_t>() = i;
+    *queue.writer<double>() = i * 0.5;
+    *queue.writer<int64_t>() = i % 1000;
+    checksum += data[2];
+  }
+  return std::chrono::steady_clock::now() - start;
+}
+
+template <typename ClockT>
+std::chrono::steady_clock::duration read_clock(uint64_t amount_of_reads,
+                                               ClockT& clock,
+                                               uint64_t& checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < amount_of_reads; i++) {
+    checksum += clock.now().time_since_epoch().count();
+  }
+  return std::chrono::steady_clock::now() - start;
+}
+
+struct SystemClock {
+  std::chrono::system_clock::time_point now() { return std::chrono::system_clock::now(); }
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 3) {
+    std::cout << "Usage: " << argv[0] << " [tuples] [repetitions]" << std::endl;
+    return 1;
+  }
+  uint64_t amount_of_tuples = argc >= 2 ? std::stoull(argv[1]) : 10'000'000;
+  uint64_t repetitions = argc == 3 ? std::stoull(argv[2]) : 5;
+
+  try {
+    std::cout << "Tuples: " << amount_of_tuples << std::endl;
+    uint64_t checksum = 0;
+
+    Measurement heap;
+    Measurement reserved;
+    Measurement huge_pages;
+    for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+      heap.add(amount_of_tuples, write_tuples(amount_of_tuples, {}, checksum));
+      reserved.add(amount_of_tuples,
+                   write_tuples(amount_of_tuples,
+                                {.reserve_address_range = true},
+                                checksum));
+      huge_pages.add(amount_of_tuples,
+                     write_tuples(amount_of_tuples,
+                                  {.reserve_address_range = true, .huge_pages = true},
+                                  checksum));
+    }
+    heap.print("Heap buffers", amount_of_tuples, "tuples");
+    reserved.print("Reserved range", amount_of_tuples, "tuples");
+    huge_pages.print("Reserved range with huge pages", amount_of_tuples, "tuples");
+
+    Measurement system_clock;
+    Measurement ingest_clock;
+    for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+      SystemClock system;
+      system_clock.add(amount_of_tuples, read_clock(amount_of_tuples, system, checksum));
+      IngestClock ingest;
+      ingest_clock.add(amount_of_tuples, read_clock(amount_of_tuples, ingest, checksum));
+    }
+    system_clock.print("system_clock", amount_of_tuples, "reads");
+    ingest_clock.print("IngestClock", amount_of_tuples, "reads");
+
+    // Keeps the writes from being optimized away.
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
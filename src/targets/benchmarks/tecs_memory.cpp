@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/enumeration/tecs/complex_event.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/union_list.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+/**
+ * Measures the memory and the speed of the tECS under wide time windows. The
+ * tECS is built as the evaluator builds the one of SELECT * WHERE SELL+
+ * under skip till any match: every event creates a bottom node, the union
+ * of the runs so far and the output that extends them, so the nodes of the
+ * whole window are alive. The first complex events of every output are
+ * enumerated, and the nodes that leave the window are recycled. Once the
+ * stream ends the runs are released and the pools are compacted, as after
+ * a burst.
+ *
+ * The nodes per GB are the ones of tECS::Node, which links its children by
+ * 32-bit ids, and of the previous node with pointers and the whole tuple.
+ *
+ * Usage: benchmark_tecs_memory [events per window] [windows] [repetitions]
+ */
+
+using namespace CORE::Internal;
+
+namespace {
+const uint64_t COMPLEX_EVENTS_PER_OUTPUT = 16;
+const uint64_t BYTES_PER_GB = uint64_t{1} << 30;
+
+// The layout of tECS::Node before the ids, kept to compare their sizes.
+struct PointerNode {
+  uint8_t node_type;
+  PointerNode* left;
+  RingTupleQueue::Tuple tuple;
+  uint64_t ref_count;
+  PointerNode* time_list_left;
+  PointerNode* time_list_right;
+  uint64_t maximum_start;
+  uint64_t timestamp;
+};
+
+struct Result {
+  uint64_t nodes_allocated = 0;
+  uint64_t bytes_released = 0;
+  uint64_t complex_events = 0;
+  uint64_t checksum = 0;
+};
+
+Result run(uint64_t window, uint64_t events) {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{100'000, &schemas};
+  schemas.add_schema({RingTupleQueue::SupportedTypes::INT64});
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS::tECS tecs{event_time_of_expiration};
+  Result result;
+  tECS::UnionList runs;
+  for (uint64_t pos = 1; pos <= events; pos++) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = pos;
+    RingTupleQueue::Tuple tuple = queue.get_tuple(data);
+    uint64_t oldest_start = pos > window ? pos - window : 0;
+    event_time_of_expiration = oldest_start;
+
+    tECS::UnionList new_runs = tecs.new_ulist(tecs.new_bottom(tuple, pos));
+    if (!runs.empty()) {
+      tecs.remove_nodes_out_of_time(runs, oldest_start);
+      tECS::Node* output = tecs.new_extend(tecs.merge(runs), tuple, pos);
+      new_runs = tecs.insert(std::move(new_runs), output);
+      tecs.pin(output);
+      tECS::Enumerator enumerator(output,
+                                  pos,
+                                  window,
+                                  tecs,
+                                  tecs.time_reservator,
+                                  COMPLEX_EVENTS_PER_OUTPUT);
+      for (tECS::ComplexEvent complex_event : enumerator) {
+        result.complex_events++;
+        result.checksum += complex_event.start + complex_event.event_tuples.size();
+      }
+    }
+    tecs.unpin(runs);
+    runs = std::move(new_runs);
+  }
+  tecs.unpin(runs);
+  result.nodes_allocated = tecs.amount_of_nodes_allocated();
+  result.bytes_released = tecs.compact();
+  return result;
+}
+
+void benchmark(uint64_t window, uint64_t repetitions) {
+  uint64_t events = 4 * window;
+  Result result;
+  double best = 0;
+  for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+    auto start = std::chrono::steady_clock::now();
+    result = run(window, events);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                   - start)
+                       .count();
+    best = repetition == 0 ? seconds : std::min(best, seconds);
+  }
+  std::cout << "Window of " << window << " events: " << result.nodes_allocated
+            << " nodes allocated, "
+            << result.nodes_allocated * sizeof(tECS::Node) / (1 << 20) << " MB ("
+            << result.bytes_released / (1 << 20) << " MB released after it), "
+            << static_cast<uint64_t>(events / best) << " events/s, "
+            << result.complex_events << " complex events (" << result.checksum << ")"
+            << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 4) {
+    std::cout << "Usage: " << argv[0] << " [events per window] [windows] [repetitions]"
+              << std::endl;
+    return 1;
+  }
+  uint64_t smallest_window = argc >= 2 ? std::stoull(argv[1]) : 10'000;
+  uint64_t windows = argc >= 3 ? std::stoull(argv[2]) : 3;
+  uint64_t repetitions = argc == 4 ? std::stoull(argv[3]) : 3;
+
+  try {
+    std::cout << "tECS::Node: " << sizeof(tECS::Node) << " bytes, "
+              << BYTES_PER_GB / sizeof(tECS::Node) << " nodes/GB" << std::endl;
+    std::cout << "Node with pointers: " << sizeof(PointerNode) << " bytes, "
+              << BYTES_PER_GB / sizeof(PointerNode) << " nodes/GB" << std::endl;
+    for (uint64_t window = smallest_window, i = 0; i < windows; window *= 10, i++) {
+      benchmark(window, repetitions);
+    }
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/union_list.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+/**
+ * Measures the union lists of the tECS under a wide time window, comparing
+ * tECS::UnionList with the previous lists, which were searched linearly on
+ * insert and created every union node again on each merge. Every event the
+ * nodes that left the window are removed from the end of the list, a node
+ * is inserted, and the list is merged as many times as the evaluator merges
+ * the list of a state that is kept between events (the marked transition and
+ * the output). The first node of the list is never removed, the others have
+ * a maximum start in the window:
+ *
+ *  - random: the node inserted has a random maximum start in the window.
+ *  - sparse: the same, but a node is inserted once every 16 events.
+ *  - newest: the node inserted has the latest maximum start, so it goes
+ *    right after the first node and no union of the list can be kept.
+ *
+ * Usage: benchmark_union_list [window] [events] [repetitions]
+ */
+
+using namespace CORE::Internal;
+
+namespace {
+const uint64_t MERGES_PER_EVENT = 2;
+
+struct Scenario {
+  std::string name;
+  uint64_t insert_every;
+  bool insert_newest;
+};
+
+struct Result {
+  uint64_t nodes_created = 0;
+  uint64_t final_size = 0;
+  uint64_t checksum = 0;
+};
+
+struct Workload {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{100'000, &schemas};
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS::tECS tecs{event_time_of_expiration};
+
+  Workload() { schemas.add_schema({RingTupleQueue::SupportedTypes::INT64}); }
+
+  RingTupleQueue::Tuple new_tuple(uint64_t pos) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = pos;
+    return queue.get_tuple(data);
+  }
+
+  // New nodes of the memory pools and recycled ones.
+  uint64_t nodes_created() const {
+    return tecs.amount_of_nodes_used() + tecs.amount_of_nodes_recycled();
+  }
+
+  // The merged node is handed to a new output node, which is then dropped.
+  void use_merged_node(tECS::Node* merged, uint64_t pos, Result& result) {
+    RingTupleQueue::Tuple tuple = new_tuple(pos);
+    tECS::Node* output = tecs.new_extend(merged, tuple, pos);
+    result.checksum += merged->max();
+    tecs.pin(output);
+    tecs.unpin(output);
+  }
+};
+
+// The maximum start of the node inserted at pos, or 0 if none is inserted.
+uint64_t max_of_inserted_node(const Scenario& scenario,
+                              uint64_t window,
+                              uint64_t pos,
+                              std::mt19937_64& random) {
+  if (pos % scenario.insert_every != 0) {
+    return 0;
+  }
+  if (scenario.insert_newest) {
+    return pos;
+  }
+  uint64_t oldest = pos > window ? pos - window + 1 : 1;
+  return oldest + random() % (pos - oldest + 1);
+}
+
+Result run_union_list(const Scenario& scenario, uint64_t window, uint64_t events) {
+  Workload workload;
+  tECS::tECS& tecs = workload.tecs;
+  Result result;
+  std::mt19937_64 random(window);
+  RingTupleQueue::Tuple first_tuple = workload.new_tuple(0);
+  tECS::UnionList ulist = tecs.new_ulist(tecs.new_bottom(first_tuple, events + 1));
+  uint64_t starting_nodes = workload.nodes_created();
+  for (uint64_t pos = 1; pos <= events; pos++) {
+    if (pos > window) {
+      workload.event_time_of_expiration = pos - window + 1;
+      tecs.remove_nodes_out_of_time(ulist, pos - window + 1);
+    }
+    if (uint64_t max = max_of_inserted_node(scenario, window, pos, random)) {
+      RingTupleQueue::Tuple tuple = workload.new_tuple(pos);
+      ulist = tecs.insert(std::move(ulist), tecs.new_bottom(tuple, max));
+    }
+    for (uint64_t merge = 0; merge < MERGES_PER_EVENT; merge++) {
+      workload.use_merged_node(tecs.merge(ulist), pos, result);
+    }
+  }
+  result.nodes_created = workload.nodes_created() - starting_nodes;
+  result.final_size = ulist.size();
+  tecs.unpin(ulist);
+  return result;
+}
+
+// The union lists before the memoized merge, kept as the baseline.
+Result run_baseline(const Scenario& scenario, uint64_t window, uint64_t events) {
+  Workload workload;
+  tECS::tECS& tecs = workload.tecs;
+  Result result;
+  std::mt19937_64 random(window);
+  RingTupleQueue::Tuple first_tuple = workload.new_tuple(0);
+  std::vector<tECS::Node*> ulist = {tecs.new_bottom(first_tuple, events + 1)};
+  tecs.pin(ulist[0]);
+  uint64_t starting_nodes = workload.nodes_created();
+  for (uint64_t pos = 1; pos <= events; pos++) {
+    if (pos > window) {
+      workload.event_time_of_expiration = pos - window + 1;
+      for (auto it = ulist.begin(); it != ulist.end();) {
+        if ((*it)->max() < pos - window + 1) {
+          tecs.unpin(*it);
+          it = ulist.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    if (uint64_t max = max_of_inserted_node(scenario, window, pos, random)) {
+      RingTupleQueue::Tuple tuple = workload.new_tuple(pos);
+      tECS::Node* node = tecs.new_bottom(tuple, max);
+      uint64_t i = 1;
+      while (i < ulist.size() && ulist[i]->max() > max) {
+        i++;
+      }
+      if (i < ulist.size() && ulist[i]->max() == max) {
+        tECS::Node* union_node = tecs.new_union(ulist[i], node);
+        tecs.pin(union_node);
+        tecs.unpin(ulist[i]);
+        ulist[i] = union_node;
+      } else {
+        tecs.pin(node);
+        ulist.insert(ulist.begin() + i, node);
+      }
+    }
+    for (uint64_t merge = 0; merge < MERGES_PER_EVENT; merge++) {
+      tECS::Node* tail = ulist.back();
+      for (auto it = ulist.rbegin() + 1; it != ulist.rend(); ++it) {
+        tail = tecs.new_direct_union(*it, tail);
+      }
+      workload.use_merged_node(tail, pos, result);
+    }
+  }
+  result.nodes_created = workload.nodes_created() - starting_nodes;
+  result.final_size = ulist.size();
+  for (tECS::Node* node : ulist) {
+    tecs.unpin(node);
+  }
+  return result;
+}
+
+template <typename Function>
+double best_seconds(uint64_t repetitions, Function&& function) {
+  double best = 0;
+  for (uint64_t repetition = 0; repetition < repetitions; repetition++) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                   - start)
+                       .count();
+    best = repetition == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+void benchmark(const Scenario& scenario,
+               uint64_t window,
+               uint64_t events,
+               uint64_t repetitions) {
+  Result result;
+  double seconds = best_seconds(repetitions, [&]() {
+    result = run_union_list(scenario, window, events);
+  });
+  Result baseline_result;
+  double baseline_seconds = best_seconds(repetitions, [&]() {
+    baseline_result = run_baseline(scenario, window, events);
+  });
+  if (result.final_size != baseline_result.final_size
+      || result.checksum != baseline_result.checksum) {
+    throw std::runtime_error("The union lists of " + scenario.name + " do not match.");
+  }
+  std::cout << scenario.name << ": " << result.final_size << " nodes in the list"
+            << std::endl;
+  std::cout << "UnionList, " << scenario.name << ": "
+            << static_cast<double>(result.nodes_created) / events << " nodes/event, "
+            << static_cast<uint64_t>(events / seconds) << " events/s" << std::endl;
+  std::cout << "Baseline, " << scenario.name << ": "
+            << static_cast<double>(baseline_result.nodes_created) / events
+            << " nodes/event, " << static_cast<uint64_t>(events / baseline_seconds)
+            << " events/s" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 4) {
+    std::cout << "Usage: " << argv[0] << " [window] [events] [repetitions]"
+              << std::endl;
+    return 1;
+  }
+  uint64_t window = argc >= 2 ? std::stoull(argv[1]) : 1000;
+  uint64_t events = argc >= 3 ? std::stoull(argv[2]) : 20'000;
+  uint64_t repetitions = argc == 4 ? std::stoull(argv[3]) : 5;
+
+  try {
+    for (const Scenario& scenario : {Scenario{"random", 1, false},
+                                     Scenario{"sparse", 16, false},
+                                     Scenario{"newest", 1, true}}) {
+      benchmark(scenario, window, events, repetitions);
+    }
+    return 0;
+  } catch (std::exception& e) {
+    std::cout << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -1,22 +1,25 @@
+#include <cstdint>
 #include <exception>
 #include <iostream>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <tracy/Tracy.hpp>
 #include <utility>
-#include <vector>
 
 #include "core_client/client.hpp"
 #include "core_server/library/server.hpp"
+#include "shared/csv_reader/csv_reader_settings.hpp"
+#include "shared/csv_reader/mapped_csv_reader.hpp"
 #include "shared/datatypes/aliases/port_number.hpp"
 #include "shared/datatypes/catalog/stream_info.hpp"
-#include "shared/datatypes/event.hpp"
 
 using namespace CORE;
 
 int main(int argc, char** argv) {
-  if (argc != 4) {
-    std::cout << "There must be 3 arguments: The query path and the data path."
+  if (argc != 4 && argc != 5) {
+    std::cout << "There must be 3 or 4 arguments: The query path, the declaration "
+                 "path, the data path and optionally the amount of parser threads."
               << std::endl;
     return 1;
   }
@@ -24,6 +27,10 @@ int main(int argc, char** argv) {
   std::string query_path = argv[1];
   std::string declaration_path = argv[2];
   std::string data_path = argv[3];
+  Internal::CSVReaderSettings csv_reader_settings;
+  if (argc == 5) {
+    csv_reader_settings.parser_threads = std::stoull(argv[4]);
+  }
 
   FrameMark;
   try {
@@ -39,16 +46,14 @@ int main(int argc, char** argv) {
     std::cout << "Query: " << query_string << std::endl;
 
     client.add_query(std::move(query_string));
-    std::vector<Types::Event> events = stream_info.get_events_from_csv(data_path);
 
-    std::cout << "Read events " << events.size() << std::endl;
-    FrameMark;
+    // The events are sent while the rest of the file is read.
+    Internal::MappedCSVReader reader(stream_info, data_path, csv_reader_settings);
+    uint64_t amount_of_events = reader.read_frames(
+      [&](std::string_view frame) { server.receive_flat_stream(frame); });
 
-    // for (Types::Event event_to_send : reader.events) {
-    //   ZoneScopedN("main::send_event");
-    //   server.receive_stream({0, {event_to_send}});
-    // }
-    server.receive_stream({0, std::move(events)});
+    std::cout << "Read events " << amount_of_events << std::endl;
+    FrameMark;
 
     return 0;
   } catch (std::exception& e) {
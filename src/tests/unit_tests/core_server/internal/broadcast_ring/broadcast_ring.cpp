@@ -0,0 +1,117 @@
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace CORE::Internal::Stream::UnitTests {
+
+TEST_CASE("BroadcastRing delivers every value to every reader", "BroadcastRing") {
+  BroadcastRing<uint64_t> ring(4);
+  auto first = ring.subscribe();
+  auto second = ring.subscribe();
+
+  for (uint64_t i = 0; i < 3; i++) {
+    ring.push(i);
+  }
+  for (uint64_t i = 0; i < 3; i++) {
+    REQUIRE(ring.next(first) == i);
+  }
+  REQUIRE(ring.next(second) == 0);
+
+  SECTION("Readers subscribed later only see the new values") {
+    auto third = ring.subscribe();
+    ring.push(3);
+    REQUIRE(ring.next(third) == 3);
+    REQUIRE(ring.next(first) == 3);
+  }
+
+  SECTION("Unsubscribed readers receive nothing") {
+    ring.unsubscribe(second);
+    REQUIRE(ring.next(second) == std::nullopt);
+    // An unsubscribed reader does not hold back the producer.
+    for (uint64_t i = 3; i < 7; i++) {
+      ring.push(i);
+      REQUIRE(ring.next(first) == i);
+    }
+  }
+}
+
+TEST_CASE("BroadcastRing readers on other threads see the values in order",
+          "BroadcastRing") {
+  const uint64_t amount_of_values = 100'000;
+  const size_t amount_of_readers = 4;
+  BroadcastRing<uint64_t> ring(64);
+
+  std::vector<uint64_t> sums(amount_of_readers, 0);
+  std::vector<uint64_t> out_of_order(amount_of_readers, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    auto reader = ring.subscribe();
+    threads.emplace_back([&, i, reader]() {
+      uint64_t expected = 0;
+      while (std::optional<uint64_t> value = ring.next(reader)) {
+        out_of_order[i] += value.value() != expected++;
+        sums[i] += value.value();
+      }
+    });
+  }
+
+  for (uint64_t i = 0; i < amount_of_values; i++) {
+    ring.push(i);
+  }
+  ring.wait_until_consumed();
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    ring.unsubscribe(i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    REQUIRE(out_of_order[i] == 0);
+    REQUIRE(sums[i] == amount_of_values * (amount_of_values - 1) / 2);
+  }
+}
+
+TEST_CASE("BroadcastRing readers can subscribe while the producer pushes",
+          "BroadcastRing") {
+  const uint64_t amount_of_values = 200'000;
+  const size_t amount_of_readers = 16;
+  BroadcastRing<uint64_t> ring(4);
+
+  std::thread producer([&]() {
+    for (uint64_t i = 0; i < amount_of_values; i++) {
+      ring.push(i);
+    }
+  });
+  // Every value is its sequence, so reading an overwritten slot is out of order.
+  std::vector<uint64_t> out_of_order(amount_of_readers, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    auto reader = ring.subscribe();
+    uint64_t first_sequence = ring.read_sequence_of(reader);
+    threads.emplace_back([&, i, reader, first_sequence]() {
+      uint64_t expected = first_sequence;
+      while (std::optional<uint64_t> value = ring.next(reader)) {
+        out_of_order[i] += value.value() != expected++;
+      }
+    });
+  }
+
+  producer.join();
+  ring.wait_until_consumed();
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    ring.unsubscribe(i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < amount_of_readers; i++) {
+    REQUIRE(out_of_order[i] == 0);
+  }
+}
+}  // namespace CORE::Internal::Stream::UnitTests
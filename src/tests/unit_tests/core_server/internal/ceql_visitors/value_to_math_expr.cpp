@@ -17,6 +17,11 @@
 #include "core_server/internal/ceql/value/operations/modulo.hpp"
 #include "core_server/internal/ceql/value/operations/multiplication.hpp"
 #include "core_server/internal/ceql/value/operations/subtraction.hpp"
+#include "core_server/internal/ceql/value/visitors/weakly_typed_value_to_math_expr.hpp"
+#include "core_server/internal/coordination/catalog.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_instruction.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_program_builder.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
 #include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
 #include "shared/datatypes/catalog/attribute_info.hpp"
@@ -114,4 +119,52 @@ TEST_CASE("Single functionality testing of Value to MathExpr", "[ValueToMathExpr
     REQUIRE(math_expr->eval(tuple) == 6);
   }
 }
+
+TEST_CASE("Weakly typed attributes read the offsets of every event type",
+          "[ValueToMathExpr]") {
+  Catalog catalog;
+  // The price is after a string in A and first in B, with a different type.
+  Types::StreamInfo stream_info = catalog.add_stream_type(
+    {"S",
+     {{"A",
+       {{"name", Types::ValueTypes::STRING_VIEW}, {"price", Types::ValueTypes::INT64}}},
+      {"B", {{"price", Types::ValueTypes::DOUBLE}}}}});
+  QueryCatalog query_catalog(catalog);
+
+  Queue queue(100, &catalog.tuple_schemas);
+  uint64_t* data = queue.start_tuple(0);
+  char* chars = queue.writer<std::string>(4);
+  memcpy(chars, "MSFT", 4);
+  *queue.writer<int64_t>() = 7;
+  Tuple a = queue.get_tuple(data);
+  data = queue.start_tuple(1);
+  *queue.writer<double>() = 2.5;
+  Tuple b = queue.get_tuple(data);
+
+  WeaklyTypedValueToMathExpr<double> visitor(query_catalog);
+  Attribute price("price");
+  price.accept_visitor(visitor);
+  auto math_expr = std::move(visitor.math_expr);
+  REQUIRE(math_expr->eval(a) == 7.0);
+  REQUIRE(math_expr->eval(b) == 2.5);
+  REQUIRE(math_expr->clone()->eval(a) == 7.0);
+
+  SECTION("A program of an event type loads the attribute") {
+    Evaluation::PredicateProgramBuilder builder(0, a.get_relative_positions());
+    uint32_t reg = math_expr->compile(builder);
+    Evaluation::PredicateCode code = std::move(builder).build();
+    REQUIRE(code.instructions.size() == 1);
+    REQUIRE(code.instructions[0].op == Evaluation::PredicateOpCode::LOAD_AT_OFFSET);
+    REQUIRE(code.instructions[0].left == 4);
+    REQUIRE(code.instructions[0].dest == reg);
+  }
+
+  SECTION("A program of every event type calls eval") {
+    Evaluation::PredicateProgramBuilder builder;
+    math_expr->compile(builder);
+    Evaluation::PredicateCode code = std::move(builder).build();
+    REQUIRE(code.instructions.size() == 1);
+    REQUIRE(code.instructions[0].op == Evaluation::PredicateOpCode::CALL_MATH_EXPR);
+  }
+}
 }  // namespace CORE::Internal::CEQL::UnitTests
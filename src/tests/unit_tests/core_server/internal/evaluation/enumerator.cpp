@@ -0,0 +1,144 @@
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/enumeration/tecs/complex_event.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/union_list.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/value.hpp"
+
+namespace CORE::Internal::tECS::UnitTests {
+
+using Output = std::pair<uint64_t, std::vector<int64_t>>;
+
+struct SubsetsDAG {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{1000, &schemas};
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS tecs{event_time_of_expiration};
+  // Node of the subsets that end in each position, sorted by decreasing max.
+  std::vector<Node*> ulist = {};
+
+  SubsetsDAG() { schemas.add_schema({RingTupleQueue::SupportedTypes::INT64}); }
+
+  /**
+   * Adds the tuple in position pos, the node returned outputs every subset of
+   * the positions so far that contains pos, starting at its minimum.
+   */
+  Node* add(uint64_t pos) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = pos;
+    RingTupleQueue::Tuple tuple = queue.get_tuple(data);
+    UnionList predecessors = tecs.new_ulist(tecs.new_bottom(tuple, pos));
+    for (Node* node : ulist) {
+      predecessors = tecs.insert(std::move(predecessors), node);
+    }
+    Node* node = tecs.new_extend(tecs.merge(predecessors), tuple, pos);
+    ulist.insert(ulist.begin(), node);
+    tecs.pin(node);
+    return node;
+  }
+};
+
+std::vector<Output> enumerate(Enumerator& enumerator) {
+  std::vector<Output> outputs;
+  for (ComplexEvent complex_event : enumerator) {
+    std::vector<int64_t> positions;
+    for (RingTupleQueue::Tuple& tuple : complex_event.event_tuples) {
+      positions.push_back(RingTupleQueue::Value<int64_t>(tuple[0]).get());
+    }
+    outputs.push_back({complex_event.start, positions});
+  }
+  std::sort(outputs.begin(), outputs.end());
+  return outputs;
+}
+
+TEST_CASE("Enumerator outputs every branch of the union nodes", "[tECS]") {
+  SubsetsDAG dag;
+  Node* node = nullptr;
+  for (uint64_t pos = 1; pos <= 4; pos++) {
+    node = dag.add(pos);
+  }
+  dag.tecs.pin(node);
+  Enumerator enumerator(node, 4, 100, dag.tecs, dag.tecs.time_reservator, -1);
+
+  std::vector<Output> expected = {{1, {1, 2, 3, 4}},
+                                  {1, {1, 2, 4}},
+                                  {1, {1, 3, 4}},
+                                  {1, {1, 4}},
+                                  {2, {2, 3, 4}},
+                                  {2, {2, 4}},
+                                  {3, {3, 4}},
+                                  {4, {4}}};
+  std::sort(expected.begin(), expected.end());
+  REQUIRE(enumerate(enumerator) == expected);
+
+  SECTION("The enumeration can be restarted") {
+    enumerator.reset();
+    REQUIRE(enumerate(enumerator) == expected);
+  }
+}
+
+TEST_CASE("Enumerator skips the branches out of the time window", "[tECS]") {
+  SubsetsDAG dag;
+  Node* node = nullptr;
+  for (uint64_t pos = 1; pos <= 4; pos++) {
+    node = dag.add(pos);
+  }
+  dag.tecs.pin(node);
+  Enumerator enumerator(node, 4, 1, dag.tecs, dag.tecs.time_reservator, -1);
+
+  std::vector<Output> expected = {{3, {3, 4}}, {4, {4}}};
+  REQUIRE(enumerate(enumerator) == expected);
+}
+
+TEST_CASE("Enumerator stops at the enumeration limit", "[tECS]") {
+  SubsetsDAG dag;
+  Node* node = nullptr;
+  for (uint64_t pos = 1; pos <= 10; pos++) {
+    node = dag.add(pos);
+  }
+  dag.tecs.pin(node);
+  Enumerator enumerator(node, 10, 100, dag.tecs, dag.tecs.time_reservator, 5);
+  REQUIRE(enumerate(enumerator).size() == 5);
+  REQUIRE(enumerator.count() == 5);
+}
+
+TEST_CASE("Enumerator counts the complex events it outputs", "[tECS]") {
+  SubsetsDAG dag;
+  Node* node = nullptr;
+  for (uint64_t pos = 1; pos <= 12; pos++) {
+    node = dag.add(pos);
+  }
+  // From the widest, the enumerators of a tECS reserve non decreasing times.
+  for (uint64_t time_window : {100, 11, 5, 1, 0}) {
+    dag.tecs.pin(node);
+    Enumerator enumerator(node, 12, time_window, dag.tecs, dag.tecs.time_reservator, -1);
+    REQUIRE(enumerator.count() == enumerate(enumerator).size());
+  }
+}
+
+TEST_CASE("Enumerator counts more complex events than it could enumerate", "[tECS]") {
+  SubsetsDAG dag;
+  Node* node = nullptr;
+  for (uint64_t pos = 1; pos <= 100; pos++) {
+    node = dag.add(pos);
+  }
+  dag.tecs.pin(node);
+  Enumerator enumerator(node, 100, 100, dag.tecs, dag.tecs.time_reservator, -1);
+  // Every subset of the 99 previous positions, which does not fit in 64 bits.
+  REQUIRE(enumerator.count() == UINT64_MAX);
+
+  dag.tecs.pin(node);
+  Enumerator in_time_window(node, 100, 40, dag.tecs, dag.tecs.time_reservator, -1);
+  REQUIRE(in_time_window.count() == uint64_t(1) << 40);
+}
+}  // namespace CORE::Internal::tECS::UnitTests
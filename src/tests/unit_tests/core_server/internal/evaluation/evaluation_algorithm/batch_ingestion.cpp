@@ -0,0 +1,94 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/ceql/query/query.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+#include "tests/unit_tests/core_server/internal/evaluation/evaluation_algorithm/common.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+TEST_CASE("Evaluation of events sent to the queries in a single batch") {
+  Internal::Interface::Backend<TestResultHandler> backend;
+
+  Types::StreamInfo stream_info = basic_stock_declaration(backend);
+
+  std::string string_query =
+    "SELECT * FROM Stock\n"
+    "WHERE SELL as msft; SELL as intel; SELL as amzn\n"
+    "FILTER msft[name='MSFT'] AND msft[price > 100]\n"
+    "    AND intel[name='INTL']\n"
+    "    AND amzn[name='AMZN'] AND amzn[price < 2000]\n"
+    "CONSUME BY NONE";
+
+  CEQL::Query parsed_query = Parsing::QueryParser::parse_query(string_query);
+
+  std::unique_ptr<TestResultHandler>
+    result_handler_ptr = std::make_unique<TestResultHandler>(
+      QueryCatalog(backend.get_catalog_reference()));
+  TestResultHandler& result_handler = *result_handler_ptr;
+
+  backend.declare_query(std::move(parsed_query), std::move(result_handler_ptr));
+
+  std::vector<Types::Event> events = {
+    {0,
+     {std::make_shared<Types::StringValue>("MSFT"),
+      std::make_shared<Types::IntValue>(101)}},
+    {0,
+     {std::make_shared<Types::StringValue>("MSFT"),
+      std::make_shared<Types::IntValue>(102)}},
+    {0,
+     {std::make_shared<Types::StringValue>("INTL"),
+      std::make_shared<Types::IntValue>(80)}},
+    {1,
+     {std::make_shared<Types::StringValue>("INTL"),
+      std::make_shared<Types::IntValue>(80)}},
+    {0,
+     {std::make_shared<Types::StringValue>("AMZN"),
+      std::make_shared<Types::IntValue>(1900)}}};
+
+  backend.send_events_to_queries(0, events);
+
+  // The query still produces one output per relevant tuple, in order.
+  Types::Enumerator output;
+  for (size_t i = 0; i < events.size() - 1; i++) {
+    INFO("Event " << i);
+    output = result_handler.get_enumerator();
+    REQUIRE(output.complex_events.size() == 0);
+  }
+
+  output = result_handler.get_enumerator();
+  REQUIRE(output.complex_events.size() == 2);
+  REQUIRE(output.complex_events[0].start == 1);
+  REQUIRE(output.complex_events[0].end == 4);
+  REQUIRE(output.complex_events[1].start == 0);
+  REQUIRE(output.complex_events[1].end == 4);
+
+  REQUIRE(output.complex_events[0].events.size() == 3);
+  REQUIRE(is_the_same_as(output.complex_events[0].events[0], 0, "MSFT", 102));
+  REQUIRE(is_the_same_as(output.complex_events[0].events[1], 0, "INTL", 80));
+  REQUIRE(is_the_same_as(output.complex_events[0].events[2], 0, "AMZN", 1900));
+
+  SECTION("An invalid event still sends the events before it") {
+    std::vector<Types::Event> invalid_batch = {
+      {0,
+       {std::make_shared<Types::StringValue>("AMZN"),
+        std::make_shared<Types::IntValue>(1920)}},
+      {0, {std::make_shared<Types::StringValue>("AMZN")}}};
+
+    REQUIRE_THROWS(backend.send_events_to_queries(0, invalid_batch));
+
+    output = result_handler.get_enumerator();
+    REQUIRE(output.complex_events.size() == 2);
+    REQUIRE(is_the_same_as(output.complex_events[0].events[2], 0, "AMZN", 1920));
+  }
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
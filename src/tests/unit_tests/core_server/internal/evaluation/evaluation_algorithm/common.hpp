@@ -35,8 +35,7 @@ class TestResultHandler : public Library::Components::ResultHandler<TestResultHa
   handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
     Types::Enumerator enumerator;
     if (internal_enumerator.has_value()) {
-      enumerator = query_catalog.convert_enumerator(
-        std::move(internal_enumerator.value()));
+      enumerator = convert_enumerator(std::move(internal_enumerator.value()));
     }
     std::unique_lock lk(output_mutex);
 
@@ -0,0 +1,170 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/queries/compiled_query_cache.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/query_stats.hpp"
+#include "shared/datatypes/value.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::QueryCompilationSettings;
+
+namespace {
+const std::string MSFT_THEN_INTL = "SELECT * FROM Stock\n"
+                                   "WHERE SELL as msft; SELL as intel\n"
+                                   "FILTER msft[name='MSFT'] AND intel[name='INTL']\n";
+const std::string WITHIN_10_EVENTS = "WITHIN 10 EVENTS";
+
+class IgnoringResultHandler
+    : public Library::Components::ResultHandler<IgnoringResultHandler> {
+ public:
+  IgnoringResultHandler(const QueryCatalog& query_catalog)
+      : ResultHandler(query_catalog) {}
+
+  void handle_complex_event(std::optional<Internal::tECS::Enumerator>&&) {}
+
+  void start_impl() {}
+};
+
+using Backend = Interface::Backend<IgnoringResultHandler>;
+
+void add_stock_stream(Backend& backend) {
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"part", Types::ValueTypes::INT64}}}}});
+}
+
+void declare_query(Backend& backend, std::string query) {
+  backend.declare_query(query,
+                        std::make_unique<IgnoringResultHandler>(
+                          QueryCatalog(backend.get_catalog_reference())));
+}
+
+// The names alternate between MSFT and INTL, so every INTL has an output.
+void send_events(Backend& backend, size_t amount_of_events) {
+  std::vector<Types::Event> events;
+  for (size_t i = 0; i < amount_of_events; i++) {
+    events.push_back({0,
+                      {std::make_shared<Types::StringValue>(i % 2 == 0 ? "MSFT" : "INTL"),
+                       std::make_shared<Types::IntValue>(i % 3)}});
+  }
+  backend.send_events_to_queries(0, events);
+  backend.wait_until_processed();
+}
+}  // namespace
+
+TEST_CASE("Query texts are normalized without whitespace and comments") {
+  using Interface::normalize_query_text;
+  REQUIRE(normalize_query_text("  SELECT *\n\tFROM   S  ") == "SELECT * FROM S");
+  REQUIRE(normalize_query_text("SELECT * -- all of them\nFROM S")
+          == normalize_query_text("SELECT * /* all\nof them */ FROM S"));
+  REQUIRE(normalize_query_text("FILTER a[name = 'x  y']")
+          == "FILTER a[name = 'x  y']");
+  REQUIRE(normalize_query_text("FILTER a[name = 'it''s  -- ok']")
+          == "FILTER a[name = 'it''s  -- ok']");
+  REQUIRE(normalize_query_text("FROM `my  stream`") == "FROM `my  stream`");
+  REQUIRE(normalize_query_text("FILTER a[x > 1]")
+          != normalize_query_text("FILTER a[x > 2]"));
+}
+
+TEST_CASE("Regexes are kept verbatim in the normalized query texts") {
+  using Interface::normalize_query_text;
+  REQUIRE(normalize_query_text("FILTER a[name LIKE <<a  b>>]")
+          != normalize_query_text("FILTER a[name LIKE <<a b>>]"));
+  REQUIRE(normalize_query_text("FILTER a[name LIKE <<x--  y>>]")
+          == "FILTER a[name LIKE <<x--  y>>]");
+  REQUIRE(normalize_query_text("FILTER a[name LIKE <<'  /*>>] -- '*/")
+          == "FILTER a[name LIKE <<'  /*>>]");
+  // The regex does not end at an escaped >.
+  REQUIRE(normalize_query_text("FILTER a[name LIKE <<a\\>>  b>>]  ")
+          == "FILTER a[name LIKE <<a\\>>  b>>]");
+}
+
+TEST_CASE("The compiled query cache keeps the most recently used queries") {
+  Backend backend({}, {}, QueryCompilationSettings{.compiled_query_cache_size = 2});
+  add_stock_stream(backend);
+  std::string other_query = MSFT_THEN_INTL;
+  other_query.replace(other_query.find("INTL"), 4, "AAPL");
+  auto compiled_query = backend.compile_query(MSFT_THEN_INTL);
+  auto other_compiled_query = backend.compile_query(other_query);
+  REQUIRE(backend.compile_query(MSFT_THEN_INTL) == compiled_query);
+
+  // The other query is the least recently used.
+  backend.compile_query(MSFT_THEN_INTL + WITHIN_10_EVENTS);
+  REQUIRE(backend.get_compiled_query_cache().size() == 2);
+  REQUIRE(backend.compile_query(MSFT_THEN_INTL) == compiled_query);
+  REQUIRE(backend.compile_query(other_query) != other_compiled_query);
+}
+
+TEST_CASE("Queries with the same text reuse their compilation") {
+  Backend backend;
+  add_stock_stream(backend);
+  auto compiled_query = backend.compile_query(MSFT_THEN_INTL);
+  REQUIRE(backend.compile_query("  " + MSFT_THEN_INTL + "-- again\n") == compiled_query);
+  REQUIRE(backend.get_compiled_query_cache().get_amount_of_hits() == 1);
+
+  SECTION("Other constants are another query") {
+    std::string other_query = MSFT_THEN_INTL;
+    other_query.replace(other_query.find("INTL"), 4, "AAPL");
+    REQUIRE(backend.compile_query(other_query) != compiled_query);
+    REQUIRE(backend.get_compiled_query_cache().size() == 2);
+  }
+
+  SECTION("A change of the catalog compiles the query again") {
+    backend.add_stream_type({"Other", {{"BUY", {{"name", Types::ValueTypes::INT64}}}}});
+    REQUIRE(backend.compile_query(MSFT_THEN_INTL) != compiled_query);
+    REQUIRE(backend.get_compiled_query_cache().size() == 1);
+  }
+
+  SECTION("The queries that share a compilation evaluate on their own") {
+    declare_query(backend, MSFT_THEN_INTL + WITHIN_10_EVENTS);
+    declare_query(backend, MSFT_THEN_INTL + WITHIN_10_EVENTS);
+    send_events(backend, 100);
+    Types::ServerStats stats = backend.get_query_stats();
+    REQUIRE(stats.queries.size() == 2);
+    REQUIRE(stats.queries[0].matches_emitted == 50);
+    REQUIRE(stats.queries[1].matches_emitted == 50);
+  }
+}
+
+TEST_CASE("The automaton of a query can be determinized before the first event") {
+  for (uint64_t eager_det_cea_states : {0, 2, 64}) {
+    INFO("Eager states: " + std::to_string(eager_det_cea_states));
+    Backend backend({}, {}, QueryCompilationSettings{.eager_det_cea_states
+                                                     = eager_det_cea_states});
+    add_stock_stream(backend);
+    declare_query(backend, MSFT_THEN_INTL + WITHIN_10_EVENTS);
+    declare_query(backend, MSFT_THEN_INTL + "PARTITION BY [part]\n" + WITHIN_10_EVENTS);
+
+    for (size_t query_idx : {0, 1}) {
+      Interface::QueryStatistics statistics = backend.get_query_statistics(query_idx);
+      if (eager_det_cea_states == 0) {
+        REQUIRE(statistics.det_cea_states == 1);
+      } else {
+        // A transition can create one state more than the bound.
+        REQUIRE(statistics.det_cea_states > 1);
+        REQUIRE(statistics.det_cea_states <= eager_det_cea_states + 1);
+      }
+    }
+
+    send_events(backend, 100);
+    Types::ServerStats stats = backend.get_query_stats();
+    REQUIRE(stats.queries[0].matches_emitted == 50);
+    REQUIRE(stats.queries[1].matches_emitted > 0);
+  }
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
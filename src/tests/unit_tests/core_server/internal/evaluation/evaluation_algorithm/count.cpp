@@ -0,0 +1,53 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+#include "tests/unit_tests/core_server/internal/evaluation/evaluation_algorithm/common.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+
+TEST_CASE("COUNT(*) outputs the amount of complex events that * outputs") {
+  for (std::string clauses : {"WITHIN 4 EVENTS", "WITHIN 100 EVENTS", "LIMIT 3"}) {
+    INFO("Clauses: " + clauses);
+    Internal::Interface::Backend<TestResultHandler> backend;
+    basic_stock_declaration(backend);
+
+    auto declare = [&](std::string selection) -> TestResultHandler& {
+      std::string query = "SELECT " + selection + " FROM Stock\n"
+                          + "WHERE SELL as msft; SELL+ as intel\n"
+                          + "FILTER msft[name='MSFT'] AND intel[name='INTL']\n"
+                          + clauses;
+      auto result_handler = std::make_unique<TestResultHandler>(
+        QueryCatalog(backend.get_catalog_reference()));
+      TestResultHandler& result_handler_reference = *result_handler;
+      backend.declare_query(Parsing::QueryParser::parse_query(query),
+                            std::move(result_handler));
+      return result_handler_reference;
+    };
+    TestResultHandler& complex_events = declare("*");
+    TestResultHandler& count = declare("COUNT(*)");
+
+    for (int64_t price = 0; price < 12; price++) {
+      INFO("Event " + std::to_string(price));
+      std::string name = price % 4 == 0 ? "MSFT" : "INTL";
+      Types::Event event = {0,
+                            {std::make_shared<Types::StringValue>(name),
+                             std::make_shared<Types::IntValue>(price)}};
+      backend.send_event_to_queries(0, event);
+      Types::Enumerator output = complex_events.get_enumerator();
+      Types::Enumerator counted = count.get_enumerator();
+      REQUIRE(counted.complex_events.empty());
+      REQUIRE(counted.count.value_or(0) == output.complex_events.size());
+    }
+  }
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
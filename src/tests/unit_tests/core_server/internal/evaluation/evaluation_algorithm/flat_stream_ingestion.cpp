@@ -0,0 +1,83 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core_server/internal/ceql/query/query.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/serializer/flat_stream/flat_stream_builder.hpp"
+#include "tests/unit_tests/core_server/internal/evaluation/evaluation_algorithm/common.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+TEST_CASE("Evaluation of events sent to the queries in a flat stream frame") {
+  Internal::Interface::Backend<TestResultHandler> backend;
+
+  Types::StreamInfo stream_info = basic_stock_declaration(backend);
+
+  std::string string_query =
+    "SELECT * FROM Stock\n"
+    "WHERE SELL as msft; SELL as intel; SELL as amzn\n"
+    "FILTER msft[name='MSFT'] AND msft[price > 100]\n"
+    "    AND intel[name='INTL']\n"
+    "    AND amzn[name='AMZN'] AND amzn[price < 2000]\n"
+    "CONSUME BY NONE";
+
+  CEQL::Query parsed_query = Parsing::QueryParser::parse_query(string_query);
+
+  std::unique_ptr<TestResultHandler>
+    result_handler_ptr = std::make_unique<TestResultHandler>(
+      QueryCatalog(backend.get_catalog_reference()));
+  TestResultHandler& result_handler = *result_handler_ptr;
+
+  backend.declare_query(std::move(parsed_query), std::move(result_handler_ptr));
+
+  FlatStreamBuilder builder(stream_info);
+  builder.add_event(0).add_string("MSFT").add_int(101);
+  builder.add_event(0).add_string("MSFT").add_int(102);
+  builder.add_event(0).add_string("INTL").add_int(80);
+  builder.add_event(1).add_string("INTL").add_int(80);
+  builder.add_event(0).add_string("AMZN").add_int(1900);
+  uint64_t amount_of_events = builder.size();
+
+  backend.send_flat_stream_to_queries(builder.build());
+
+  Types::Enumerator output;
+  for (size_t i = 0; i < amount_of_events - 1; i++) {
+    INFO("Event " << i);
+    output = result_handler.get_enumerator();
+    REQUIRE(output.complex_events.size() == 0);
+  }
+
+  output = result_handler.get_enumerator();
+  REQUIRE(output.complex_events.size() == 2);
+  REQUIRE(output.complex_events[0].start == 1);
+  REQUIRE(output.complex_events[0].end == 4);
+  REQUIRE(output.complex_events[1].start == 0);
+  REQUIRE(output.complex_events[1].end == 4);
+
+  REQUIRE(output.complex_events[0].events.size() == 3);
+  REQUIRE(is_the_same_as(output.complex_events[0].events[0], 0, "MSFT", 102));
+  REQUIRE(is_the_same_as(output.complex_events[0].events[1], 0, "INTL", 80));
+  REQUIRE(is_the_same_as(output.complex_events[0].events[2], 0, "AMZN", 1900));
+
+  SECTION("A corrupted frame still sends the events before the corruption") {
+    builder.clear();
+    builder.add_event(0).add_string("AMZN").add_int(1920);
+    builder.add_event(0).add_string("AMZN").add_int(1930);
+    std::string frame = builder.build();
+    // Drop the last word of the second event.
+    frame.resize(frame.size() - sizeof(uint64_t));
+
+    REQUIRE_THROWS(backend.send_flat_stream_to_queries(frame));
+
+    output = result_handler.get_enumerator();
+    REQUIRE(output.complex_events.size() == 2);
+    REQUIRE(is_the_same_as(output.complex_events[0].events[2], 0, "AMZN", 1920));
+  }
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
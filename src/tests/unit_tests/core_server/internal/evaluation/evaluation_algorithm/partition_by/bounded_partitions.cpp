@@ -0,0 +1,120 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "core_server/internal/ceql/query/query.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+#include "tests/unit_tests/core_server/internal/evaluation/evaluation_algorithm/common.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::PartitionBySettings;
+using Interface::PartitionByStatistics;
+using Interface::PartitionEvictionPolicy;
+
+namespace {
+std::string bounded_partitions_query() {
+  return "SELECT * FROM Stock\n"
+         "WHERE SELL as msft; SELL as intel; SELL as amzn\n"
+         "FILTER msft[name='MSFT'] AND intel[name='INTL'] AND amzn[name='AMZN']\n"
+         "PARTITION BY [part]\n"
+         "CONSUME BY NONE";
+}
+
+Types::Event sell(std::string name, int64_t part) {
+  return {0,
+          {std::make_shared<Types::StringValue>(name),
+           std::make_shared<Types::IntValue>(100),
+           std::make_shared<Types::IntValue>(part)}};
+}
+
+void declare_partitioned_stock(Interface::Backend<TestResultHandler>& backend) {
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"price", Types::ValueTypes::INT64},
+                              {"part", Types::ValueTypes::INT64}}}}});
+}
+}  // namespace
+
+TEST_CASE("Partition by evicts the least recently used partition when bounded") {
+  Interface::Backend<TestResultHandler> backend(
+    PartitionBySettings{1, PartitionEvictionPolicy::LEAST_RECENTLY_USED});
+  declare_partitioned_stock(backend);
+
+  std::unique_ptr<TestResultHandler>
+    result_handler_ptr = std::make_unique<TestResultHandler>(
+      QueryCatalog(backend.get_catalog_reference()));
+  TestResultHandler& result_handler = *result_handler_ptr;
+  backend.declare_query(Parsing::QueryParser::parse_query(bounded_partitions_query()),
+                        std::move(result_handler_ptr));
+
+  INFO("SELL MSFT - part 0");
+  backend.send_event_to_queries(0, sell("MSFT", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL MSFT - part 1, evicts part 0");
+  backend.send_event_to_queries(0, sell("MSFT", 1));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL INTL - part 0, evicts part 1");
+  backend.send_event_to_queries(0, sell("INTL", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL AMZN - part 0, the MSFT of part 0 was lost");
+  backend.send_event_to_queries(0, sell("AMZN", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  std::optional<PartitionByStatistics> statistics = backend.get_partition_by_statistics(0);
+  REQUIRE(statistics.has_value());
+  REQUIRE(statistics->live_partitions == 1);
+  REQUIRE(statistics->evicted_partitions == 2);
+  REQUIRE(statistics->ignored_tuples == 0);
+  REQUIRE(statistics->pooled_evaluators == 0);
+}
+
+TEST_CASE("Partition by ignores new partitions when bounded") {
+  Interface::Backend<TestResultHandler> backend(
+    PartitionBySettings{1, PartitionEvictionPolicy::IGNORE_NEW_PARTITIONS});
+  declare_partitioned_stock(backend);
+
+  std::unique_ptr<TestResultHandler>
+    result_handler_ptr = std::make_unique<TestResultHandler>(
+      QueryCatalog(backend.get_catalog_reference()));
+  TestResultHandler& result_handler = *result_handler_ptr;
+  backend.declare_query(Parsing::QueryParser::parse_query(bounded_partitions_query()),
+                        std::move(result_handler_ptr));
+
+  INFO("SELL MSFT - part 0");
+  backend.send_event_to_queries(0, sell("MSFT", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL MSFT - part 1, ignored");
+  backend.send_event_to_queries(0, sell("MSFT", 1));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL INTL - part 0");
+  backend.send_event_to_queries(0, sell("INTL", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 0);
+
+  INFO("SELL AMZN - part 0");
+  backend.send_event_to_queries(0, sell("AMZN", 0));
+  REQUIRE(result_handler.get_enumerator().complex_events.size() == 1);
+
+  std::optional<PartitionByStatistics> statistics = backend.get_partition_by_statistics(0);
+  REQUIRE(statistics.has_value());
+  REQUIRE(statistics->live_partitions == 1);
+  REQUIRE(statistics->evicted_partitions == 0);
+  REQUIRE(statistics->ignored_tuples == 1);
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/complex_event.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::PartitionBySettings;
+using Interface::PartitionByStatistics;
+
+namespace {
+// Keeps a description of every output, written by a single thread.
+class RecordingResultHandler
+    : public Library::Components::ResultHandler<RecordingResultHandler> {
+  std::vector<std::string>& outputs;
+
+ public:
+  RecordingResultHandler(const QueryCatalog& query_catalog,
+                         std::vector<std::string>& outputs)
+      : ResultHandler(query_catalog), outputs(outputs) {}
+
+  void
+  handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
+    std::vector<std::string> complex_events;
+    if (internal_enumerator.has_value()) {
+      Types::Enumerator enumerator = query_catalog.convert_enumerator(
+        std::move(internal_enumerator.value()));
+      for (const Types::ComplexEvent& complex_event : enumerator.complex_events) {
+        complex_events.push_back(complex_event.to_string());
+      }
+    }
+    // The enumeration order depends on the tECS, not on the events.
+    std::sort(complex_events.begin(), complex_events.end());
+    std::string out;
+    for (const std::string& complex_event : complex_events) {
+      out += complex_event + "\n";
+    }
+    outputs.push_back(out);
+  }
+
+  void start_impl() {}
+};
+
+std::vector<Types::Event> random_stock_events(size_t amount) {
+  std::mt19937 random(11);
+  std::vector<std::string> names = {"MSFT", "INTL", "AMZN"};
+  std::vector<Types::Event> events;
+  for (size_t i = 0; i < amount; i++) {
+    events.push_back({random() % 4 == 0 ? 1u : 0u,
+                      {std::make_shared<Types::StringValue>(names[random() % 3]),
+                       std::make_shared<Types::IntValue>(random() % 200),
+                       std::make_shared<Types::IntValue>(random() % 5)}});
+  }
+  return events;
+}
+
+struct Run {
+  std::vector<std::string> outputs;
+  PartitionByStatistics statistics;
+};
+
+Run run_query(std::string query, PartitionBySettings settings) {
+  Run run;
+  Interface::Backend<RecordingResultHandler> backend(settings);
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"price", Types::ValueTypes::INT64},
+                              {"part", Types::ValueTypes::INT64}}},
+                            {"BUY",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"price", Types::ValueTypes::INT64},
+                              {"volume", Types::ValueTypes::INT64}}}}});
+  backend.declare_query(Parsing::QueryParser::parse_query(query),
+                        std::make_unique<RecordingResultHandler>(
+                          QueryCatalog(backend.get_catalog_reference()), run.outputs));
+  std::vector<Types::Event> events = random_stock_events(2000);
+  for (size_t i = 0; i < events.size(); i += 100) {
+    backend.send_events_to_queries(0, std::span(events).subspan(i, 100));
+  }
+  backend.wait_until_processed();
+  run.statistics = backend.get_partition_by_statistics(0).value();
+  return run;
+}
+
+void require_same_outputs_with_shards(std::string query) {
+  Run single = run_query(query, {});
+  size_t amount_of_outputs = std::count_if(single.outputs.begin(),
+                                           single.outputs.end(),
+                                           [](const std::string& output) {
+                                             return !output.empty();
+                                           });
+  INFO("Outputs: " + std::to_string(amount_of_outputs));
+  REQUIRE(amount_of_outputs > 0);
+  for (size_t worker_threads : {1, 4}) {
+    INFO("Worker threads: " + std::to_string(worker_threads));
+    Run sharded = run_query(query, {.worker_threads = worker_threads});
+    REQUIRE(sharded.outputs == single.outputs);
+    REQUIRE(sharded.statistics.live_partitions == single.statistics.live_partitions);
+  }
+}
+}  // namespace
+
+TEST_CASE("Sharded partition by outputs the same as a single evaluator") {
+  require_same_outputs_with_shards(
+    "SELECT * FROM Stock\n"
+    "WHERE SELL as msft; SELL as intel; SELL as amzn\n"
+    "FILTER msft[name='MSFT'] AND intel[name='INTL'] AND amzn[name='AMZN']\n"
+    "PARTITION BY [part]\n"
+    "WITHIN 40 EVENTS\n"
+    "CONSUME BY NONE");
+}
+
+TEST_CASE("Sharded partition by resets every shard with consume by any") {
+  require_same_outputs_with_shards(
+    "SELECT * FROM Stock\n"
+    "WHERE SELL as msft; SELL as intel\n"
+    "FILTER msft[name='MSFT'] AND intel[name='INTL']\n"
+    "PARTITION BY [part]\n"
+    "CONSUME BY ANY");
+}
+
+TEST_CASE("Sharded partition by hands empty outputs for tuples with no partition") {
+  // Only SELL has part, every BUY still gets an output.
+  require_same_outputs_with_shards(
+    "SELECT * FROM Stock\n"
+    "WHERE SELL as expensive; SELL as later\n"
+    "FILTER expensive[price > 190]\n"
+    "PARTITION BY [part]\n"
+    "WITHIN 20 EVENTS\n"
+    "CONSUME BY NONE");
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
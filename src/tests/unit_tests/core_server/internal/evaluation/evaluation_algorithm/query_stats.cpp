@@ -0,0 +1,173 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/coordination/catalog.hpp"
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/interface/evaluators/query_counters.hpp"
+#include "core_server/internal/interface/evaluators/query_statistics.hpp"
+#include "core_server/internal/interface/queries/partition_by_query.hpp"
+#include "core_server/internal/interface/queries/result_stage.hpp"
+#include "core_server/internal/interface/queries/simple_query.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/internal/stream/broadcast_ring/broadcast_ring.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/query_stats.hpp"
+#include "shared/datatypes/value.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::PartitionBySettings;
+using Interface::ResultBackpressure;
+using Interface::ResultStageSettings;
+
+namespace {
+const std::string MSFT_THEN_INTL = "SELECT * FROM Stock\n"
+                                   "WHERE SELL as msft; SELL as intel\n"
+                                   "FILTER msft[name='MSFT'] AND intel[name='INTL']\n";
+
+class IgnoringResultHandler
+    : public Library::Components::ResultHandler<IgnoringResultHandler> {
+ public:
+  IgnoringResultHandler(const QueryCatalog& query_catalog)
+      : ResultHandler(query_catalog) {}
+
+  void handle_complex_event(std::optional<Internal::tECS::Enumerator>&&) {}
+
+  void start_impl() {}
+};
+
+// Enough for every shard to sweep its partitions, which publishes the
+// statistics of their automaton and tECS.
+const size_t AMOUNT_OF_EVENTS = 6000;
+
+// The names alternate between MSFT and INTL, so every INTL has an output.
+Types::ServerStats run_query(std::string query,
+                             PartitionBySettings settings = {},
+                             ResultStageSettings result_stage_settings = {}) {
+  Interface::Backend<IgnoringResultHandler> backend(settings,
+                                                    {},
+                                                    {},
+                                                    {},
+                                                    result_stage_settings);
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"part", Types::ValueTypes::INT64}}}}});
+  backend.declare_query(Parsing::QueryParser::parse_query(query),
+                        std::make_unique<IgnoringResultHandler>(
+                          QueryCatalog(backend.get_catalog_reference())));
+  std::vector<Types::Event> events;
+  for (size_t i = 0; i < AMOUNT_OF_EVENTS; i++) {
+    events.push_back({0,
+                      {std::make_shared<Types::StringValue>(i % 2 == 0 ? "MSFT" : "INTL"),
+                       std::make_shared<Types::IntValue>(i % 3)}});
+  }
+  backend.send_events_to_queries(0, events);
+  backend.wait_until_processed();
+  return backend.get_query_stats();
+}
+
+void require_stats_of_every_event(const Types::ServerStats& stats) {
+  REQUIRE(stats.queries.size() == 1);
+  const Types::QueryStats& query = stats.queries[0];
+  REQUIRE(query.events_processed == AMOUNT_OF_EVENTS);
+  REQUIRE(query.latency_histogram.size() == Interface::QUERY_LATENCY_HISTOGRAM_BUCKETS);
+  REQUIRE(std::accumulate(query.latency_histogram.begin(),
+                          query.latency_histogram.end(),
+                          uint64_t(0))
+          == AMOUNT_OF_EVENTS);
+  REQUIRE(query.det_cea_states > 0);
+  REQUIRE(query.tecs_nodes_used > 0);
+  REQUIRE(query.tecs_nodes_allocated >= query.tecs_nodes_used);
+  REQUIRE(query.tecs_live_bytes > 0);
+  REQUIRE(query.tecs_retained_bytes >= query.tecs_live_bytes);
+  REQUIRE(query.det_cea_retained_bytes >= query.det_cea_live_bytes);
+  REQUIRE(query.ingest_watermark > 0);
+  REQUIRE(query.evaluation_nanoseconds > 0);
+  REQUIRE(stats.ring_tuple_queue_bytes_in_use > 0);
+}
+}  // namespace
+
+TEST_CASE("Query stats count the events and matches of a query") {
+  Types::ServerStats stats = run_query(MSFT_THEN_INTL + "WITHIN 10 EVENTS");
+  require_stats_of_every_event(stats);
+  REQUIRE(stats.queries[0].matches_emitted == AMOUNT_OF_EVENTS / 2);
+  REQUIRE(stats.queries[0].live_partitions == 0);
+}
+
+TEST_CASE("Query stats count the events and partitions of a partition by query") {
+  for (size_t worker_threads : {0, 2}) {
+    INFO("Worker threads: " + std::to_string(worker_threads));
+    Types::ServerStats stats = run_query(MSFT_THEN_INTL
+                                           + "PARTITION BY [part]\nWITHIN 10 EVENTS",
+                                         {.worker_threads = worker_threads});
+    require_stats_of_every_event(stats);
+    REQUIRE(stats.queries[0].matches_emitted > 0);
+    REQUIRE(stats.queries[0].live_partitions == 3);
+  }
+}
+
+TEST_CASE("Queries have empty statistics until their evaluator is created") {
+  Catalog catalog;
+  RingTupleQueue::Queue queue(1000, &catalog.tuple_schemas);
+  Stream::BroadcastRing<uint64_t*> tuple_ring;
+  SharedPredicateEvaluator shared_predicate_evaluator(queue, tuple_ring.capacity());
+  auto result_handler = [&]() {
+    return std::make_unique<IgnoringResultHandler>(QueryCatalog(catalog));
+  };
+
+  Interface::SimpleQuery<IgnoringResultHandler> simple_query(QueryCatalog(catalog),
+                                                            queue,
+                                                            tuple_ring,
+                                                            shared_predicate_evaluator,
+                                                            result_handler());
+  REQUIRE(simple_query.get_query_statistics().tecs_nodes_allocated == 0);
+  REQUIRE(simple_query.load_published_statistics().det_cea_states == 0);
+
+  Interface::PartitionByQuery<IgnoringResultHandler> partition_by_query(
+    QueryCatalog(catalog),
+    queue,
+    tuple_ring,
+    shared_predicate_evaluator,
+    result_handler());
+  REQUIRE(partition_by_query.get_partition_by_statistics().live_partitions == 0);
+  REQUIRE(partition_by_query.get_query_statistics().tecs_nodes_allocated == 0);
+  REQUIRE(partition_by_query.load_published_statistics().det_cea_states == 0);
+}
+
+TEST_CASE("Query stats count the outputs handled by a result stage") {
+  for (std::string partition_by : {"", "PARTITION BY [part]\n"}) {
+    std::string query = MSFT_THEN_INTL + partition_by + "WITHIN 10 EVENTS";
+    INFO("Query: " + query);
+    Types::ServerStats stats = run_query(query, {}, {.maximum_pending_outputs = 2});
+    require_stats_of_every_event(stats);
+    REQUIRE(stats.queries[0].matches_emitted > 0);
+    REQUIRE(stats.queries[0].outputs_dropped == 0);
+  }
+}
+
+TEST_CASE("A result stage that drops outputs counts them") {
+  ResultStageSettings result_stage_settings = {
+    .maximum_pending_outputs = 1, .backpressure = ResultBackpressure::DROP_OUTPUTS};
+  Types::ServerStats stats = run_query(MSFT_THEN_INTL + "WITHIN 10 EVENTS",
+                                       {},
+                                       result_stage_settings);
+  require_stats_of_every_event(stats);
+  REQUIRE(stats.queries[0].matches_emitted + stats.queries[0].outputs_dropped
+          == AMOUNT_OF_EVENTS / 2);
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
@@ -0,0 +1,136 @@
+#include "core_server/internal/interface/queries/result_stage.hpp"
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::PartitionBySettings;
+using Interface::ResultBackpressure;
+using Interface::ResultStageSettings;
+
+namespace {
+const std::string MSFT_THEN_INTL = "SELECT * FROM Stock\n"
+                                   "WHERE SELL as msft; SELL as intel\n"
+                                   "FILTER msft[name='MSFT'] AND intel[name='INTL']\n";
+
+/**
+ * Enumerates the complex events of every output, and takes its time with the
+ * ones that have some so the result stage fills up.
+ */
+class SlowResultHandler : public Library::Components::ResultHandler<SlowResultHandler> {
+  std::vector<std::string>& outputs;
+
+ public:
+  SlowResultHandler(const QueryCatalog& query_catalog, std::vector<std::string>& outputs)
+      : ResultHandler(query_catalog), outputs(outputs) {}
+
+  void
+  handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
+    std::string output;
+    if (internal_enumerator.has_value()) {
+      Types::Enumerator enumerator = convert_enumerator(
+        std::move(internal_enumerator.value()));
+      for (const Types::ComplexEvent& complex_event : enumerator) {
+        output += complex_event.to_string() + "\n";
+      }
+    }
+    if (!output.empty()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+    outputs.push_back(std::move(output));
+  }
+
+  void start_impl() {}
+};
+
+const size_t AMOUNT_OF_EVENTS = 2000;
+
+// The complex events of every event, in the order they were handled.
+std::vector<std::string> run_query(std::string query,
+                                   PartitionBySettings settings,
+                                   ResultStageSettings result_stage_settings) {
+  std::vector<std::string> outputs;
+  Interface::Backend<SlowResultHandler> backend(settings,
+                                                {},
+                                                {},
+                                                {},
+                                                result_stage_settings);
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"part", Types::ValueTypes::INT64}}}}});
+  backend.declare_query(Parsing::QueryParser::parse_query(query),
+                        std::make_unique<SlowResultHandler>(
+                          QueryCatalog(backend.get_catalog_reference()), outputs));
+  // Every MSFT is followed by an INTL of the same partition, and the
+  // partitions cycle through 8 values.
+  std::vector<Types::Event> events;
+  for (size_t i = 0; i < AMOUNT_OF_EVENTS; i++) {
+    events.push_back(
+      {0,
+       {std::make_shared<Types::StringValue>(i % 2 == 0 ? "MSFT" : "INTL"),
+        std::make_shared<Types::IntValue>(static_cast<int64_t>((i / 2) % 8))}});
+  }
+  backend.send_events_to_queries(0, events);
+  backend.wait_until_processed();
+  return outputs;
+}
+
+void require_same_outputs_as_inline(std::string query, PartitionBySettings settings) {
+  std::vector<std::string> expected = run_query(query, settings, {});
+  REQUIRE(expected.size() == AMOUNT_OF_EVENTS);
+  size_t amount_of_matches = 0;
+  for (const std::string& output : expected) {
+    amount_of_matches += !output.empty();
+  }
+  REQUIRE(amount_of_matches > 0);
+
+  for (size_t maximum_pending_outputs : {1, 4}) {
+    INFO("Maximum pending outputs: " + std::to_string(maximum_pending_outputs));
+    std::vector<std::string> outputs = run_query(
+      query,
+      settings,
+      {.maximum_pending_outputs = maximum_pending_outputs,
+       .backpressure = ResultBackpressure::BLOCK});
+    REQUIRE(outputs == expected);
+  }
+}
+}  // namespace
+
+TEST_CASE("A blocking result stage hands the same complex events as the query thread",
+          "[ResultStage]") {
+  require_same_outputs_as_inline(MSFT_THEN_INTL + "WITHIN 10 EVENTS", {});
+}
+
+TEST_CASE("A blocking result stage keeps the tECS of retired partitions readable",
+          "[ResultStage]") {
+  // Only 4 of the 8 partitions are live and none is pooled, so the evicted
+  // evaluators are retired while their outputs are pending.
+  PartitionBySettings settings = {
+    .maximum_live_partitions = 4,
+    .eviction_policy = Interface::PartitionEvictionPolicy::LEAST_RECENTLY_USED,
+    .maximum_pooled_evaluators = 0};
+  std::string query = MSFT_THEN_INTL + "PARTITION BY [part]\nWITHIN 10 EVENTS";
+  require_same_outputs_as_inline(query, settings);
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
@@ -0,0 +1,141 @@
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/internal/interface/evaluators/partition_by_settings.hpp"
+#include "core_server/internal/parsing/ceql_query/parser.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/library/components/result_handler/result_handler.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/complex_event.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using Interface::PartitionBySettings;
+
+namespace {
+const std::string MSFT_THEN_INTL = "SELECT * FROM Stock\n"
+                                   "WHERE SELL as msft; SELL as intel\n"
+                                   "FILTER msft[name='MSFT'] AND intel[name='INTL']\n";
+
+struct Outputs {
+  uint64_t complex_events = 0;
+  // Complex events with an event that does not match the query, written by
+  // the query thread.
+  uint64_t wrong_complex_events = 0;
+};
+
+// Checks every output of msft; intel, a recycled tuple would not match.
+class CheckingResultHandler
+    : public Library::Components::ResultHandler<CheckingResultHandler> {
+  Outputs& outputs;
+
+ public:
+  CheckingResultHandler(const QueryCatalog& query_catalog, Outputs& outputs)
+      : ResultHandler(query_catalog), outputs(outputs) {}
+
+  void
+  handle_complex_event(std::optional<Internal::tECS::Enumerator>&& internal_enumerator) {
+    if (!internal_enumerator.has_value()) {
+      return;
+    }
+    Types::Enumerator enumerator = query_catalog.convert_enumerator(
+      std::move(internal_enumerator.value()));
+    for (const Types::ComplexEvent& complex_event : enumerator.complex_events) {
+      outputs.complex_events++;
+      const std::vector<Types::Event>& events = complex_event.events;
+      if (events.size() != 2 || events[0].attributes[0]->to_string() != "MSFT"
+          || events[1].attributes[0]->to_string() != "INTL"
+          || std::stoll(events[1].attributes[1]->to_string())
+                 - std::stoll(events[0].attributes[1]->to_string())
+               >= 10) {
+        outputs.wrong_complex_events++;
+      }
+    }
+  }
+
+  void start_impl() {}
+};
+
+struct Run {
+  Outputs outputs;
+  RingTupleQueue::MemoryUsage memory_after_a_quarter;
+  RingTupleQueue::MemoryUsage memory_at_the_end;
+};
+
+const size_t AMOUNT_OF_EVENTS = 200'000;
+const size_t EVENTS_PER_BATCH = 1000;
+
+// The names alternate between MSFT and INTL and stock_time is the position.
+Run run_query(std::string query, PartitionBySettings settings = {}) {
+  Run run;
+  Interface::Backend<CheckingResultHandler> backend(settings);
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"stock_time", Types::ValueTypes::INT64},
+                              {"part", Types::ValueTypes::INT64}}}}});
+  backend.declare_query(Parsing::QueryParser::parse_query(query),
+                        std::make_unique<CheckingResultHandler>(
+                          QueryCatalog(backend.get_catalog_reference()), run.outputs));
+  std::vector<Types::Event> events;
+  for (size_t i = 0; i < AMOUNT_OF_EVENTS; i++) {
+    events.push_back({0,
+                      {std::make_shared<Types::StringValue>(i % 2 == 0 ? "MSFT" : "INTL"),
+                       std::make_shared<Types::IntValue>(i),
+                       std::make_shared<Types::IntValue>(0)}});
+    if (events.size() == EVENTS_PER_BATCH) {
+      backend.send_events_to_queries(0, events);
+      // Bounds how far the backend gets ahead of the query.
+      backend.wait_until_processed();
+      events.clear();
+    }
+    if (i + 1 == AMOUNT_OF_EVENTS / 4) {
+      run.memory_after_a_quarter = backend.get_ring_tuple_queue_memory_usage();
+    }
+  }
+  run.memory_at_the_end = backend.get_ring_tuple_queue_memory_usage();
+  return run;
+}
+
+void require_buffers_are_recycled(const Run& run) {
+  // Every INTL has the 5 MSFT before it within 10, except for the first ones.
+  REQUIRE(run.outputs.complex_events == 5 * (AMOUNT_OF_EVENTS / 2) - (4 + 3 + 2 + 1));
+  REQUIRE(run.outputs.wrong_complex_events == 0);
+  REQUIRE(run.memory_at_the_end.bytes_allocated
+          == run.memory_after_a_quarter.bytes_allocated);
+}
+}  // namespace
+
+TEST_CASE("The ring tuple queue recycles the tuples out of an attribute time window") {
+  require_buffers_are_recycled(run_query(MSFT_THEN_INTL + "WITHIN 10 [stock_time]"));
+}
+
+TEST_CASE("The ring tuple queue recycles the tuples out of an events time window") {
+  require_buffers_are_recycled(run_query(MSFT_THEN_INTL + "WITHIN 10 EVENTS"));
+}
+
+TEST_CASE("The ring tuple queue recycles the tuples of sharded partitions") {
+  require_buffers_are_recycled(
+    run_query(MSFT_THEN_INTL + "PARTITION BY [part]\nWITHIN 10 [stock_time]",
+              {.worker_threads = 2}));
+}
+
+TEST_CASE("The ring tuple queue keeps the tuples without a time window") {
+  Run run = run_query(MSFT_THEN_INTL + "CONSUME BY ANY");
+  REQUIRE(run.outputs.wrong_complex_events == 0);
+  REQUIRE(run.memory_at_the_end.bytes_allocated
+          > 2 * run.memory_after_a_quarter.bytes_allocated);
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
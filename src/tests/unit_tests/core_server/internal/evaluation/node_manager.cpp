@@ -0,0 +1,147 @@
+#include "core_server/internal/evaluation/enumeration/tecs/node_manager.hpp"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
+#include "core_server/internal/evaluation/minipool/pool_compaction.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/value.hpp"
+
+namespace CORE::Internal::tECS::UnitTests {
+
+namespace {
+struct Tuples {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{1000, &schemas};
+
+  Tuples() { schemas.add_schema({RingTupleQueue::SupportedTypes::INT64}); }
+
+  RingTupleQueue::Tuple new_tuple(int64_t value) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = value;
+    return queue.get_tuple(data);
+  }
+};
+
+int64_t value_of(const RingTupleQueue::Tuple& tuple) {
+  return RingTupleQueue::Value<int64_t>(tuple[0]).get();
+}
+}  // namespace
+
+TEST_CASE("The nodes of every minipool are found by their id") {
+  Tuples tuples;
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  NodeManager node_manager(4, event_time_of_expiration);
+  std::vector<Node*> nodes;
+  for (int64_t pos = 0; pos < 100; pos++) {
+    RingTupleQueue::Tuple tuple = tuples.new_tuple(pos);
+    Node* node = node_manager.alloc(tuple, pos);
+    node_manager.increase_ref_count(node);
+    if (!nodes.empty()) {
+      node = node_manager.alloc(node, tuple, pos);
+      node_manager.increase_ref_count(node);
+    }
+    nodes.push_back(node);
+  }
+  // The pools have 4, 8, 16, 32, 64 and 128 nodes.
+  REQUIRE(node_manager.amount_of_nodes_allocated() == 252);
+
+  for (int64_t pos = 0; pos < 100; pos++) {
+    Node* node = nodes[pos];
+    REQUIRE(node_manager.node_at(node_manager.id_of(node)) == node);
+    REQUIRE(value_of(node_manager.tuple_of(*node)) == pos);
+    REQUIRE(node->pos() == pos);
+  }
+}
+
+TEST_CASE("The children of the nodes are found by their ids") {
+  Tuples tuples;
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS tecs(event_time_of_expiration);
+  RingTupleQueue::Tuple first_tuple = tuples.new_tuple(1);
+  RingTupleQueue::Tuple second_tuple = tuples.new_tuple(2);
+  Node* left = tecs.new_bottom(first_tuple, 5);
+  Node* right = tecs.new_extend(tecs.new_bottom(first_tuple, 5), second_tuple, 6);
+  Node* union_node = tecs.new_union(left, right);
+
+  REQUIRE(union_node->is_union());
+  REQUIRE(union_node->max() == 5);
+  REQUIRE(tecs.get_left(union_node) == left);
+  REQUIRE(tecs.get_right(union_node) == right);
+  REQUIRE(right->is_output());
+  REQUIRE(tecs.next(right)->is_bottom());
+  REQUIRE(value_of(tecs.get_tuple(right)) == 2);
+  REQUIRE(value_of(tecs.get_tuple(tecs.next(right))) == 1);
+}
+
+TEST_CASE("Compact releases the minipools of a burst once their nodes are free") {
+  Tuples tuples;
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  NodeManager node_manager(4, event_time_of_expiration);
+  uint64_t first_pool_bytes = node_manager.retained_bytes();
+  // Every output holds the previous one, only the last one is pinned.
+  RingTupleQueue::Tuple first_tuple = tuples.new_tuple(0);
+  Node* last = node_manager.alloc(first_tuple, 0);
+  for (int64_t pos = 1; pos < 100; pos++) {
+    RingTupleQueue::Tuple tuple = tuples.new_tuple(pos);
+    last = node_manager.alloc(last, tuple, pos);
+  }
+  node_manager.increase_ref_count(last);
+  uint64_t burst_bytes = node_manager.retained_bytes();
+  // The nodes of the time list are live too.
+  REQUIRE(node_manager.live_bytes() == 102 * sizeof(Node));
+  REQUIRE(node_manager.compact() == 0);
+
+  node_manager.decrease_ref_count(last);
+  REQUIRE(node_manager.live_bytes() == 101 * sizeof(Node));
+  uint64_t released = node_manager.compact();
+  REQUIRE(released == burst_bytes - first_pool_bytes);
+  REQUIRE(node_manager.retained_bytes() == first_pool_bytes);
+  REQUIRE(node_manager.released_bytes() == released);
+
+  // The released ids are given again.
+  std::vector<Node*> nodes;
+  for (int64_t pos = 0; pos < 10; pos++) {
+    RingTupleQueue::Tuple tuple = tuples.new_tuple(pos);
+    Node* node = node_manager.alloc(tuple, pos);
+    node_manager.increase_ref_count(node);
+    nodes.push_back(node);
+  }
+  for (int64_t pos = 0; pos < 10; pos++) {
+    REQUIRE(node_manager.node_at(node_manager.id_of(nodes[pos])) == nodes[pos]);
+    REQUIRE(value_of(node_manager.tuple_of(*nodes[pos])) == pos);
+  }
+}
+
+TEST_CASE("The tECS compacts its pools once they stay underused for the period") {
+  Tuples tuples;
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS tecs(event_time_of_expiration);
+  MiniPool::PoolCompactionSettings settings{.utilization_threshold = 0.5,
+                                            .period = std::chrono::seconds(10)};
+  auto start = std::chrono::steady_clock::time_point{};
+  uint64_t first_pool_bytes = tecs.retained_bytes();
+  std::vector<Node*> burst;
+  for (int64_t pos = 0; pos < 10'000; pos++) {
+    RingTupleQueue::Tuple tuple = tuples.new_tuple(pos);
+    burst.push_back(tecs.new_bottom(tuple, pos));
+    tecs.pin(burst.back());
+  }
+  REQUIRE(tecs.retained_bytes() > first_pool_bytes);
+  REQUIRE(tecs.compact_if_underused(settings, start) == 0);
+
+  for (Node* node : burst) {
+    tecs.unpin(node);
+  }
+  REQUIRE(tecs.compact_if_underused(settings, start) == 0);
+  REQUIRE(tecs.compact_if_underused(settings, start + std::chrono::seconds(5)) == 0);
+  REQUIRE(tecs.compact_if_underused(settings, start + std::chrono::seconds(10)) > 0);
+  REQUIRE(tecs.retained_bytes() == first_pool_bytes);
+}
+}  // namespace CORE::Internal::tECS::UnitTests
@@ -0,0 +1,384 @@
+#include "core_server/internal/evaluation/predicate_program/predicate_program.hpp"
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core_server/internal/evaluation/physical_predicate/predicate_headers.hpp"
+#include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/evaluation/predicate_program/predicate_instruction.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using namespace CEA;
+
+// Event 0: String, Integer1, Integer2, Double1, Double2. Event 1: Integer1, Integer2.
+// Event 2: Integer1, no predicate reads it.
+struct Events {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{10'000, &schemas};
+
+  Events() {
+    using Type = RingTupleQueue::SupportedTypes;
+    schemas.add_schema(
+      {Type::STRING_VIEW, Type::INT64, Type::INT64, Type::DOUBLE, Type::DOUBLE});
+    schemas.add_schema({Type::INT64, Type::INT64});
+    schemas.add_schema({Type::INT64});
+  }
+
+  RingTupleQueue::Tuple event_0(std::string string,
+                                int64_t integer1,
+                                int64_t integer2,
+                                double double1,
+                                double double2) {
+    uint64_t* data = queue.start_tuple(0);
+    char* chars = queue.writer<std::string>(string.size());
+    memcpy(chars, string.data(), string.size());
+    *queue.writer<int64_t>() = integer1;
+    *queue.writer<int64_t>() = integer2;
+    *queue.writer<double>() = double1;
+    *queue.writer<double>() = double2;
+    return queue.get_tuple(data);
+  }
+
+  RingTupleQueue::Tuple event_1(int64_t integer1, int64_t integer2) {
+    uint64_t* data = queue.start_tuple(1);
+    *queue.writer<int64_t>() = integer1;
+    *queue.writer<int64_t>() = integer2;
+    return queue.get_tuple(data);
+  }
+
+  RingTupleQueue::Tuple event_2(int64_t integer1) {
+    uint64_t* data = queue.start_tuple(2);
+    *queue.writer<int64_t>() = integer1;
+    return queue.get_tuple(data);
+  }
+};
+
+// Has no compilation, so the program calls it.
+class IntegerIsEven : public PhysicalPredicate {
+  size_t pos;
+
+ public:
+  IntegerIsEven(uint64_t event_type_id, size_t pos)
+      : PhysicalPredicate(event_type_id), pos(pos) {}
+
+  bool eval(RingTupleQueue::Tuple& tuple) override {
+    return RingTupleQueue::Value<int64_t>(tuple[pos]).get() % 2 == 0;
+  }
+
+  std::string to_string() const override {
+    return "Event[" + std::to_string(pos) + "] even";
+  }
+};
+
+template <typename Type>
+std::unique_ptr<MathExpr<Type>> attribute(size_t pos) {
+  return std::make_unique<Attribute<Type, Type>>(pos);
+}
+
+template <typename Type>
+std::unique_ptr<MathExpr<Type>> literal(Type value) {
+  return std::make_unique<Literal<Type>>(value);
+}
+
+// Integer1 * Integer2 of the event 0.
+std::unique_ptr<MathExpr<int64_t>> product() {
+  return std::make_unique<Multiplication<int64_t>>(attribute<int64_t>(1),
+                                                   attribute<int64_t>(2));
+}
+
+template <typename... Predicates>
+std::vector<std::unique_ptr<PhysicalPredicate>> vector_of(Predicates&&... predicates) {
+  std::vector<std::unique_ptr<PhysicalPredicate>> out;
+  (out.push_back(std::forward<Predicates>(predicates)), ...);
+  return out;
+}
+
+std::vector<std::unique_ptr<PhysicalPredicate>> mixed_predicates() {
+  std::vector<std::unique_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0, 0, "MSFT"));
+  predicates.push_back(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 5));
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<LESS_EQUALS, double>>(0, 3, 0.5));
+  predicates.push_back(
+    std::make_unique<CompareWithAttribute<GREATER_EQUALS, int64_t, double>>(0, 1, 4));
+  predicates.push_back(
+    std::make_unique<CompareWithAttribute<NOT_EQUALS, int64_t, int64_t>>(1, 0, 1));
+  predicates.push_back(
+    std::make_unique<CompareMathExprs<GREATER, int64_t>>(0,
+                                                         product(),
+                                                         literal<int64_t>(20)));
+  predicates.push_back(
+    std::make_unique<CompareMathExprs<LESS, int64_t>>(0,
+                                                      product(),
+                                                      literal<int64_t>(50)));
+  predicates.push_back(std::make_unique<CompareMathExprs<EQUALS, int64_t>>(
+    1,
+    std::make_unique<Modulo<int64_t>>(std::make_unique<Addition<int64_t>>(
+                                        attribute<int64_t>(0), literal<int64_t>(30)),
+                                      literal<int64_t>(3)),
+    std::make_unique<Subtraction<int64_t>>(attribute<int64_t>(1), literal<int64_t>(1))));
+  predicates.push_back(std::make_unique<CompareMathExprs<GREATER, double>>(
+    0,
+    std::make_unique<Division<double>>(attribute<double>(3), literal<double>(2.0)),
+    attribute<double>(4)));
+  predicates.push_back(std::make_unique<InRangePredicate<int64_t>>(0,
+                                                                   attribute<int64_t>(2),
+                                                                   literal<int64_t>(2),
+                                                                   literal<int64_t>(6)));
+  predicates.push_back(std::make_unique<AndPredicate>(
+    0,
+    vector_of(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 5),
+              std::make_unique<CompareMathExprs<GREATER, int64_t>>(0,
+                                                                   product(),
+                                                                   literal<int64_t>(20)),
+              std::make_unique<NotPredicate>(0, std::make_unique<IntegerIsEven>(0, 2)))));
+  // Each operand of the OR checks its own event type.
+  predicates.push_back(std::make_unique<OrPredicate>(
+    std::set<uint64_t>{0, 1},
+    vector_of(std::make_unique<CompareWithConstant<LESS, int64_t>>(1, 0, 3),
+              std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0,
+                                                                              0,
+                                                                              "ORCL"),
+              std::make_unique<CompareWithConstant<EQUALS, int64_t>>(0, 2, 4))));
+  predicates.push_back(std::make_unique<IntegerIsEven>(1, 1));
+  predicates.push_back(std::make_unique<AndPredicate>(vector_of()));
+  return predicates;
+}
+
+TEST_CASE("PredicateProgram evaluates as the virtual calls", "[PredicateProgram]") {
+  Events events;
+  PredicateEvaluator evaluator(mixed_predicates());
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int64_t> small_integer(0, 9);
+  std::uniform_int_distribution<int> coin(0, 2);
+  std::vector<std::string> names = {"MSFT", "ORCL", "CSCO"};
+
+  for (int i = 0; i < 2000; i++) {
+    RingTupleQueue::Tuple tuple = events.event_1(small_integer(rng), small_integer(rng));
+    if (coin(rng) != 0) {
+      tuple = events.event_0(names[coin(rng)],
+                             small_integer(rng),
+                             small_integer(rng),
+                             small_integer(rng) / 10.0,
+                             small_integer(rng) / 10.0);
+    }
+    Bitset::SmallBitset expected = evaluator.eval_with_virtual_calls(tuple);
+    INFO("Tuple " + std::to_string(i) + " of event type " + std::to_string(tuple.id()));
+    REQUIRE(evaluator(tuple) == expected);
+  }
+}
+
+TEST_CASE("PredicateProgram copies evaluate independently", "[PredicateProgram]") {
+  Events events;
+  PredicateEvaluator evaluator(mixed_predicates());
+  PredicateEvaluator copy = evaluator;
+  RingTupleQueue::Tuple msft = events.event_0("MSFT", 7, 4, 0.2, 0.0);
+  RingTupleQueue::Tuple orcl = events.event_0("ORCL", 1, 1, 0.9, 1.0);
+  Bitset::SmallBitset expected_msft = evaluator.eval_with_virtual_calls(msft);
+  Bitset::SmallBitset expected_orcl = evaluator.eval_with_virtual_calls(orcl);
+  REQUIRE(evaluator(msft) == expected_msft);
+  REQUIRE(copy(orcl) == expected_orcl);
+  REQUIRE(evaluator(msft) == expected_msft);
+}
+
+TEST_CASE("PredicateProgram computes common subexpressions once",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0, 0, "MSFT"));
+  predicates.push_back(
+    std::make_unique<CompareMathExprs<GREATER, int64_t>>(0,
+                                                         product(),
+                                                         literal<int64_t>(20)));
+  predicates.push_back(
+    std::make_unique<CompareMathExprs<LESS, int64_t>>(0,
+                                                      product(),
+                                                      literal<int64_t>(50)));
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0, 0, "MSFT"));
+  predicates.push_back(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 20));
+
+  PredicateProgram program(predicates);
+  // String, Integer1 and Integer2 are read once.
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::LOAD) == 3);
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::MULTIPLY) == 1);
+  // The repeated name filter is compared once.
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::COMPARE) == 4);
+  // A single event type check for the five predicates.
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::CHECK_EVENT_TYPE) == 1);
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::STORE_RESULT) == 5);
+
+  Events events;
+  RingTupleQueue::Tuple tuple = events.event_0("MSFT", 5, 6, 0, 0);
+  REQUIRE(program(tuple) == 0b01111);
+  tuple = events.event_0("ORCL", 21, 3, 0, 0);
+  REQUIRE(program(tuple) == 0b10010);
+  tuple = events.event_1(21, 3);
+  REQUIRE(program(tuple) == 0);
+}
+
+// Integer1 > minimum AND Integer2 / Integer1 > 2 of the event 0.
+std::unique_ptr<PhysicalPredicate> guarded_division(int64_t minimum) {
+  return std::make_unique<AndPredicate>(
+    0,
+    vector_of(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, minimum),
+              std::make_unique<CompareMathExprs<GREATER, int64_t>>(
+                0,
+                std::make_unique<Division<int64_t>>(attribute<int64_t>(2),
+                                                    attribute<int64_t>(1)),
+                literal<int64_t>(2))));
+}
+
+TEST_CASE("PredicateProgram short-circuits operands that can fail",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(guarded_division(5));
+  predicates.push_back(guarded_division(0));
+
+  PredicateProgram program(predicates);
+  // Each division only runs in its own branch, so it is not shared.
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::DIVIDE) == 2);
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::JUMP_IF) == 3);
+
+  Events events;
+  RingTupleQueue::Tuple tuple = events.event_0("MSFT", 6, 18, 0, 0);
+  REQUIRE(program(tuple) == 0b11);
+  tuple = events.event_0("MSFT", 3, 3, 0, 0);
+  REQUIRE(program(tuple) == 0b00);
+  tuple = events.event_0("MSFT", 3, 9, 0, 0);
+  REQUIRE(program(tuple) == 0b10);
+  // No division by zero.
+  tuple = events.event_0("MSFT", 0, 5, 0, 0);
+  REQUIRE(program(tuple) == 0b00);
+}
+
+TEST_CASE("PredicateProgram short-circuits operands with their own jumps",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  // The divisions are guarded inside the second and third operands, so the
+  // jumps over those operands go around jumps that are already landed.
+  predicates.push_back(std::make_unique<OrPredicate>(
+    0,
+    vector_of(std::make_unique<IntegerIsEven>(0, 2),
+              guarded_division(5),
+              std::make_unique<CompareWithConstant<EQUALS, int64_t>>(0, 2, 9),
+              guarded_division(0))));
+
+  PredicateProgram program(predicates);
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::DIVIDE) == 2);
+
+  Events events;
+  for (int64_t integer1 = 0; integer1 < 8; integer1++) {
+    for (int64_t integer2 = 0; integer2 < 20; integer2++) {
+      RingTupleQueue::Tuple tuple = events.event_0("MSFT", integer1, integer2, 0, 0);
+      bool expected = integer2 % 2 == 0 || (integer1 > 5 && integer2 / integer1 > 2)
+                      || integer2 == 9 || (integer1 > 0 && integer2 / integer1 > 2);
+      INFO("Integer1 " + std::to_string(integer1) + ", Integer2 "
+           + std::to_string(integer2));
+      REQUIRE(program(tuple) == (expected ? 0b1 : 0b0));
+    }
+  }
+}
+
+TEST_CASE("PredicateProgram evaluates cheap operands without jumps",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(std::make_unique<AndPredicate>(
+    0,
+    vector_of(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 5),
+              std::make_unique<CompareMathExprs<GREATER, int64_t>>(
+                0, product(), literal<int64_t>(20)))));
+  predicates.push_back(
+    std::make_unique<CompareMathExprs<GREATER, int64_t>>(0,
+                                                         product(),
+                                                         literal<int64_t>(20)));
+
+  PredicateProgram program(predicates);
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::MULTIPLY) == 1);
+  // Only the event type check jumps.
+  REQUIRE(program.amount_of_instructions(PredicateOpCode::JUMP_IF) == 1);
+
+  Events events;
+  RingTupleQueue::Tuple tuple = events.event_0("MSFT", 6, 4, 0, 0);
+  REQUIRE(program(tuple) == 0b11);
+  tuple = events.event_0("MSFT", 5, 5, 0, 0);
+  REQUIRE(program(tuple) == 0b10);
+  tuple = events.event_0("MSFT", 1, 1, 0, 0);
+  REQUIRE(program(tuple) == 0b00);
+}
+
+TEST_CASE("PredicateProgram of an event type has no event type checks",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  for (auto& predicate : mixed_predicates()) {
+    predicates.push_back(std::move(predicate));
+  }
+  PredicateEvaluator evaluator(mixed_predicates());
+  Events events;
+
+  PredicateProgram program_0(predicates, 0);
+  REQUIRE(program_0.amount_of_instructions(PredicateOpCode::CHECK_EVENT_TYPE) == 0);
+  REQUIRE(!program_0.constant_result().has_value());
+  RingTupleQueue::Tuple tuple = events.event_0("ORCL", 7, 4, 0.2, 0.0);
+  REQUIRE(program_0(tuple) == evaluator.eval_with_virtual_calls(tuple));
+
+  PredicateProgram program_1(predicates, 1);
+  REQUIRE(program_1.amount_of_instructions(PredicateOpCode::CHECK_EVENT_TYPE) == 0);
+  // Only the predicates of the event 1 read the tuple.
+  REQUIRE(program_1.amount_of_instructions(PredicateOpCode::LOAD) == 2);
+  tuple = events.event_1(2, 4);
+  REQUIRE(program_1(tuple) == evaluator.eval_with_virtual_calls(tuple));
+
+  // Only the empty conjunction admits the event 2.
+  PredicateProgram program_2(predicates, 2);
+  REQUIRE(program_2.constant_result() == Bitset::SmallBitset(uint64_t{1} << 13));
+}
+
+TEST_CASE("PredicateProgram of an event type reads the attributes at their offsets",
+          "[PredicateProgram]") {
+  std::vector<std::shared_ptr<PhysicalPredicate>> predicates;
+  for (auto& predicate : mixed_predicates()) {
+    predicates.push_back(std::move(predicate));
+  }
+  PredicateEvaluator evaluator(mixed_predicates());
+  Events events;
+  RingTupleQueue::Tuple tuple = events.event_0("ORCL", 7, 4, 0.2, 0.0);
+
+  PredicateProgram by_index(predicates, 0);
+  PredicateProgram by_offset(predicates, 0, tuple.get_relative_positions());
+  REQUIRE(by_offset.amount_of_instructions(PredicateOpCode::LOAD) == 0);
+  REQUIRE(by_offset.amount_of_instructions(PredicateOpCode::LOAD_AT_OFFSET)
+          == by_index.amount_of_instructions(PredicateOpCode::LOAD));
+  REQUIRE(by_offset(tuple) == evaluator.eval_with_virtual_calls(tuple));
+  tuple = events.event_0("MSFT", 6, 5, 0.5, 0.1);
+  REQUIRE(by_offset(tuple) == evaluator.eval_with_virtual_calls(tuple));
+}
+
+TEST_CASE("PredicateEvaluator caches the results of event types it does not read",
+          "[PredicateProgram]") {
+  PredicateEvaluator evaluator(mixed_predicates());
+  Events events;
+  RingTupleQueue::Tuple tuple = events.event_2(5);
+  REQUIRE(evaluator(tuple) == evaluator.eval_with_virtual_calls(tuple));
+  REQUIRE(evaluator.has_constant_result(2));
+  tuple = events.event_2(6);
+  REQUIRE(evaluator(tuple) == evaluator.eval_with_virtual_calls(tuple));
+
+  REQUIRE(!evaluator.has_constant_result(0));
+  tuple = events.event_0("MSFT", 7, 4, 0.2, 0.0);
+  REQUIRE(evaluator(tuple) == evaluator.eval_with_virtual_calls(tuple));
+  REQUIRE(!evaluator.has_constant_result(0));
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
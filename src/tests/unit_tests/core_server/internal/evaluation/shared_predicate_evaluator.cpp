@@ -0,0 +1,316 @@
+#include "core_server/internal/evaluation/shared_predicate_evaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+#include "core_server/internal/evaluation/physical_predicate/predicate_headers.hpp"
+#include "core_server/internal/evaluation/predicate_evaluator.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+
+namespace CORE::Internal::Evaluation::UnitTests {
+using namespace CEA;
+
+// Event 0: Name, Price. Event 1: Volume.
+struct StockEvents {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{10'000, &schemas};
+
+  StockEvents() {
+    using Type = RingTupleQueue::SupportedTypes;
+    schemas.add_schema({Type::STRING_VIEW, Type::INT64});
+    schemas.add_schema({Type::INT64});
+  }
+
+  uint64_t* buy(std::string name, int64_t price) {
+    uint64_t* data = queue.start_tuple(0);
+    char* chars = queue.writer<std::string>(name.size());
+    memcpy(chars, name.data(), name.size());
+    *queue.writer<int64_t>() = price;
+    return data;
+  }
+
+  uint64_t* sell(int64_t volume) {
+    uint64_t* data = queue.start_tuple(1);
+    *queue.writer<int64_t>() = volume;
+    return data;
+  }
+};
+
+// Has no compilation, so it is evaluated once per query.
+class PriceIsOdd : public PhysicalPredicate {
+ public:
+  PriceIsOdd() : PhysicalPredicate(0) {}
+
+  bool eval(RingTupleQueue::Tuple& tuple) override {
+    return RingTupleQueue::Value<int64_t>(tuple[1]).get() % 2 != 0;
+  }
+
+  std::string to_string() const override { return "Event[1] odd"; }
+};
+
+std::vector<std::unique_ptr<PhysicalPredicate>> first_query_predicates() {
+  std::vector<std::unique_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0, 0, "MSFT"));
+  predicates.push_back(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 5));
+  predicates.push_back(std::make_unique<CompareWithConstant<EQUALS, int64_t>>(1, 0, 3));
+  predicates.push_back(std::make_unique<PriceIsOdd>());
+  return predicates;
+}
+
+// Shares the first two predicates of the first query, in another order.
+std::vector<std::unique_ptr<PhysicalPredicate>> second_query_predicates() {
+  std::vector<std::unique_ptr<PhysicalPredicate>> predicates;
+  predicates.push_back(std::make_unique<CompareWithConstant<GREATER, int64_t>>(0, 1, 5));
+  predicates.push_back(std::make_unique<CompareWithConstant<LESS, int64_t>>(0, 1, 100));
+  predicates.push_back(
+    std::make_unique<CompareWithConstant<EQUALS, std::string_view>>(0, 0, "MSFT"));
+  predicates.push_back(std::make_unique<PriceIsOdd>());
+  return predicates;
+}
+
+std::vector<uint64_t*> random_tuples(StockEvents& events, size_t amount) {
+  std::mt19937 random(7);
+  std::vector<std::string> names = {"MSFT", "AAPL", "GOOG"};
+  std::vector<uint64_t*> out;
+  for (size_t i = 0; i < amount; i++) {
+    if (random() % 3 == 0) {
+      out.push_back(events.sell(random() % 6));
+    } else {
+      out.push_back(events.buy(names[random() % names.size()], random() % 200));
+    }
+  }
+  return out;
+}
+
+TEST_CASE("SharedPredicateEvaluator evaluates identical predicates once",
+          "[SharedPredicateEvaluator]") {
+  StockEvents events;
+  SharedPredicateEvaluator shared_evaluator(events.queue, 8);
+  std::atomic<uint64_t> processed_sequence = 0;
+  PredicateEvaluator first(first_query_predicates());
+  PredicateEvaluator second(second_query_predicates());
+  auto first_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(first.predicates, processed_sequence));
+  auto second_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(second.predicates, processed_sequence));
+  first.use_shared_results(first_view);
+  // A copy, as the evaluators of the partitions of a query.
+  PredicateEvaluator second_copy = second;
+  second_copy.use_shared_results(second_view);
+
+  // Name and price > 5. The others are only in one query, and the odd price
+  // checks have no compilation.
+  REQUIRE(shared_evaluator.amount_of_shared_predicates(0) == 2);
+  REQUIRE(shared_evaluator.amount_of_shared_predicates(1) == 0);
+
+  std::vector<uint64_t*> tuples = random_tuples(events, 200);
+  uint64_t sequence = 0;
+  for (size_t start = 0; start < tuples.size();
+       start += shared_evaluator.maximum_batch_size()) {
+    std::span<uint64_t* const> batch = std::span<uint64_t* const>(tuples).subspan(
+      start, std::min(shared_evaluator.maximum_batch_size(), tuples.size() - start));
+    shared_evaluator.evaluate(batch, sequence);
+    for (uint64_t* data : batch) {
+      RingTupleQueue::Tuple tuple = events.queue.get_tuple(data);
+      INFO("Tuple " + std::to_string(sequence) + " of event "
+           + std::to_string(tuple.id()));
+      first_view->current = &shared_evaluator.result_of(sequence);
+      second_view->current = &shared_evaluator.result_of(sequence);
+      REQUIRE(first(tuple) == first.eval_with_virtual_calls(tuple));
+      REQUIRE(second_copy(tuple) == second.eval_with_virtual_calls(tuple));
+      sequence++;
+    }
+  }
+}
+
+TEST_CASE("SharedPredicateEvaluator leaves a single query to evaluate on its own",
+          "[SharedPredicateEvaluator]") {
+  StockEvents events;
+  SharedPredicateEvaluator shared_evaluator(events.queue, 8);
+  std::atomic<uint64_t> processed_sequence = 0;
+  PredicateEvaluator first(first_query_predicates());
+  auto first_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(first.predicates, processed_sequence));
+  first.use_shared_results(first_view);
+
+  std::vector<uint64_t*> tuples = {events.buy("MSFT", 7), events.sell(3)};
+  shared_evaluator.evaluate(tuples, 0);
+  for (uint64_t sequence = 0; sequence < tuples.size(); sequence++) {
+    RingTupleQueue::Tuple tuple = events.queue.get_tuple(tuples[sequence]);
+    first_view->current = &shared_evaluator.result_of(sequence);
+    Bitset::SmallBitset shared_result;
+    REQUIRE(!first_view->read(shared_result));
+    REQUIRE(first(tuple) == first.eval_with_virtual_calls(tuple));
+  }
+
+  // Tuples evaluated before a query was added are not shared with it.
+  PredicateEvaluator second(second_query_predicates());
+  PredicateEvaluator third(second_query_predicates());
+  shared_evaluator.add_query(second.predicates, processed_sequence);
+  shared_evaluator.evaluate(tuples, 2);
+  auto third_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(third.predicates, processed_sequence));
+  third_view->current = &shared_evaluator.result_of(2);
+  Bitset::SmallBitset shared_result;
+  REQUIRE(!third_view->read(shared_result));
+  first_view->current = &shared_evaluator.result_of(2);
+  REQUIRE(first_view->read(shared_result));
+  REQUIRE(shared_result == Bitset::SmallBitset(0b0011));
+  RingTupleQueue::Tuple tuple = events.queue.get_tuple(tuples[0]);
+  REQUIRE(first(tuple) == first.eval_with_virtual_calls(tuple));
+}
+
+TEST_CASE("SharedPredicateEvaluator only compiles the event types of a new query again",
+          "[SharedPredicateEvaluator]") {
+  StockEvents events;
+  SharedPredicateEvaluator shared_evaluator(events.queue, 8);
+  std::atomic<uint64_t> processed_sequence = 0;
+  PredicateEvaluator first(first_query_predicates());
+  PredicateEvaluator second(second_query_predicates());
+  PredicateEvaluator third(first_query_predicates());
+  auto first_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(first.predicates, processed_sequence));
+  first.use_shared_results(first_view);
+  size_t second_id = shared_evaluator.add_query(second.predicates, processed_sequence);
+  size_t third_id = shared_evaluator.add_query(third.predicates, processed_sequence);
+
+  std::vector<uint64_t*> tuples = {events.buy("MSFT", 7), events.sell(3)};
+  uint64_t sequence = 0;
+  auto evaluate = [&]() {
+    shared_evaluator.evaluate(tuples, sequence);
+    for (uint64_t* data : tuples) {
+      RingTupleQueue::Tuple tuple = events.queue.get_tuple(data);
+      first_view->current = &shared_evaluator.result_of(sequence++);
+      REQUIRE(first(tuple) == first.eval_with_virtual_calls(tuple));
+    }
+  };
+  evaluate();
+  const SharedPredicateMapping* buy_mapping = shared_evaluator.result_of(0).mapping;
+  const SharedPredicateMapping* sell_mapping = shared_evaluator.result_of(1).mapping;
+  REQUIRE(buy_mapping != nullptr);
+  REQUIRE(sell_mapping != nullptr);
+
+  // Only has predicates of the buy events.
+  PredicateEvaluator fourth(second_query_predicates());
+  size_t fourth_id = shared_evaluator.add_query(fourth.predicates, processed_sequence);
+  evaluate();
+  REQUIRE(shared_evaluator.result_of(2).mapping != buy_mapping);
+  REQUIRE(shared_evaluator.result_of(3).mapping == sell_mapping);
+
+  // Without the third query the volume check is not shared.
+  shared_evaluator.remove_query(third_id);
+  evaluate();
+  REQUIRE(shared_evaluator.result_of(4).mapping != nullptr);
+  REQUIRE(shared_evaluator.result_of(5).mapping == nullptr);
+  REQUIRE(shared_evaluator.amount_of_shared_predicates(0) == 3);
+
+  shared_evaluator.remove_query(second_id);
+  shared_evaluator.remove_query(fourth_id);
+  evaluate();
+  REQUIRE(shared_evaluator.result_of(6).mapping == nullptr);
+  REQUIRE(shared_evaluator.result_of(7).mapping == nullptr);
+}
+
+TEST_CASE("SharedPredicateEvaluator frees the stages that the queries processed",
+          "[SharedPredicateEvaluator]") {
+  StockEvents events;
+  SharedPredicateEvaluator shared_evaluator(events.queue, 8);
+  std::atomic<uint64_t> processed_sequence = 0;
+  PredicateEvaluator first(first_query_predicates());
+  auto first_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(first.predicates, processed_sequence));
+  first.use_shared_results(first_view);
+
+  std::vector<uint64_t*> tuples = {events.buy("MSFT", 7), events.sell(3)};
+  uint64_t sequence = 0;
+  for (size_t i = 0; i < 100; i++) {
+    INFO("Iteration " + std::to_string(i));
+    // Every iteration compiles both event types again.
+    PredicateEvaluator other(first_query_predicates());
+    size_t other_id = shared_evaluator.add_query(other.predicates, processed_sequence);
+    shared_evaluator.evaluate(tuples, sequence);
+    for (uint64_t* data : tuples) {
+      RingTupleQueue::Tuple tuple = events.queue.get_tuple(data);
+      first_view->current = &shared_evaluator.result_of(sequence++);
+      REQUIRE(first_view->mapping() != nullptr);
+      REQUIRE(first(tuple) == first.eval_with_virtual_calls(tuple));
+      processed_sequence.store(sequence);
+    }
+    shared_evaluator.remove_query(other_id);
+    REQUIRE(shared_evaluator.amount_of_retained_stages() <= 2);
+  }
+
+  // A query that did not process the tuples keeps their stages.
+  std::atomic<uint64_t> stalled_sequence = sequence;
+  PredicateEvaluator stalled(first_query_predicates());
+  size_t stalled_id = shared_evaluator.add_query(stalled.predicates, stalled_sequence);
+  for (size_t i = 0; i < 10; i++) {
+    PredicateEvaluator other(first_query_predicates());
+    size_t other_id = shared_evaluator.add_query(other.predicates, processed_sequence);
+    shared_evaluator.evaluate(tuples, sequence);
+    sequence += tuples.size();
+    processed_sequence.store(sequence);
+    shared_evaluator.remove_query(other_id);
+  }
+  REQUIRE(shared_evaluator.amount_of_retained_stages() > 10);
+  // Only the stage evaluated last and the ones published after it are left.
+  shared_evaluator.remove_query(stalled_id);
+  REQUIRE(shared_evaluator.amount_of_retained_stages() == 3);
+}
+
+TEST_CASE("SharedPredicateEvaluator evaluates while queries are added and removed",
+          "[SharedPredicateEvaluator]") {
+  StockEvents events;
+  SharedPredicateEvaluator shared_evaluator(events.queue, 8);
+  std::atomic<uint64_t> processed_sequence = 0;
+  PredicateEvaluator first(first_query_predicates());
+  auto first_view = std::make_shared<SharedPredicateView>(
+    shared_evaluator.add_query(first.predicates, processed_sequence));
+  first.use_shared_results(first_view);
+  std::vector<uint64_t*> tuples = random_tuples(events, 200);
+
+  // The producer and the first query in the same thread.
+  std::atomic<bool> is_stopped = false;
+  size_t wrong_results = 0;
+  std::thread producer([&]() {
+    uint64_t sequence = 0;
+    while (!is_stopped.load()) {
+      std::span<uint64_t* const> batch = std::span<uint64_t* const>(tuples).subspan(
+        (sequence * 3) % (tuples.size() - shared_evaluator.maximum_batch_size()),
+        shared_evaluator.maximum_batch_size());
+      shared_evaluator.evaluate(batch, sequence);
+      for (uint64_t* data : batch) {
+        RingTupleQueue::Tuple tuple = events.queue.get_tuple(data);
+        first_view->current = &shared_evaluator.result_of(sequence++);
+        wrong_results += first(tuple) != first.eval_with_virtual_calls(tuple);
+        processed_sequence.store(sequence);
+      }
+    }
+  });
+  for (size_t i = 0; i < 200; i++) {
+    PredicateEvaluator other(i % 2 == 0 ? first_query_predicates()
+                                        : second_query_predicates());
+    size_t other_id = shared_evaluator.add_query(other.predicates, processed_sequence);
+    std::this_thread::yield();
+    shared_evaluator.remove_query(other_id);
+  }
+  is_stopped.store(true);
+  producer.join();
+
+  REQUIRE(wrong_results == 0);
+}
+}  // namespace CORE::Internal::Evaluation::UnitTests
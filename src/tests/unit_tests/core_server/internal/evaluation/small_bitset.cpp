@@ -0,0 +1,82 @@
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace CORE::Internal::Bitset::UnitTests {
+
+TEST_CASE("SmallBitset basic bit operations", "SmallBitset") {
+  SmallBitset bitset;
+  REQUIRE(bitset.none());
+  REQUIRE(bitset == 0);
+
+  bitset.set(0);
+  bitset.set(3);
+  REQUIRE(bitset == 0b1001);
+  REQUIRE(bitset.test(3));
+  REQUIRE(!bitset.test(2));
+  REQUIRE(bitset.count() == 2);
+  REQUIRE(bitset.to_string() == "1001");
+
+  bitset.reset(0);
+  REQUIRE(bitset == 0b1000);
+  REQUIRE(SmallBitset().to_string() == "0");
+
+  REQUIRE((SmallBitset(0b1100) & SmallBitset(0b1010)) == 0b1000);
+  REQUIRE((SmallBitset(0b1100) | SmallBitset(0b1010)) == 0b1110);
+  REQUIRE((SmallBitset(0b1100) ^ SmallBitset(0b1010)) == 0b0110);
+  REQUIRE(SmallBitset(0b1100).intersects(0b0100));
+  REQUIRE(!SmallBitset(0b1100).intersects(0b0011));
+  REQUIRE(SmallBitset(0b1010).complement(4) == 0b0101);
+}
+
+TEST_CASE("SmallBitset agrees_with_on only checks the masked bits", "SmallBitset") {
+  SmallBitset evaluation = 0b10011011;
+  REQUIRE(evaluation.agrees_with_on(0b10000000, 0b11100000));
+  REQUIRE(!evaluation.agrees_with_on(0b11000000, 0b11100000));
+  REQUIRE(evaluation.agrees_with_on(0, 0));
+}
+
+TEST_CASE("SmallBitset spills past the inline words", "SmallBitset") {
+  const uint64_t far_bit = SmallBitset::INLINE_BITS + 70;
+
+  SmallBitset small = SmallBitset::with_bit(5);
+  SmallBitset wide = SmallBitset::with_bit(far_bit);
+  REQUIRE(small.is_inline());
+  REQUIRE(!wide.is_inline());
+  REQUIRE(wide.test(far_bit));
+  REQUIRE(!wide.test(5));
+  REQUIRE(small < wide);
+  REQUIRE(!(wide < small));
+
+  SmallBitset both = small | wide;
+  REQUIRE(both.count() == 2);
+  REQUIRE(both.intersects(wide));
+  REQUIRE(both.agrees_with_on(wide, SmallBitset::with_bit(far_bit)));
+  REQUIRE(!both.agrees_with_on(small, both));
+
+  std::vector<uint64_t> set_bits;
+  both.for_each_set_bit([&](uint64_t pos) { set_bits.push_back(pos); });
+  REQUIRE(set_bits == std::vector<uint64_t>{5, far_bit});
+
+  SECTION("Clearing the wide bits returns to the inline representation") {
+    SmallBitset cleared = both ^ wide;
+    REQUIRE(cleared.is_inline());
+    REQUIRE(cleared == small);
+    REQUIRE(std::hash<SmallBitset>{}(cleared) == std::hash<SmallBitset>{}(small));
+
+    both.reset(far_bit);
+    REQUIRE(both.is_inline());
+    REQUIRE(both == small);
+  }
+
+  SECTION("Bitsets can be used as hash keys") {
+    std::unordered_set<SmallBitset> bitsets = {small, wide, both};
+    REQUIRE(bitsets.size() == 3);
+    REQUIRE(bitsets.contains(small | wide));
+    REQUIRE(!bitsets.contains(0));
+  }
+}
+}  // namespace CORE::Internal::Bitset::UnitTests
@@ -1,10 +1,173 @@
 #include "core_server/internal/evaluation/enumeration/tecs/tecs.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "core_server/internal/evaluation/enumeration/tecs/complex_event.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/enumerator.hpp"
 #include "core_server/internal/evaluation/enumeration/tecs/node.hpp"
+#include "core_server/internal/evaluation/enumeration/tecs/union_list.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/queue.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/tuple.hpp"
+#include "core_server/internal/stream/ring_tuple_queue/value.hpp"
+
+namespace CORE::Internal::tECS::UnitTests {
+
+using Output = std::pair<uint64_t, std::vector<int64_t>>;
+
+struct UnionListNodes {
+  RingTupleQueue::TupleSchemas schemas;
+  RingTupleQueue::Queue queue{1000, &schemas};
+  std::atomic<uint64_t> event_time_of_expiration = 0;
+  tECS tecs{event_time_of_expiration};
+
+  UnionListNodes() { schemas.add_schema({RingTupleQueue::SupportedTypes::INT64}); }
+
+  // Outputs the tuple of pos, it is not pinned.
+  Node* output(uint64_t pos) {
+    uint64_t* data = queue.start_tuple(0);
+    *queue.writer<int64_t>() = pos;
+    RingTupleQueue::Tuple tuple = queue.get_tuple(data);
+    return tecs.new_extend(tecs.new_bottom(tuple, pos), tuple, pos);
+  }
+
+  // The union of the nodes of the list as a new list merges it.
+  Node* fresh_merge(const UnionList& ulist) {
+    UnionList fresh = tecs.new_ulist(ulist[0]);
+    for (size_t idx = 1; idx < ulist.size(); idx++) {
+      fresh = tecs.insert(std::move(fresh), ulist[idx]);
+    }
+    Node* merged = tecs.merge(fresh);
+    tecs.pin(merged);
+    tecs.unpin(fresh);
+    return merged;
+  }
+
+  // The union that merge created before it was memoized, from the last node.
+  Node* merge_from_the_end(const UnionList& ulist) {
+    Node* tail = ulist[ulist.size() - 1];
+    for (size_t idx = ulist.size() - 1; idx-- > 0;) {
+      tail = tecs.new_direct_union(ulist[idx], tail);
+    }
+    tecs.pin(tail);
+    return tail;
+  }
+
+  // In the order of the enumeration, the node is unpinned.
+  std::vector<Output> enumerate(Node* node) {
+    std::vector<Output> outputs;
+    Enumerator enumerator(node, 100, 100, tecs, tecs.time_reservator, -1);
+    for (ComplexEvent complex_event : enumerator) {
+      std::vector<int64_t> positions;
+      for (RingTupleQueue::Tuple& tuple : complex_event.event_tuples) {
+        positions.push_back(RingTupleQueue::Value<int64_t>(tuple[0]).get());
+      }
+      outputs.push_back({complex_event.start, positions});
+    }
+    return outputs;
+  }
+};
+
+std::vector<Output> sorted(std::vector<Output> outputs) {
+  std::sort(outputs.begin(), outputs.end());
+  return outputs;
+}
+
+TEST_CASE("merge of a union list outputs what a fresh merge outputs", "[tECS]") {
+  UnionListNodes nodes;
+  tECS& tecs = nodes.tecs;
+  uint64_t live_bytes_before = tecs.live_bytes();
+
+  UnionList ulist = tecs.new_ulist(nodes.output(10));
+  for (uint64_t pos : {8, 6, 4, 2}) {
+    ulist = tecs.insert(std::move(ulist), nodes.output(pos));
+  }
+  // Every node inserted outputs one complex event.
+  size_t complex_events = 5;
+  auto check = [&]() {
+    Node* merged = tecs.merge(ulist);
+    REQUIRE(tecs.merge(ulist) == merged);
+    tecs.pin(merged);
+    std::vector<Output> outputs = nodes.enumerate(merged);
+    REQUIRE(outputs.size() == complex_events);
+    REQUIRE(outputs == nodes.enumerate(nodes.fresh_merge(ulist)));
+    // Only the order of the complex events changed with the memoization.
+    REQUIRE(sorted(outputs) == sorted(nodes.enumerate(nodes.merge_from_the_end(ulist))));
+  };
+  check();
+
+  SECTION("A node inserted between the others") {
+    ulist = tecs.insert(std::move(ulist), nodes.output(5));
+    complex_events++;
+    REQUIRE(ulist.size() == 6);
+    check();
+  }
+
+  SECTION("A node with the maximum start of another one") {
+    ulist = tecs.insert(std::move(ulist), nodes.output(6));
+    complex_events++;
+    REQUIRE(ulist.size() == 5);
+    REQUIRE(ulist[2]->is_union());
+    check();
+  }
+
+  SECTION("The nodes out of time removed") {
+    tecs.remove_nodes_out_of_time(ulist, 5);
+    complex_events = 3;
+    REQUIRE(ulist.size() == 3);
+    check();
+    ulist = tecs.insert(std::move(ulist), nodes.output(3));
+    complex_events++;
+    check();
+  }
+
+  SECTION("Every node removed but the first one") {
+    tecs.remove_nodes_out_of_time(ulist, 9);
+    complex_events = 1;
+    REQUIRE(ulist.size() == 1);
+    check();
+  }
+
+  // Once the list is unpinned every node it created is free.
+  tecs.unpin(ulist);
+  tecs.compact();
+  REQUIRE(tecs.live_bytes() == live_bytes_before);
+}
+
+TEST_CASE("The merged node of a union list outlives the changes of the list",
+          "[tECS]") {
+  UnionListNodes nodes;
+  tECS& tecs = nodes.tecs;
+  uint64_t live_bytes_before = tecs.live_bytes();
+
+  UnionList ulist = tecs.new_ulist(nodes.output(10));
+  for (uint64_t pos : {8, 6, 4}) {
+    ulist = tecs.insert(std::move(ulist), nodes.output(pos));
+  }
+  Node* merged = tecs.merge(ulist);
+  tecs.pin(merged);
+  std::vector<Output> expected = {{4, {4}}, {6, {6}}, {8, {8}}, {10, {10}}};
+  REQUIRE(sorted(nodes.enumerate(merged)) == expected);
+
+  tecs.pin(merged);
+  tecs.remove_nodes_out_of_time(ulist, 7);
+  ulist = tecs.insert(std::move(ulist), nodes.output(7));
+  REQUIRE(tecs.merge(ulist) != merged);
+  tecs.unpin(ulist);
+  tecs.compact();
+  REQUIRE(sorted(nodes.enumerate(merged)) == expected);
+
+  tecs.compact();
+  REQUIRE(tecs.live_bytes() == live_bytes_before);
+}
+}  // namespace CORE::Internal::tECS::UnitTests
 
 // These tests where commented out because Tuple's are now used.
 
@@ -0,0 +1,63 @@
+#include "core_server/internal/evaluation/enumeration/tecs/time_reservator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace CORE::Internal::tECS::UnitTests {
+
+TEST_CASE("The smallest reserved time is the oldest one that is not released") {
+  TimeReservator time_reservator;
+  REQUIRE(time_reservator.get_smallest_reserved_time() == UINT64_MAX);
+
+  // More slots than a block holds, so the blocks are chained and reused.
+  std::vector<TimeReservator::Slot*> slots;
+  for (uint64_t time = 0; time < 3 * TIME_RESERVATOR_SLOTS_PER_BLOCK; time++) {
+    slots.push_back(time_reservator.reserve(time));
+  }
+  REQUIRE(time_reservator.get_smallest_reserved_time() == 0);
+
+  time_reservator.release(slots[1]);
+  REQUIRE(time_reservator.get_smallest_reserved_time() == 0);
+  time_reservator.release(slots[0]);
+  REQUIRE(time_reservator.get_smallest_reserved_time() == 2);
+
+  for (uint64_t time = 2; time < 2 * TIME_RESERVATOR_SLOTS_PER_BLOCK; time++) {
+    time_reservator.release(slots[time]);
+  }
+  REQUIRE(time_reservator.get_smallest_reserved_time()
+          == 2 * TIME_RESERVATOR_SLOTS_PER_BLOCK);
+
+  uint64_t last_time = 3 * TIME_RESERVATOR_SLOTS_PER_BLOCK;
+  for (uint64_t time = last_time; time < last_time + 2 * TIME_RESERVATOR_SLOTS_PER_BLOCK;
+       time++) {
+    slots.push_back(time_reservator.reserve(time));
+  }
+  for (uint64_t time = 2 * TIME_RESERVATOR_SLOTS_PER_BLOCK; time < slots.size(); time++) {
+    REQUIRE(time_reservator.get_smallest_reserved_time() == time);
+    time_reservator.release(slots[time]);
+  }
+  REQUIRE(time_reservator.get_smallest_reserved_time() == UINT64_MAX);
+}
+
+TEST_CASE("The reserved times can be released by other threads") {
+  TimeReservator time_reservator;
+  std::vector<TimeReservator::Slot*> slots;
+  for (uint64_t time = 0; time < 10'000; time++) {
+    slots.push_back(time_reservator.reserve(time));
+  }
+  std::thread releaser([&]() {
+    for (TimeReservator::Slot* slot : slots) {
+      time_reservator.release(slot);
+    }
+  });
+  uint64_t smallest = 0;
+  while (smallest != UINT64_MAX) {
+    uint64_t next_smallest = time_reservator.get_smallest_reserved_time();
+    REQUIRE(next_smallest >= smallest);
+    smallest = next_smallest;
+  }
+  releaser.join();
+}
+}  // namespace CORE::Internal::tECS::UnitTests
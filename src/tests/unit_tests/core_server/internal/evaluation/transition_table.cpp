@@ -0,0 +1,86 @@
+#include "core_server/internal/evaluation/det_cea/transition_table.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+
+#include "core_server/internal/evaluation/bitset/small_bitset.hpp"
+
+namespace CORE::Internal::CEA::Det::UnitTests {
+using SmallBitset = Bitset::SmallBitset;
+
+TEST_CASE("TransitionTable stores and finds transitions", "TransitionTable") {
+  TransitionTable<uint64_t> table;
+  REQUIRE(table.find(0b101) == nullptr);
+
+  for (uint64_t i = 1; i <= 100; i++) {
+    table.insert(i, i * 10);
+  }
+  REQUIRE(table.size() == 100);
+  for (uint64_t i = 1; i <= 100; i++) {
+    REQUIRE(table.find(i) != nullptr);
+    REQUIRE(*table.find(i) == i * 10);
+  }
+  REQUIRE(table.find(101) == nullptr);
+
+  SECTION("Inserting an existing key overwrites it") {
+    table.insert(5, 7);
+    REQUIRE(*table.find(5) == 7);
+    REQUIRE(table.size() == 100);
+  }
+
+  SECTION("Erased keys are removed without losing the others") {
+    for (uint64_t i = 1; i <= 100; i += 2) {
+      table.erase(i);
+    }
+    REQUIRE(table.size() == 50);
+    for (uint64_t i = 1; i <= 100; i++) {
+      REQUIRE(table.contains(i) == (i % 2 == 0));
+    }
+  }
+
+  SECTION("Clear removes everything") {
+    table.clear();
+    REQUIRE(table.size() == 0);
+    REQUIRE(!table.contains(1));
+  }
+}
+
+TEST_CASE("TransitionTable keeps the empty evaluation in its own slot",
+          "TransitionTable") {
+  TransitionTable<uint64_t> table(1);
+  table.insert(0, 42);
+  table.insert(0b1, 1);
+  table.insert(0b10, 2);
+
+  // The empty evaluation does not count towards the bound.
+  REQUIRE(table.find(0) != nullptr);
+  REQUIRE(*table.find(0) == 42);
+  REQUIRE(table.size() == 2);
+
+  table.erase(0);
+  REQUIRE(table.find(0) == nullptr);
+}
+
+TEST_CASE("TransitionTable evicts the least recently used transition",
+          "TransitionTable") {
+  TransitionTable<uint64_t> table(3);
+  table.insert(1, 1);
+  table.insert(2, 2);
+  table.insert(3, 3);
+
+  // Use 1 so that 2 becomes the least recently used.
+  REQUIRE(table.find(1) != nullptr);
+  table.insert(4, 4);
+
+  REQUIRE(table.size() == 3);
+  REQUIRE(table.contains(1));
+  REQUIRE(!table.contains(2));
+  REQUIRE(table.contains(3));
+  REQUIRE(table.contains(4));
+
+  SmallBitset wide = SmallBitset::with_bit(SmallBitset::INLINE_BITS + 1);
+  table.insert(wide, 5);
+  REQUIRE(!table.contains(3));
+  REQUIRE(*table.find(wide) == 5);
+}
+}  // namespace CORE::Internal::CEA::Det::UnitTests
@@ -60,6 +60,17 @@ TEST_CASE("Select captures star correctly", "[Select, list_of_variables]") {
   REQUIRE(!parse_select(create_select_query("ALL", "T")).is_star);
 }
 
+TEST_CASE("Select captures COUNT(*) correctly", "[Select, Output]") {
+  Select count = parse_select(create_select_query("ANY", "count ( * )"));
+  REQUIRE(count.output == Select::Output::COUNT);
+  REQUIRE(count.strategy == Select::Strategy::ANY);
+  REQUIRE(count.is_star);
+  REQUIRE(parse_select(create_select_query("", "COUNT(*)")).output
+          == Select::Output::COUNT);
+  REQUIRE(parse_select(create_select_query("", "*")).output
+          == Select::Output::COMPLEX_EVENTS);
+}
+
 TEST_CASE("Select captures list_of_variables correctly", "[Select, list_of_variables]") {
   ProjectionFormula* formula;
   std::set<std::string> vars;
@@ -2,6 +2,7 @@
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -143,6 +144,64 @@ TEST_CASE("Tuple and TupleSchemas operations", "[Queue]") {
       REQUIRE(val1.get() == i);
     }
   }
+
+  SECTION("Ring memory usage") {
+    auto id = schemas.add_schema({SupportedTypes::INT64});
+    MemoryUsage initial = ring_tuple_queue.get_memory_usage();
+    REQUIRE(initial.bytes_allocated == 100 * sizeof(uint64_t));
+
+    uint64_t* data = nullptr;
+    for (int i = 0; i < 1000; i++) {
+      data = ring_tuple_queue.start_tuple(id);
+      *ring_tuple_queue.writer<int64_t>() = i;
+    }
+    MemoryUsage grown = ring_tuple_queue.get_memory_usage();
+    REQUIRE(grown.bytes_allocated >= 1000 * 3 * sizeof(uint64_t));
+    REQUIRE(grown.bytes_in_use == grown.bytes_allocated);
+
+    // Every tuple written so far can be recycled.
+    auto last_tuple = ring_tuple_queue.get_tuple(data);
+    ring_tuple_queue.update_overwrite_timepoint(last_tuple.timestamp());
+    for (int i = 0; i < 100; i++) {
+      ring_tuple_queue.start_tuple(id);
+      *ring_tuple_queue.writer<int64_t>() = i;
+    }
+    MemoryUsage recycled = ring_tuple_queue.get_memory_usage();
+    REQUIRE(recycled.bytes_allocated == grown.bytes_allocated);
+    REQUIRE(recycled.bytes_in_use < grown.bytes_in_use);
+  }
+}
+
+TEST_CASE("Queue with the buffers in a reserved address range", "[Queue]") {
+  TupleSchemas schemas;
+  auto id = schemas.add_schema({SupportedTypes::INT64, SupportedTypes::STRING_VIEW});
+  // Small enough that the last buffers go to the heap.
+  Queue ring_tuple_queue(100,
+                         &schemas,
+                         {.reserve_address_range = true,
+                          .reserved_bytes = 4096,
+                          .huge_pages = true});
+
+  std::vector<uint64_t*> datas;
+  for (int i = 0; i < 10000; i++) {
+    uint64_t* data = ring_tuple_queue.start_tuple(id);
+    *ring_tuple_queue.writer<int64_t>() = i;
+    std::string name = std::to_string(i);
+    char* chars = ring_tuple_queue.writer<std::string>(name.size());
+    memcpy(chars, name.data(), name.size());
+    datas.push_back(data);
+  }
+
+  std::chrono::system_clock::time_point previous_timestamp;
+  for (int i = 0; i < 10000; i++) {
+    Tuple tuple = ring_tuple_queue.get_tuple(datas[i]);
+    Value<int64_t> integer(tuple[0]);
+    REQUIRE(integer.get() == i);
+    Value<std::string_view> name(tuple[1]);
+    REQUIRE(name.get() == std::to_string(i));
+    REQUIRE(tuple.timestamp() >= previous_timestamp);
+    previous_timestamp = tuple.timestamp();
+  }
 }
 
 }  // namespace RingTupleQueue::UnitTests
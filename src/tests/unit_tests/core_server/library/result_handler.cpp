@@ -0,0 +1,212 @@
+#include "core_server/library/components/result_handler/result_handler.hpp"
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core_server/internal/coordination/query_catalog.hpp"
+#include "core_server/internal/interface/backend.hpp"
+#include "core_server/library/components/result_handler/result_emission_settings.hpp"
+#include "shared/datatypes/aliases/port_number.hpp"
+#include "shared/datatypes/enumerator.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/result_batch.hpp"
+#include "shared/datatypes/result_emission_mode.hpp"
+#include "shared/datatypes/value.hpp"
+#include "shared/networking/message_subscriber/zmq_message_subscriber.hpp"
+#include "shared/serializer/cereal_serializer.hpp"
+
+namespace CORE::Library::Components::UnitTests {
+
+using Backend = Internal::Interface::Backend<OnlineResultHandler>;
+
+const Types::PortNumber RESULTS_PORT = 5600;
+// Long enough for the subscription to reach the publisher and be polled.
+const std::chrono::milliseconds SUBSCRIPTION_DELAY{300};
+const int RECEIVE_TIMEOUT_MS = 2000;
+
+void declare_query(Backend& backend,
+                   ResultEmissionSettings settings,
+                   std::string selection = "*") {
+  backend.add_stream_type({"Stock",
+                           {{"SELL",
+                             {{"name", Types::ValueTypes::STRING_VIEW},
+                              {"price", Types::ValueTypes::INT64}}}}});
+  backend.declare_query("SELECT " + selection + " FROM Stock\n"
+                        + "WHERE SELL as msft\n"
+                        + "FILTER msft[name='MSFT']",
+                        std::make_unique<OnlineResultHandler>(
+                          Internal::QueryCatalog(backend.get_catalog_reference()),
+                          RESULTS_PORT,
+                          settings));
+}
+
+// Only the second event is a match.
+void send_events(Backend& backend) {
+  for (std::string name : {"INTL", "MSFT", "INTL"}) {
+    Types::Event event = {0,
+                          {std::make_shared<Types::StringValue>(name),
+                           std::make_shared<Types::IntValue>(1)}};
+    backend.send_event_to_queries(0, event);
+  }
+}
+
+template <class Payload>
+Payload
+receive(Internal::ZMQMessageSubscriber& subscriber, Types::ResultEmissionMode mode) {
+  std::optional<std::string> frame = subscriber.receive(RECEIVE_TIMEOUT_MS);
+  REQUIRE(frame.has_value());
+  REQUIRE(Types::is_result_emission_frame(mode, frame.value()));
+  return Internal::CerealSerializer<Payload>::deserialize(
+    Types::result_emission_payload(mode, frame.value()));
+}
+
+TEST_CASE("EveryEvent subscriptions get one enumerator per event",
+          "[result handler]") {
+  Internal::ZMQMessageSubscriber subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::EveryEvent));
+  Backend backend;
+  declare_query(backend, {.heartbeat_interval = std::chrono::milliseconds(0)});
+  std::this_thread::sleep_for(SUBSCRIPTION_DELAY);
+  send_events(backend);
+
+  for (size_t expected_size : {0, 1, 0}) {
+    INFO("Expected complex events: " + std::to_string(expected_size));
+    Types::Enumerator enumerator = receive<Types::Enumerator>(
+      subscriber, Types::ResultEmissionMode::EveryEvent);
+    REQUIRE(enumerator.complex_events.size() == expected_size);
+  }
+}
+
+TEST_CASE("COUNT(*) queries send their counts in frames of their own",
+          "[result handler]") {
+  Internal::ZMQMessageSubscriber subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::EveryEvent));
+  Internal::ZMQMessageSubscriber matches_only_subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::MatchesOnly));
+  Backend backend;
+  declare_query(backend,
+                {.maximum_batch_size = 1,
+                 .heartbeat_interval = std::chrono::milliseconds(0)},
+                "COUNT(*)");
+  std::this_thread::sleep_for(SUBSCRIPTION_DELAY);
+  send_events(backend);
+
+  std::vector<uint64_t> counts;
+  while (std::optional<std::string> frame = subscriber.receive(
+           static_cast<int>(SUBSCRIPTION_DELAY.count()))) {
+    if (!Types::is_result_emission_frame(Types::ResultEmissionMode::EveryEvent,
+                                         frame.value())) {
+      continue;
+    }
+    REQUIRE(Types::is_result_count_payload(frame.value()));
+    counts.push_back(Internal::CerealSerializer<uint64_t>::deserialize(
+      frame.value().substr(Types::RESULT_COUNT_TOPIC.size())));
+  }
+  REQUIRE(counts == std::vector<uint64_t>{0, 1, 0});
+  Types::ResultBatch batch = receive<Types::ResultBatch>(
+    matches_only_subscriber, Types::ResultEmissionMode::MatchesOnly);
+  REQUIRE(batch.enumerators.empty());
+  REQUIRE(batch.counts == std::vector<uint64_t>{1});
+}
+
+TEST_CASE("EveryEvent frames are the serialized enumerators without a topic",
+          "[result handler]") {
+  // Like the clients that predate the modes, it subscribes to every frame.
+  Internal::ZMQMessageSubscriber every_frame_subscriber("tcp://localhost:"
+                                                        + std::to_string(RESULTS_PORT));
+  Internal::ZMQMessageSubscriber matches_only_subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::MatchesOnly));
+  Backend backend;
+  declare_query(backend,
+                {.maximum_batch_size = 1,
+                 .heartbeat_interval = std::chrono::milliseconds(0)});
+  std::this_thread::sleep_for(SUBSCRIPTION_DELAY);
+  send_events(backend);
+
+  std::vector<size_t> sizes;
+  size_t result_batches = 0;
+  while (std::optional<std::string> frame = every_frame_subscriber.receive(
+           static_cast<int>(SUBSCRIPTION_DELAY.count()))) {
+    if (!Types::is_result_emission_frame(Types::ResultEmissionMode::EveryEvent,
+                                         frame.value())) {
+      result_batches++;
+      continue;
+    }
+    auto enumerator = Internal::CerealSerializer<Types::Enumerator>::deserialize(
+      frame.value());
+    REQUIRE(Internal::CerealSerializer<Types::Enumerator>::serialize(enumerator)
+            == frame.value());
+    sizes.push_back(enumerator.complex_events.size());
+  }
+  REQUIRE(sizes == std::vector<size_t>{0, 1, 0});
+  // The batch of the match, asked for by the other subscriber.
+  REQUIRE(result_batches == 1);
+  Types::ResultBatch batch = receive<Types::ResultBatch>(
+    matches_only_subscriber, Types::ResultEmissionMode::MatchesOnly);
+  REQUIRE(batch.enumerators.size() == 1);
+}
+
+TEST_CASE("MatchesOnly subscriptions only get the non-empty enumerators",
+          "[result handler]") {
+  Internal::ZMQMessageSubscriber subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::MatchesOnly));
+  Backend backend;
+  declare_query(backend,
+                {.maximum_batch_size = 1,
+                 .heartbeat_interval = std::chrono::milliseconds(0)});
+  std::this_thread::sleep_for(SUBSCRIPTION_DELAY);
+  send_events(backend);
+
+  Types::ResultBatch batch = receive<Types::ResultBatch>(
+    subscriber, Types::ResultEmissionMode::MatchesOnly);
+  REQUIRE(batch.enumerators.size() == 1);
+  REQUIRE(batch.enumerators[0].complex_events.size() == 1);
+  // The batch is full with the match of the second event.
+  REQUIRE(batch.amount_of_events_processed == 2);
+  REQUIRE(!subscriber.receive(static_cast<int>(SUBSCRIPTION_DELAY.count())).has_value());
+}
+
+TEST_CASE("MatchesOnly subscriptions get heartbeats with the query progress",
+          "[result handler]") {
+  Internal::ZMQMessageSubscriber subscriber(
+    "tcp://localhost:" + std::to_string(RESULTS_PORT),
+    Types::result_emission_topic(Types::ResultEmissionMode::MatchesOnly));
+  Backend backend;
+  declare_query(backend,
+                {.maximum_batch_latency = std::chrono::milliseconds(0),
+                 .heartbeat_interval = std::chrono::milliseconds(50)});
+  std::this_thread::sleep_for(SUBSCRIPTION_DELAY);
+
+  Types::ResultBatch heartbeat = receive<Types::ResultBatch>(
+    subscriber, Types::ResultEmissionMode::MatchesOnly);
+  REQUIRE(heartbeat.enumerators.empty());
+  REQUIRE(heartbeat.amount_of_events_processed == 0);
+
+  Types::Event event = {0,
+                        {std::make_shared<Types::StringValue>("INTL"),
+                         std::make_shared<Types::IntValue>(1)}};
+  backend.send_event_to_queries(0, event);
+  // The event has no matches, so the progress only arrives with a heartbeat.
+  uint64_t events_processed = 0;
+  for (int i = 0; i < 10 && events_processed == 0; i++) {
+    heartbeat = receive<Types::ResultBatch>(subscriber,
+                                            Types::ResultEmissionMode::MatchesOnly);
+    REQUIRE(heartbeat.enumerators.empty());
+    events_processed = heartbeat.amount_of_events_processed;
+  }
+  REQUIRE(events_processed == 1);
+}
+
+}  // namespace CORE::Library::Components::UnitTests
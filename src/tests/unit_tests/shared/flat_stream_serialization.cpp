@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/serializer/flat_stream/flat_stream_builder.hpp"
+#include "shared/serializer/flat_stream/flat_stream_format.hpp"
+#include "shared/serializer/flat_stream/flat_stream_reader.hpp"
+
+namespace CORE::Internal::UnitTests {
+
+Types::StreamInfo all_types_stream_info() {
+  return {7,
+          "S",
+          {{3,
+            "A",
+            {{"name", Types::ValueTypes::STRING_VIEW},
+             {"price", Types::ValueTypes::INT64},
+             {"ratio", Types::ValueTypes::DOUBLE},
+             {"open", Types::ValueTypes::BOOL},
+             {"date", Types::ValueTypes::DATE}}},
+           {4, "B", {{"id", Types::ValueTypes::INT64}}}}};
+}
+
+int64_t read_int(const FlatStreamReader::Event& event, size_t index) {
+  return static_cast<int64_t>(event.word(index));
+}
+
+double read_double(const FlatStreamReader::Event& event, size_t index) {
+  uint64_t word = event.word(index);
+  double value;
+  memcpy(&value, &word, sizeof(double));
+  return value;
+}
+
+TEST_CASE("Flat stream frames keep every attribute type", "[flat_stream]") {
+  FlatStreamBuilder builder(all_types_stream_info());
+  builder.add_event(3)
+    .add_string("MSFT")
+    .add_int(-101)
+    .add_double(1.5)
+    .add_bool(true)
+    .add_date(200);
+  builder.add_event(4).add_int(42);
+  builder.add_event(3)
+    .add_string("")
+    .add_int(7)
+    .add_double(-2.25)
+    .add_bool(false)
+    .add_date(0);
+  REQUIRE(builder.size() == 3);
+
+  std::string frame = builder.build();
+  REQUIRE(frame.size() % sizeof(uint64_t) == 0);
+  REQUIRE(FlatStreamReader::is_flat_stream(frame));
+
+  FlatStreamReader reader(frame);
+  REQUIRE(reader.get_stream_id() == 7);
+  REQUIRE(reader.get_amount_of_events() == 3);
+
+  // name (2 words), price, ratio, open, date.
+  size_t attribute_words = 6;
+
+  std::optional<FlatStreamReader::Event> event = reader.next_event();
+  REQUIRE(event.has_value());
+  REQUIRE(event->event_type_id == 3);
+  REQUIRE(event->string(attribute_words, event->word(0), event->word(1)) == "MSFT");
+  REQUIRE(read_int(event.value(), 2) == -101);
+  REQUIRE(read_double(event.value(), 3) == 1.5);
+  REQUIRE(event->word(4) == 1);
+  REQUIRE(read_int(event.value(), 5) == 200);
+
+  event = reader.next_event();
+  REQUIRE(event.has_value());
+  REQUIRE(event->event_type_id == 4);
+  REQUIRE(event->payload.size() == sizeof(uint64_t));
+  REQUIRE(read_int(event.value(), 0) == 42);
+
+  event = reader.next_event();
+  REQUIRE(event.has_value());
+  REQUIRE(event->string(attribute_words, event->word(0), event->word(1)) == "");
+  REQUIRE(read_double(event.value(), 3) == -2.25);
+  REQUIRE(event->word(4) == 0);
+
+  REQUIRE(!reader.next_event().has_value());
+}
+
+TEST_CASE("Flat stream builder rejects events that do not match the declaration",
+          "[flat_stream]") {
+  FlatStreamBuilder builder(all_types_stream_info());
+  REQUIRE_THROWS(builder.add_int(1));
+  REQUIRE_THROWS(builder.add_event(5));
+  builder.add_event(4);
+  REQUIRE_THROWS(builder.add_double(1.0));
+  builder.add_int(1);
+  REQUIRE_THROWS(builder.add_int(2));
+  builder.add_event(3).add_string("MSFT");
+  REQUIRE_THROWS(builder.build());
+}
+
+TEST_CASE("Flat stream reader rejects malformed frames", "[flat_stream]") {
+  REQUIRE(!FlatStreamReader::is_flat_stream("not a flat stream frame"));
+  REQUIRE_THROWS(FlatStreamReader(std::string_view("short")));
+
+  FlatStreamBuilder builder(all_types_stream_info());
+  builder.add_event(3)
+    .add_string("a long name")
+    .add_int(1)
+    .add_double(1)
+    .add_bool(true)
+    .add_date(1);
+  std::string frame = builder.build();
+
+  SECTION("Truncated") {
+    frame.resize(frame.size() - sizeof(uint64_t));
+    FlatStreamReader reader(frame);
+    REQUIRE_THROWS(reader.next_event());
+  }
+
+  SECTION("Trailing data") {
+    frame.append(sizeof(uint64_t), '\0');
+    FlatStreamReader reader(frame);
+    REQUIRE(reader.next_event().has_value());
+    REQUIRE_THROWS(reader.next_event());
+  }
+
+  SECTION("String out of the event") {
+    FlatStreamReader reader(frame);
+    std::optional<FlatStreamReader::Event> event = reader.next_event();
+    REQUIRE(event.has_value());
+    REQUIRE(!event->string(6, event->word(0), 1000).has_value());
+    REQUIRE(!event->string(6, UINT64_MAX, 1).has_value());
+  }
+}
+}  // namespace CORE::Internal::UnitTests
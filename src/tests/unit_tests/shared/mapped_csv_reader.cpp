@@ -0,0 +1,212 @@
+#include "shared/csv_reader/mapped_csv_reader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "shared/csv_reader/csv_reader_settings.hpp"
+#include "shared/datatypes/catalog/datatypes.hpp"
+#include "shared/datatypes/catalog/stream_info.hpp"
+#include "shared/datatypes/event.hpp"
+#include "shared/datatypes/value.hpp"
+#include "shared/serializer/flat_stream/flat_stream_reader.hpp"
+
+namespace CORE::Internal::UnitTests {
+
+Types::StreamInfo stocks_stream_info() {
+  return {0,
+          "S",
+          {{0,
+            "BUY",
+            {{"name", Types::ValueTypes::STRING_VIEW},
+             {"price", Types::ValueTypes::INT64},
+             {"ratio", Types::ValueTypes::DOUBLE},
+             {"open", Types::ValueTypes::BOOL}}},
+           {1, "SELL", {{"id", Types::ValueTypes::INT64}}}}};
+}
+
+// Written to the temporary directory, removed when the test ends.
+struct CSVFile {
+  std::string path;
+
+  CSVFile(std::string name, std::string contents)
+      : path(std::filesystem::temp_directory_path() / ("core_" + name + ".csv")) {
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+  }
+
+  ~CSVFile() { std::filesystem::remove(path); }
+};
+
+// Readable description of an event, the same for both readers.
+std::string describe(uint64_t event_type_id, std::vector<std::string> attributes) {
+  std::string out = std::to_string(event_type_id);
+  for (const std::string& attribute : attributes) {
+    out += "|" + attribute;
+  }
+  return out;
+}
+
+std::string describe(const Types::Event& event) {
+  std::vector<std::string> attributes;
+  for (const std::shared_ptr<Types::Value>& value : event.attributes) {
+    attributes.push_back(value->to_string());
+  }
+  return describe(event.event_type_id, attributes);
+}
+
+std::vector<std::string> describe_frame(std::string_view frame) {
+  std::vector<std::string> out;
+  FlatStreamReader reader(frame);
+  while (std::optional<FlatStreamReader::Event> event = reader.next_event()) {
+    std::vector<std::string> attributes;
+    if (event->event_type_id == 0) {
+      double ratio;
+      uint64_t ratio_word = event->word(3);
+      memcpy(&ratio, &ratio_word, sizeof(double));
+      attributes.push_back(
+        std::string(event->string(5, event->word(0), event->word(1)).value()));
+      attributes.push_back(std::to_string(static_cast<int64_t>(event->word(2))));
+      attributes.push_back(std::to_string(ratio));
+      attributes.push_back(std::to_string(event->word(4) != 0));
+    } else {
+      attributes.push_back(std::to_string(static_cast<int64_t>(event->word(0))));
+    }
+    out.push_back(describe(event->event_type_id, attributes));
+  }
+  return out;
+}
+
+std::string stocks_csv(size_t amount_of_events) {
+  std::string out = "name,attributes\n";
+  for (size_t i = 0; i < amount_of_events; i++) {
+    if (i % 3 == 2) {
+      out += "SELL," + std::to_string(i) + "\n";
+    } else {
+      out += "BUY,name" + std::to_string(i) + "," + std::to_string(100 - int64_t(i))
+             + "," + std::to_string(i / 4.0) + "," + (i % 2 == 0 ? "true" : "false")
+             + "\n";
+    }
+  }
+  return out;
+}
+
+std::vector<std::string> read_with_mapped_reader(const std::string& path,
+                                                 CSVReaderSettings settings) {
+  MappedCSVReader reader(stocks_stream_info(), path, settings);
+  std::vector<std::string> out;
+  uint64_t amount_of_events = reader.read_frames([&](std::string_view frame) {
+    std::vector<std::string> events = describe_frame(frame);
+    out.insert(out.end(), events.begin(), events.end());
+  });
+  REQUIRE(amount_of_events == out.size());
+  return out;
+}
+
+TEST_CASE("MappedCSVReader reads the same events as get_events_from_csv",
+          "[MappedCSVReader]") {
+  CSVFile file("mapped_csv_reader_events", stocks_csv(2000));
+  std::vector<std::string> expected;
+  for (const Types::Event& event : stocks_stream_info().get_events_from_csv(file.path)) {
+    expected.push_back(describe(event));
+  }
+  REQUIRE(expected.size() == 2000);
+
+  REQUIRE(read_with_mapped_reader(file.path, {}) == expected);
+  // Chunks of a few lines, so the order of the chunks matters.
+  REQUIRE(read_with_mapped_reader(file.path, {.chunk_size = 64}) == expected);
+  REQUIRE(read_with_mapped_reader(file.path,
+                                  {.chunk_size = 64,
+                                   .parser_threads = 4,
+                                   .maximum_chunks_ahead = 3})
+          == expected);
+}
+
+TEST_CASE("MappedCSVReader accepts windows line endings and no final newline",
+          "[MappedCSVReader]") {
+  CSVFile file("mapped_csv_reader_line_endings",
+               "name,attributes\r\nSELL, 5\r\n\r\nBUY,,-3,+1.5,true\r\nSELL,7");
+  std::vector<std::string> expected = {describe(1, {"5"}),
+                                       describe(0, {"", "-3", "1.500000", "1"}),
+                                       describe(1, {"7"})};
+  REQUIRE(read_with_mapped_reader(file.path, {}) == expected);
+  REQUIRE(read_with_mapped_reader(file.path, {.chunk_size = 1, .parser_threads = 2})
+          == expected);
+}
+
+TEST_CASE("MappedCSVReader ignores what get_events_from_csv ignores",
+          "[MappedCSVReader]") {
+  // Fields after the attributes, and text after a number.
+  CSVFile file("mapped_csv_reader_lenient",
+               "name,attributes\n"
+               "SELL,7,\n"
+               "SELL,8,9,extra\n"
+               "SELL,9abc\n"
+               "SELL, +10 \n"
+               "BUY,MSFT,12.5,2.5x,true,\n");
+  std::vector<std::string> expected;
+  for (const Types::Event& event : stocks_stream_info().get_events_from_csv(file.path)) {
+    expected.push_back(describe(event));
+  }
+  REQUIRE(expected
+          == std::vector<std::string>{describe(1, {"7"}),
+                                      describe(1, {"8"}),
+                                      describe(1, {"9"}),
+                                      describe(1, {"10"}),
+                                      describe(0, {"MSFT", "12", "2.500000", "1"})});
+  REQUIRE(read_with_mapped_reader(file.path, {}) == expected);
+  REQUIRE(read_with_mapped_reader(file.path, {.chunk_size = 1, .parser_threads = 2})
+          == expected);
+}
+
+TEST_CASE("MappedCSVReader reads an empty file", "[MappedCSVReader]") {
+  CSVFile file("mapped_csv_reader_empty", "");
+  REQUIRE(read_with_mapped_reader(file.path, {}).empty());
+  REQUIRE(read_with_mapped_reader(file.path, {.parser_threads = 2}).empty());
+}
+
+TEST_CASE("MappedCSVReader consumes the frames before an invalid line",
+          "[MappedCSVReader]") {
+  for (std::string invalid_line :
+       {"BUY,MSFT,x,1.0,true\n", "BUY,MSFT,1,,true\n", "HOLD,1\n", "SELL\n"}) {
+    CSVFile file("mapped_csv_reader_invalid",
+                 stocks_csv(100) + invalid_line + "SELL,1\n");
+    for (size_t parser_threads : {0, 3}) {
+      MappedCSVReader reader(stocks_stream_info(),
+                             file.path,
+                             {.chunk_size = 64, .parser_threads = parser_threads});
+      size_t amount_of_events = 0;
+      REQUIRE_THROWS(reader.read_frames([&](std::string_view frame) {
+        amount_of_events += describe_frame(frame).size();
+      }));
+      // Only the chunk of the invalid line is lost.
+      REQUIRE(amount_of_events > 90);
+      REQUIRE(amount_of_events < 100);
+    }
+  }
+}
+
+TEST_CASE("MappedCSVReader stops the parsers if the consumer throws",
+          "[MappedCSVReader]") {
+  CSVFile file("mapped_csv_reader_consumer", stocks_csv(1000));
+  MappedCSVReader reader(stocks_stream_info(),
+                         file.path,
+                         {.chunk_size = 64, .parser_threads = 4});
+  size_t amount_of_frames = 0;
+  REQUIRE_THROWS(reader.read_frames([&](std::string_view frame) {
+    if (++amount_of_frames == 5) {
+      throw std::runtime_error("Consumer failed");
+    }
+  }));
+  REQUIRE(amount_of_frames == 5);
+}
+}  // namespace CORE::Internal::UnitTests